@@ -28,6 +28,7 @@
 #include <OpenSim/Simulation/Control/PrescribedController.h>
 #include <OpenSim/Tools/AnalyzeTool.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
+#include <OpenSim/Analyses/InducedAccelerations.h>
 #include <OpenSim/Analyses/InducedAccelerationsSolver.h>
 
 using namespace OpenSim;
@@ -57,6 +58,19 @@ int main()
             std::vector<double>(result1.getSmallestNumberOfStates(), 0.15),
             __FILE__, __LINE__, "Induced Accelerations of Running failed");
         cout << "Induced Accelerations of Running passed\n" << endl;
+
+        // Contributors computed on several threads give the same results
+        AnalyzeTool threaded("subject02_Setup_IAA_02_232.xml");
+        threaded.setResultsDir("ResultsInducedAccelerationsThreaded");
+        dynamic_cast<InducedAccelerations&>(
+            threaded.getAnalysisSet().get("InducedAccelerations"))
+                .setNumThreads(3);
+        threaded.run();
+        Storage result2("ResultsInducedAccelerationsThreaded/subject02_running_arms_InducedAccelerations_center_of_mass.sto");
+        CHECK_STORAGE_AGAINST_STANDARD(result2, result1,
+            std::vector<double>(result1.getSmallestNumberOfStates(), 1e-6),
+            __FILE__, __LINE__, "Threaded Induced Accelerations of Running failed");
+        cout << "Threaded Induced Accelerations of Running passed\n" << endl;
     }
     catch (const OpenSim::Exception& e) {
         e.print(cerr);
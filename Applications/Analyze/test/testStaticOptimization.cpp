@@ -40,6 +40,10 @@ void testArm26(const string& muscleModelClassName, double atol, double ftol);
 
 void testArm26DisabledMuscles();
 
+void testAnalyticConstraintMatrix();
+
+void testParallelFrames();
+
 void testLapackErrorDLASD4();
 
 void testModelWithPassiveForces();
@@ -105,6 +109,22 @@ int main()
         failures.push_back("testArm26DisabledMuscles");
     }
 
+    try {
+        testAnalyticConstraintMatrix();
+    }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testAnalyticConstraintMatrix");
+    }
+
+    try {
+        testParallelFrames();
+    }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testParallelFrames");
+    }
+
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << endl;
         return 1;
@@ -265,4 +285,67 @@ void testArm26DisabledMuscles() {
     ASSERT_EQUAL(forces.getColumnLabels().findIndex("TRIlat"), -1);
     ASSERT_EQUAL(forces.getColumnLabels().findIndex("TRImed"), -1);
 
+}
+
+void testAnalyticConstraintMatrix() {
+    // The constraint matrix computed from the mass matrix gives the same
+    // solution as the one computed by forward dynamics (the model has muscles,
+    // a passive spring and external loads).
+    AnalyzeTool analyze("staticoptimization_spring_Setup.xml");
+    analyze.setResultsDir("ResultsSO_spring_analytic");
+    StaticOptimization& so = dynamic_cast<StaticOptimization&>(
+            analyze.getAnalysisSet().get("StaticOptimization"));
+    so.setUseAnalyticConstraintMatrix(true);
+    analyze.run();
+    std::string resultsDir = analyze.getResultsDir();
+    Storage activations(resultsDir + "/walk_subject01_ankle_spring_StaticOptimization_activation.sto");
+    Storage stdActivations("std_walk_subject01_ankle_spring_StaticOptimization_activation.sto");
+
+    Storage forces(resultsDir + "/walk_subject01_ankle_spring_StaticOptimization_force.sto");
+    Storage stdForces("std_walk_subject01_ankle_spring_StaticOptimization_force.sto");
+
+    CHECK_STORAGE_AGAINST_STANDARD(activations, stdActivations,
+        std::vector<double>(28, 0.025),
+        __FILE__, __LINE__,
+        "AnalyticConstraintMatrix activations failed");
+
+    CHECK_STORAGE_AGAINST_STANDARD(forces, stdForces,
+        std::vector<double>(48, 2.5),
+        __FILE__, __LINE__,
+        "AnalyticConstraintMatrix forces failed.");
+    cout << resultsDir << ": test AnalyticConstraintMatrix passed." << endl;
+}
+
+void testParallelFrames() {
+    // Solving blocks of frames on several threads gives the results of the
+    // sequential solution, in time order.
+    AnalyzeTool analyze("staticoptimization_spring_Setup.xml");
+    analyze.setResultsDir("ResultsSO_spring_parallel");
+    StaticOptimization& so = dynamic_cast<StaticOptimization&>(
+            analyze.getAnalysisSet().get("StaticOptimization"));
+    so.setNumThreads(3);
+    analyze.run();
+    std::string resultsDir = analyze.getResultsDir();
+    Storage activations(resultsDir + "/walk_subject01_ankle_spring_StaticOptimization_activation.sto");
+    Storage stdActivations("std_walk_subject01_ankle_spring_StaticOptimization_activation.sto");
+
+    Storage forces(resultsDir + "/walk_subject01_ankle_spring_StaticOptimization_force.sto");
+    Storage stdForces("std_walk_subject01_ankle_spring_StaticOptimization_force.sto");
+
+    ASSERT_EQUAL(stdActivations.getSize(), activations.getSize());
+    for (int i = 1; i < activations.getSize(); ++i) {
+        ASSERT(activations.getRow(i).getTime() >
+               activations.getRow(i-1).getTime());
+    }
+
+    CHECK_STORAGE_AGAINST_STANDARD(activations, stdActivations,
+        std::vector<double>(28, 0.025),
+        __FILE__, __LINE__,
+        "ParallelFrames activations failed");
+
+    CHECK_STORAGE_AGAINST_STANDARD(forces, stdForces,
+        std::vector<double>(48, 2.5),
+        __FILE__, __LINE__,
+        "ParallelFrames forces failed.");
+    cout << resultsDir << ": test ParallelFrames passed." << endl;
 }
\ No newline at end of file
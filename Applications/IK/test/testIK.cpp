@@ -83,6 +83,20 @@ int main()
             std::vector<double>(24, 0.2), __FILE__, __LINE__, 
             "testInverseKinematicsGait2354 failed");
         cout << "testInverseKinematicsGait2354 passed" << endl;
+
+        // Solving the frames in chunks on several threads gives the same
+        // motion as solving them in sequence.
+        InverseKinematicsTool ikParallel("subject01_Setup_InverseKinematics.xml");
+        ikParallel.setNumThreads(4);
+        ikParallel.setOutputMotionFileName(
+            "subject01_walk1_ik_test_parallel.mot");
+        ikParallel.run();
+        Storage resultParallel(ikParallel.getOutputMotionFileName());
+        ASSERT(resultParallel.getSize() == result1.getSize());
+        CHECK_STORAGE_AGAINST_STANDARD(resultParallel, result1,
+            std::vector<double>(24, 1e-3), __FILE__, __LINE__,
+            "testInverseKinematicsGait2354 with threads failed");
+        cout << "testInverseKinematicsGait2354 with threads passed" << endl;
     }
     catch (const std::exception& e) {
         cout << e.what() << endl;
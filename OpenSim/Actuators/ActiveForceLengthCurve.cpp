@@ -80,6 +80,7 @@ void ActiveForceLengthCurve::constructProperties()
     constructProperty_max_norm_active_fiber_length(1.8123);
     constructProperty_shallow_ascending_slope(0.8616);
     constructProperty_minimum_value(0.1);
+    constructProperty_lookup_table_tolerance();
 }
 
 void ActiveForceLengthCurve::buildCurve()
@@ -87,6 +88,9 @@ void ActiveForceLengthCurve::buildCurve()
     SimTK::Function* f = createSimTKFunction();
     m_curve = *(static_cast<SmoothSegmentedFunction*>(f));
     delete f;
+    if(!getProperty_lookup_table_tolerance().empty())
+        m_curve.setLookupTableTolerance(get_lookup_table_tolerance());
+
     setObjectIsUpToDateWithProperties();
 }
 
@@ -148,6 +152,18 @@ void ActiveForceLengthCurve::setMinValue(double minimumValue)
     ensureCurveUpToDate();
 }
 
+double ActiveForceLengthCurve::getLookupTableTolerance() const
+{
+    return getProperty_lookup_table_tolerance().empty() ?
+        0 : get_lookup_table_tolerance();
+}
+
+void ActiveForceLengthCurve::setLookupTableTolerance(double tolerance)
+{
+    set_lookup_table_tolerance(tolerance);
+    ensureCurveUpToDate();
+}
+
 //==============================================================================
 // SERVICES
 //==============================================================================
@@ -177,6 +193,26 @@ double ActiveForceLengthCurve::
     return m_curve.calcDerivative(derivComponents, x);
 }
 
+void ActiveForceLengthCurve::calcDerivatives(const SimTK::Vector& x, int order,
+        SimTK::Vector& result) const
+{
+    SimTK_ASSERT(isObjectUpToDateWithProperties(),
+        "ActiveForceLengthCurve: Curve is not up-to-date with its properties");
+    SimTK_ERRCHK1_ALWAYS(order >= 0 && order <= 2,
+        "ActiveForceLengthCurve::calcDerivatives",
+        "order must be 0, 1, or 2, but %i was entered", order);
+
+    m_curve.calcDerivatives(x, order, result);
+}
+
+const SmoothSegmentedFunction& ActiveForceLengthCurve::
+    getSmoothSegmentedFunction() const
+{
+    SimTK_ASSERT(isObjectUpToDateWithProperties(),
+        "ActiveForceLengthCurve: Curve is not up-to-date with its properties");
+    return m_curve;
+}
+
 SimTK::Vec2 ActiveForceLengthCurve::getCurveDomain() const
 {
     SimTK_ASSERT(isObjectUpToDateWithProperties(),
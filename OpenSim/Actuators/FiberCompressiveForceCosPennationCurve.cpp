@@ -83,6 +83,7 @@ void FiberCompressiveForceCosPennationCurve::constructProperties()
     constructProperty_stiffness_at_perpendicular();
     constructProperty_curviness();
 
+    constructProperty_lookup_table_tolerance();
 }
 
 
@@ -100,6 +101,9 @@ void FiberCompressiveForceCosPennationCurve::buildCurve( bool computeIntegral )
     
     delete f;  
        
+    if(!getProperty_lookup_table_tolerance().empty())
+        m_curve.setLookupTableTolerance(get_lookup_table_tolerance());
+
     setObjectIsUpToDateWithProperties();
 }
 
@@ -221,6 +225,19 @@ bool FiberCompressiveForceCosPennationCurve::isFittedCurveBeingUsed() const
     return m_isFittedCurveBeingUsed;
 }
 
+double FiberCompressiveForceCosPennationCurve::getLookupTableTolerance() const
+{
+    return getProperty_lookup_table_tolerance().empty() ?
+        0 : get_lookup_table_tolerance();
+}
+
+void FiberCompressiveForceCosPennationCurve::
+    setLookupTableTolerance(double tolerance)
+{
+    set_lookup_table_tolerance(tolerance);
+    ensureCurveUpToDate();
+}
+
 //=============================================================================
 // SERVICES
 //=============================================================================
@@ -256,6 +273,29 @@ double FiberCompressiveForceCosPennationCurve::
     return m_curve.calcDerivative(derivComponents, x);
 }
 
+void FiberCompressiveForceCosPennationCurve::
+    calcDerivatives(const SimTK::Vector& x, int order,
+        SimTK::Vector& result) const
+{
+    SimTK_ASSERT(isObjectUpToDateWithProperties(),
+        "FiberCompressiveForceCosPennationCurve: Curve is not up-to-date"
+        " with its properties");
+    SimTK_ERRCHK1_ALWAYS(order >= 0 && order <= 2,
+        "FiberCompressiveForceCosPennationCurve::calcDerivatives",
+        "order must be 0, 1, or 2, but %i was entered", order);
+
+    m_curve.calcDerivatives(x, order, result);
+}
+
+const SmoothSegmentedFunction& FiberCompressiveForceCosPennationCurve::
+    getSmoothSegmentedFunction() const
+{
+    SimTK_ASSERT(isObjectUpToDateWithProperties(),
+        "FiberCompressiveForceCosPennationCurve: Curve is not up-to-date"
+        " with its properties");
+    return m_curve;
+}
+
 double FiberCompressiveForceCosPennationCurve::
     calcIntegral(double cosPennationAngle) const
 {    
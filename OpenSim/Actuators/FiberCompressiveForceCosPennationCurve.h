@@ -83,6 +83,10 @@ public:
         "Stiffness of the curve at pennation angle of 90 degrees");
     OpenSim_DECLARE_OPTIONAL_PROPERTY(curviness, double, 
         "Fiber curve bend, from linear to maximum bend (0-1)");
+    OpenSim_DECLARE_OPTIONAL_PROPERTY(lookup_table_tolerance, double,
+        "If set, the curve and its first two derivatives are evaluated from "
+        "a precomputed table with at most this error (relative to their "
+        "largest magnitudes)");
 
 //==============================================================================
 // PUBLIC METHODS
@@ -333,6 +337,18 @@ public:
     double calcDerivative(const std::vector<int>& derivComponents,
                           const SimTK::Vector& x) const override;
 
+    /** Evaluates the derivative of the given order (0, 1 or 2; 0 gives the
+    value of the curve) at each element of `x`, writing the results to
+    `result`. This is faster than calling calcDerivative() for each element
+    when the curve has a lookup table (see setLookupTableTolerance()). */
+    void calcDerivatives(const SimTK::Vector& x, int order,
+                         SimTK::Vector& result) const;
+
+    /** The SmoothSegmentedFunction that implements this curve, e.g., to 
+    evaluate the curves of many muscles in one call with
+    SmoothSegmentedFunction::calcDerivatives(). */
+    const SmoothSegmentedFunction& getSmoothSegmentedFunction() const;
+
     /**     
     @param cosPennationAngle
                 The cosine of the pennation angle
@@ -412,6 +428,13 @@ public:
        */
        void printMuscleCurveToCSVFile(const std::string& path);
 
+       /** @returns The error bound of the lookup table used to evaluate the curve,
+       or 0 if the curve is evaluated without a table. */
+       double getLookupTableTolerance() const;
+
+       /** See SmoothSegmentedFunction::setLookupTableTolerance(). */
+       void setLookupTableTolerance(double tolerance);
+
        void ensureCurveUpToDate();
     
 
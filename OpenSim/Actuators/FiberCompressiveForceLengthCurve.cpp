@@ -72,6 +72,7 @@ void FiberCompressiveForceLengthCurve::constructProperties()
     constructProperty_norm_length_at_zero_force(0.5);
     constructProperty_stiffness_at_zero_length();
     constructProperty_curviness();
+    constructProperty_lookup_table_tolerance();
 }
 
 
@@ -89,6 +90,9 @@ void FiberCompressiveForceLengthCurve::buildCurve( bool computeIntegral )
 
     delete f; 
 
+    if(!getProperty_lookup_table_tolerance().empty())
+        m_curve.setLookupTableTolerance(get_lookup_table_tolerance());
+
     setObjectIsUpToDateWithProperties();
 }
 
@@ -212,6 +216,18 @@ void FiberCompressiveForceLengthCurve::
 }
 
 
+double FiberCompressiveForceLengthCurve::getLookupTableTolerance() const
+{
+    return getProperty_lookup_table_tolerance().empty() ?
+        0 : get_lookup_table_tolerance();
+}
+
+void FiberCompressiveForceLengthCurve::setLookupTableTolerance(double tolerance)
+{
+    set_lookup_table_tolerance(tolerance);
+    ensureCurveUpToDate();
+}
+
 //=============================================================================
 // SERVICES
 //=============================================================================
@@ -260,6 +276,29 @@ double FiberCompressiveForceLengthCurve::
     return m_curve.calcDerivative(derivComponents, x);
 }
 
+void FiberCompressiveForceLengthCurve::
+    calcDerivatives(const SimTK::Vector& x, int order,
+        SimTK::Vector& result) const
+{
+    SimTK_ASSERT(isObjectUpToDateWithProperties(),
+        "FiberCompressiveForceLengthCurve: Curve is not up-to-date"
+        " with its properties");
+    SimTK_ERRCHK1_ALWAYS(order >= 0 && order <= 2,
+        "FiberCompressiveForceLengthCurve::calcDerivatives",
+        "order must be 0, 1, or 2, but %i was entered", order);
+
+    m_curve.calcDerivatives(x, order, result);
+}
+
+const SmoothSegmentedFunction& FiberCompressiveForceLengthCurve::
+    getSmoothSegmentedFunction() const
+{
+    SimTK_ASSERT(isObjectUpToDateWithProperties(),
+        "FiberCompressiveForceLengthCurve: Curve is not up-to-date"
+        " with its properties");
+    return m_curve;
+}
+
 SimTK::Vec2 FiberCompressiveForceLengthCurve::getCurveDomain() const
 {
     SimTK_ASSERT(isObjectUpToDateWithProperties()==true,
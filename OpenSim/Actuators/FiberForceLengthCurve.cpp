@@ -77,6 +77,7 @@ void FiberForceLengthCurve::constructProperties()
     constructProperty_stiffness_at_low_force();
     constructProperty_stiffness_at_one_norm_force();
     constructProperty_curviness();
+    constructProperty_lookup_table_tolerance();
 }
 
 void FiberForceLengthCurve::buildCurve(bool computeIntegral)
@@ -94,6 +95,9 @@ void FiberForceLengthCurve::buildCurve(bool computeIntegral)
     m_curve = *f;
     delete f;
 
+    if(!getProperty_lookup_table_tolerance().empty())
+        m_curve.setLookupTableTolerance(get_lookup_table_tolerance());
+
     setObjectIsUpToDateWithProperties();
 }
 
@@ -209,6 +213,18 @@ void FiberForceLengthCurve::setOptionalProperties(double aStiffnessAtLowForce,
     ensureCurveUpToDate();
 }
 
+double FiberForceLengthCurve::getLookupTableTolerance() const
+{
+    return getProperty_lookup_table_tolerance().empty() ?
+        0 : get_lookup_table_tolerance();
+}
+
+void FiberForceLengthCurve::setLookupTableTolerance(double tolerance)
+{
+    set_lookup_table_tolerance(tolerance);
+    ensureCurveUpToDate();
+}
+
 //==============================================================================
 // SERVICES
 //==============================================================================
@@ -238,6 +254,26 @@ double FiberForceLengthCurve::
     return m_curve.calcDerivative(derivComponents, x);
 }
 
+void FiberForceLengthCurve::calcDerivatives(const SimTK::Vector& x, int order,
+        SimTK::Vector& result) const
+{
+    SimTK_ASSERT(isObjectUpToDateWithProperties(),
+        "FiberForceLengthCurve: Curve is not up-to-date with its properties");
+    SimTK_ERRCHK1_ALWAYS(order >= 0 && order <= 2,
+        "FiberForceLengthCurve::calcDerivatives",
+        "order must be 0, 1, or 2, but %i was entered", order);
+
+    m_curve.calcDerivatives(x, order, result);
+}
+
+const SmoothSegmentedFunction& FiberForceLengthCurve::
+    getSmoothSegmentedFunction() const
+{
+    SimTK_ASSERT(isObjectUpToDateWithProperties(),
+        "FiberForceLengthCurve: Curve is not up-to-date with its properties");
+    return m_curve;
+}
+
 double FiberForceLengthCurve::calcIntegral(double normFiberLength) const
 {
     SimTK_ASSERT(isObjectUpToDateWithProperties(),
@@ -82,6 +82,7 @@ void ForceVelocityCurve::constructProperties()
     constructProperty_max_eccentric_velocity_force_multiplier(1.4);
     constructProperty_concentric_curviness(0.6);
     constructProperty_eccentric_curviness(0.9);
+    constructProperty_lookup_table_tolerance();
 }
 
 void ForceVelocityCurve::buildCurve()
@@ -89,6 +90,9 @@ void ForceVelocityCurve::buildCurve()
     SimTK::Function* f = createSimTKFunction();
     m_curve = *(static_cast<SmoothSegmentedFunction*>(f));
     delete f;
+    if(!getProperty_lookup_table_tolerance().empty())
+        m_curve.setLookupTableTolerance(get_lookup_table_tolerance());
+
     setObjectIsUpToDateWithProperties();
 }
 
@@ -166,6 +170,18 @@ void ForceVelocityCurve::setEccentricCurviness(double aEccentricCurviness)
     ensureCurveUpToDate();
 }
 
+double ForceVelocityCurve::getLookupTableTolerance() const
+{
+    return getProperty_lookup_table_tolerance().empty() ?
+        0 : get_lookup_table_tolerance();
+}
+
+void ForceVelocityCurve::setLookupTableTolerance(double tolerance)
+{
+    set_lookup_table_tolerance(tolerance);
+    ensureCurveUpToDate();
+}
+
 //==============================================================================
 // SERVICES
 //==============================================================================
@@ -195,6 +211,26 @@ double ForceVelocityCurve::
     return m_curve.calcDerivative(derivComponents, x);
 }
 
+void ForceVelocityCurve::calcDerivatives(const SimTK::Vector& x, int order,
+        SimTK::Vector& result) const
+{
+    SimTK_ASSERT(isObjectUpToDateWithProperties(),
+        "ForceVelocityCurve: Curve is not up-to-date with its properties");
+    SimTK_ERRCHK1_ALWAYS(order >= 0 && order <= 2,
+        "ForceVelocityCurve::calcDerivatives",
+        "order must be 0, 1, or 2, but %i was entered", order);
+
+    m_curve.calcDerivatives(x, order, result);
+}
+
+const SmoothSegmentedFunction& ForceVelocityCurve::
+    getSmoothSegmentedFunction() const
+{
+    SimTK_ASSERT(isObjectUpToDateWithProperties(),
+        "ForceVelocityCurve: Curve is not up-to-date with its properties");
+    return m_curve;
+}
+
 SimTK::Vec2 ForceVelocityCurve::getCurveDomain() const
 {
     SimTK_ASSERT(isObjectUpToDateWithProperties(),
@@ -158,6 +158,10 @@ public:
         "Concentric curve shape, from linear (0) to maximal curve (1)");
     OpenSim_DECLARE_PROPERTY(eccentric_curviness, double,
         "Eccentric curve shape, from linear (0) to maximal curve (1)");
+    OpenSim_DECLARE_OPTIONAL_PROPERTY(lookup_table_tolerance, double,
+        "If set, the curve and its first two derivatives are evaluated from "
+        "a precomputed table with at most this error (relative to their "
+        "largest magnitudes)");
 
 //==============================================================================
 // PUBLIC METHODS
@@ -322,6 +326,18 @@ public:
     double calcDerivative(const std::vector<int>& derivComponents,
                           const SimTK::Vector& x) const override;
 
+    /** Evaluates the derivative of the given order (0, 1 or 2; 0 gives the
+    value of the curve) at each element of `x`, writing the results to
+    `result`. This is faster than calling calcDerivative() for each element
+    when the curve has a lookup table (see setLookupTableTolerance()). */
+    void calcDerivatives(const SimTK::Vector& x, int order,
+                         SimTK::Vector& result) const;
+
+    /** The SmoothSegmentedFunction that implements this curve, e.g., to 
+    evaluate the curves of many muscles in one call with
+    SmoothSegmentedFunction::calcDerivatives(). */
+    const SmoothSegmentedFunction& getSmoothSegmentedFunction() const;
+
     /** Returns a SimTK::Vec2 containing the lower (0th element) and upper (1st
     element) bounds on the domain of the curve. Outside this domain, the curve
     is approximated using linear extrapolation.
@@ -362,6 +378,13 @@ public:
     */
     void printMuscleCurveToCSVFile(const std::string& path);
 
+    /** @returns The error bound of the lookup table used to evaluate the curve,
+    or 0 if the curve is evaluated without a table. */
+    double getLookupTableTolerance() const;
+
+    /** See SmoothSegmentedFunction::setLookupTableTolerance(). */
+    void setLookupTableTolerance(double tolerance);
+
     void ensureCurveUpToDate();
 //==============================================================================
 // PRIVATE
@@ -83,6 +83,7 @@ void ForceVelocityInverseCurve::constructProperties()
     constructProperty_max_eccentric_velocity_force_multiplier(1.4);
     constructProperty_concentric_curviness(0.6);
     constructProperty_eccentric_curviness(0.9);
+    constructProperty_lookup_table_tolerance();
 }
 
 void ForceVelocityInverseCurve::buildCurve()
@@ -90,6 +91,9 @@ void ForceVelocityInverseCurve::buildCurve()
     SimTK::Function* f = createSimTKFunction();
     m_curve = *(static_cast<SmoothSegmentedFunction*>(f));
     delete f;
+    if(!getProperty_lookup_table_tolerance().empty())
+        m_curve.setLookupTableTolerance(get_lookup_table_tolerance());
+
     setObjectIsUpToDateWithProperties();
 }
 
@@ -168,6 +172,18 @@ setEccentricCurviness(double aEccentricCurviness)
     ensureCurveUpToDate();
 }
 
+double ForceVelocityInverseCurve::getLookupTableTolerance() const
+{
+    return getProperty_lookup_table_tolerance().empty() ?
+        0 : get_lookup_table_tolerance();
+}
+
+void ForceVelocityInverseCurve::setLookupTableTolerance(double tolerance)
+{
+    set_lookup_table_tolerance(tolerance);
+    ensureCurveUpToDate();
+}
+
 //==============================================================================
 // SERVICES
 //==============================================================================
@@ -200,6 +216,29 @@ double ForceVelocityInverseCurve::
     return m_curve.calcDerivative(derivComponents, x);
 }
 
+void ForceVelocityInverseCurve::
+    calcDerivatives(const SimTK::Vector& x, int order,
+        SimTK::Vector& result) const
+{
+    SimTK_ASSERT(isObjectUpToDateWithProperties(),
+        "ForceVelocityInverseCurve: Curve is not up-to-date"
+        " with its properties");
+    SimTK_ERRCHK1_ALWAYS(order >= 0 && order <= 2,
+        "ForceVelocityInverseCurve::calcDerivatives",
+        "order must be 0, 1, or 2, but %i was entered", order);
+
+    m_curve.calcDerivatives(x, order, result);
+}
+
+const SmoothSegmentedFunction& ForceVelocityInverseCurve::
+    getSmoothSegmentedFunction() const
+{
+    SimTK_ASSERT(isObjectUpToDateWithProperties(),
+        "ForceVelocityInverseCurve: Curve is not up-to-date"
+        " with its properties");
+    return m_curve;
+}
+
 SimTK::Vec2 ForceVelocityInverseCurve::getCurveDomain() const
 {
     SimTK_ASSERT(isObjectUpToDateWithProperties(),
@@ -260,6 +260,16 @@ Millard2012AccelerationMuscle(const std::string &aName,  double aMaxIsometricFor
     addStateVariable(STATE_FIBER_VELOCITY_NAME);
  }
 
+void Millard2012AccelerationMuscle::
+    extendRealizeTopology(SimTK::State& s) const
+{
+    Super::extendRealizeTopology(s);
+
+    _activationSV = getStateVariableHandle(STATE_ACTIVATION_NAME);
+    _fiberLengthSV = getStateVariableHandle(STATE_FIBER_LENGTH_NAME);
+    _fiberVelocitySV = getStateVariableHandle(STATE_FIBER_VELOCITY_NAME);
+}
+
 void Millard2012AccelerationMuscle::extendInitStateFromProperties(SimTK::State& s) const
 {
     Super::extendInitStateFromProperties(s);
@@ -363,7 +373,7 @@ void Millard2012AccelerationMuscle::
 void Millard2012AccelerationMuscle::
     setActivation(SimTK::State& s, double activation) const
 {
-    setStateVariableValue(s, STATE_ACTIVATION_NAME, activation);    
+    _activationSV.setValue(s, activation);
     markCacheVariableInvalid(s,"dynamicsInfo");
     
 }
@@ -371,7 +381,7 @@ void Millard2012AccelerationMuscle::
 void Millard2012AccelerationMuscle::
     setFiberLength(SimTK::State& s, double fiberLength) const
 {
-    setStateVariableValue(s, STATE_FIBER_LENGTH_NAME, fiberLength);
+    _fiberLengthSV.setValue(s, fiberLength);
     markCacheVariableInvalid(s,"lengthInfo");
     markCacheVariableInvalid(s,"velInfo");
     markCacheVariableInvalid(s,"dynamicsInfo");
@@ -381,7 +391,7 @@ void Millard2012AccelerationMuscle::
 void Millard2012AccelerationMuscle::
     setFiberVelocity(SimTK::State& s, double fiberVelocity) const
 {
-    setStateVariableValue(s, STATE_FIBER_VELOCITY_NAME, fiberVelocity);
+    _fiberVelocitySV.setValue(s, fiberVelocity);
     markCacheVariableInvalid(s,"velInfo");
     markCacheVariableInvalid(s,"dynamicsInfo");
     
@@ -778,7 +788,7 @@ void Millard2012AccelerationMuscle::
             = get_FiberCompressiveForceCosPennationCurve(); 
 
         //Populate the output struct
-        mli.fiberLength       = getStateVariableValue(s, STATE_FIBER_LENGTH_NAME); 
+        mli.fiberLength       = _fiberLengthSV.getValue(s); 
 
         mli.normFiberLength   = mli.fiberLength/optFiberLength;
         mli.pennationAngle    = m_penMdl.calcPennationAngle(mli.fiberLength);
@@ -904,7 +914,7 @@ void Millard2012AccelerationMuscle::
         //=========================================================================
 
         //1. Get MuscleLengthInfo & available State information
-        double dlce   = getStateVariableValue(s, STATE_FIBER_VELOCITY_NAME);
+        double dlce   = _fiberVelocitySV.getValue(s);
         double dlceN1  = dlce/(getMaxContractionVelocity()*optFiberLen);
         double lce    = mli.fiberLength;
         double phi    = mli.pennationAngle;
@@ -976,7 +986,7 @@ void Millard2012AccelerationMuscle::
         const FiberVelocityInfo &mvi = getFiberVelocityInfo(s);        
         
     //Get the state of this muscle
-        double a   = getStateVariableValue(s, STATE_ACTIVATION_NAME); 
+        double a   = _activationSV.getValue(s); 
 
     //Get the properties of this muscle
         // double mcl            = getLength(s);
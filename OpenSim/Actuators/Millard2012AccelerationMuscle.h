@@ -717,6 +717,11 @@ protected:
     */
     void extendAddToSystem(SimTK::MultibodySystem& system) const override final;
 
+    /**Resolves the handles to the state variables of this muscle
+    @param s the state of the model
+    */
+    void extendRealizeTopology(SimTK::State& s) const override final;
+
     /**Initializes the state of the ModelComponent
     @param s the state of the model
     */
@@ -765,6 +770,13 @@ private:
     //The name used to access the fiber velocity state
     static const std::string STATE_FIBER_VELOCITY_NAME;
 
+#ifndef SWIG
+    //Handles to the activation, fiber length and fiber velocity states
+    mutable SimTK::ResetOnCopy<StateVariableHandle> _activationSV;
+    mutable SimTK::ResetOnCopy<StateVariableHandle> _fiberLengthSV;
+    mutable SimTK::ResetOnCopy<StateVariableHandle> _fiberVelocitySV;
+#endif
+
     //A struct that holds all of the necessary quantities to compute
     //the fiber and tendon force, acceleration, and stiffness
     struct AccelerationMuscleInfo;
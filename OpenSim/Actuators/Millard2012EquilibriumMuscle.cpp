@@ -31,6 +31,8 @@ const string Millard2012EquilibriumMuscle::
     STATE_ACTIVATION_NAME = "activation";
 const string Millard2012EquilibriumMuscle::
     STATE_FIBER_LENGTH_NAME = "fiber_length";
+const string Millard2012EquilibriumMuscle::
+    EQUILIBRIUM_TENDON_LENGTH_NAME = "equilibrium_tendon_length";
 const double MIN_NONZERO_DAMPING_COEFFICIENT = 0.001;
 
 //==============================================================================
@@ -50,6 +52,7 @@ void Millard2012EquilibriumMuscle::constructProperties()
     constructProperty_minimum_activation(0.01);
 
     constructProperty_maximum_pennation_angle(acos(0.1));
+    constructProperty_use_bracketed_equilibrium_solver(false);
 
     constructProperty_ActiveForceLengthCurve(ActiveForceLengthCurve());
     constructProperty_ForceVelocityCurve(ForceVelocityCurve());
@@ -345,11 +348,11 @@ setActivation(SimTK::State& s, double activation) const
         setControls(SimTK::Vector(1, activation), controls);
         _model->setControls(s, controls);
     } else {
-        setStateVariableValue(s, STATE_ACTIVATION_NAME,
-                              getActivationModel().clampActivation(activation));
+        _activationSV.setValue(s,
+                               getActivationModel().clampActivation(activation));
     }
-    markCacheVariableInvalid(s,"velInfo");
-    markCacheVariableInvalid(s,"dynamicsInfo");
+    _velInfoCV.markValueInvalid(s);
+    _dynamicsInfoCV.markValueInvalid(s);
 }
 
 void Millard2012EquilibriumMuscle::setDefaultFiberLength(double fiberLength)
@@ -387,11 +390,10 @@ void Millard2012EquilibriumMuscle::
 setFiberLength(SimTK::State& s, double fiberLength) const
 {
     if (!get_ignore_tendon_compliance()) {
-        setStateVariableValue(s, STATE_FIBER_LENGTH_NAME,
-                              clampFiberLength(fiberLength));
-        markCacheVariableInvalid(s,"lengthInfo");
-        markCacheVariableInvalid(s,"velInfo");
-        markCacheVariableInvalid(s,"dynamicsInfo");
+        _fiberLengthSV.setValue(s, clampFiberLength(fiberLength));
+        _lengthInfoCV.markValueInvalid(s);
+        _velInfoCV.markValueInvalid(s);
+        _dynamicsInfoCV.markValueInvalid(s);
     }
 }
 
@@ -409,6 +411,14 @@ computeActuation(const SimTK::State& s) const
 
 void Millard2012EquilibriumMuscle::
 computeFiberEquilibrium(SimTK::State& s, bool solveForVelocity) const
+{
+    FiberEquilibriumStatistics stats;
+    computeFiberEquilibrium(s, solveForVelocity, stats);
+}
+
+void Millard2012EquilibriumMuscle::
+computeFiberEquilibrium(SimTK::State& s, bool solveForVelocity,
+                        FiberEquilibriumStatistics& stats) const
 {
     if(get_ignore_tendon_compliance()) {                    // rigid tendon
         return;
@@ -430,11 +440,38 @@ computeFiberEquilibrium(SimTK::State& s, bool solveForVelocity) const
     double pathSpeed = solveForVelocity ? getLengtheningSpeed(s) : 0;
     double activation = getActivation(s);
 
+    // Start from the tendon length of the previous solution, if any.
+    const double lastTendonLength =
+        getDiscreteVariableValue(s, EQUILIBRIUM_TENDON_LENGTH_NAME);
+    const bool warmStart = !SimTK::isNaN(lastTendonLength);
+    double initialFiberLength = SimTK::NaN;
+    if(warmStart) {
+        initialFiberLength = clampFiberLength(getPennationModel().
+                calcFiberLength(pathLength, lastTendonLength));
+    }
+    resetFiberEquilibriumWarmStart(s);
+
     try {
         std::pair<StatusFromEstimateMuscleFiberState,
                   ValuesFromEstimateMuscleFiberState> result =
             estimateMuscleFiberState(activation, pathLength, pathSpeed,
-                tol, maxIter, solveForVelocity);
+                tol, maxIter, solveForVelocity, initialFiberLength);
+        int iterations = (int)result.second["iterations"];
+
+        ++stats.numSolves;
+        if(warmStart) {
+            ++stats.numWarmStarts;
+            if(result.first ==
+                    StatusFromEstimateMuscleFiberState::
+                    Failure_MaxIterationsReached) {
+                ++stats.numColdRestarts;
+                result = estimateMuscleFiberState(activation, pathLength,
+                    pathSpeed, tol, maxIter, solveForVelocity);
+                iterations += (int)result.second["iterations"];
+            }
+        }
+        stats.numIterations += iterations;
+        stats.maxIterations = max(stats.maxIterations, iterations);
 
         switch(result.first) {
 
@@ -452,6 +489,7 @@ computeFiberEquilibrium(SimTK::State& s, bool solveForVelocity) const
             break;
 
         case StatusFromEstimateMuscleFiberState::Failure_MaxIterationsReached:
+            ++stats.numFailures;
             // Report internal variables and throw exception.
             std::ostringstream ss;
             ss << "\n  Solution error " << abs(result.second["solution_error"])
@@ -463,12 +501,27 @@ computeFiberEquilibrium(SimTK::State& s, bool solveForVelocity) const
             break;
         }
 
+        const double lce = result.second["fiber_length"];
+        setDiscreteVariableValue(s, EQUILIBRIUM_TENDON_LENGTH_NAME,
+            getPennationModel().calcTendonLength(
+                cos(getPennationModel().calcPennationAngle(lce)), lce,
+                pathLength));
+
     } catch (const std::exception& x) {
         OPENSIM_THROW_FRMOBJ(MuscleCannotEquilibrate,
             "Internal exception encountered.\n" + std::string{x.what()});
     }
 }
 
+void Millard2012EquilibriumMuscle::
+resetFiberEquilibriumWarmStart(SimTK::State& s) const
+{
+    if(!get_ignore_tendon_compliance()) {
+        setDiscreteVariableValue(s, EQUILIBRIUM_TENDON_LENGTH_NAME,
+                                 SimTK::NaN);
+    }
+}
+
 //==============================================================================
 // SCALING
 //==============================================================================
@@ -495,40 +548,13 @@ extendPostScale(const SimTK::State& s, const ScaleSet& scaleSet)
 void Millard2012EquilibriumMuscle::calcMuscleLengthInfo(const SimTK::State& s,
     MuscleLengthInfo& mli) const
 {
-    // Get musculotendon actuator properties.
-    //double maxIsoForce    = getMaxIsometricForce();
-    double optFiberLength = getOptimalFiberLength();
-    double tendonSlackLen = getTendonSlackLength();
-
     try {
         // Get muscle-specific properties.
         const ActiveForceLengthCurve& falCurve = get_ActiveForceLengthCurve();
         const FiberForceLengthCurve&  fpeCurve = get_FiberForceLengthCurve();
         //const TendonForceLengthCurve& fseCurve = get_TendonForceLengthCurve();
 
-        if(get_ignore_tendon_compliance()) {                //rigid tendon
-            mli.fiberLength = clampFiberLength(
-                               getPennationModel().calcFiberLength(getLength(s),
-                               tendonSlackLen));
-        } else {                                            // elastic tendon
-            mli.fiberLength = clampFiberLength(
-                                getStateVariableValue(s, STATE_FIBER_LENGTH_NAME));
-        }
-
-        mli.normFiberLength   = mli.fiberLength / optFiberLength;
-        mli.pennationAngle    = getPennationModel().
-                                    calcPennationAngle(mli.fiberLength);
-        mli.cosPennationAngle = cos(mli.pennationAngle);
-        mli.sinPennationAngle = sin(mli.pennationAngle);
-        mli.fiberLengthAlongTendon = mli.fiberLength * mli.cosPennationAngle;
-
-        // Necessary even for the rigid tendon, as it might have gone slack.
-        mli.tendonLength      = getPennationModel().
-                                    calcTendonLength(mli.cosPennationAngle,
-                                                     mli.fiberLength,
-                                                     getLength(s));
-        mli.normTendonLength  = mli.tendonLength / tendonSlackLen;
-        mli.tendonStrain      = mli.normTendonLength - 1.0;
+        calcMuscleLengthGeometry(s, mli);
 
         mli.fiberPassiveForceLengthMultiplier =
             fpeCurve.calcValue(mli.normFiberLength);
@@ -544,6 +570,39 @@ void Millard2012EquilibriumMuscle::calcMuscleLengthInfo(const SimTK::State& s,
 }
 
 
+void Millard2012EquilibriumMuscle::calcMuscleLengthGeometry(
+    const SimTK::State& s, MuscleLengthInfo& mli) const
+{
+    // Get musculotendon actuator properties.
+    //double maxIsoForce    = getMaxIsometricForce();
+    double optFiberLength = getOptimalFiberLength();
+    double tendonSlackLen = getTendonSlackLength();
+
+    if(get_ignore_tendon_compliance()) {                //rigid tendon
+        mli.fiberLength = clampFiberLength(
+                           getPennationModel().calcFiberLength(getLength(s),
+                           tendonSlackLen));
+    } else {                                            // elastic tendon
+        mli.fiberLength = clampFiberLength(_fiberLengthSV.getValue(s));
+    }
+
+    mli.normFiberLength   = mli.fiberLength / optFiberLength;
+    mli.pennationAngle    = getPennationModel().
+                                calcPennationAngle(mli.fiberLength);
+    mli.cosPennationAngle = cos(mli.pennationAngle);
+    mli.sinPennationAngle = sin(mli.pennationAngle);
+    mli.fiberLengthAlongTendon = mli.fiberLength * mli.cosPennationAngle;
+
+    // Necessary even for the rigid tendon, as it might have gone slack.
+    mli.tendonLength      = getPennationModel().
+                                calcTendonLength(mli.cosPennationAngle,
+                                                 mli.fiberLength,
+                                                 getLength(s));
+    mli.normTendonLength  = mli.tendonLength / tendonSlackLen;
+    mli.tendonStrain      = mli.normTendonLength - 1.0;
+}
+
+
 //==============================================================================
 // MUSCLE INTERFACE REQUIREMENTS -- MUSCLE POTENTIAL ENERGY INFO
 //==============================================================================
@@ -646,7 +705,7 @@ calcFiberVelocityInfo(const SimTK::State& s, FiberVelocityInfo& fvi) const
             double a = SimTK::NaN;
             if(!get_ignore_activation_dynamics()) {
                 a = getActivationModel().clampActivation(
-                        getStateVariableValue(s, STATE_ACTIVATION_NAME));
+                        _activationSV.getValue(s));
             } else {
                 a = getActivationModel().clampActivation(getControl(s));
             }
@@ -681,7 +740,7 @@ calcFiberVelocityInfo(const SimTK::State& s, FiberVelocityInfo& fvi) const
             double a = SimTK::NaN;
             if(!get_ignore_activation_dynamics()) {
                 a = getActivationModel().clampActivation(
-                        getStateVariableValue(s, STATE_ACTIVATION_NAME));
+                        _activationSV.getValue(s));
             } else {
                 a = getActivationModel().clampActivation(getControl(s));
             }
@@ -791,7 +850,7 @@ calcMuscleDynamicsInfo(const SimTK::State& s, MuscleDynamicsInfo& mdi) const
         double a = SimTK::NaN;
         if(!get_ignore_activation_dynamics()) {
             a = getActivationModel().clampActivation(
-                    getStateVariableValue(s, STATE_ACTIVATION_NAME));
+                    _activationSV.getValue(s));
         } else {
             a = getActivationModel().clampActivation(getControl(s));
         }
@@ -943,6 +1002,22 @@ extendAddToSystem(SimTK::MultibodySystem& system) const
     }
     if(!get_ignore_tendon_compliance()) {
         addStateVariable(STATE_FIBER_LENGTH_NAME);
+        // Changing the warm start does not change the dynamics.
+        addDiscreteVariable(EQUILIBRIUM_TENDON_LENGTH_NAME,
+                            SimTK::Stage::Report);
+    }
+}
+
+void Millard2012EquilibriumMuscle::
+extendRealizeTopology(SimTK::State& s) const
+{
+    Super::extendRealizeTopology(s);
+
+    if(!get_ignore_activation_dynamics()) {
+        _activationSV = getStateVariableHandle(STATE_ACTIVATION_NAME);
+    }
+    if(!get_ignore_tendon_compliance()) {
+        _fiberLengthSV = getStateVariableHandle(STATE_FIBER_LENGTH_NAME);
     }
 }
 
@@ -956,6 +1031,7 @@ extendInitStateFromProperties(SimTK::State& s) const
     }
     if(!get_ignore_tendon_compliance()) {
         setFiberLength(s, getDefaultFiberLength());
+        resetFiberEquilibriumWarmStart(s);
     }
 }
 
@@ -1238,7 +1314,8 @@ Millard2012EquilibriumMuscle::estimateMuscleFiberState(
                                     const double pathLengtheningSpeed,
                                     const double aSolTolerance,
                                     const int aMaxIterations,
-                                    bool staticSolution) const
+                                    bool staticSolution,
+                                    double initialFiberLength) const
 {
     // If seeking a static solution, set velocities to zero and avoid the
     // velocity-sharing algorithm below, as it can produce nonzero fiber and
@@ -1267,7 +1344,9 @@ Millard2012EquilibriumMuscle::estimateMuscleFiberState(
 
     // Position level
     double tl  = getTendonSlackLength()*1.01;  // begin with small tendon force
-    double lce = clampFiberLength(getPennationModel().calcFiberLength(ml,tl));
+    double lce = SimTK::isNaN(initialFiberLength) ?
+        clampFiberLength(getPennationModel().calcFiberLength(ml,tl)) :
+        clampFiberLength(initialFiberLength);
 
     double phi = 0.0;
     double cosphi = 1.0;
@@ -1423,8 +1502,75 @@ Millard2012EquilibriumMuscle::estimateMuscleFiberState(
     double ferrPrev = ferr;
     double lcePrev = lce;
 
+    // Evaluates the force error at fiber length x, estimating the fiber
+    // velocity at x, so that the error depends on x alone.
+    auto evaluateFunc = [&](double x) {
+        lce = x;
+        positionFunc();
+        multipliersFunc();
+        if (!staticSolution) {
+            fv = 1.0;
+            dlceN = 0.0;
+            ferrFunc();
+            partialsFunc();
+            velocityFunc();
+        }
+        ferrFunc();
+        partialsFunc();
+    };
+
+    bool useNewton = true;
+    if (get_use_bracketed_equilibrium_solver() &&
+            abs(ferr) > aSolTolerance) {
+        // The force error is negative at the shortest fiber, where the tendon
+        // is longest, and positive once the tendon is slack.
+        double lceLower = getMinimumFiberLength();
+        double lceUpper = clampFiberLength(
+                getPennationModel().calcFiberLength(ml, tsl));
+        double x = lce;
+        evaluateFunc(lceUpper);
+        const double ferrUpper = ferr;
+        evaluateFunc(lceLower);
+        iter += 2;
+        if (ferr < 0 && ferrUpper > 0) {
+            useNewton = false;
+            x = min(max(x, lceLower), lceUpper);
+            evaluateFunc(x);
+            double ferrLast = SimTK::MostPositiveReal;
+            while (abs(ferr) > aSolTolerance && iter < aMaxIterations
+                   && lceUpper - lceLower > SimTK::Eps*lceUpper) {
+                if (ferr < 0) lceLower = x;
+                else          lceUpper = x;
+
+                // Take the Newton step unless it leaves the bracket or the
+                // error is not decreasing quickly enough; bisect otherwise.
+                dferr_d_lce = dFmAT_dlce - dFt_d_lce;
+                double xNewton = x - ferr/dferr_d_lce;
+                if (xNewton > lceLower && xNewton < lceUpper
+                        && abs(ferr) < 0.5*abs(ferrLast)) {
+                    x = xNewton;
+                } else {
+                    x = 0.5*(lceLower + lceUpper);
+                }
+                ferrLast = ferr;
+                evaluateFunc(x);
+                iter++;
+            }
+        } else if (ferr >= 0) {
+            // Even the shortest fiber overcomes the tendon; the fiber is at
+            // its lower bound, which is handled below.
+            useNewton = false;
+        } else {
+            // No bracket; fall back to the damped Newton method.
+            evaluateFunc(x);
+        }
+        ferrPrev = ferr;
+        lcePrev = lce;
+    }
+
     double h =1.0;
-    while( (abs(ferr) > aSolTolerance) && (iter < aMaxIterations)) {
+    while( useNewton && (abs(ferr) > aSolTolerance)
+           && (iter < aMaxIterations)) {
         // Compute the search direction
         dferr_d_lce = dFmAT_dlce - dFt_d_lce;
         h = 1.0;
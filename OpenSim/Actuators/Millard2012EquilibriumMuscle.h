@@ -218,6 +218,9 @@ public:
         "Activation lower bound.");
     OpenSim_DECLARE_PROPERTY(maximum_pennation_angle, double,
         "Maximum pennation angle (in radians).");
+    OpenSim_DECLARE_PROPERTY(use_bracketed_equilibrium_solver, bool,
+        "Solve for the equilibrium fiber length with Newton steps safeguarded "
+        "by bisection, rather than with damped Newton steps.");
     OpenSim_DECLARE_UNNAMED_PROPERTY(ActiveForceLengthCurve,
         "Active-force-length curve.");
     OpenSim_DECLARE_UNNAMED_PROPERTY(ForceVelocityCurve,
@@ -434,6 +437,11 @@ public:
     /** Computes the fiber length such that the fiber and tendon are developing
         the same force, either assuming muscle-tendon velocity as provided
         by the state or zero as designated by the useZeroVelocity flag.
+
+        The solve starts from the tendon length of the previous solution
+        stored in the state, which is usually close when the same state is
+        equilibrated at each frame of a motion. If that fails, or if the state
+        holds no solution yet, the solve starts from the default initial guess.
         @param[in,out] s         The state of the system.
         @param solveForVelocity  Flag indicating to solve for fiber velocity,
                                  which by default is false (zero fiber-velocity)
@@ -442,6 +450,34 @@ public:
     void computeFiberEquilibrium(SimTK::State& s, 
                                  bool solveForVelocity = false) const;
 
+#ifndef SWIG
+    /** Counts of the work done by computeFiberEquilibrium(). */
+    struct FiberEquilibriumStatistics {
+        /** Number of equilibrium solves. */
+        int numSolves = 0;
+        /** Number of solves started from the previous solution. */
+        int numWarmStarts = 0;
+        /** Number of warm-started solves that failed and were repeated from
+        the default initial guess. */
+        int numColdRestarts = 0;
+        /** Number of solves that did not converge. */
+        int numFailures = 0;
+        /** Total number of iterations of all the solves. */
+        int numIterations = 0;
+        /** Largest number of iterations of one solve. */
+        int maxIterations = 0;
+    };
+
+    /** Same as computeFiberEquilibrium(SimTK::State&, bool), but also adds
+    the work done by the solve to the counts in `stats`. */
+    void computeFiberEquilibrium(SimTK::State& s, bool solveForVelocity,
+                                 FiberEquilibriumStatistics& stats) const;
+
+    /** Forget the equilibrium solution stored in the state, so that the next
+    solve starts from the default initial guess. */
+    void resetFiberEquilibriumWarmStart(SimTK::State& s) const;
+#endif
+
 //==============================================================================
 // DEPRECATED
 //==============================================================================
@@ -544,6 +580,9 @@ protected:
     /** Creates the ModelComponent so that it can be used in simulation */
     void extendAddToSystem(SimTK::MultibodySystem& system) const override;
 
+    /** Resolves the handles to the state variables */
+    void extendRealizeTopology(SimTK::State& s) const override;
+
     /** Initializes the state of the ModelComponent */
     void extendInitStateFromProperties(SimTK::State& s) const override;
 
@@ -558,17 +597,34 @@ private:
     static const std::string STATE_ACTIVATION_NAME;
     // The name used to access the fiber length state.
     static const std::string STATE_FIBER_LENGTH_NAME;
+    // The name of the discrete variable that holds the tendon length of the
+    // last solution of computeFiberEquilibrium() (NaN if there is none).
+    static const std::string EQUILIBRIUM_TENDON_LENGTH_NAME;
 
     // Indicates whether fiber damping is included in the model (false if
     // dampingCoefficient < 0.001).
     bool use_fiber_damping;
 
+#ifndef SWIG
+    // Handles to the activation and fiber length states, if allocated.
+    mutable SimTK::ResetOnCopy<StateVariableHandle> _activationSV;
+    mutable SimTK::ResetOnCopy<StateVariableHandle> _fiberLengthSV;
+#endif
+
     void setNull();
     void constructProperties();
 
     // Rebuilds muscle model if any of its properties have changed.
     void extendFinalizeFromProperties() override;
 
+    // Calculates the lengths and pennation angle in the MuscleLengthInfo,
+    // that is, everything but the force-length multipliers.
+    void calcMuscleLengthGeometry(const SimTK::State& s,
+                                  MuscleLengthInfo& mli) const;
+
+    // Evaluates the length info of many muscles in bulk.
+    friend class Millard2012EquilibriumMuscleBatch;
+
     /* Calculates the fiber velocity that satisfies the equilibrium equation
     given a fixed fiber length.
         @param fiso maximum isometric force
@@ -759,6 +815,8 @@ private:
            give up attempting to initialize the model
     @param staticSolution set to true to calculate the static equilibrium
            solution, setting fiber and tendon velocities to zero
+    @param initialFiberLength the fiber length from which to start the solve;
+           if NaN, the solve starts with the tendon slightly stretched
     */
     std::pair<StatusFromEstimateMuscleFiberState,
               ValuesFromEstimateMuscleFiberState>
@@ -767,7 +825,8 @@ private:
                                  const double pathLengtheningSpeed,
                                  const double aSolTolerance,
                                  const int aMaxIterations,
-                                 bool staticSolution=false) const;
+                                 bool staticSolution=false,
+                                 double initialFiberLength=SimTK::NaN) const;
 
 };
 } //end of namespace OpenSim
@@ -0,0 +1,90 @@
+/* -------------------------------------------------------------------------- *
+ *              OpenSim:  Millard2012EquilibriumMuscleBatch.cpp               *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2019 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "Millard2012EquilibriumMuscleBatch.h"
+#include "Millard2012EquilibriumMuscle.h"
+#include <OpenSim/Simulation/Model/Model.h>
+
+using namespace OpenSim;
+
+Millard2012EquilibriumMuscleBatch::Millard2012EquilibriumMuscleBatch(
+        const Model& model)
+{
+    for (const auto& muscle :
+            model.getComponentList<Millard2012EquilibriumMuscle>()) {
+        _muscles.emplace_back(&muscle);
+    }
+}
+
+void Millard2012EquilibriumMuscleBatch::realizeMuscleLengthInfo(
+        const SimTK::State& s) const
+{
+    // The arrays keep their capacity, so no memory is allocated once the
+    // batch has been used.
+    _pending.clear();
+    _activeCurves.clear();
+    _passiveCurves.clear();
+    _pendingNormFiberLength.clear();
+
+    for (int i = 0; i < getNumMuscles(); ++i) {
+        const Millard2012EquilibriumMuscle& muscle = *_muscles[i];
+        if (muscle._lengthInfoCV.isValueValid(s)) continue;
+
+        Muscle::MuscleLengthInfo& mli = muscle.updMuscleLengthInfo(s);
+        try {
+            muscle.calcMuscleLengthGeometry(s, mli);
+        } catch(const std::exception& x) {
+            std::string msg = "Exception caught in "
+                    "Millard2012EquilibriumMuscleBatch::realizeMuscleLengthInfo"
+                    " from " + muscle.getName() + "\n" + x.what();
+            throw OpenSim::Exception(msg);
+        }
+
+        _pendingNormFiberLength.push_back(mli.normFiberLength);
+        _activeCurves.push_back(
+                &muscle.get_ActiveForceLengthCurve().
+                        getSmoothSegmentedFunction());
+        _passiveCurves.push_back(
+                &muscle.get_FiberForceLengthCurve().
+                        getSmoothSegmentedFunction());
+        _pending.push_back(i);
+    }
+    if (_pending.empty()) return;
+
+    const int numPending = (int)_pending.size();
+    // Resizing a Vector to its current size does not allocate.
+    _normFiberLength.resize(numPending);
+    for (int k = 0; k < numPending; ++k)
+        _normFiberLength[k] = _pendingNormFiberLength[k];
+    SmoothSegmentedFunction::calcDerivatives(_activeCurves, _normFiberLength,
+                                             0, _active);
+    SmoothSegmentedFunction::calcDerivatives(_passiveCurves, _normFiberLength,
+                                             0, _passive);
+
+    for (int k = 0; k < numPending; ++k) {
+        const Millard2012EquilibriumMuscle& muscle = *_muscles[_pending[k]];
+        Muscle::MuscleLengthInfo& mli = muscle.updMuscleLengthInfo(s);
+        mli.fiberActiveForceLengthMultiplier = _active[k];
+        mli.fiberPassiveForceLengthMultiplier = _passive[k];
+        muscle._lengthInfoCV.markValueValid(s);
+    }
+}
@@ -0,0 +1,100 @@
+#ifndef OPENSIM_MILLARD2012_EQUILIBRIUM_MUSCLE_BATCH_H_
+#define OPENSIM_MILLARD2012_EQUILIBRIUM_MUSCLE_BATCH_H_
+/* -------------------------------------------------------------------------- *
+ *               OpenSim:  Millard2012EquilibriumMuscleBatch.h                *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2019 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Actuators/osimActuatorsDLL.h>
+#include <simbody/internal/common.h>
+
+namespace OpenSim {
+
+class Model;
+class Millard2012EquilibriumMuscle;
+class SmoothSegmentedFunction;
+
+/**
+ * Evaluates the MuscleLengthInfo of all the Millard2012EquilibriumMuscle%s in
+ * a Model together, rather than one muscle at a time. The geometry of each
+ * muscle is computed first, and then the active and passive force-length
+ * curves of all the muscles are each evaluated in a single call to
+ * SmoothSegmentedFunction::calcDerivatives(). This is most effective when the
+ * curves use lookup tables (see ActiveForceLengthCurve::
+ * setLookupTableTolerance()).
+ *
+ * The results are stored in the cache of each muscle, so the muscles use
+ * them afterwards as if they had computed them themselves, and the results
+ * are the same.
+ *
+ * @code
+ * Millard2012EquilibriumMuscleBatch batch(model);
+ * model.realizePosition(state);
+ * batch.realizeMuscleLengthInfo(state);
+ * model.realizeAcceleration(state);
+ * @endcode
+ *
+ * The muscles are collected when the batch is constructed, so the batch
+ * must be constructed again if muscles are added to or removed from the
+ * model, and the model must outlive the batch.
+ *
+ * This is an opt-in helper that batches only the MuscleLengthInfo. Nothing
+ * in OpenSim creates one, so the muscles compute their MuscleLengthInfo one
+ * at a time unless realizeMuscleLengthInfo() is called before they need it,
+ * as above. The fiber velocities, the force-velocity curves and the
+ * equilibrium solve are always computed one muscle at a time.
+ *
+ * This class is not thread safe: realizeMuscleLengthInfo() uses memory owned
+ * by the object.
+ */
+class OSIMACTUATORS_API Millard2012EquilibriumMuscleBatch {
+public:
+    /** Collect the Millard2012EquilibriumMuscle%s of `model`. */
+    explicit Millard2012EquilibriumMuscleBatch(const Model& model);
+
+    int getNumMuscles() const { return (int)_muscles.size(); }
+    const Millard2012EquilibriumMuscle& getMuscle(int i) const
+    {   return *_muscles[i]; }
+
+    /** Compute the MuscleLengthInfo of every muscle whose MuscleLengthInfo is
+    not yet valid in `s`, and store it in the cache of the muscle.
+    @pre `s` is realized to SimTK::Stage::Position.
+    @throws Exception If the MuscleLengthInfo of a muscle cannot be
+    computed. */
+    void realizeMuscleLengthInfo(const SimTK::State& s) const;
+
+private:
+    SimTK::Array_<SimTK::ReferencePtr<const Millard2012EquilibriumMuscle>>
+            _muscles;
+
+    // Work memory for realizeMuscleLengthInfo(), indexed by the muscles whose
+    // MuscleLengthInfo is computed.
+    mutable SimTK::Array_<int> _pending;
+    mutable SimTK::Array_<const SmoothSegmentedFunction*> _activeCurves;
+    mutable SimTK::Array_<const SmoothSegmentedFunction*> _passiveCurves;
+    mutable SimTK::Array_<double> _pendingNormFiberLength;
+    mutable SimTK::Vector _normFiberLength;
+    mutable SimTK::Vector _active;
+    mutable SimTK::Vector _passive;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_MILLARD2012_EQUILIBRIUM_MUSCLE_BATCH_H_
@@ -88,6 +88,7 @@ void TendonForceLengthCurve::constructProperties()
     constructProperty_stiffness_at_one_norm_force();
     constructProperty_norm_force_at_toe_end();
     constructProperty_curviness();
+    constructProperty_lookup_table_tolerance();
 }
 
 void TendonForceLengthCurve::buildCurve(bool computeIntegral)
@@ -101,6 +102,9 @@ void TendonForceLengthCurve::buildCurve(bool computeIntegral)
                                      getName());
     m_curve = *f;
     delete f;
+    if(!getProperty_lookup_table_tolerance().empty())
+        m_curve.setLookupTableTolerance(get_lookup_table_tolerance());
+
     setObjectIsUpToDateWithProperties();
 }
 
@@ -213,6 +217,18 @@ SimTK::Function* TendonForceLengthCurve::createSimTKFunction() const
                 getName());
 }
 
+double TendonForceLengthCurve::getLookupTableTolerance() const
+{
+    return getProperty_lookup_table_tolerance().empty() ?
+        0 : get_lookup_table_tolerance();
+}
+
+void TendonForceLengthCurve::setLookupTableTolerance(double tolerance)
+{
+    set_lookup_table_tolerance(tolerance);
+    ensureCurveUpToDate();
+}
+
 //==============================================================================
 // SERVICES
 //==============================================================================
@@ -242,6 +258,26 @@ double TendonForceLengthCurve::
     return m_curve.calcDerivative(derivComponents, x);
 }
 
+void TendonForceLengthCurve::calcDerivatives(const SimTK::Vector& x, int order,
+        SimTK::Vector& result) const
+{
+    SimTK_ASSERT(isObjectUpToDateWithProperties(),
+        "TendonForceLengthCurve: Curve is not up-to-date with its properties");
+    SimTK_ERRCHK1_ALWAYS(order >= 0 && order <= 2,
+        "TendonForceLengthCurve::calcDerivatives",
+        "order must be 0, 1, or 2, but %i was entered", order);
+
+    m_curve.calcDerivatives(x, order, result);
+}
+
+const SmoothSegmentedFunction& TendonForceLengthCurve::
+    getSmoothSegmentedFunction() const
+{
+    SimTK_ASSERT(isObjectUpToDateWithProperties(),
+        "TendonForceLengthCurve: Curve is not up-to-date with its properties");
+    return m_curve;
+}
+
 double TendonForceLengthCurve::calcIntegral(double aNormLength) const
 {
     SimTK_ASSERT(isObjectUpToDateWithProperties(),
@@ -937,6 +937,107 @@ void testMillard2012EquilibriumMuscle()
         muscle->setMinimumActivation(0.01);
         model.finalizeFromProperties();
     }
+
+    // Test that warm-started equilibrium solves, with either solver, find the
+    // same fiber lengths as solves from the default initial guess, and that
+    // they take fewer iterations.
+    for (bool bracketed : {false, true}) {
+        Model model;
+        auto body = new Body("body", 1., SimTK::Vec3(0), SimTK::Inertia(1.));
+        auto slider = new SliderJoint("slider", model.getGround(), *body);
+        model.addBody(body);
+        model.addJoint(slider);
+        auto muscle = new Millard2012EquilibriumMuscle("muscle", 100., 0.1,
+                                                       0.05, 0.1);
+        muscle->addNewPathPoint("p1", model.updGround(), SimTK::Vec3(0));
+        muscle->addNewPathPoint("p2", *body, SimTK::Vec3(0));
+        muscle->set_use_bracketed_equilibrium_solver(bracketed);
+        model.addForce(muscle);
+
+        SimTK::State& state = model.initSystem();
+        muscle->setActivation(state, 0.5);
+        const Coordinate& coord = slider->getCoordinate();
+        const int numFrames = 20;
+        Millard2012EquilibriumMuscle::FiberEquilibriumStatistics warmStats;
+        Millard2012EquilibriumMuscle::FiberEquilibriumStatistics coldStats;
+        for (int i = 0; i < numFrames; ++i) {
+            coord.setValue(state, 0.13 + 0.003*i);
+            SimTK::State coldState = state;
+            muscle->resetFiberEquilibriumWarmStart(coldState);
+
+            muscle->computeFiberEquilibrium(state, false, warmStats);
+            muscle->computeFiberEquilibrium(coldState, false, coldStats);
+            model.realizeVelocity(state);
+            model.realizeVelocity(coldState);
+            ASSERT_EQUAL(muscle->getFiberLength(coldState),
+                         muscle->getFiberLength(state), 1e-6);
+            ASSERT_EQUAL(0., muscle->getFiberVelocity(state), 1e-6);
+        }
+        // Only the first warm solve has no previous solution to start from.
+        ASSERT(warmStats.numSolves == numFrames);
+        ASSERT(warmStats.numWarmStarts == numFrames - 1);
+        ASSERT(warmStats.numFailures == 0);
+        ASSERT(coldStats.numSolves == numFrames);
+        ASSERT(coldStats.numWarmStarts == 0);
+        ASSERT(coldStats.numFailures == 0);
+        ASSERT(warmStats.numIterations < coldStats.numIterations);
+
+        // The result of a solve does not depend on the solves before it in
+        // other states.
+        SimTK::State otherState = state;
+        coord.setValue(otherState, 0.2);
+        muscle->computeFiberEquilibrium(otherState);
+        SimTK::State repeatState = state;
+        muscle->computeFiberEquilibrium(repeatState);
+        model.realizeVelocity(repeatState);
+        ASSERT_EQUAL(muscle->getFiberLength(state),
+                     muscle->getFiberLength(repeatState), 1e-6);
+    }
+
+    // Test that Millard2012EquilibriumMuscleBatch caches the same
+    // MuscleLengthInfo that each muscle computes on its own.
+    {
+        Model model;
+        for (int i = 0; i < 4; ++i) {
+            auto muscle = new Millard2012EquilibriumMuscle(
+                    "muscle" + std::to_string(i), 1., 0.1 + 0.02*i, 0.05, 0.1);
+            muscle->addNewPathPoint("p1", model.updGround(), SimTK::Vec3(0));
+            muscle->addNewPathPoint("p2", model.updGround(),
+                                    SimTK::Vec3(0, 0, 0.12 + 0.03*i));
+            muscle->set_ignore_tendon_compliance(i % 2 == 0);
+            if (i > 1) {
+                ActiveForceLengthCurve fal =
+                        muscle->getActiveForceLengthCurve();
+                fal.setLookupTableTolerance(1e-8);
+                muscle->setActiveForceLengthCurve(fal);
+                FiberForceLengthCurve fpe = muscle->getFiberForceLengthCurve();
+                fpe.setLookupTableTolerance(1e-8);
+                muscle->setFiberForceLengthCurve(fpe);
+            }
+            model.addForce(muscle);
+        }
+
+        SimTK::State& state = model.initSystem();
+        Millard2012EquilibriumMuscleBatch batch(model);
+        ASSERT(batch.getNumMuscles() == 4);
+
+        SimTK::State batchState = state;
+        model.realizePosition(batchState);
+        batch.realizeMuscleLengthInfo(batchState);
+        model.realizePosition(state);
+        for (int i = 0; i < batch.getNumMuscles(); ++i) {
+            const Millard2012EquilibriumMuscle& muscle = batch.getMuscle(i);
+            ASSERT_EQUAL(muscle.getFiberLength(state),
+                         muscle.getFiberLength(batchState), 1e-12);
+            ASSERT_EQUAL(muscle.getTendonLength(state),
+                         muscle.getTendonLength(batchState), 1e-12);
+            ASSERT_EQUAL(muscle.getActiveForceLengthMultiplier(state),
+                         muscle.getActiveForceLengthMultiplier(batchState),
+                         1e-12);
+            ASSERT_EQUAL(muscle.getPassiveForceMultiplier(state),
+                         muscle.getPassiveForceMultiplier(batchState), 1e-12);
+        }
+    }
 }
 
 void testMillard2012AccelerationMuscle()
@@ -31,6 +31,7 @@
 
 #include <SimTKsimbody.h>
 #include <ctime>
+#include <memory>
 #include <string>
 #include <stdio.h>
 
@@ -45,6 +46,7 @@ void testTendonForceLengthCurve();
 void testFiberForceLengthCurve();
 void testFiberCompressiveForceLengthCurve();
 void testFiberCompressiveForceCosPennationCurve();
+template <typename CurveType> void testLookupTable();
 
 int main(int argc, char* argv[])
 {
@@ -59,6 +61,13 @@ int main(int argc, char* argv[])
             testFiberForceLengthCurve();
             testFiberCompressiveForceLengthCurve();
             testFiberCompressiveForceCosPennationCurve();
+            testLookupTable<ActiveForceLengthCurve>();
+            testLookupTable<ForceVelocityCurve>();
+            testLookupTable<ForceVelocityInverseCurve>();
+            testLookupTable<TendonForceLengthCurve>();
+            testLookupTable<FiberForceLengthCurve>();
+            testLookupTable<FiberCompressiveForceLengthCurve>();
+            testLookupTable<FiberCompressiveForceCosPennationCurve>();
 
             cout << "================================================" << endl;
             cout << "                   Timing Tests                 " << endl;
@@ -1227,3 +1236,71 @@ void testFiberCompressiveForceCosPennationCurve()
         cout <<"________________________________________________________"<<endl;
 
 }
+
+template <typename CurveType>
+void testLookupTable()
+{
+    CurveType exact;
+    cout << "Testing lookup table: " << exact.getConcreteClassName() << endl;
+    SimTK_TEST(exact.getLookupTableTolerance() == 0);
+
+    const double tolerance = 1e-6;
+    CurveType table(exact);
+    table.setLookupTableTolerance(tolerance);
+    SimTK_TEST(table.getLookupTableTolerance() == tolerance);
+
+    // Sample the curve domain and the linear extrapolation regions.
+    SimTK::Vec2 domain = exact.getCurveDomain();
+    double width = domain(1) - domain(0);
+    const int numPoints = 997;
+    SimTK::Vec3 scale(1.0);
+    SimTK::Matrix values(numPoints, 3);
+    for(int i = 0; i < numPoints; ++i) {
+        double x = domain(0) - 0.1*width + 1.2*width*i/(numPoints-1);
+        for(int order = 0; order <= 2; ++order) {
+            values(i, order) = exact.calcDerivative(x, order);
+            scale(order) = max(scale(order), abs(values(i, order)));
+        }
+    }
+    for(int i = 0; i < numPoints; ++i) {
+        double x = domain(0) - 0.1*width + 1.2*width*i/(numPoints-1);
+        SimTK_TEST_EQ_TOL(table.calcValue(x), values(i, 0),
+                          10*tolerance*scale(0));
+        for(int order = 0; order <= 2; ++order) {
+            SimTK_TEST_EQ_TOL(table.calcDerivative(x, order),
+                              values(i, order), 10*tolerance*scale(order));
+        }
+    }
+
+    // Evaluating all the points in one call gives the same results, with or
+    // without the table.
+    SimTK::Vector x(numPoints), batch;
+    for(int i = 0; i < numPoints; ++i)
+        x[i] = domain(0) - 0.1*width + 1.2*width*i/(numPoints-1);
+    for(int order = 0; order <= 2; ++order) {
+        table.calcDerivatives(x, order, batch);
+        SimTK_TEST(batch.size() == numPoints);
+        for(int i = 0; i < numPoints; ++i)
+            SimTK_TEST_EQ(batch[i], table.calcDerivative(x[i], order));
+        exact.calcDerivatives(x, order, batch);
+        for(int i = 0; i < numPoints; ++i)
+            SimTK_TEST_EQ(batch[i], values(i, order));
+    }
+
+    // The tolerance is serialized.
+    const std::string fileName = "lookupTable_" +
+                                 exact.getConcreteClassName() + ".xml";
+    table.print(fileName);
+    std::unique_ptr<Object> object(Object::makeObjectFromFile(fileName));
+    CurveType& deserialized = dynamic_cast<CurveType&>(*object);
+    deserialized.ensureCurveUpToDate();
+    SimTK_TEST(deserialized.getLookupTableTolerance() == tolerance);
+    SimTK_TEST(deserialized.calcValue(domain(0) + 0.3*width) ==
+               table.calcValue(domain(0) + 0.3*width));
+    remove(fileName.c_str());
+
+    // A tolerance of 0 evaluates the curve without the table.
+    table.setLookupTableTolerance(0);
+    SimTK_TEST(table.calcDerivative(domain(0) + 0.3*width, 2) ==
+               exact.calcDerivative(domain(0) + 0.3*width, 2));
+}
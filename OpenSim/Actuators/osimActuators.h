@@ -37,6 +37,7 @@
 #include "Thelen2003Muscle.h"
 #include "RigidTendonMuscle.h"
 #include "Millard2012EquilibriumMuscle.h"
+#include "Millard2012EquilibriumMuscleBatch.h"
 #include "Millard2012AccelerationMuscle.h"
 
 #include "McKibbenActuator.h"
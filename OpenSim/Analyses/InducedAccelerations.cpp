@@ -28,6 +28,9 @@
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/Model/ExternalForce.h>
 #include "InducedAccelerations.h"
+#include <algorithm>
+#include <exception>
+#include <thread>
 
 using namespace OpenSim;
 using namespace std;
@@ -68,7 +71,8 @@ InducedAccelerations::InducedAccelerations(Model *aModel) :
     _constraintSet((ConstraintSet&)_constraintSetProp.getValueObj()),
     _forceThreshold(_forceThresholdProp.getValueDbl()),
     _computePotentialsOnly(_computePotentialsOnlyProp.getValueBool()),
-    _reportConstraintReactions(_reportConstraintReactionsProp.getValueBool())
+    _reportConstraintReactions(_reportConstraintReactionsProp.getValueBool()),
+    _numThreads(_numThreadsProp.getValueInt())
 {
     // make sure members point to NULL if not valid. 
     setNull();
@@ -96,7 +100,8 @@ InducedAccelerations::InducedAccelerations(const std::string &aFileName):
     _constraintSet((ConstraintSet&)_constraintSetProp.getValueObj()),
     _forceThreshold(_forceThresholdProp.getValueDbl()),
     _computePotentialsOnly(_computePotentialsOnlyProp.getValueBool()),
-    _reportConstraintReactions(_reportConstraintReactionsProp.getValueBool())
+    _reportConstraintReactions(_reportConstraintReactionsProp.getValueBool()),
+    _numThreads(_numThreadsProp.getValueInt())
 {
     setNull();
 
@@ -120,7 +125,8 @@ InducedAccelerations::InducedAccelerations(const InducedAccelerations &aInducedA
     _constraintSet((ConstraintSet&)_constraintSetProp.getValueObj()),
     _forceThreshold(_forceThresholdProp.getValueDbl()),
     _computePotentialsOnly(_computePotentialsOnlyProp.getValueBool()),
-    _reportConstraintReactions(_reportConstraintReactionsProp.getValueBool())
+    _reportConstraintReactions(_reportConstraintReactionsProp.getValueBool()),
+    _numThreads(_numThreadsProp.getValueInt())
 {
     setNull();
     // COPY TYPE AND NAME
@@ -153,6 +159,7 @@ operator=(const InducedAccelerations &aInducedAccelerations)
     _computePotentialsOnly = aInducedAccelerations._computePotentialsOnly;
     _reportConstraintReactions = aInducedAccelerations._reportConstraintReactions;
     _includeCOM = aInducedAccelerations._includeCOM;
+    _numThreads = aInducedAccelerations._numThreads;
     return(*this);
 }
 
@@ -171,6 +178,7 @@ void InducedAccelerations::setNull()
     _bodyNames[0] = CENTER_OF_MASS_NAME;
     _computePotentialsOnly = false;
     _reportConstraintReactions = false;
+    _numThreads = 1;
     // Analysis does not own contents of these sets
     _coordSet.setMemoryOwner(false);
     _bodySet.setMemoryOwner(false);
@@ -213,6 +221,11 @@ void InducedAccelerations::setupProperties()
     _reportConstraintReactionsProp.setName("report_constraint_reactions");
     _reportConstraintReactionsProp.setComment("Report individual contributions to constraint reactions in addition to accelerations.");
     _propertySet.append(&_reportConstraintReactionsProp);
+
+    _numThreadsProp.setName("num_threads");
+    _numThreadsProp.setComment("Number of threads that compute the contributions at each time. "
+        "A value of 0 or less uses one thread per processor.");
+    _propertySet.append(&_numThreadsProp);
 }
 
 //=============================================================================
@@ -499,10 +512,83 @@ void InducedAccelerations::setModel(Model &aModel)
  */
 int InducedAccelerations::record(const SimTK::State& s)
 {
-    int nu = _model->getNumSpeeds();
     double aT = s.getTime();
     cout << "time = " << aT << endl;
 
+    // Each thread computes a contiguous block of contributors, the first
+    // block with this analysis and the others with the copies.
+    int ncontrib = _contributors.getSize();
+    int numThreads = (int)_workers.size() + 1;
+    std::vector<std::exception_ptr> errors(numThreads);
+    auto computeBlock = [&](int t) {
+        try {
+            InducedAccelerations& analysis = (t == 0) ? *this : *_workers[t-1];
+            analysis.computeContributions(s, ncontrib*t/numThreads,
+                                          ncontrib*(t+1)/numThreads);
+        }
+        catch (...) {
+            errors[t] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> threads;
+    for(int t=1; t<numThreads; t++) threads.emplace_back(computeBlock, t);
+    computeBlock(0);
+    for(auto& thread : threads) thread.join();
+    for(const auto& error : errors)
+        if(error) std::rethrow_exception(error);
+
+    // Append the contributions of the other blocks, in contributor order
+    for(const auto& worker : _workers) {
+        for(int i=0;i<_coordSet.getSize();i++)
+            _coordIndAccs[i]->append(*worker->_coordIndAccs[i]);
+        for(int i=0;i<_bodySet.getSize();i++)
+            _bodyIndAccs[i]->append(*worker->_bodyIndAccs[i]);
+        _comIndAccs.append(worker->_comIndAccs);
+        _constraintReactions.append(worker->_constraintReactions);
+    }
+
+    // Set the accelerations of coordinates into their storages
+    int nc = _coordSet.getSize();
+    for(int i=0; i<nc; i++) {
+        _storeInducedAccelerations[i]->append(aT, _coordIndAccs[i]->getSize(),&(_coordIndAccs[i]->get(0)));
+    }
+
+    // Set the accelerations of bodies into their storages
+    int nb = _bodySet.getSize();
+    for(int i=0; i<nb; i++) {
+        _storeInducedAccelerations[nc+i]->append(aT, _bodyIndAccs[i]->getSize(),&(_bodyIndAccs[i]->get(0)));
+    }
+
+    // Set the accelerations of system center of mass into a storage
+    if(_includeCOM){
+        _storeInducedAccelerations[nc+nb]->append(aT, _comIndAccs.getSize(), &_comIndAccs[0]);
+    }
+    if(_reportConstraintReactions){
+        _storeConstraintReactions->append(aT, _constraintReactions.getSize(), &_constraintReactions[0]);
+    }
+
+    return(0);
+}
+
+//_____________________________________________________________________________
+/**
+ * Compute the induced accelerations of the contributors with indices
+ * first to last-1 into the work arrays, in contributor order.
+ *
+ * The contact constraints and the state used by the contributors are set up
+ * with the model of this analysis, so copies of the analysis can compute
+ * different contributors at the same time.
+ *
+ * @param s State at which the contributions are computed
+ * @param first Index of the first contributor
+ * @param last One past the index of the last contributor
+ */
+void InducedAccelerations::computeContributions(const SimTK::State& s,
+                                                int first, int last)
+{
+    int nu = _model->getNumSpeeds();
+    double aT = s.getTime();
+
     SimTK::Vector Q = s.getQ();
 
     // Reset Accelerations for coordinates at this time step
@@ -541,7 +627,7 @@ int InducedAccelerations::record(const SimTK::State& s)
     s_analysis.setTime(aT);
 
     // Cycle through the force contributors to the system acceleration
-    for(int c=0; c< _contributors.getSize(); c++){          
+    for(int c=first; c<last; c++){          
         //cout << "Solving for contributor: " << _contributors[c] << endl;
         // Need to be at the dynamics stage to disable a force
         _model->getMultibodySystem().realize(s_analysis, SimTK::Stage::Dynamics);
@@ -764,28 +850,6 @@ int InducedAccelerations::record(const SimTK::State& s)
         }
 
     } // End cycling through contributors at this time step
-
-    // Set the accelerations of coordinates into their storages
-    int nc = _coordSet.getSize();
-    for(int i=0; i<nc; i++) {
-        _storeInducedAccelerations[i]->append(aT, _coordIndAccs[i]->getSize(),&(_coordIndAccs[i]->get(0)));
-    }
-
-    // Set the accelerations of bodies into their storages
-    int nb = _bodySet.getSize();
-    for(int i=0; i<nb; i++) {
-        _storeInducedAccelerations[nc+i]->append(aT, _bodyIndAccs[i]->getSize(),&(_bodyIndAccs[i]->get(0)));
-    }
-
-    // Set the accelerations of system center of mass into a storage
-    if(_includeCOM){
-        _storeInducedAccelerations[nc+nb]->append(aT, _comIndAccs.getSize(), &_comIndAccs[0]);
-    }
-    if(_reportConstraintReactions){
-        _storeConstraintReactions->append(aT, _constraintReactions.getSize(), &_constraintReactions[0]);
-    }
-
-    return(0);
 }
 
 /**
@@ -796,6 +860,23 @@ int InducedAccelerations::record(const SimTK::State& s)
  */
 void InducedAccelerations::initialize(const SimTK::State& s)
 {   
+    // Copies of this analysis compute blocks of contributors on other
+    // threads. They are set up here, before this analysis adopts its
+    // constraints, each with its own copy of the model and of the
+    // constraints. Building a model is not guaranteed to be thread safe, so
+    // they are set up one at a time.
+    _workers.clear();
+    int ncontrib = _model->getActuators().getSize() + 2;
+    if(!_computePotentialsOnly) ncontrib++;
+    int numThreads = _numThreads;
+    if(numThreads <= 0) numThreads = (int)std::thread::hardware_concurrency();
+    numThreads = std::max(1, std::min(numThreads, ncontrib));
+    for(int t=1; t<numThreads; t++) {
+        _workers.emplace_back(new InducedAccelerations(*this));
+        _workers.back()->setNumThreads(1);
+        _workers.back()->initialize(s);
+    }
+
     // Go forward with a copy of the model so Analysis can add to model if necessary
     _model = _model->clone();
 
@@ -27,9 +27,12 @@
 // INCLUDES
 //=============================================================================
 // Headers define the various property types that OpenSim objects can read 
+#include <OpenSim/Common/PropertyInt.h>
 #include <OpenSim/Common/PropertyObj.h>
 #include <OpenSim/Common/PropertyStrArray.h>
 #include <OpenSim/Simulation/Model/Analysis.h>
+#include <memory>
+#include <vector>
 // Header to define analysis (DLL) interface
 #include "osimAnalysesDLL.h"
 
@@ -73,6 +76,10 @@ private:
     CoordinateSet &_coordSet;
     BodySet &_bodySet;
 
+    /* Copies of this analysis, each with its own copy of the model, that
+       compute the contributions of blocks of contributors on other threads. */
+    std::vector<std::unique_ptr<InducedAccelerations>> _workers;
+
 protected:
     // Properties are the user-specified quantities that are read in from file
     /** Specifies the list of coordinates for which induced accelerations are reported */
@@ -102,6 +109,10 @@ protected:
     PropertyBool _reportConstraintReactionsProp;
     bool &_reportConstraintReactions;
 
+    /** Number of threads that compute the contributions at each time. */
+    PropertyInt _numThreadsProp;
+    int &_numThreads;
+
     /** Storages for recording induced accelerations for specified coordinates and/or bodies. */
     Array<Storage *> _storeInducedAccelerations;
     Storage* _storeConstraintReactions;
@@ -185,6 +196,12 @@ public:
     // GET AND SET
     //-------------------------------------------------------------------------
     void setModel(Model &aModel) override;
+    /** Number of threads that compute the contributions at each time (0 or
+        less for one per processor). Each thread computes a contiguous block of
+        contributors with its own copy of the model; the copies are made when
+        the analysis is initialized. */
+    void setNumThreads(const int numThreads) { _numThreads = numThreads; }
+    int getNumThreads() const { return _numThreads; }
 
     //-------------------------------------------------------------------------
     // INTEGRATION
@@ -208,6 +225,7 @@ public:
 protected:
     //========================== Internal Methods =============================
     int record(const SimTK::State& s);
+    void computeContributions(const SimTK::State& s, int first, int last);
     void constructDescription();
     void assembleContributors();
     Array<std::string> constructColumnLabelsForCoordinate();
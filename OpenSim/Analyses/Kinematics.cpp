@@ -180,6 +180,9 @@ deleteStorage()
 void Kinematics::
 updateCoordinatesToRecord()
 {
+    _valueHandles.clear();
+    _speedHandles.clear();
+
     if(!_model) {
         _coordinateIndices.setSize(0);
         _values.setSize(0);
@@ -207,6 +210,31 @@ updateCoordinatesToRecord()
     }
 }
 
+//_____________________________________________________________________________
+/**
+ * Resolve the handles to the value and speed of each coordinate to record,
+ * unless those resolved previously are still valid.
+ */
+void Kinematics::
+updateStateVariableHandles()
+{
+    const int nvalues = _coordinateIndices.getSize();
+    bool valid = ((int)_valueHandles.size() == nvalues);
+    for(int i=0;valid && i<nvalues;i++) {
+        valid = _valueHandles[i].isValid() && _speedHandles[i].isValid();
+    }
+    if(valid) return;
+
+    const CoordinateSet& cs = _model->getCoordinateSet();
+    _valueHandles.clear();
+    _speedHandles.clear();
+    for(int i=0;i<nvalues;i++) {
+        const Coordinate& coord = cs[_coordinateIndices[i]];
+        _valueHandles.push_back(coord.getStateVariableHandle("value"));
+        _speedHandles.push_back(coord.getStateVariableHandle("speed"));
+    }
+}
+
 //=============================================================================
 // GET AND SET
 //=============================================================================
@@ -318,6 +346,10 @@ void Kinematics::setModel(Model& aModel)
     // BASE CLASS
     Analysis::setModel(aModel);
 
+    // Handles to the state variables of another model are of no use.
+    _valueHandles.clear();
+    _speedHandles.clear();
+
     // Allocate storages to contain the results of the analysis
     allocateStorage();
 }
@@ -359,17 +391,18 @@ int Kinematics::record(const SimTK::State& s)
         _model->getMultibodySystem().realize(s, SimTK::Stage::Velocity);
     }
     // RECORD RESULTS
+    updateStateVariableHandles();
     const CoordinateSet& cs = _model->getCoordinateSet();
     int nvalues = _coordinateIndices.getSize();
     for(int i=0;i<nvalues;i++){
-        _values[i] = cs[_coordinateIndices[i]].getValue(s);
+        _values[i] = _valueHandles[i].getValue(s);
         if(getInDegrees() && (cs[_coordinateIndices[i]].getMotionType() == Coordinate::Rotational))
             _values[i] *= SimTK_RADIAN_TO_DEGREE;
     }
     _pStore->append(s.getTime(),nvalues,&_values[0]);
 
     for(int i=0;i<nvalues;i++){
-        _values[i] = cs[_coordinateIndices[i]].getSpeedValue(s);
+        _values[i] = _speedHandles[i].getValue(s);
         if(getInDegrees() && (cs[_coordinateIndices[i]].getMotionType() == Coordinate::Rotational))
             _values[i] *= SimTK_RADIAN_TO_DEGREE;
     }
@@ -28,6 +28,7 @@
 // INCLUDES
 //=============================================================================
 #include <OpenSim/Simulation/Model/Analysis.h>
+#include <OpenSim/Common/Component.h>
 #include "osimAnalysesDLL.h"
 
 
@@ -57,6 +58,13 @@ protected:
 
     Array<int> _coordinateIndices;
     Array<double> _values;
+#ifndef SWIG
+    /** Handles to the value and speed state variables of the recorded
+    coordinates. They are cleared whenever the model or the coordinates to
+    record change, and are not copied. */
+    SimTK::ResetOnCopy<std::vector<StateVariableHandle>> _valueHandles;
+    SimTK::ResetOnCopy<std::vector<StateVariableHandle>> _speedHandles;
+#endif
 
     Storage *_pStore;
     Storage *_vStore;
@@ -81,6 +89,7 @@ private:
     void allocateStorage();
     void deleteStorage();
     void updateCoordinatesToRecord();
+    void updateStateVariableHandles();
 
 public:
     //--------------------------------------------------------------------------
@@ -30,6 +30,11 @@
 #include <OpenSim/Simulation/Model/Model.h>
 #include "MuscleAnalysis.h"
 
+#include <algorithm>
+#include <deque>
+#include <future>
+#include <thread>
+
 using namespace OpenSim;
 using namespace std;
 
@@ -430,6 +435,7 @@ MuscleAnalysis& MuscleAnalysis::operator=(const MuscleAnalysis &aAnalysis)
 void MuscleAnalysis::setModel(Model& aModel)
 {
     Super::setModel(aModel);
+    _momentArmSolver.reset();
     allocateStorageObjects();
 }
 //_____________________________________________________________________________
@@ -642,23 +648,34 @@ int MuscleAnalysis::record(const SimTK::State& s)
 
     if (_computeMoments){
         // LOOP OVER ACTIVE MOMENT ARM STORAGE OBJECTS
-        Coordinate *q = NULL;
         Storage *maStore=NULL, *mStore=NULL;
         int nq = _momentArmStorageArray.getSize();
         Array<double> ma(0.0,nm),m(0.0,nm);
 
-        for(int i=0; i<nq; i++) {
+        std::vector<const Coordinate*> coordinates(nq);
+        for(int i=0; i<nq; i++)
+            coordinates[i] = _momentArmStorageArray[i]->q;
+        std::vector<const GeometryPath*> paths(nm);
+        for(int j=0; j<nm; j++)
+            paths[j] = &_muscleArray[j]->getGeometryPath();
 
-            q = _momentArmStorageArray[i]->q;
+        _model->getMultibodySystem().realize(s, s.getSystemStage());
+
+        // Solve for the moment arms of all muscles about all coordinates at
+        // once (muscles x coordinates), which shares the coupling due to
+        // constraints across muscles and the path forces across coordinates.
+        if (!_momentArmSolver)
+            _momentArmSolver.reset(new MomentArmSolver(*_model));
+        SimTK::Matrix momentArms =
+            _momentArmSolver->solve(s, coordinates, paths);
+
+        for(int i=0; i<nq; i++) {
             maStore = _momentArmStorageArray[i]->momentArmStore;
             mStore = _momentArmStorageArray[i]->momentStore;
-           
-            // bool locked = q->getLocked(s);
 
-            _model->getMultibodySystem().realize(s, s.getSystemStage());
             // LOOP OVER MUSCLES
             for(int j=0; j<nm; j++) {
-                ma[j] = _muscleArray[j]->computeMomentArm(s,*q);
+                ma[j] = momentArms(j, i);
                 m[j] = ma[j] * force[j];
             }
             maStore->append(s.getTime(),nm,&ma[0]);
@@ -688,6 +705,10 @@ int MuscleAnalysis::begin(const SimTK::State&s )
 
     allocateStorageObjects();
 
+    // The solver holds a copy of the model's working state, which may have
+    // been re-created since the last analysis.
+    _momentArmSolver.reset();
+
     // RESET STORAGE
     Storage *store;
     int size = _storageList.getSize();
@@ -782,21 +803,40 @@ printResults(const string &aBaseName,const string &aDir,double aDT,
         return 0;
     }
 
+    // Several files are written at the same time, one per processor, each
+    // from its own storage and formatted on a single thread, so that the
+    // number of threads stays bounded. All the files are written before
+    // returning.
+    const size_t maxPrinting =
+        std::max(1u, std::thread::hardware_concurrency());
+    std::deque<std::future<void>> printing;
+    auto printResult = [&](const Storage *aStorage, const string &aName) {
+        if(printing.size() >= maxPrinting) {
+            printing.front().get();
+            printing.pop_front();
+        }
+        printing.push_back(std::async(std::launch::async,
+            &Storage::printResult, aStorage, aName, aDir, aDT, aExtension, 1));
+    };
+
     std::string prefix = aBaseName + "_" + getName() + "_";
     for(int i=0; i<_storageList.getSize(); ++i){
-        Storage::printResult(_storageList[i],prefix+_storageList[i]->getName(),aDir,aDT,aExtension);
+        printResult(_storageList[i],prefix+_storageList[i]->getName());
     }
 
     int size = _momentArmStorageArray.getSize();
     for(int i=0;i<size;i++) {
         string fileName = prefix + _momentArmStorageArray.get(i)
             ->momentArmStore->getName();
-        Storage::printResult(_momentArmStorageArray.get(i)
-            ->momentArmStore,fileName,aDir,aDT,aExtension);
+        printResult(_momentArmStorageArray.get(i)->momentArmStore,fileName);
         fileName = prefix + _momentArmStorageArray.get(i)
             ->momentStore->getName();
-        Storage::printResult(_momentArmStorageArray.get(i)
-            ->momentStore,fileName,aDir,aDT,aExtension);
+        printResult(_momentArmStorageArray.get(i)->momentStore,fileName);
+    }
+
+    while(!printing.empty()) {
+        printing.front().get();
+        printing.pop_front();
     }
 
     return 0;
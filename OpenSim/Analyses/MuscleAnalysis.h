@@ -30,6 +30,7 @@
 //=============================================================================
 #include <OpenSim/Simulation/Model/Analysis.h>
 #include <OpenSim/Simulation/Model/Muscle.h>
+#include <OpenSim/Simulation/MomentArmSolver.h>
 #include "osimAnalysesDLL.h"
 
 
@@ -141,6 +142,10 @@ private:
     /** Array of active muscles. */
     ArrayPtrs<Muscle> _muscleArray;
 
+    /** Solver for the moment arms of all muscles about all coordinates at
+    once. Created on demand and cleared on copy. */
+    SimTK::ResetOnCopy<std::unique_ptr<MomentArmSolver> > _momentArmSolver;
+
 //=============================================================================
 // METHODS
 //=============================================================================
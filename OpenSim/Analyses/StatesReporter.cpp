@@ -125,6 +125,9 @@ StatesReporter& StatesReporter::operator=(const StatesReporter &aStatesReporter)
     // BASE CLASS
     Analysis::operator=(aStatesReporter);
 
+    // The handles of the other reporter may refer to a different model.
+    _stateVariableHandles.clear();
+
     // STORAGE
     setupStorage();
 
@@ -144,6 +147,23 @@ setupStorage()
     _storageList.setMemoryOwner(false);
 }
 
+//=============================================================================
+// GET AND SET
+//=============================================================================
+//_____________________________________________________________________________
+/**
+ * Set the model whose states are recorded.
+ */
+void StatesReporter::
+setModel(Model& aModel)
+{
+    // BASE CLASS
+    Analysis::setModel(aModel);
+
+    // Handles to the state variables of another model are of no use.
+    _stateVariableHandles.clear();
+}
+
 //-----------------------------------------------------------------------------
 // DESCRIPTION
 //-----------------------------------------------------------------------------
@@ -179,6 +199,9 @@ constructDescription()
 void StatesReporter::
 constructColumnLabels()
 {
+    // The handles are resolved again, in the order of the new labels.
+    _stateVariableHandles.clear();
+
     if (_model)
     {
         // ASSIGN
@@ -188,6 +211,32 @@ constructColumnLabels()
     }
 }
 
+//_____________________________________________________________________________
+/**
+ * Resolve the handles to the state variables of the model, unless those
+ * resolved previously are still valid (i.e., the model's System has not been
+ * rebuilt since).
+ */
+void StatesReporter::
+updateStateVariableHandles()
+{
+    const int nsv = _model->getNumStateVariables();
+    bool valid = ((int)_stateVariableHandles.size() == nsv);
+    for(int i=0;valid && i<nsv;i++) {
+        valid = _stateVariableHandles[i].isValid();
+    }
+    if(valid) return;
+
+    const Array<string> names = _model->getStateVariableNames();
+    _stateVariableHandles.clear();
+    _stateVariableHandles.reserve(nsv);
+    for(int i=0;i<names.getSize();i++) {
+        _stateVariableHandles.push_back(
+                _model->getStateVariableHandle(names[i]));
+    }
+    _stateValues.setSize(names.getSize());
+}
+
 //=============================================================================
 // ANALYSIS
 //=============================================================================
@@ -203,9 +252,12 @@ record(const SimTK::State& s)
     // MAKE SURE ALL StatesReporter QUANTITIES ARE VALID
     _model->getMultibodySystem().realize(s, SimTK::Stage::Velocity );
 
-    SimTK::Vector stateValues = _model->getStateVariableValues(s);
-    StateVector nextRow(s.getTime(), stateValues);
-    _statesStore.append(nextRow);
+    updateStateVariableHandles();
+    const int nsv = (int)_stateVariableHandles.size();
+    for(int i=0;i<nsv;i++) {
+        _stateValues[i] = _stateVariableHandles[i].getValue(s);
+    }
+    _statesStore.append(s.getTime(), _stateValues);
 
     return(0);
 }
@@ -28,6 +28,7 @@
 // INCLUDES
 //=============================================================================
 #include <OpenSim/Common/Storage.h>
+#include <OpenSim/Common/Component.h>
 #include <OpenSim/Simulation/Model/Analysis.h>
 #include "osimAnalysesDLL.h"
 
@@ -56,6 +57,15 @@ OpenSim_DECLARE_CONCRETE_OBJECT(StatesReporter, Analysis);
 // DATA
 //=============================================================================
 private:
+#ifndef SWIG
+    /** Handles to the state variables of the model, in the order of the
+    column labels. They are cleared whenever the column labels are
+    constructed, and are not copied. */
+    SimTK::ResetOnCopy<std::vector<StateVariableHandle>>
+        _stateVariableHandles;
+#endif
+    /** Work array for the values of the state variables. */
+    Array<double> _stateValues;
 
 protected:
     /** States storage. */
@@ -75,6 +85,7 @@ private:
     void constructDescription();
     void constructColumnLabels();
     void setupStorage();
+    void updateStateVariableHandles();
 
 public:
     //--------------------------------------------------------------------------
@@ -95,6 +106,8 @@ public:
     {
         return _statesStore;
     }
+    // MODEL
+    void setModel(Model& aModel) override;
     //--------------------------------------------------------------------------
     // ANALYSIS
     //--------------------------------------------------------------------------
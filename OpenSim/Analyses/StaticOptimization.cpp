@@ -31,8 +31,13 @@
 #include <OpenSim/Simulation/Control/ControlSet.h>
 #include "StaticOptimization.h"
 #include "StaticOptimizationTarget.h"
+#include <simmath/Optimizer.h>
 #include <OpenSim/Simulation/Model/ActivationFiberLengthMuscle.h>
 
+#include <algorithm>
+#include <exception>
+#include <thread>
+
 
 using namespace OpenSim;
 using namespace std;
@@ -47,6 +52,8 @@ using namespace std;
 StaticOptimization::~StaticOptimization()
 {
     deleteStorage();
+    _optimizer.reset();
+    _target.reset();
     delete _modelWorkingCopy;
     if(_ownsForceSet) delete _forceSet;
 }
@@ -61,6 +68,8 @@ StaticOptimization::StaticOptimization(Model *aModel) :
     _useMusclePhysiology(_useMusclePhysiologyProp.getValueBool()),
     _convergenceCriterion(_convergenceCriterionProp.getValueDbl()),
     _maximumIterations(_maximumIterationsProp.getValueInt()),
+    _useAnalyticConstraintMatrix(_useAnalyticConstraintMatrixProp.getValueBool()),
+    _numThreads(_numThreadsProp.getValueInt()),
     _modelWorkingCopy(NULL)
 {
     setNull();
@@ -82,12 +91,16 @@ StaticOptimization::StaticOptimization(const StaticOptimization &aStaticOptimiza
     _useMusclePhysiology(_useMusclePhysiologyProp.getValueBool()),
     _convergenceCriterion(_convergenceCriterionProp.getValueDbl()),
     _maximumIterations(_maximumIterationsProp.getValueInt()),
+    _useAnalyticConstraintMatrix(_useAnalyticConstraintMatrixProp.getValueBool()),
+    _numThreads(_numThreadsProp.getValueInt()),
     _modelWorkingCopy(NULL)
 {
     setNull();
     // COPY TYPE AND NAME
     *this = aStaticOptimization;
     _forceReporter = nullptr;
+    // The working copy of the model belongs to the original.
+    _modelWorkingCopy = NULL;
 }
 
 //=============================================================================
@@ -114,7 +127,11 @@ operator=(const StaticOptimization &aStaticOptimization)
     _activationExponent=aStaticOptimization._activationExponent;
     _convergenceCriterion=aStaticOptimization._convergenceCriterion;
     _maximumIterations=aStaticOptimization._maximumIterations;
+    _useAnalyticConstraintMatrix=aStaticOptimization._useAnalyticConstraintMatrix;
+    _numThreads=aStaticOptimization._numThreads;
     _forceReporter = nullptr;
+    _optimizer.reset();
+    _target.reset();
     _useMusclePhysiology=aStaticOptimization._useMusclePhysiology;
     return(*this);
 }
@@ -138,6 +155,8 @@ void StaticOptimization::setNull()
     _numCoordinateActuators = 0;
     _convergenceCriterion = 1e-4;
     _maximumIterations = 100;
+    _useAnalyticConstraintMatrix = false;
+    _numThreads = 1;
     _forceReporter = nullptr;
     setName("StaticOptimization");
 }
@@ -173,6 +192,21 @@ setupProperties()
         "An integer for setting the maximum number of iterations the optimizer can use at each time.  ");
     _maximumIterationsProp.setName("optimizer_max_iterations");
     _propertySet.append(&_maximumIterationsProp);
+
+    _useAnalyticConstraintMatrixProp.setComment(
+        "If true, the acceleration constraints are computed from the mass matrix and the "
+        "generalized forces of the actuators, rather than from one forward dynamics "
+        "evaluation per actuator, and the optimization at each time starts from the "
+        "solution at the previous time.");
+    _useAnalyticConstraintMatrixProp.setName("use_analytic_constraint_matrix");
+    _propertySet.append(&_useAnalyticConstraintMatrixProp);
+
+    _numThreadsProp.setComment(
+        "Number of threads that solve the time frames. A value of 0 or less uses one thread "
+        "per processor. With more than one thread, the frames are collected and solved in "
+        "contiguous blocks when the analysis ends.");
+    _numThreadsProp.setName("num_threads");
+    _propertySet.append(&_numThreadsProp);
 }
 
 //=============================================================================
@@ -263,6 +297,7 @@ setModel(Model& aModel)
 Storage* StaticOptimization::
 getActivationStorage()
 {
+    solvePendingStates();
     return(_activationStorage);
 }
 //_____________________________________________________________________________
@@ -274,6 +309,7 @@ getActivationStorage()
 Storage* StaticOptimization::
 getForceStorage()
 {
+    solvePendingStates();
     if (_forceReporter)
         return(&_forceReporter->updForceStorage());
     else
@@ -334,18 +370,40 @@ record(const SimTK::State& s)
 
     // Optimization target
     _modelWorkingCopy->setAllControllersEnabled(false);
-    StaticOptimizationTarget target(sWorkingCopy,_modelWorkingCopy,na,nacc,_useMusclePhysiology);
+    bool warmStart = _useAnalyticConstraintMatrix && _target;
+    if(!_target) {
+        _target.reset(new StaticOptimizationTarget(sWorkingCopy,_modelWorkingCopy,na,nacc,_useMusclePhysiology));
+        _optimizer.reset();
+    }
+    StaticOptimizationTarget& target = *_target;
     target.setStatesStore(_statesStore);
     target.setStatesSplineSet(_statesSplineSet);
     target.setActivationExponent(_activationExponent);
     target.setDX(_numericalDerivativeStepSize);
+    target.setUseAnalyticConstraintMatrix(_useAnalyticConstraintMatrix);
 
     // Pick optimizer algorithm
     SimTK::OptimizerAlgorithm algorithm = SimTK::InteriorPoint;
     //SimTK::OptimizerAlgorithm algorithm = SimTK::CFSQP;
 
-    // Optimizer
-    SimTK::Optimizer *optimizer = new SimTK::Optimizer(target, algorithm);
+    // Parameter bounds
+    SimTK::Vector lowerBounds(na), upperBounds(na);
+    for(int i=0,j=0;i<fs.getSize();i++) {
+        ScalarActuator* act = dynamic_cast<ScalarActuator*>(&fs.get(i));
+        if (act) {
+            lowerBounds(j) = act->getMinControl();
+            upperBounds(j) = act->getMaxControl();
+            j++;
+        }
+    }
+    
+    target.setParameterLimits(lowerBounds, upperBounds);
+
+    // Optimizer, created for the first time frame and reused afterwards
+    if(!_optimizer) {
+        _optimizer.reset(new SimTK::Optimizer(target, algorithm));
+    }
+    SimTK::Optimizer *optimizer = _optimizer.get();
 
     // Optimizer options
     //cout<<"\nSetting optimizer print level to "<<_printLevel<<".\n";
@@ -364,20 +422,8 @@ record(const SimTK::State& s)
         optimizer->setAdvancedRealOption("nlp_scaling_max_gradient",1);
     }
 
-    // Parameter bounds
-    SimTK::Vector lowerBounds(na), upperBounds(na);
-    for(int i=0,j=0;i<fs.getSize();i++) {
-        ScalarActuator* act = dynamic_cast<ScalarActuator*>(&fs.get(i));
-        if (act) {
-            lowerBounds(j) = act->getMinControl();
-            upperBounds(j) = act->getMaxControl();
-            j++;
-        }
-    }
-    
-    target.setParameterLimits(lowerBounds, upperBounds);
-
-    _parameters = 0; // Set initial guess to zeros
+    // Set initial guess to zeros, or to the solution at the previous time
+    if(!warmStart) _parameters = 0;
 
     // Static optimization
     _modelWorkingCopy->getMultibodySystem().realize(sWorkingCopy,SimTK::Stage::Velocity);
@@ -511,7 +557,45 @@ int StaticOptimization::begin(const SimTK::State& s )
 {
     if(!proceed()) return(0);
 
+    setUpWorkingCopy(s);
+
+    // RECORD
+    int status = 0;
+    if(_activationStorage->getSize()<=0) {
+        if(_numThreads != 1) {
+            _pendingStates.clear();
+            _pendingStates.push_back(s);
+        } else {
+            status = record(s);
+        }
+        const Set<Actuator>& fs = _modelWorkingCopy->getActuators();
+        for(int k=0;k<fs.getSize();k++) {
+            ScalarActuator* act = dynamic_cast<ScalarActuator *>(&fs[k]);
+            if (act){
+                cout << "Bounds for " << act->getName() << ": "
+                    << act->getMinControl() << " to "
+                    << act->getMaxControl() << endl;
+            }
+            else{
+                std::string msg = getConcreteClassName();
+                msg += "::can only process scalar Actuator types.";
+                throw Exception(msg);
+            }
+        }
+    }
+
+    return(status);
+}
+//_____________________________________________________________________________
+/**
+ * Make the working copy of the model, and the storage, for the analysis
+ * that starts at state s.
+ */
+void StaticOptimization::setUpWorkingCopy(const SimTK::State& s)
+{
     // Make a working copy of the model
+    _optimizer.reset();
+    _target.reset();
     delete _modelWorkingCopy;
     _modelWorkingCopy = _model->clone();
     // Remove disabled Actuators so we don't use them downstream (issue #2438)
@@ -605,28 +689,78 @@ int StaticOptimization::begin(const SimTK::State& s )
     // RESET STORAGE
     _activationStorage->reset(s.getTime());
     _forceReporter->updForceStorage().reset(s.getTime());
+}
+//_____________________________________________________________________________
+/**
+ * Collect the state of a time frame to be solved by solvePendingStates().
+ * A state with the same time as the previous one replaces it.
+ */
+void StaticOptimization::addPendingState(const SimTK::State& s)
+{
+    if(!_pendingStates.empty() && _pendingStates.back().getTime() == s.getTime())
+        _pendingStates.back() = s;
+    else
+        _pendingStates.push_back(s);
+}
+//_____________________________________________________________________________
+/**
+ * Solve the collected time frames on several threads. Each thread solves a
+ * contiguous block of frames with its own copy of this analysis and of the
+ * model (the calling thread uses this analysis), so that each frame can
+ * start from the solution of the previous frame of its block. The results
+ * of the copies are then appended to the storage of this analysis, in time
+ * order.
+ */
+void StaticOptimization::solvePendingStates()
+{
+    if(_pendingStates.empty()) return;
+    std::vector<SimTK::State> states;
+    states.swap(_pendingStates);
+    int nt = (int)states.size();
+
+    int numThreads = _numThreads;
+    if(numThreads <= 0) numThreads = (int)std::thread::hardware_concurrency();
+    numThreads = std::max(1, std::min(numThreads, nt));
+
+    // Building a model is not guaranteed to be thread safe, so the copies
+    // are set up here, one at a time.
+    std::vector<std::unique_ptr<StaticOptimization>> workers;
+    for(int t=1; t<numThreads; t++) {
+        workers.emplace_back(new StaticOptimization(*this));
+        StaticOptimization& worker = *workers.back();
+        worker.setNumThreads(1);
+        worker.setStatesStore(_statesStore);
+        worker.setUpWorkingCopy(states[nt*t/numThreads]);
+    }
 
-    // RECORD
-    int status = 0;
-    if(_activationStorage->getSize()<=0) {
-        status = record(s);
-        const Set<Actuator>& fs = _modelWorkingCopy->getActuators();
-        for(int k=0;k<fs.getSize();k++) {
-            ScalarActuator* act = dynamic_cast<ScalarActuator *>(&fs[k]);
-            if (act){
-                cout << "Bounds for " << act->getName() << ": "
-                    << act->getMinControl() << " to "
-                    << act->getMaxControl() << endl;
-            }
-            else{
-                std::string msg = getConcreteClassName();
-                msg += "::can only process scalar Actuator types.";
-                throw Exception(msg);
-            }
+    std::vector<std::exception_ptr> errors(numThreads);
+    auto solveFrames = [&](int t) {
+        try {
+            StaticOptimization& analysis = (t == 0) ? *this : *workers[t-1];
+            const int end = nt*(t+1)/numThreads;
+            for(int i=nt*t/numThreads; i<end; i++)
+                analysis.record(states[i]);
         }
+        catch (...) {
+            errors[t] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> threads;
+    for(int t=1; t<numThreads; t++) threads.emplace_back(solveFrames, t);
+    solveFrames(0);
+    for(auto& thread : threads) thread.join();
+    for(const auto& error : errors)
+        if(error) std::rethrow_exception(error);
+
+    Storage& forceStorage = _forceReporter->updForceStorage();
+    for(const auto& worker : workers) {
+        const Storage& activations = *worker->_activationStorage;
+        for(int i=0; i<activations.getSize(); i++)
+            _activationStorage->append(*activations.getStateVector(i));
+        const Storage& forces = worker->_forceReporter->getForceStorage();
+        for(int i=0; i<forces.getSize(); i++)
+            forceStorage.append(*forces.getStateVector(i));
     }
-
-    return(status);
 }
 //_____________________________________________________________________________
 /**
@@ -646,7 +780,8 @@ int StaticOptimization::step(const SimTK::State& s, int stepNumber )
 {
     if(!proceed(stepNumber)) return(0);
 
-    record(s);
+    if(_numThreads != 1) addPendingState(s);
+    else record(s);
 
     return(0);
 }
@@ -663,7 +798,12 @@ int StaticOptimization::end( const SimTK::State& s )
 {
     if(!proceed()) return(0);
 
-    record(s);
+    if(_numThreads != 1) {
+        addPendingState(s);
+        solvePendingStates();
+    } else {
+        record(s);
+    }
 
     return(0);
 }
@@ -691,6 +831,8 @@ int StaticOptimization::
 printResults(const string &aBaseName,const string &aDir,double aDT,
                  const string &aExtension)
 {
+    solvePendingStates();
+
     // ACTIVATIONS
     Storage::printResult(_activationStorage,aBaseName+"_"+getName()+"_activation",aDir,aDT,aExtension);
 
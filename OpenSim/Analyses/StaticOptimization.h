@@ -29,10 +29,15 @@
 //=============================================================================
 #include "osimAnalysesDLL.h"
 #include <memory>
+#include <vector>
 #include <OpenSim/Simulation/Model/Analysis.h>
 #include <OpenSim/Common/GCVSplineSet.h>
 #include "ForceReporter.h"
 
+namespace SimTK {
+class Optimizer;
+}
+
 //=============================================================================
 //=============================================================================
 /**
@@ -41,6 +46,7 @@ namespace OpenSim {
 
 class Model;
 class ForceSet;
+class StaticOptimizationTarget;
 
 /**
  * This class implements static optimization to compute Muscle Forces and 
@@ -59,6 +65,15 @@ private:
 
     std::unique_ptr<ForceReporter> _forceReporter;
 
+    /** Optimization target and optimizer, kept from one time frame to the
+        next. */
+    std::unique_ptr<StaticOptimizationTarget> _target;
+    std::unique_ptr<SimTK::Optimizer> _optimizer;
+
+    /** States of the time frames that have not been solved yet, when more
+        than one thread is used. */
+    std::vector<SimTK::State> _pendingStates;
+
 protected:
     /** Use force set from model. */
     PropertyBool _useModelForceSetProp;
@@ -76,6 +91,12 @@ protected:
     PropertyInt _maximumIterationsProp;
     int &_maximumIterations;
 
+    PropertyBool _useAnalyticConstraintMatrixProp;
+    bool &_useAnalyticConstraintMatrix;
+
+    PropertyInt _numThreadsProp;
+    int &_numThreads;
+
     Storage *_activationStorage;
     Storage *_forceStorage;
     GCVSplineSet _statesSplineSet;
@@ -114,6 +135,9 @@ private:
     void constructColumnLabels();
     void allocateStorage();
     void deleteStorage();
+    void setUpWorkingCopy(const SimTK::State& s);
+    void addPendingState(const SimTK::State& s);
+    void solvePendingStates();
 
 public:
     //--------------------------------------------------------------------------
@@ -135,6 +159,14 @@ public:
     double getConvergenceCriterion() { return _convergenceCriterion; }
     void setMaxIterations( const int maxIt) { _maximumIterations = maxIt; }
     int getMaxIterations() {return _maximumIterations; }
+    void setUseAnalyticConstraintMatrix(const bool useIt) { _useAnalyticConstraintMatrix = useIt; }
+    bool getUseAnalyticConstraintMatrix() const { return _useAnalyticConstraintMatrix; }
+    /** Number of threads that solve the time frames (0 or less for one per
+        processor). With more than one thread, the states of the frames are
+        collected by begin() and step(), and the frames are solved when the
+        analysis ends, in contiguous blocks by copies of this analysis. */
+    void setNumThreads(const int numThreads) { _numThreads = numThreads; }
+    int getNumThreads() const { return _numThreads; }
     //--------------------------------------------------------------------------
     // ANALYSIS
     //--------------------------------------------------------------------------
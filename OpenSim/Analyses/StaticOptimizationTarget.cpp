@@ -30,6 +30,8 @@
 // INCLUDES
 //=============================================================================
 #include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/Model/PathActuator.h>
+#include <OpenSim/Actuators/CoordinateActuator.h>
 #include "StaticOptimizationTarget.h"
 
 using namespace OpenSim;
@@ -65,6 +67,7 @@ StaticOptimizationTarget(const SimTK::State& s, Model *aModel,int aNP,int aNC, b
     _recipOptForceSquared.setSize(aNP);
     _optimalForce.setSize(aNP);
     _useMusclePhysiology=useMusclePhysiology;
+    _useAnalyticConstraintMatrix=false;
 
     setModel(*aModel);
     setNumParams(aNP);
@@ -127,11 +130,15 @@ prepareToOptimize(SimTK::State& s, double *x)
     pVector = 0;
     computeConstraintVector(s, pVector,_constraintVector);
 
-    for(int p=0; p<np; p++) {
-        pVector[p] = 1;
-        computeConstraintVector(s, pVector, cVector);
-        for(int c=0; c<nc; c++) _constraintMatrix(c,p) = (cVector[c] - _constraintVector[c]);
-        pVector[p] = 0;
+    if(_useAnalyticConstraintMatrix) {
+        computeAnalyticConstraintMatrix(s);
+    } else {
+        for(int p=0; p<np; p++) {
+            pVector[p] = 1;
+            computeConstraintVector(s, pVector, cVector);
+            for(int c=0; c<nc; c++) _constraintMatrix(c,p) = (cVector[c] - _constraintVector[c]);
+            pVector[p] = 0;
+        }
     }
 #endif
 
@@ -565,6 +572,92 @@ constraintFunc(const SimTK::Vector &parameters, const bool new_parameters, SimTK
     return(0);
 }
 
+//______________________________________________________________________________
+/**
+ * Compute the constraint matrix from the mass matrix and the generalized
+ * forces of a unit value of each parameter. The accelerations caused by
+ * generalized forces f are M^-1 (f - G^T lambda), where the constraint
+ * forces G^T lambda keep G udot = 0. The state must have been realized to
+ * Acceleration with all parameters zero.
+ *
+ * Actuators whose generalized forces are not computed here (i.e., those
+ * other than muscles, PathActuators and CoordinateActuators) get their
+ * column of the matrix by realizing the accelerations.
+ */
+void StaticOptimizationTarget::
+computeAnalyticConstraintMatrix(SimTK::State& s)
+{
+    const SimTK::SimbodyMatterSubsystem& matter = _model->getMatterSubsystem();
+    int np = getNumParameters();
+    int nc = getNumConstraints();
+    int nu = s.getNU();
+
+    // Generalized forces of a unit value of each parameter
+    Matrix unitForces(nu, np, 0.0);
+    Array<bool> isAnalytic(false, np);
+    SimTK::Vector_<SimTK::SpatialVec> bodyForces(matter.getNumBodies());
+    Vector mobilityForces(nu), bodyMobilityForces(nu);
+    const ForceSet& fSet = _model->getForceSet();
+    for(int i=0, j=0;i<fSet.getSize();i++) {
+        const ScalarActuator* act = dynamic_cast<const ScalarActuator*>(&fSet.get(i));
+        if(!act) continue;
+
+        bodyForces = SimTK::SpatialVec(SimTK::Vec3(0), SimTK::Vec3(0));
+        mobilityForces = 0;
+        const PathActuator* pathAct = dynamic_cast<const PathActuator*>(act);
+        const CoordinateActuator* coordAct = dynamic_cast<const CoordinateActuator*>(act);
+        if(!act->appliesForce(s)) {
+            isAnalytic[j] = true;
+        } else if(pathAct && (dynamic_cast<const Muscle*>(act) ||
+                              act->getConcreteClassName() == "PathActuator")) {
+            pathAct->getGeometryPath().addInEquivalentForces(s, _optimalForce[j],
+                bodyForces, mobilityForces);
+            isAnalytic[j] = true;
+        } else if(coordAct && coordAct->getCoordinate()) {
+            const Coordinate& coord = *coordAct->getCoordinate();
+            matter.addInMobilityForce(s,
+                SimTK::MobilizedBodyIndex(coord.getBodyIndex()),
+                SimTK::MobilizerUIndex(coord.getMobilizerQIndex()),
+                _optimalForce[j], mobilityForces);
+            isAnalytic[j] = true;
+        }
+        if(isAnalytic[j]) {
+            matter.multiplyBySystemJacobianTranspose(s, bodyForces, bodyMobilityForces);
+            unitForces(j) = mobilityForces + bodyMobilityForces;
+        }
+        j++;
+    }
+
+    // Accelerations caused by these forces
+    Matrix MInv, G;
+    matter.calcMInv(s, MInv);
+    matter.calcG(s, G);
+    Matrix accelerations = MInv * unitForces;
+    if(G.nrow() > 0) {
+        // Constraints may be redundant, so the multipliers are found in the
+        // least-squares sense.
+        SimTK::FactorQTZ GMInvGt(G * MInv * ~G);
+        Matrix constraintErrors = G * accelerations;
+        Vector lambda(G.nrow());
+        for(int p=0; p<np; p++) {
+            GMInvGt.solve(Vector(constraintErrors(p)), lambda);
+            accelerations(p) -= MInv * (~G * lambda);
+        }
+    }
+
+    Vector pVector(np, 0.0), cVector(nc);
+    for(int p=0; p<np; p++) {
+        if(isAnalytic[p]) {
+            for(int c=0; c<nc; c++)
+                _constraintMatrix(c,p) = -accelerations(_accelerationIndices[c], p);
+        } else {
+            pVector[p] = 1;
+            computeConstraintVector(s, pVector, cVector);
+            for(int c=0; c<nc; c++) _constraintMatrix(c,p) = (cVector[c] - _constraintVector[c]);
+            pVector[p] = 0;
+        }
+    }
+}
 //______________________________________________________________________________
 /**
  * Compute all constraints given parameters.
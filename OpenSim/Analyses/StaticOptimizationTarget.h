@@ -64,6 +64,9 @@ private:
     
     SimTK::Matrix _constraintMatrix;
     SimTK::Vector _constraintVector;
+    /** Compute the constraint matrix from the mass matrix instead of
+        realizing the accelerations once per parameter. */
+    bool _useAnalyticConstraintMatrix;
 
     const Storage *_statesStore;
     GCVSplineSet _statesSplineSet;
@@ -96,6 +99,14 @@ public:
     double getActivationExponent() const { return _activationExponent; }
     void setCurrentState( const SimTK::State* state) { _currentState = state; }
     const SimTK::State* getCurrentState() const { return _currentState; }
+    /** If true, prepareToOptimize() computes the linear map from the
+        parameters to the accelerations from the mass matrix, the constraint
+        Jacobian and the generalized forces of unit actuations, realizing the
+        accelerations only once. Otherwise, the accelerations are realized
+        once per parameter. The map is used for both the constraints and
+        their Jacobian. */
+    void setUseAnalyticConstraintMatrix(bool useIt) { _useAnalyticConstraintMatrix = useIt; }
+    bool getUseAnalyticConstraintMatrix() const { return _useAnalyticConstraintMatrix; }
 
     // UTILITY
     void validatePerturbationSize(double &aSize);
@@ -122,6 +133,7 @@ public:
     int constraintJacobian(const SimTK::Vector &x, bool new_coefficients, SimTK::Matrix &jac) const override;
 
 private:
+    void computeAnalyticConstraintMatrix(SimTK::State& s);
     void computeConstraintVector(SimTK::State& s, const SimTK::Vector &x, SimTK::Vector &c) const;
     void computeAcceleration(SimTK::State& s, const SimTK::Vector &aF,SimTK::Vector &rAccel) const;
     void cumulativeTime(double &aTime, double aIncrement);
@@ -74,12 +74,15 @@ void
 AbstractDataTable::setDependentsMetaData(const DependentsMetaData& 
                                          dependentsMetaData) {
     _dependentsMetaData = dependentsMetaData;
+    _columnIndexMap.clear();
     validateDependentsMetaData();
 }
 
 void
 AbstractDataTable::removeDependentsMetaDataForKey(const std::string& key) {
     _dependentsMetaData.removeValueForKey(key);
+    if(key == "labels")
+        _columnIndexMap.clear();
 }
 
 bool
@@ -152,11 +155,11 @@ AbstractDataTable::getColumnIndex(const std::string& columnLabel) const {
 
     const auto& absArray = 
         _dependentsMetaData.getValueArrayForKey("labels");
-    for(size_t i = 0; i < absArray.size(); ++i)
-        if(absArray[i].getValue<std::string>() == columnLabel)
-            return i;
+    const size_t index = _columnIndexMap.find(absArray, columnLabel);
+    OPENSIM_THROW_IF(index == absArray.size(),
+                     KeyNotFound, columnLabel);
 
-    OPENSIM_THROW(KeyNotFound, columnLabel);
+    return index;
 }
 
 bool 
@@ -166,11 +169,7 @@ AbstractDataTable::hasColumn(const std::string& columnLabel) const {
 
     const auto& absArray = 
         _dependentsMetaData.getValueArrayForKey("labels");
-    for(size_t i = 0; i < absArray.size(); ++i)
-        if(absArray[i].getValue<std::string>() == columnLabel)
-            return true;
-
-    return false;
+    return _columnIndexMap.find(absArray, columnLabel) != absArray.size();
 }
 
 bool 
@@ -183,8 +182,39 @@ AbstractDataTable::appendColumnLabel(const std::string& columnLabel) {
     auto& absArray = _dependentsMetaData.updValueArrayForKey("labels");
     auto& labels = static_cast<ValueArray<std::string>&>(absArray);
     labels.upd().push_back(SimTK::Value<std::string>{columnLabel});
+    _columnIndexMap.clear();
 
     validateDependentsMetaData();
 }
 
+size_t
+AbstractDataTable::ColumnIndexMap::find(const AbstractValueArray& labels,
+                                        const std::string& columnLabel) const {
+    std::lock_guard<std::mutex> lock{_mutex};
+    if(!_isBuilt || _indices.size() > labels.size())
+        build(labels);
+
+    auto iter = _indices.find(columnLabel);
+    if(iter != _indices.end() &&
+       (iter->second >= labels.size() ||
+        labels[iter->second].getValue<std::string>() != columnLabel)) {
+        // The labels were changed without clearing the map.
+        build(labels);
+        iter = _indices.find(columnLabel);
+    }
+
+    return iter == _indices.end() ? labels.size() : iter->second;
+}
+
+void
+AbstractDataTable::ColumnIndexMap::build(
+        const AbstractValueArray& labels) const {
+    _indices.clear();
+    _indices.reserve(labels.size());
+    // emplace() keeps the first of duplicate labels.
+    for(size_t i = 0; i < labels.size(); ++i)
+        _indices.emplace(labels[i].getValue<std::string>(), i);
+    _isBuilt = true;
+}
+
 } // namespace OpenSim
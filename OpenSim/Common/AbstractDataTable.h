@@ -32,7 +32,9 @@ provide an in-memory container for data access and manipulation.              */
 #include "OpenSim/Common/Exception.h"
 #include "OpenSim/Common/ValueArrayDictionary.h"
 
+#include <mutex>
 #include <ostream>
+#include <unordered_map>
 
 namespace OpenSim {
 
@@ -394,6 +396,7 @@ public:
 
         _dependentsMetaData.removeValueArrayForKey("labels");
         _dependentsMetaData.setValueArrayForKey("labels", labels);
+        _columnIndexMap.clear();
         try {
             validateDependentsMetaData();
         }
@@ -486,6 +489,43 @@ protected:
     TableMetaData       _tableMetaData;
     DependentsMetaData  _dependentsMetaData;
     IndependentMetaData _independentMetaData;
+
+private:
+    // Map from column label to column index, used by getColumnIndex() and
+    // hasColumn(). The map is built when first needed and cleared whenever
+    // the column labels are set. A copy of the map starts out empty. The
+    // label at the index found is checked against the label looked up, and
+    // the map is rebuilt if they differ. Lookups may happen concurrently on a
+    // table that is not being modified, so the map is guarded by a mutex.
+    class ColumnIndexMap {
+    public:
+        ColumnIndexMap() = default;
+        ColumnIndexMap(const ColumnIndexMap&) {}
+        ColumnIndexMap& operator=(const ColumnIndexMap&) {
+            clear();
+            return *this;
+        }
+
+        void clear() {
+            std::lock_guard<std::mutex> lock{_mutex};
+            _indices.clear();
+            _isBuilt = false;
+        }
+
+        // Index of the first column with the given label, or labels.size()
+        // if there is none.
+        size_t find(const AbstractValueArray& labels,
+                    const std::string& columnLabel) const;
+
+    private:
+        void build(const AbstractValueArray& labels) const;
+
+        mutable std::mutex                              _mutex;
+        mutable std::unordered_map<std::string, size_t> _indices;
+        mutable bool                                    _isBuilt{false};
+    };
+
+    ColumnIndexMap _columnIndexMap;
 }; // AbstractDataTable
 
 } // namespace OpenSim
@@ -0,0 +1,685 @@
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  BinaryFileAdapter.cpp                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2019 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "BinaryFileAdapter.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+namespace OpenSim {
+
+namespace {
+    // First bytes of every file.
+    const char signature[8] = {'O', 'S', 'I', 'M', 'B', 'S', 'T', 'O'};
+    // Written in the byte order of the writer to detect a different order.
+    const std::uint32_t byteOrderMark = 0x01020304;
+    const std::uint32_t formatVersion = 1;
+
+    // Name and number of components of the supported element types, and
+    // conversion of elements to and from their components.
+    template<typename T> struct ElementType;
+
+    template<> struct ElementType<double> {
+        static std::string name() { return "double"; }
+        static const int numComponents = 1;
+        static void toComponents(const double& elem, double* comps) {
+            comps[0] = elem;
+        }
+        static void fromComponents(const double* comps, double& elem) {
+            elem = comps[0];
+        }
+    };
+
+    template<> struct ElementType<SimTK::Vec3> {
+        static std::string name() { return "Vec3"; }
+        static const int numComponents = 3;
+        static void toComponents(const SimTK::Vec3& elem, double* comps) {
+            for(int i = 0; i < 3; ++i) comps[i] = elem[i];
+        }
+        static void fromComponents(const double* comps, SimTK::Vec3& elem) {
+            for(int i = 0; i < 3; ++i) elem[i] = comps[i];
+        }
+    };
+
+    template<> struct ElementType<SimTK::Quaternion> {
+        static std::string name() { return "Quaternion"; }
+        static const int numComponents = 4;
+        static void toComponents(const SimTK::Quaternion& elem,
+                                 double* comps) {
+            for(int i = 0; i < 4; ++i) comps[i] = elem[i];
+        }
+        static void fromComponents(const double* comps,
+                                   SimTK::Quaternion& elem) {
+            // The values were written from a Quaternion, so they are used
+            // as is instead of being normalized again.
+            elem = SimTK::Quaternion{SimTK::Vec4{comps[0], comps[1],
+                                                 comps[2], comps[3]},
+                                     true};
+        }
+    };
+
+    template<> struct ElementType<SimTK::SpatialVec> {
+        static std::string name() { return "SpatialVec"; }
+        static const int numComponents = 6;
+        static void toComponents(const SimTK::SpatialVec& elem,
+                                 double* comps) {
+            for(int i = 0; i < 2; ++i)
+                for(int j = 0; j < 3; ++j) comps[3 * i + j] = elem[i][j];
+        }
+        static void fromComponents(const double* comps,
+                                   SimTK::SpatialVec& elem) {
+            for(int i = 0; i < 2; ++i)
+                for(int j = 0; j < 3; ++j) elem[i][j] = comps[3 * i + j];
+        }
+    };
+
+    struct Header {
+        std::string dataType;
+        std::uint32_t numComponents{};
+        std::vector<std::pair<std::string, std::string>> metadata;
+        std::vector<std::string> labels;
+    };
+
+    template<typename U>
+    void writeValue(std::ostream& stream, const U& value) {
+        stream.write(reinterpret_cast<const char*>(&value), sizeof(U));
+    }
+
+    void writeString(std::ostream& stream, const std::string& str) {
+        writeValue(stream, static_cast<std::uint64_t>(str.size()));
+        stream.write(str.data(), str.size());
+    }
+
+    void writeHeader(std::ostream& stream, const Header& header) {
+        stream.write(signature, sizeof(signature));
+        writeValue(stream, byteOrderMark);
+        writeValue(stream, formatVersion);
+        writeString(stream, header.dataType);
+        writeValue(stream, header.numComponents);
+        writeValue(stream,
+                   static_cast<std::uint64_t>(header.metadata.size()));
+        for(const auto& keyValue : header.metadata) {
+            writeString(stream, keyValue.first);
+            writeString(stream, keyValue.second);
+        }
+        writeValue(stream, static_cast<std::uint64_t>(header.labels.size()));
+        for(const auto& label : header.labels)
+            writeString(stream, label);
+    }
+
+    // Reads values from the contents of a file, checking that the file does
+    // not end before the values do.
+    class Reader {
+    public:
+        Reader(const MappedFile& file, const std::string& fileName) :
+            _pos{file.begin()}, _end{file.end()}, _fileName{fileName} {}
+
+        bool atEnd() const { return _pos == _end; }
+
+        size_t getNumBytesLeft() const { return _end - _pos; }
+
+        const char* getPosition() const { return _pos; }
+
+        void read(void* data, size_t size) {
+            require(size);
+            if(size > 0)
+                std::memcpy(data, _pos, size);
+            _pos += size;
+        }
+
+        void skip(size_t size) {
+            require(size);
+            _pos += size;
+        }
+
+        template<typename U>
+        U readValue() {
+            U value;
+            read(&value, sizeof(U));
+            return value;
+        }
+
+        std::string readString() {
+            const auto size = readValue<std::uint64_t>();
+            require(size);
+            std::string str(_pos, static_cast<size_t>(size));
+            _pos += size;
+            return str;
+        }
+
+    private:
+        void require(std::uint64_t size) const {
+            OPENSIM_THROW_IF(size > getNumBytesLeft(),
+                             BinaryFileCorrupt,
+                             _fileName,
+                             "The file ends unexpectedly.");
+        }
+
+        const char* _pos;
+        const char* _end;
+        const std::string& _fileName;
+    };
+
+    Header readHeader(Reader& reader, const std::string& fileName) {
+        char fileSignature[sizeof(signature)];
+        reader.read(fileSignature, sizeof(fileSignature));
+        OPENSIM_THROW_IF(std::memcmp(fileSignature, signature,
+                                     sizeof(signature)) != 0,
+                         BinaryFileCorrupt,
+                         fileName,
+                         "The file is not an OpenSim binary file.");
+        OPENSIM_THROW_IF(reader.readValue<std::uint32_t>() != byteOrderMark,
+                         BinaryFileCorrupt,
+                         fileName,
+                         "The file was written on a machine with a "
+                         "different byte order.");
+        const auto version = reader.readValue<std::uint32_t>();
+        OPENSIM_THROW_IF(version > formatVersion,
+                         BinaryFileCorrupt,
+                         fileName,
+                         "The file has version " + std::to_string(version) +
+                         " of the format, but only versions up to " +
+                         std::to_string(formatVersion) + " are supported.");
+
+        Header header{};
+        header.dataType = reader.readString();
+        header.numComponents = reader.readValue<std::uint32_t>();
+        const auto numMetaData = reader.readValue<std::uint64_t>();
+        for(std::uint64_t i = 0; i < numMetaData; ++i) {
+            auto key = reader.readString();
+            auto value = reader.readString();
+            header.metadata.emplace_back(std::move(key), std::move(value));
+        }
+        const auto numColumns = reader.readValue<std::uint64_t>();
+        for(std::uint64_t i = 0; i < numColumns; ++i)
+            header.labels.push_back(reader.readString());
+        return header;
+    }
+
+    // Go through the chunks that follow the header without reading the
+    // elements. Returns the total number of rows and the last time.
+    size_t scanChunks(Reader reader, const Header& header,
+                      const std::string& fileName, double& lastTime) {
+        const size_t bytesPerRow =
+            (1 + header.labels.size() * header.numComponents) *
+            sizeof(double);
+        size_t numRows = 0;
+        lastTime = -SimTK::Infinity;
+        while(!reader.atEnd()) {
+            const auto chunkRows = reader.readValue<std::uint64_t>();
+            OPENSIM_THROW_IF(chunkRows > reader.getNumBytesLeft() / bytesPerRow,
+                             BinaryFileCorrupt,
+                             fileName,
+                             "The file ends unexpectedly.");
+            const size_t n = static_cast<size_t>(chunkRows);
+            if(n > 0) {
+                reader.skip((n - 1) * sizeof(double));
+                lastTime = reader.readValue<double>();
+            }
+            reader.skip(n * (bytesPerRow - sizeof(double)));
+            numRows += n;
+        }
+        return numRows;
+    }
+
+    template<typename T>
+    std::shared_ptr<AbstractDataTable>
+    readTable(Reader& reader, const Header& header,
+              const std::string& fileName) {
+        using Element = ElementType<T>;
+        OPENSIM_THROW_IF(header.numComponents != Element::numComponents,
+                         BinaryFileCorrupt,
+                         fileName,
+                         "Elements of type " + header.dataType + " must have " +
+                         std::to_string(Element::numComponents) +
+                         " components.");
+        const int ncol = static_cast<int>(header.labels.size());
+
+        // Find the number of rows first, so that the table is allocated once.
+        double lastTime{};
+        const size_t numRows = scanChunks(reader, header, fileName, lastTime);
+        std::vector<double> times(numRows);
+        SimTK::Matrix_<T> matrix(static_cast<int>(numRows), ncol);
+
+        std::vector<double> column;
+        size_t row = 0;
+        while(!reader.atEnd()) {
+            const size_t n =
+                static_cast<size_t>(reader.readValue<std::uint64_t>());
+            reader.read(times.data() + row, n * sizeof(double));
+            column.resize(n * Element::numComponents);
+            for(int col = 0; col < ncol; ++col) {
+                reader.read(column.data(), column.size() * sizeof(double));
+                for(size_t i = 0; i < n; ++i)
+                    Element::fromComponents(
+                            &column[i * Element::numComponents],
+                            matrix(static_cast<int>(row + i), col));
+            }
+            row += n;
+        }
+
+        auto table = std::make_shared<TimeSeriesTable_<T>>(times, matrix,
+                                                           header.labels);
+        for(const auto& keyValue : header.metadata)
+            table->updTableMetaData().setValueForKey(keyValue.first,
+                                                     keyValue.second);
+        return table;
+    }
+
+    // Reads the rows of a file a block at a time. A block may take rows from
+    // several chunks of the file, or part of a chunk.
+    template<typename T>
+    class BinaryChunkSource : public FileAdapter::ChunkSource {
+    public:
+        BinaryChunkSource(const std::string& fileName) :
+            _fileName{fileName}, _file{fileName}, _reader{_file, _fileName} {
+            OPENSIM_THROW_IF(_file.size() == 0,
+                             FileIsEmpty,
+                             fileName);
+            const Header header = readHeader(_reader, _fileName);
+            OPENSIM_THROW_IF(header.numComponents != Element::numComponents,
+                             BinaryFileCorrupt,
+                             fileName,
+                             "Elements of type " + header.dataType +
+                             " must have " +
+                             std::to_string(Element::numComponents) +
+                             " components.");
+            _header = TimeSeriesTable_<T>{
+                    std::vector<double>{},
+                    SimTK::Matrix_<T>(0, int(header.labels.size())),
+                    header.labels};
+            for(const auto& keyValue : header.metadata)
+                _header.updTableMetaData().setValueForKey(keyValue.first,
+                                                          keyValue.second);
+            _bytesPerRow = (1 + header.labels.size() * Element::numComponents) *
+                           sizeof(double);
+        }
+
+        const AbstractDataTable& getHeader() const override {
+            return _header;
+        }
+
+        bool readChunk(AbstractDataTable& chunk, size_t maxRows) override {
+            auto table = dynamic_cast<TimeSeriesTable_<T>*>(&chunk);
+            OPENSIM_THROW_IF(table == nullptr,
+                             IncorrectTableType,
+                             "File '" + _fileName + "' holds a table of " +
+                             Element::name() + ".");
+            *table = _header;
+
+            // Find the parts of the chunks in the file that make up the
+            // block, so that the block is allocated once.
+            struct Part {
+                const char* chunkBegin;
+                size_t chunkRows;
+                size_t firstRow;
+                size_t numRows;
+            };
+            std::vector<Part> parts;
+            size_t numRows = 0;
+            while(numRows < maxRows) {
+                if(_rowsLeftInChunk == 0) {
+                    if(_reader.atEnd())
+                        break;
+                    const auto chunkRows = _reader.readValue<std::uint64_t>();
+                    OPENSIM_THROW_IF(chunkRows >
+                                     _reader.getNumBytesLeft() / _bytesPerRow,
+                                     BinaryFileCorrupt,
+                                     _fileName,
+                                     "The file ends unexpectedly.");
+                    _chunkBegin = _reader.getPosition();
+                    _chunkRows = static_cast<size_t>(chunkRows);
+                    _rowsLeftInChunk = _chunkRows;
+                    _reader.skip(_chunkRows * _bytesPerRow);
+                    continue;
+                }
+                const size_t n = std::min(_rowsLeftInChunk, maxRows - numRows);
+                parts.push_back({_chunkBegin, _chunkRows,
+                                 _chunkRows - _rowsLeftInChunk, n});
+                _rowsLeftInChunk -= n;
+                numRows += n;
+            }
+            if(numRows == 0)
+                return false;
+
+            const int ncol = static_cast<int>(_header.getNumColumns());
+            std::vector<double> times(numRows);
+            SimTK::Matrix_<T> matrix(static_cast<int>(numRows), ncol);
+            std::vector<double> column;
+            size_t row = 0;
+            for(const Part& part : parts) {
+                // A chunk holds the times of its rows, and then its elements
+                // column by column.
+                std::memcpy(times.data() + row,
+                            part.chunkBegin + part.firstRow * sizeof(double),
+                            part.numRows * sizeof(double));
+                column.resize(part.numRows * Element::numComponents);
+                for(int col = 0; col < ncol; ++col) {
+                    const char* elements = part.chunkBegin +
+                        (part.chunkRows * (1 + col * Element::numComponents) +
+                         part.firstRow * Element::numComponents) *
+                        sizeof(double);
+                    std::memcpy(column.data(), elements,
+                                column.size() * sizeof(double));
+                    for(size_t i = 0; i < part.numRows; ++i)
+                        Element::fromComponents(
+                                &column[i * Element::numComponents],
+                                matrix(static_cast<int>(row + i), col));
+                }
+                row += part.numRows;
+            }
+
+            *table = TimeSeriesTable_<T>{times, matrix,
+                                         _header.getColumnLabels()};
+            table->updTableMetaData() = _header.getTableMetaData();
+            return true;
+        }
+
+    private:
+        using Element = ElementType<T>;
+
+        const std::string   _fileName;
+        const MappedFile    _file;
+        Reader              _reader;
+        TimeSeriesTable_<T> _header;
+        size_t              _bytesPerRow{};
+        // The chunk of the file that the next rows are taken from.
+        const char*         _chunkBegin{};
+        size_t              _chunkRows{};
+        size_t              _rowsLeftInChunk{};
+    };
+
+    template<typename T>
+    Header makeHeader(const TimeSeriesTable_<T>& table) {
+        Header header{};
+        header.dataType = ElementType<T>::name();
+        header.numComponents = ElementType<T>::numComponents;
+        if(table.getNumColumns() > 0)
+            header.labels = table.getColumnLabels();
+        return header;
+    }
+
+    template<typename T>
+    void writeRows(std::ostream& stream,
+                   const TimeSeriesTable_<T>& table,
+                   int chunkSize) {
+        using Element = ElementType<T>;
+        const auto& times = table.getIndependentColumn();
+        const auto& matrix = table.getMatrix();
+        const size_t numRows = times.size();
+        const int ncol = static_cast<int>(table.getNumColumns());
+
+        const size_t rowsPerChunk =
+            chunkSize > 0 ? static_cast<size_t>(chunkSize) : numRows;
+        std::vector<double> column;
+        for(size_t start = 0; start < numRows; start += rowsPerChunk) {
+            const size_t n = std::min(rowsPerChunk, numRows - start);
+            writeValue(stream, static_cast<std::uint64_t>(n));
+            stream.write(reinterpret_cast<const char*>(times.data() + start),
+                         n * sizeof(double));
+            column.resize(n * Element::numComponents);
+            for(int col = 0; col < ncol; ++col) {
+                for(size_t i = 0; i < n; ++i)
+                    Element::toComponents(
+                            matrix(static_cast<int>(start + i), col),
+                            &column[i * Element::numComponents]);
+                stream.write(reinterpret_cast<const char*>(column.data()),
+                             column.size() * sizeof(double));
+            }
+        }
+    }
+
+    // Calls op(table) with table cast to the TimeSeriesTable_ it is.
+    template<typename Op>
+    void dispatch(const AbstractDataTable& table, Op& op) {
+        using namespace SimTK;
+
+        if(auto t = dynamic_cast<const TimeSeriesTable_<double>*>(&table))
+            op(*t);
+        else if(auto t = dynamic_cast<const TimeSeriesTable_<Vec3>*>(&table))
+            op(*t);
+        else if(auto t =
+                dynamic_cast<const TimeSeriesTable_<Quaternion>*>(&table))
+            op(*t);
+        else if(auto t =
+                dynamic_cast<const TimeSeriesTable_<SpatialVec>*>(&table))
+            op(*t);
+        else
+            OPENSIM_THROW(IncorrectTableType,
+                          "BinaryFileAdapter only supports TimeSeriesTable_ "
+                          "of double, Vec3, Quaternion and SpatialVec.");
+    }
+
+    struct HeaderWriter {
+        std::ostream& stream;
+        template<typename T>
+        void operator()(const TimeSeriesTable_<T>& table) const {
+            Header header = makeHeader(table);
+            for(const auto& key : table.getTableMetaDataKeys()) {
+                try {
+                    header.metadata.emplace_back(key,
+                        table.template getTableMetaData<std::string>(key));
+                } catch(const InvalidTemplateArgument&) {}
+            }
+            writeHeader(stream, header);
+        }
+    };
+
+    struct RowsWriter {
+        std::ostream& stream;
+        int chunkSize;
+        template<typename T>
+        void operator()(const TimeSeriesTable_<T>& table) const {
+            writeRows(stream, table, chunkSize);
+        }
+    };
+
+    // Checks that the rows of a table can be appended to a file.
+    struct AppendChecker {
+        const std::string& fileName;
+        template<typename T>
+        void operator()(const TimeSeriesTable_<T>& table) const {
+            const Header header = makeHeader(table);
+            double lastTime{};
+            {
+                const MappedFile file{fileName};
+                Reader reader{file, fileName};
+                const Header fileHeader = readHeader(reader, fileName);
+                OPENSIM_THROW_IF(fileHeader.dataType != header.dataType ||
+                                 fileHeader.labels != header.labels,
+                                 IncorrectTableType,
+                                 "The table does not have the same type and "
+                                 "columns as the table in file '" +
+                                 fileName + "'.");
+                scanChunks(reader, fileHeader, fileName, lastTime);
+            }
+            const auto& times = table.getIndependentColumn();
+            OPENSIM_THROW_IF(!times.empty() && times.front() <= lastTime,
+                             InvalidArgument,
+                             "The times of the rows to append to file '" +
+                             fileName + "' must follow the last time in the "
+                             "file (" + std::to_string(lastTime) + ").");
+        }
+    };
+} // anonymous namespace
+
+BinaryFileAdapter*
+BinaryFileAdapter::clone() const {
+    return new BinaryFileAdapter{*this};
+}
+
+const std::string
+BinaryFileAdapter::tableString() {
+    return "table";
+}
+
+const std::string
+BinaryFileAdapter::extension() {
+    return "bsto";
+}
+
+void
+BinaryFileAdapter::write(const AbstractDataTable& table,
+                         const std::string& fileName) {
+    InputTables tables{};
+    tables.emplace(tableString(), &table);
+    BinaryFileAdapter{}.extendWrite(tables, fileName);
+}
+
+void
+BinaryFileAdapter::append(const AbstractDataTable& table,
+                          const std::string& fileName) {
+    OPENSIM_THROW_IF(fileName.empty(),
+                     EmptyFileName);
+    BinaryFileAdapter{}.writeTable(table, fileName, true);
+}
+
+BinaryFileAdapter::OutputTables
+BinaryFileAdapter::extendRead(const std::string& fileName) const {
+    OPENSIM_THROW_IF(fileName.empty(),
+                     EmptyFileName);
+
+    const MappedFile file{fileName};
+    OPENSIM_THROW_IF(file.size() == 0,
+                     FileIsEmpty,
+                     fileName);
+
+    Reader reader{file, fileName};
+    const Header header = readHeader(reader, fileName);
+
+    std::shared_ptr<AbstractDataTable> table{};
+    if(header.dataType == ElementType<double>::name())
+        table = readTable<double>(reader, header, fileName);
+    else if(header.dataType == ElementType<SimTK::Vec3>::name())
+        table = readTable<SimTK::Vec3>(reader, header, fileName);
+    else if(header.dataType == ElementType<SimTK::Quaternion>::name())
+        table = readTable<SimTK::Quaternion>(reader, header, fileName);
+    else if(header.dataType == ElementType<SimTK::SpatialVec>::name())
+        table = readTable<SimTK::SpatialVec>(reader, header, fileName);
+    else
+        OPENSIM_THROW(BinaryFileCorrupt,
+                      fileName,
+                      "Data type '" + header.dataType + "' is not "
+                      "supported.");
+
+    OutputTables output_tables{};
+    output_tables.emplace(tableString(), table);
+
+    return output_tables;
+}
+
+std::unique_ptr<FileAdapter::ChunkSource>
+BinaryFileAdapter::extendOpenChunkSource(const std::string& fileName) const {
+    OPENSIM_THROW_IF(fileName.empty(),
+                     EmptyFileName);
+
+    // Find the type of the elements first.
+    std::string dataType{};
+    {
+        const MappedFile file{fileName};
+        OPENSIM_THROW_IF(file.size() == 0,
+                         FileIsEmpty,
+                         fileName);
+        Reader reader{file, fileName};
+        dataType = readHeader(reader, fileName).dataType;
+    }
+
+    std::unique_ptr<ChunkSource> source{};
+    if(dataType == ElementType<double>::name())
+        source.reset(new BinaryChunkSource<double>{fileName});
+    else if(dataType == ElementType<SimTK::Vec3>::name())
+        source.reset(new BinaryChunkSource<SimTK::Vec3>{fileName});
+    else if(dataType == ElementType<SimTK::Quaternion>::name())
+        source.reset(new BinaryChunkSource<SimTK::Quaternion>{fileName});
+    else if(dataType == ElementType<SimTK::SpatialVec>::name())
+        source.reset(new BinaryChunkSource<SimTK::SpatialVec>{fileName});
+    else
+        OPENSIM_THROW(BinaryFileCorrupt,
+                      fileName,
+                      "Data type '" + dataType + "' is not supported.");
+    return source;
+}
+
+void
+BinaryFileAdapter::extendWrite(const InputTables& absTables,
+                               const std::string& fileName) const {
+    OPENSIM_THROW_IF(absTables.empty(),
+                     NoTableFound);
+
+    const AbstractDataTable* table{};
+    try {
+        table = absTables.at(tableString());
+    } catch(std::out_of_range&) {
+        OPENSIM_THROW(KeyMissing,
+                      tableString());
+    }
+
+    OPENSIM_THROW_IF(fileName.empty(),
+                     EmptyFileName);
+
+    writeTable(*table, fileName, false);
+}
+
+void
+BinaryFileAdapter::writeTableHeader(std::ostream& stream,
+                                    const AbstractDataTable& table) {
+    HeaderWriter writer{stream};
+    dispatch(table, writer);
+}
+
+void
+BinaryFileAdapter::writeTableRows(std::ostream& stream,
+                                  const AbstractDataTable& table) {
+    RowsWriter writer{stream, 0};
+    dispatch(table, writer);
+}
+
+void
+BinaryFileAdapter::writeTable(const AbstractDataTable& table,
+                              const std::string& fileName,
+                              bool append) const {
+    std::ofstream stream{};
+    if(append) {
+        AppendChecker checker{fileName};
+        dispatch(table, checker);
+        stream.open(fileName, std::ios::binary | std::ios::app);
+    } else {
+        stream.open(fileName, std::ios::binary | std::ios::trunc);
+    }
+    OPENSIM_THROW_IF(!stream.good(),
+                     IOError,
+                     "Could not open file '" + fileName + "' for writing.");
+
+    if(!append)
+        writeTableHeader(stream, table);
+    RowsWriter writer{stream, _chunkSize};
+    dispatch(table, writer);
+
+    stream.close();
+    OPENSIM_THROW_IF(stream.fail(),
+                     IOError,
+                     "Failed to write file '" + fileName + "'.");
+}
+
+} // namespace OpenSim
@@ -0,0 +1,162 @@
+#ifndef OPENSIM_BINARY_FILE_ADAPTER_H_
+#define OPENSIM_BINARY_FILE_ADAPTER_H_
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  BinaryFileAdapter.h                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2019 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "FileAdapter.h"
+#include "TimeSeriesTable.h"
+
+namespace OpenSim {
+
+class BinaryFileCorrupt : public IOError {
+public:
+    BinaryFileCorrupt(const std::string& file,
+                      size_t line,
+                      const std::string& func,
+                      const std::string& filename,
+                      const std::string& reason) :
+        IOError(file, line, func) {
+        std::string msg = "Error reading binary file '" + filename + "'. ";
+        msg += reason;
+
+        addMessage(msg);
+    }
+};
+
+/** BinaryFileAdapter is a FileAdapter that reads and writes time series
+tables in a compact, self-describing binary format (extension ".bsto"). Values
+are stored with full double precision, so a table read back from a file is
+identical to the table that was written.
+
+The file holds, in order:
+  - a header: a signature, the byte order and version of the format, the name
+    of the data type of the elements (double, Vec3, Quaternion or
+    SpatialVec), the table metadata that can be represented as strings (like
+    the header of a STO file), and the column labels;
+  - one or more chunks of rows: the number of rows in the chunk, the times of
+    the rows, and then the elements column by column.
+
+Rows are written in chunks of getChunkSize() rows, and more chunks can be
+appended to an existing file with append(), so results can be streamed to a
+file while they are being computed. Files are read through a memory mapping.
+Files are written in the byte order of the machine that writes them, and an
+exception is thrown if they are read on a machine with a different byte
+order.
+
+The adapter is registered for the extension "bsto", so FileAdapter::readFile(),
+FileAdapter::writeFile(), TimeSeriesTable_, and Storage read and write these
+files like any other supported file.                                          */
+class OSIMCOMMON_API BinaryFileAdapter : public FileAdapter {
+public:
+    BinaryFileAdapter()                                    = default;
+    BinaryFileAdapter(const BinaryFileAdapter&)            = default;
+    BinaryFileAdapter(BinaryFileAdapter&&)                 = default;
+    BinaryFileAdapter& operator=(const BinaryFileAdapter&) = default;
+    BinaryFileAdapter& operator=(BinaryFileAdapter&&)      = default;
+    ~BinaryFileAdapter()                                   = default;
+
+    BinaryFileAdapter* clone() const override;
+
+    /** Key used for table associative array returned/accepted by write/read. */
+    static const std::string tableString();
+
+    /** Extension of the files read and written by this adapter.             */
+    static const std::string extension();
+
+#ifndef SWIG
+    /** Read a binary file that contains a TimeSeriesTable_<T>.
+    \throws IncorrectTableType If the file contains a table of another type. */
+    template<typename T>
+    static TimeSeriesTable_<T> readFile(const std::string& fileName) {
+        auto absTable = BinaryFileAdapter{}.extendRead(fileName).
+                        at(tableString());
+        auto table = dynamic_cast<TimeSeriesTable_<T>*>(absTable.get());
+        OPENSIM_THROW_IF(table == nullptr,
+                         IncorrectTableType,
+                         "File '" + fileName + "' does not contain a table "
+                         "of the requested type.");
+        return *table;
+    }
+#endif
+
+    /** Write a table to a binary file. The table must be a TimeSeriesTable_
+    of double, SimTK::Vec3, SimTK::Quaternion or SimTK::SpatialVec.          */
+    static void write(const AbstractDataTable& table,
+                      const std::string& fileName);
+
+    /** Append the rows of a table to an existing binary file, as a new chunk.
+    The table must have the same type and column labels as the table in the
+    file, and its rows must follow the last row in the file in time. The
+    metadata of the table is not written.                                    */
+    static void append(const AbstractDataTable& table,
+                       const std::string& fileName);
+
+#ifndef SWIG
+    /** Write the header of a binary file for `table` (the type of its
+    elements, its string metadata and its column labels) to `stream`, without
+    any rows. Together with writeTableRows(), this lets a file be written
+    incrementally through a stream that stays open.                          */
+    static void writeTableHeader(std::ostream& stream,
+                                 const AbstractDataTable& table);
+
+    /** Write the rows of `table` to `stream` as one chunk. The table must
+    have the same type and column labels as the table whose header was
+    written to the stream, and its rows must follow the rows already
+    written.                                                                 */
+    static void writeTableRows(std::ostream& stream,
+                               const AbstractDataTable& table);
+#endif
+
+    /** Maximum number of rows in each chunk written by this adapter. If not
+    positive, all the rows of a table are written in one chunk. The default
+    is 4096.                                                                 */
+    void setChunkSize(int chunkSize) { _chunkSize = chunkSize; }
+    int getChunkSize() const { return _chunkSize; }
+
+protected:
+    /** Implementation of the read functionality.                             */
+    OutputTables extendRead(const std::string& fileName) const override;
+
+#ifndef SWIG
+    /** Read the rows of a file a block at a time. The blocks need not match
+    the chunks in the file.                                                   */
+    std::unique_ptr<ChunkSource>
+    extendOpenChunkSource(const std::string& fileName) const override;
+#endif
+
+    /** Implementation of the write functionality.                            */
+    void extendWrite(const InputTables& tables,
+                     const std::string& fileName) const override;
+
+private:
+    /** Write the rows of `table` to `fileName`, with a header if `append` is
+    false, or after checking the header in the file otherwise.              */
+    void writeTable(const AbstractDataTable& table,
+                    const std::string& fileName,
+                    bool append) const;
+
+    int _chunkSize{4096};
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_BINARY_FILE_ADAPTER_H_
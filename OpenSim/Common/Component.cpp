@@ -767,6 +767,16 @@ const Component::StateVariable* Component::
     // Must have already called initSystem.
     OPENSIM_THROW_IF_FRMOBJ(!hasSystem(), ComponentHasNoSystem);
 
+    // Avoid parsing the path for the common case of a state variable of this
+    // component.
+    if (pathName.find('/') == std::string::npos) {
+        auto it = _namedStateVariableInfo.find(pathName);
+        if (it != _namedStateVariableInfo.end()) {
+            return it->second.stateVariable.get();
+        }
+        return nullptr;
+    }
+
     ComponentPath svPath(pathName);
 
     const StateVariable* found = nullptr;
@@ -816,22 +826,22 @@ Array<std::string> Component::getStateVariableNames() const
 // Get the value of a state variable allocated by this Component.
 double Component::
     getStateVariableValue(const SimTK::State& s, const std::string& name) const
+{
+    // The handle finds the state variable within this component or its
+    // subcomponents, and throws if there is none.
+    return getStateVariableHandle(name).getValue(s);
+}
+
+StateVariableHandle Component::
+    getStateVariableHandle(const std::string& name) const
 {
     // Must have already called initSystem.
     OPENSIM_THROW_IF_FRMOBJ(!hasSystem(), ComponentHasNoSystem);
 
-    // find the state variable with this component or its subcomponents
     const StateVariable* rsv = traverseToStateVariable(name);
-    if (rsv) {
-        return rsv->getValue(s);
-    }
-    
-    std::stringstream msg;
-    msg << "Component::getStateVariableValue: ERR- state named '" << name 
-        << "' not found in " << getName() << " of type " << getConcreteClassName();
-    throw Exception(msg.str(),__FILE__,__LINE__);
-
-    return SimTK::NaN;
+    OPENSIM_THROW_IF_FRMOBJ(!rsv, Exception,
+        "State variable '" + name + "' not found.");
+    return StateVariableHandle(*rsv);
 }
 
 // Get the value of a state variable derivative computed by this Component.
@@ -872,21 +882,9 @@ double Component::
 void Component::
     setStateVariableValue(State& s, const std::string& name, double value) const
 {
-    // Must have already called initSystem.
-    OPENSIM_THROW_IF_FRMOBJ(!hasSystem(), ComponentHasNoSystem);
-
-    // find the state variable
-    const StateVariable* rsv = traverseToStateVariable(name);
-
-    if(rsv){ // find required rummaging through the state variable names
-            return rsv->setValue(s, value);
-    }
-    
-    std::stringstream msg;
-    msg << "Component::setStateVariable: ERR- state named '" << name 
-        << "' not found in " << getName() << " of type " 
-        << getConcreteClassName() << ".\n";
-    throw Exception(msg.str(),__FILE__,__LINE__);
+    // The handle finds the state variable within this component or its
+    // subcomponents, and throws if there is none.
+    getStateVariableHandle(name).setValue(s, value);
 }
 
 bool Component::isAllStatesVariablesListValid() const
@@ -1045,12 +1043,35 @@ setDiscreteVariableValue(SimTK::State& s, const std::string& name, double value)
     }
 }
 
+DiscreteVariableHandle Component::
+getDiscreteVariableHandle(const std::string& name) const
+{
+    // Must have already called initSystem.
+    OPENSIM_THROW_IF_FRMOBJ(!hasSystem(), ComponentHasNoSystem);
+
+    auto it = _namedDiscreteVariableInfo.find(name);
+    OPENSIM_THROW_IF_FRMOBJ(it == _namedDiscreteVariableInfo.end(), Exception,
+        "Discrete variable '" + name + "' not found.");
+    OPENSIM_THROW_IF_FRMOBJ(!it->second.index.isValid(), Exception,
+        "Discrete variable '" + name + "' has not been allocated.");
+    return DiscreteVariableHandle(*this, it->second.index);
+}
+
 bool Component::constructOutputForStateVariable(const std::string& name)
 {
-    auto func = [name](const Component* comp,
+    const size_t index = _stateVariableOutputNames.size();
+    _stateVariableOutputNames.push_back(name);
+    auto func = [name, index](const Component* comp,
                        const SimTK::State& s, const std::string&,
                        double& result) -> void {
-        result = comp->getStateVariableValue(s, name);
+        // Use the state variable resolved in extendRealizeTopology() to
+        // avoid looking it up by name every time the output is evaluated.
+        const auto& variables = comp->_stateVariableOutputVariables;
+        if (index < variables.size() && variables[index]) {
+            result = variables[index]->getValue(s);
+        } else {
+            result = comp->getStateVariableValue(s, name);
+        }
     };
     return constructOutput<double>(name, func, SimTK::Stage::Model);
 }
@@ -1388,6 +1409,9 @@ void Component::extendRealizeTopology(SimTK::State& s) const
     
     Component *mutableThis = const_cast<Component*>(this);
 
+    // Any handles to the variables of a previous allocation are now stale.
+    _stateAllocationsToken = std::make_shared<const int>(0);
+
     // Allocate Modeling Option
     if(_namedModelingOptionInfo.size()>0){
         std::map<std::string, ModelingOptionInfo>::iterator it;
@@ -1442,6 +1466,24 @@ void Component::extendRealizeTopology(SimTK::State& s) const
                (s, ci.dependsOnStage, ci.prototype->clone());
         }
     }
+
+    // Allocate the storage for the values of this Component's outputs.
+    if (!_outputsTable.empty()) {
+        const SimTK::CacheEntryIndex index = subSys.allocateLazyCacheEntry(s,
+                SimTK::Stage::Topology, new SimTK::Value<OutputValueCache>());
+        int numSlots = 0;
+        for (const auto& it : _outputsTable) {
+            numSlots += it.second->setValueStorage(subSys, index, numSlots);
+        }
+    }
+
+    // Resolve the state variables of the outputs created by
+    // constructOutputForStateVariable().
+    _stateVariableOutputVariables.clear();
+    for (const auto& name : _stateVariableOutputNames) {
+        _stateVariableOutputVariables.push_back(
+                traverseToStateVariable(name));
+    }
 }
 
 
@@ -1750,6 +1792,11 @@ void Component::clearStateAllocations()
     _namedStateVariableInfo.clear();
     _namedDiscreteVariableInfo.clear();
     _namedCacheVariableInfo.clear();
+    _stateAllocationsToken.reset();
+    _stateVariableOutputVariables.clear();
+    for (const auto& it : _outputsTable) {
+        it.second->clearValueStorage();
+    }
 }
 
 void Component::reset()
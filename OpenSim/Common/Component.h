@@ -50,6 +50,7 @@
 #include "ComponentList.h"
 #include "ComponentPath.h"
 #include <functional>
+#include <memory>
 
 #include "simbody/internal/MultibodySystem.h"
 
@@ -57,6 +58,9 @@ namespace OpenSim {
 
 class Model;
 class ModelDisplayHints;
+class StateVariableHandle;
+class DiscreteVariableHandle;
+template <typename T> class CacheVariableHandle;
 
 //==============================================================================
 /// Component Exceptions
@@ -1575,6 +1579,45 @@ public:
             throw Exception(msg.str(),__FILE__,__LINE__);
         }   
     }
+
+#ifndef SWIG
+    /**
+     * Get a handle to a state variable of this Component or of one of its
+     * subcomponents. The name is resolved once, so that reading and writing
+     * the value through the handle involves no string lookups. The handle
+     * remains valid until the System is rebuilt (e.g., by another call to
+     * initSystem()); see StateVariableHandle::isValid().
+     *
+     * @param name   the name (or path, relative to this Component) of the
+     *               state variable
+     * @throws ComponentHasNoSystem if this Component has not been added to a
+     *         System (i.e., if initSystem has not been called)
+     */
+    StateVariableHandle getStateVariableHandle(const std::string& name) const;
+
+    /**
+     * Get a handle to a discrete variable allocated by this Component.
+     * @see getStateVariableHandle()
+     *
+     * @param name   the name of the discrete variable
+     * @throws ComponentHasNoSystem if this Component has not been added to a
+     *         System (i.e., if initSystem has not been called)
+     */
+    DiscreteVariableHandle getDiscreteVariableHandle(
+            const std::string& name) const;
+
+    /**
+     * Get a handle to a cache variable allocated by this Component. `T` must
+     * be the type with which the cache variable was added.
+     * @see getStateVariableHandle()
+     *
+     * @param name   the name of the cache variable
+     * @throws ComponentHasNoSystem if this Component has not been added to a
+     *         System (i.e., if initSystem has not been called)
+     */
+    template<typename T> CacheVariableHandle<T>
+    getCacheVariableHandle(const std::string& name) const;
+#endif
     // End of Model Component State Accessors.
     //@} 
 
@@ -1652,6 +1695,10 @@ protected:
     //template <class T> friend class ComponentSet;
     // Give the ComponentMeasure access to the realize() methods.
     template <class T> friend class ComponentMeasure;
+    // Give the handles access to the state variables and the subsystem.
+    friend class StateVariableHandle;
+    friend class DiscreteVariableHandle;
+    template <typename T> friend class CacheVariableHandle;
 
 #ifndef SWIG
     /// @class MemberSubcomponentIndex
@@ -2950,6 +2997,22 @@ private:
     // cache information.
     mutable std::map<std::string, CacheInfo>            _namedCacheVariableInfo;
 
+    // Identifies the allocation of the variables above. A new token is
+    // created each time the variables are allocated in
+    // extendRealizeTopology(), and it is released when they are cleared or
+    // when this Component is destroyed (copies do not share it). Handles keep
+    // a weak reference to it, so they can detect that they have gone stale
+    // without accessing this Component.
+    mutable SimTK::ResetOnCopy<std::shared_ptr<const int>>
+        _stateAllocationsToken;
+
+    // Names of the state variables for which outputs were constructed (see
+    // constructOutputForStateVariable()) and the corresponding state
+    // variables, resolved in extendRealizeTopology().
+    std::vector<std::string> _stateVariableOutputNames;
+    mutable SimTK::ResetOnCopy<std::vector<const StateVariable*>>
+        _stateVariableOutputVariables;
+
     // Check that the list of _allStateVariables is valid
     bool isAllStatesVariablesListValid() const;
 
@@ -2963,6 +3026,205 @@ private:
 };  // END of class Component
 //==============================================================================
 //==============================================================================
+
+#ifndef SWIG
+/** A handle to a continuous state variable of a Component, obtained with
+Component::getStateVariableHandle(). The handle refers directly to the state
+variable, so getting or setting its value does not require looking up the
+state variable by name. This is intended for code that accesses the same
+state variables many times (e.g., in every time step of a simulation).
+
+A handle is invalidated when the System of the Component that owns the state
+variable is rebuilt (e.g., by another call to initSystem()) or when that
+Component is destroyed, and accessing the value through an invalid handle
+throws an Exception. Checking validity does not access the Component, so it is
+safe to keep a handle that outlives its Component.
+@code
+auto handle = model.getStateVariableHandle("knee/knee_angle/value");
+for (const auto& state : states) {
+    double q = handle.getValue(state);
+}
+@endcode */
+class StateVariableHandle {
+public:
+    /** Create an unbound handle; isValid() returns false. */
+    StateVariableHandle() = default;
+
+    /** Whether the handle is bound to a state variable that is still
+    allocated in the owning Component's System. */
+    bool isValid() const {
+        return !_token.expired();
+    }
+    /** The name of the state variable, without a path. */
+    const std::string& getName() const {
+        checkValid();
+        return _stateVariable->getName();
+    }
+    /** Get the value of the state variable in the provided State. */
+    double getValue(const SimTK::State& state) const {
+        checkValid();
+        return _stateVariable->getValue(state);
+    }
+    /** %Set the value of the state variable in the provided State. */
+    void setValue(SimTK::State& state, double value) const {
+        checkValid();
+        _stateVariable->setValue(state, value);
+    }
+
+private:
+    friend class Component;
+    explicit StateVariableHandle(const Component::StateVariable& sv) :
+        _stateVariable(&sv),
+        _token(sv.getOwner()._stateAllocationsToken) {}
+
+    void checkValid() const {
+        OPENSIM_THROW_IF(!isValid(), Exception,
+            "StateVariableHandle is not bound to a state variable, or the "
+            "System of the state variable's Component has been rebuilt.");
+    }
+
+    const Component::StateVariable* _stateVariable = nullptr;
+    // Expires when the owning Component deallocates its variables or is
+    // destroyed; _stateVariable is only accessed while it is alive.
+    std::weak_ptr<const int> _token;
+};
+
+/** A handle to a discrete variable allocated by a Component, obtained with
+Component::getDiscreteVariableHandle(). See StateVariableHandle. */
+class DiscreteVariableHandle {
+public:
+    /** Create an unbound handle; isValid() returns false. */
+    DiscreteVariableHandle() = default;
+
+    /** Whether the handle is bound to a discrete variable that is still
+    allocated in the owning Component's System. */
+    bool isValid() const {
+        return !_token.expired();
+    }
+    /** Get the value of the discrete variable in the provided State. */
+    double getValue(const SimTK::State& state) const {
+        checkValid();
+        return SimTK::Value<double>::downcast(
+            _component->getDefaultSubsystem().getDiscreteVariable(
+                    state, _index)).get();
+    }
+    /** %Set the value of the discrete variable in the provided State. */
+    void setValue(SimTK::State& state, double value) const {
+        checkValid();
+        SimTK::Value<double>::downcast(
+            _component->getDefaultSubsystem().updDiscreteVariable(
+                    state, _index)).upd() = value;
+    }
+
+private:
+    friend class Component;
+    DiscreteVariableHandle(const Component& component,
+            SimTK::DiscreteVariableIndex index) :
+        _component(&component), _index(index),
+        _token(component._stateAllocationsToken) {}
+
+    void checkValid() const {
+        OPENSIM_THROW_IF(!isValid(), Exception,
+            "DiscreteVariableHandle is not bound to a discrete variable, or "
+            "the System of the variable's Component has been rebuilt.");
+    }
+
+    const Component* _component = nullptr;
+    SimTK::DiscreteVariableIndex _index;
+    std::weak_ptr<const int> _token;
+};
+
+/** A handle to a cache variable of type `T` allocated by a Component,
+obtained with Component::getCacheVariableHandle(). The methods mirror
+Component's cache variable accessors (e.g., getValue() corresponds to
+Component::getCacheVariableValue()). See StateVariableHandle. */
+template <typename T>
+class CacheVariableHandle {
+public:
+    /** Create an unbound handle; isValid() returns false. */
+    CacheVariableHandle() = default;
+
+    /** Whether the handle is bound to a cache variable that is still
+    allocated in the owning Component's System. */
+    bool isValid() const {
+        return !_token.expired();
+    }
+    /** Get a const reference to the value of the cache variable. */
+    const T& getValue(const SimTK::State& state) const {
+        checkValid();
+        return SimTK::Value<T>::downcast(
+            _component->getDefaultSubsystem().getCacheEntry(
+                    state, _index)).get();
+    }
+    /** Get a writable reference to the value of the cache variable. Call
+    markValueValid() once the value has been updated. */
+    T& updValue(const SimTK::State& state) const {
+        checkValid();
+        return SimTK::Value<T>::downcast(
+            _component->getDefaultSubsystem().updCacheEntry(
+                    state, _index)).upd();
+    }
+    /** %Set the value of the cache variable and mark it valid. */
+    void setValue(const SimTK::State& state, const T& value) const {
+        updValue(state) = value;
+        _component->getDefaultSubsystem().markCacheValueRealized(
+                state, _index);
+    }
+    /** Whether the value of the cache variable is valid in `state`. */
+    bool isValueValid(const SimTK::State& state) const {
+        checkValid();
+        return _component->getDefaultSubsystem().isCacheValueRealized(
+                state, _index);
+    }
+    /** Mark the value of the cache variable as valid in `state`. */
+    void markValueValid(const SimTK::State& state) const {
+        checkValid();
+        _component->getDefaultSubsystem().markCacheValueRealized(
+                state, _index);
+    }
+    /** Mark the value of the cache variable as invalid in `state`. */
+    void markValueInvalid(const SimTK::State& state) const {
+        checkValid();
+        _component->getDefaultSubsystem().markCacheValueNotRealized(
+                state, _index);
+    }
+
+private:
+    friend class Component;
+    CacheVariableHandle(const Component& component,
+            SimTK::CacheEntryIndex index) :
+        _component(&component), _index(index),
+        _token(component._stateAllocationsToken) {}
+
+    void checkValid() const {
+        OPENSIM_THROW_IF(!isValid(), Exception,
+            "CacheVariableHandle is not bound to a cache variable, or the "
+            "System of the variable's Component has been rebuilt.");
+    }
+
+    const Component* _component = nullptr;
+    SimTK::CacheEntryIndex _index;
+    std::weak_ptr<const int> _token;
+};
+
+template<typename T> CacheVariableHandle<T>
+Component::getCacheVariableHandle(const std::string& name) const
+{
+    // Must have already called initSystem.
+    OPENSIM_THROW_IF_FRMOBJ(!hasSystem(), ComponentHasNoSystem);
+
+    auto it = _namedCacheVariableInfo.find(name);
+    OPENSIM_THROW_IF_FRMOBJ(it == _namedCacheVariableInfo.end(), Exception,
+        "Cache variable '" + name + "' not found.");
+    OPENSIM_THROW_IF_FRMOBJ(
+        !dynamic_cast<const SimTK::Value<T>*>(it->second.prototype.get()),
+        Exception,
+        "Cache variable '" + name + "' is not of the requested type.");
+    OPENSIM_THROW_IF_FRMOBJ(!it->second.index.isValid(), Exception,
+        "Cache variable '" + name + "' has not been allocated.");
+    return CacheVariableHandle<T>(*this, it->second.index);
+}
+#endif
     
 // Implement methods for ComponentListIterator
 /// ComponentListIterator<T> pre-increment operator, advances the iterator to
@@ -36,9 +36,13 @@
 
 #include <functional>
 #include <map>
+#include <memory>
+#include <vector>
 
 #include <SimTKcommon/internal/Stage.h>
 #include <SimTKcommon/internal/State.h>
+#include <SimTKcommon/internal/Subsystem.h>
+#include <SimTKcommon/internal/Value.h>
 
 namespace OpenSim {
 
@@ -68,6 +72,53 @@ public:
 };
 
 
+#ifndef SWIG
+/** Storage, held in a SimTK::State, for the values of the Outputs of a
+Component; see Output::getValue(). Each Output channel has a slot that holds
+its most recent value and the stage versions of the State from which the
+value was computed. A copy of a State starts with an empty cache, so that
+copying States does not copy the Output values. @internal */
+class OutputValueCache {
+public:
+    struct AbstractEntry {
+        virtual ~AbstractEntry() = default;
+    };
+    template <class T>
+    struct Entry : AbstractEntry {
+        T value;
+        // Stage versions of the State when the value was computed; empty if
+        // the value cannot be reused.
+        SimTK::Array_<SimTK::StageVersion> versions;
+    };
+
+    OutputValueCache() = default;
+    OutputValueCache(const OutputValueCache&) {}
+    OutputValueCache& operator=(const OutputValueCache&) {
+        _entries.clear();
+        return *this;
+    }
+
+    /** Get the entry in the given slot, creating it if necessary. */
+    template <class T>
+    Entry<T>& updEntry(int slot) {
+        if (slot >= (int)_entries.size()) _entries.resize(slot + 1);
+        std::unique_ptr<AbstractEntry>& entry = _entries[slot];
+        if (!entry) entry.reset(new Entry<T>());
+        return static_cast<Entry<T>&>(*entry);
+    }
+
+    friend std::ostream& operator<<(std::ostream& o,
+            const OutputValueCache&) {
+        o << "OpenSim::OutputValueCache should not be serialized!"
+          << std::endl;
+        return o;
+    }
+
+private:
+    std::vector<std::unique_ptr<AbstractEntry>> _entries;
+};
+#endif
+
 //=============================================================================
 //                           OPENSIM COMPONENT OUTPUT
 //=============================================================================
@@ -151,8 +202,22 @@ protected:
         _owner.reset(&owner);
     }
 
+    // Set where the values of this Output's channels are stored: the slots
+    // starting at firstSlot of the OutputValueCache in the given cache entry.
+    // This is invoked by the owner when it allocates its State resources.
+    // Returns the number of slots used.
+    virtual int setValueStorage(const SimTK::Subsystem& subsystem,
+            SimTK::CacheEntryIndex index, int firstSlot) const = 0;
+    // Stop using the State to store the values of this Output.
+    void clearValueStorage() const { _valueSubsystem.reset(); }
+
     SimTK::ReferencePtr<const Component> _owner;
 
+    // The OutputValueCache that holds the values of this Output. These are
+    // reset when the Output is copied, since the copy has a different owner.
+    mutable SimTK::ReferencePtr<const SimTK::Subsystem> _valueSubsystem;
+    mutable SimTK::CacheEntryIndex _valueIndex;
+
 private:
     std::string name;
     SimTK::Stage dependsOnStage;
@@ -276,7 +341,16 @@ public:
     //--------------------------------------------------------------------------
     /** Return the Value of this output if the state is appropriately realized   
         to a stage at or beyond the dependsOnStage, otherwise expect an
-        Exception. */
+        Exception.
+
+        Once the owning Component is part of a System, the value is stored in
+        the provided State, so that Outputs can be evaluated concurrently by
+        threads that use different States. If the State is realized to
+        Stage::Acceleration or beyond, the value is computed only once: all
+        callers (e.g., several reporters) receive the same value until one of
+        the State's stages up to Acceleration is invalidated. The returned
+        reference is valid until the Output is evaluated again with the same
+        State. */
     const T& getValue(const SimTK::State& state) const {
         if (isListOutput()) {
             throw Exception("Cannot get value for list Output. "
@@ -288,8 +362,8 @@ public:
                     state.getSystemStage(), getDependsOnStage(),
                     "Output::getValue(state)");
         }
-        _outputFcn(_owner.get(), state, "", _result);
-        return _result;
+        // A single-value Output has exactly one channel.
+        return _channels.begin()->second.getValue(state);
     }
     
     std::string getTypeName() const override {
@@ -317,7 +391,42 @@ public:
     }
 
 private:
-    mutable T _result;
+    int setValueStorage(const SimTK::Subsystem& subsystem,
+            SimTK::CacheEntryIndex index, int firstSlot) const override {
+        _valueSubsystem.reset(&subsystem);
+        _valueIndex = index;
+        int slot = firstSlot;
+        for (const auto& it : _channels) it.second._slot = slot++;
+        return slot - firstSlot;
+    }
+
+    // Evaluate a channel of this Output. The value is reused if it was
+    // computed from this State after the State was realized to Acceleration,
+    // and none of the State's stages up to Acceleration has changed since.
+    // Otherwise, the value is recomputed and stored in the State (or in
+    // `result` if this Output has no storage in the State).
+    const T& evaluate(const SimTK::State& state,
+            const std::string& channelName, int slot, T& result) const {
+        if (_valueSubsystem.empty() || slot < 0) {
+            _outputFcn(_owner.get(), state, channelName, result);
+            return result;
+        }
+        OutputValueCache& cache = SimTK::Value<OutputValueCache>::updDowncast(
+                _valueSubsystem->updCacheEntry(state, _valueIndex)).upd();
+        OutputValueCache::Entry<T>& entry = cache.template updEntry<T>(slot);
+        const bool reusable =
+                state.getSystemStage() >= SimTK::Stage::Acceleration;
+        if (reusable && !entry.versions.empty() &&
+                state.getLowestSystemStageDifference(entry.versions) >
+                        SimTK::Stage::Acceleration) {
+            return entry.value;
+        }
+        _outputFcn(_owner.get(), state, channelName, entry.value);
+        if (reusable) state.getSystemStageVersions(entry.versions);
+        else          entry.versions.clear();
+        return entry.value;
+    }
+
     std::function<void (const Component*,
                         const SimTK::State&,
                         const std::string& channel,
@@ -336,10 +445,9 @@ public:
     Channel() = default;
     Channel(const Output<T>* output, const std::string& channelName)
      : _output(output), _channelName(channelName) {}
+    /** Return the value of this channel; see Output::getValue(). */
     const T& getValue(const SimTK::State& state) const {
-        // Must cache, since we're returning a reference.
-        _output->_outputFcn(_output->_owner.get(), state, _channelName, _result);
-        return _result;
+        return _output->evaluate(state, _channelName, _slot, _result);
     }
     const Output<T>& getOutput() const { return _output.getRef(); }
     const std::string& getChannelName() const override {
@@ -357,11 +465,16 @@ public:
         return getOutput().getOwner().getAbsolutePathString() + "|" + getName();
     }
 private:
+    // Holds the value if it cannot be stored in the State.
     mutable T _result;
     SimTK::ReferencePtr<const Output<T>> _output;
     std::string _channelName;
+    // This channel's slot in the OutputValueCache; see setValueStorage().
+    mutable int _slot = -1;
     
 #ifndef SWIG // These declarations cause a warning in SWIG.
+    // To allow Output<T> to assign the slot.
+    friend class Output<T>;
     // To allow Output<T> to set the _output pointer upon copy.
     friend Output<T>::Output(const Output&);
     friend Output<T>& Output<T>::operator=(const Output&);
@@ -420,6 +420,15 @@ public:
         // No operation.
     }
 
+    /** Get the index of the row whose entry in the independent column is
+    equal to the given value, or the number of rows if there is no such row.
+    Derived classes whose independent column is sorted can override this
+    function with a faster search.                                            */
+    virtual size_t findRowIndex(const ETX& ind) const {
+        return static_cast<size_t>(std::distance(_indData.cbegin(),
+                std::find(_indData.cbegin(), _indData.cend(), ind)));
+    }
+
     /** Copy assign a DataTable_<double, double> from 
     DataTable_<double, ThatETY> where ThatETY can be SimTK::Vec<X>. Each column
     of the other table is split into multiple columns of this table. For example
@@ -662,15 +671,69 @@ public:
                              static_cast<size_t>(depRow.ncol()));
         }
 
+        // The matrix grows geometrically, so that appending n rows one at a
+        // time takes O(n) copies of rows rather than O(n^2).
+        const int numRows = static_cast<int>(_indData.size());
+        // The room reserved by reserveRows() is the capacity of _indData.
+        const int capacity = static_cast<int>(_indData.capacity());
+        if(numRows == 0 && _depData.ncol() != depRow.size())
+            _depData.resize(std::max({_depData.nrow(), capacity, 1}),
+                            depRow.size());
+        else if(numRows == _depData.nrow())
+            _depData.resizeKeep(std::max({2 * numRows, capacity, 1}),
+                                _depData.ncol());
+
+        _depData.updRow(numRows) = depRow;
         _indData.push_back(indRow);
+    }
 
-        if(_depData.nrow() == 0) {
-            _depData.resize(1, depRow.size());
+    /** Append rows to the DataTable_. The rows are validated as by
+    appendRow(); if a row is invalid, none of the rows are appended.
+
+    \throws InvalidArgument If the length of indColumn does not match the
+                            number of rows of depData.
+    \throws IncorrectNumColumns If a row added is invalid. Validity of the 
+    row added is decided by the derived class.                                */
+    void appendRows(const std::vector<ETX>& indColumn,
+                    const SimTK::MatrixBase<ETY>& depData) {
+        OPENSIM_THROW_IF(indColumn.size() !=
+                         static_cast<size_t>(depData.nrow()),
+                         InvalidArgument,
+                         "Length of independent column does not match number "
+                         "of rows of dependent data.");
+        if(indColumn.empty())
+            return;
+
+        // Grow geometrically, as appendRow() does, so that appending many
+        // small blocks of rows stays linear in the number of rows.
+        const size_t numRows = _indData.size();
+        if(getRowCapacity() < numRows + indColumn.size())
+            reserveRows(std::max(numRows + indColumn.size(), 2 * numRows));
+        try {
+            for(size_t r = 0; r < indColumn.size(); ++r)
+                appendRow(indColumn[r], depData.row(static_cast<int>(r)));
+        } catch(...) {
+            _indData.resize(numRows);
+            throw;
         }
-        else 
-            _depData.resizeKeep(_depData.nrow() + 1, _depData.ncol());
-            
-        _depData.updRow(_depData.nrow() - 1) = depRow;
+    }
+
+    /** Make room for the given number of rows, so that rows can be appended
+    up to that number without reallocating the underlying matrix. If the table
+    has no rows yet, the matrix is allocated when the first row is appended.
+    Views of the rows, columns and matrix of the table are invalidated when
+    the matrix is reallocated.                                                */
+    void reserveRows(size_t numRows) {
+        _indData.reserve(numRows);
+        if(!_indData.empty() && numRows > static_cast<size_t>(_depData.nrow()))
+            _depData.resizeKeep(static_cast<int>(numRows), _depData.ncol());
+    }
+
+    /** Get the number of rows that can be appended without reallocating the
+    underlying matrix. See reserveRows().                                     */
+    size_t getRowCapacity() const {
+        return _indData.empty() ? _indData.capacity() :
+                                  static_cast<size_t>(_depData.nrow());
     }
 
     /** Get row at index.                                                     
@@ -692,12 +755,12 @@ public:
     \throws KeyNotFound If the independent column has no entry with given
                         value.                                                */
     const RowVectorView getRow(const ETX& ind) const {
-        auto iter = std::find(_indData.cbegin(), _indData.cend(), ind);
+        const size_t index = findRowIndex(ind);
 
-        OPENSIM_THROW_IF(iter == _indData.cend(),
+        OPENSIM_THROW_IF(index == _indData.size(),
                          KeyNotFound, std::to_string(ind));
 
-        return _depData.row((int)std::distance(_indData.cbegin(), iter));
+        return _depData.row((int)index);
     }
 
     /** Update row at index.                                                  
@@ -719,12 +782,12 @@ public:
     \throws KeyNotFound If the independent column has no entry with given
                         value.                                                */
     RowVectorView updRow(const ETX& ind) {
-        auto iter = std::find(_indData.cbegin(), _indData.cend(), ind);
+        const size_t index = findRowIndex(ind);
 
-        OPENSIM_THROW_IF(iter == _indData.cend(),
+        OPENSIM_THROW_IF(index == _indData.size(),
                          KeyNotFound, std::to_string(ind));
 
-        return _depData.updRow((int)std::distance(_indData.cbegin(), iter));
+        return _depData.updRow((int)index);
     }
 
     /** Set row at index. Equivalent to
@@ -789,7 +852,7 @@ public:
             for(size_t r = index; r < getNumRows() - 1; ++r)
                 _depData.updRow((int)r) = _depData.row((int)(r + 1));
         
-        _depData.resizeKeep(_depData.nrow() - 1, _depData.ncol());
+        // The last row of the matrix is kept as room for appending rows.
         _indData.erase(_indData.begin() + index);
     }
 
@@ -798,12 +861,12 @@ public:
     \throws KeyNotFound If the independent column has no entry with the given
                         value.                                                */
     void removeRow(const ETX& ind) {
-        auto iter = std::find(_indData.cbegin(), _indData.cend(), ind);
+        const size_t index = findRowIndex(ind);
 
-        OPENSIM_THROW_IF(iter == _indData.cend(),
+        OPENSIM_THROW_IF(index == _indData.size(),
                          KeyNotFound, std::to_string(ind));
 
-        return removeRowAtIndex((int)std::distance(_indData.cbegin(), iter));
+        return removeRowAtIndex(index);
     }
 
     /// @} End of Row accessors/mutators.
@@ -943,7 +1006,8 @@ public:
                          static_cast<size_t>(getNumRows()),
                          static_cast<size_t>(depCol.nrow()));
         
-        _depData.resizeKeep(_depData.nrow(), _depData.ncol() + 1);
+        _depData.resizeKeep(static_cast<int>(getNumRows()),
+                            _depData.ncol() + 1);
         _depData.updCol(_depData.ncol() - 1) = depCol;
         appendColumnLabel(columnLabel);
     }
@@ -978,13 +1042,7 @@ public:
     \throws KeyNotFound If the independent column has no entry with the given
     value.                                                */
     void removeColumn(const std::string& columnLabel) {
-        const auto& labels = getColumnLabels();
-        auto iter = std::find(labels.cbegin(), labels.cend(), columnLabel);
-
-        OPENSIM_THROW_IF(iter == labels.cend(),
-            KeyNotFound, columnLabel);
-
-        return removeColumnAtIndex(std::distance(labels.cbegin(), iter));
+        return removeColumnAtIndex(getColumnIndex(columnLabel));
     }
 
     /** Get dependent column at index.
@@ -998,7 +1056,8 @@ public:
                          ColumnIndexOutOfRange, index, 0,
                          static_cast<size_t>(_depData.ncol() - 1));
 
-        return _depData.col(static_cast<int>(index));
+        return _depData.col(static_cast<int>(index))
+                       .block(0, static_cast<int>(getNumRows()));
     }
 
     /** Get dependent Column which has the given column label.                
@@ -1006,7 +1065,8 @@ public:
     \throws KeyNotFound If columnLabel is not found to be label of any existing
                         column.                                               */
     VectorView getDependentColumn(const std::string& columnLabel) const {
-        return _depData.col(static_cast<int>(getColumnIndex(columnLabel)));
+        return _depData.col(static_cast<int>(getColumnIndex(columnLabel)))
+                       .block(0, static_cast<int>(getNumRows()));
     }
 
     /** Update dependent column at index.
@@ -1020,7 +1080,8 @@ public:
                          ColumnIndexOutOfRange, index, 0,
                          static_cast<size_t>(_depData.ncol() - 1));
 
-        return _depData.updCol(static_cast<int>(index));
+        return _depData.updCol(static_cast<int>(index))
+                       .updBlock(0, static_cast<int>(getNumRows()));
     }
 
     /** Update dependent Column which has the given column label.
@@ -1028,7 +1089,8 @@ public:
     \throws KeyNotFound If columnLabel is not found to be label of any existing
                         column.                                               */
     VectorView updDependentColumn(const std::string& columnLabel) {
-        return _depData.updCol(static_cast<int>(getColumnIndex(columnLabel)));
+        return _depData.updCol(static_cast<int>(getColumnIndex(columnLabel)))
+                       .updBlock(0, static_cast<int>(getNumRows()));
     }
 
     /** %Set value of the independent column at index.
@@ -1055,9 +1117,11 @@ public:
     /// column.
     /// @{
 
-    /** Get a read-only view to the underlying matrix.                        */
-    const MatrixView& getMatrix() const {
-        return _depData.getAsMatrixView();
+    /** Get a read-only view to the underlying matrix. The view is
+    invalidated when rows are appended beyond getRowCapacity().              */
+    MatrixView getMatrix() const {
+        return _depData.block(0, 0, static_cast<int>(getNumRows()),
+                              _depData.ncol());
     }
 
     /** Get a read-only view of a block of the underlying matrix.             
@@ -1079,11 +1143,11 @@ public:
         OPENSIM_THROW_IF(isRowIndexOutOfRange(rowStart),
                          RowIndexOutOfRange,
                          rowStart, 0, 
-                         static_cast<unsigned>(_depData.nrow() - 1));
+                         static_cast<unsigned>(_indData.size() - 1));
         OPENSIM_THROW_IF(isRowIndexOutOfRange(rowStart + numRows - 1),
                          RowIndexOutOfRange,
                          rowStart + numRows - 1, 0, 
-                         static_cast<unsigned>(_depData.nrow() - 1));
+                         static_cast<unsigned>(_indData.size() - 1));
         OPENSIM_THROW_IF(isColumnIndexOutOfRange(columnStart),
                          ColumnIndexOutOfRange,
                          columnStart, 0, 
@@ -1099,9 +1163,11 @@ public:
                               static_cast<int>(numColumns));
     }
 
-    /** Get a writable view to the underlying matrix.                         */
-    MatrixView& updMatrix() {
-        return _depData.updAsMatrixView();
+    /** Get a writable view to the underlying matrix. The view is
+    invalidated when rows are appended beyond getRowCapacity().              */
+    MatrixView updMatrix() {
+        return _depData.updBlock(0, 0, static_cast<int>(getNumRows()),
+                                 _depData.ncol());
     }
 
     /** Get a writable view of a block of the underlying matrix.
@@ -1123,11 +1189,11 @@ public:
         OPENSIM_THROW_IF(isRowIndexOutOfRange(rowStart),
                          RowIndexOutOfRange,
                          rowStart, 0, 
-                         static_cast<unsigned>(_depData.nrow() - 1));
+                         static_cast<unsigned>(_indData.size() - 1));
         OPENSIM_THROW_IF(isRowIndexOutOfRange(rowStart + numRows - 1),
                          RowIndexOutOfRange,
                          rowStart + numRows - 1, 0, 
-                         static_cast<unsigned>(_depData.nrow() - 1));
+                         static_cast<unsigned>(_indData.size() - 1));
         OPENSIM_THROW_IF(isColumnIndexOutOfRange(columnStart),
                          ColumnIndexOutOfRange,
                          columnStart, 0, 
@@ -1318,7 +1384,7 @@ protected:
             rowData.push_back(toStr(getIndependentColumn()[row]));
             for(const auto& col : cols)
                 for(const auto& comp :
-                        splitElement(getMatrix().getElt(row, col)))
+                        splitElement(_depData.getElt(row, col)))
                         rowData.push_back(toStr(comp));
             table.push_back(std::move(rowData));
         }
@@ -1557,7 +1623,8 @@ protected:
 
     /** Get number of rows.                                                   */
     size_t implementGetNumRows() const override {
-        return _depData.nrow();
+        // _depData may have more rows, as room for appending rows.
+        return _indData.size();
     }
 
     /** Get number of columns.                                                */
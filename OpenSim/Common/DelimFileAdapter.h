@@ -28,9 +28,15 @@
 #include "FileAdapter.h"
 #include "TimeSeriesTable.h"
 #include "OpenSim/Common/IO.h"
+#include "TextRowWriter.h"
 
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstring>
 #include <string>
 #include <fstream>
+#include <limits>
 #include <regex>
 
 namespace OpenSim {
@@ -120,6 +126,10 @@ protected:
     /** Implementation of the read functionality.                             */
     OutputTables extendRead(const std::string& filename) const override;
 
+    /** Read the rows of a file a chunk at a time.                            */
+    std::unique_ptr<FileAdapter::ChunkSource>
+    extendOpenChunkSource(const std::string& filename) const override;
+
     /** Implementation of the write functionality.                            */
     void extendWrite(const InputTables& tables,
                      const std::string& filename) const override;
@@ -129,13 +139,17 @@ protected:
     inline SimTK::RowVector_<T> 
     readElems(const std::vector<std::string>& tokens) const;
 
-    /** Write an element of type T (template parameter) to stream with the
-    specified precision.                                                      */
-    inline void writeElem(std::ostream& stream, 
-                          const T& elem,
-                          const unsigned& prec) const;
+    /** Append an element of type T (template parameter) to buffer with the
+    specified precision, formatted as a stream with that precision formats
+    it.                                                                       */
+    inline void appendElem(std::string& buffer,
+                           const T& elem,
+                           const unsigned& prec) const;
 
 private:
+    /** Implements extendRead() and extendOpenChunkSource().                  */
+    class DelimChunkSource;
+
     /** Following overloads implement dataTypeName().                         */
     static inline std::string dataTypeName_impl(double);
     static inline std::string dataTypeName_impl(SimTK::UnitVec3);
@@ -162,17 +176,58 @@ private:
     readElems_impl(const std::vector<std::string>& tokens,
                    SimTK::Vec<M>) const;
 
-    /** Following overloads implement writeElem().                            */
-    inline void writeElem_impl(std::ostream& stream,
-                               const double& elem,
-                               const unsigned& prec) const;
-    inline void writeElem_impl(std::ostream& stream,
-                               const SimTK::SpatialVec& elem,
-                               const unsigned& prec) const;
+    /** Set of characters, used to find delimiters while scanning a line.    */
+    using CharSet = std::array<bool, 256>;
+    static CharSet makeCharSet(const std::string& chars);
+    /** Whitespace trimmed from tokens (see IO::TrimWhitespace()).          */
+    static bool isWhitespace(char ch) {
+        return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n';
+    }
+
+    /** Read the line in the character range [begin, end) (without its line
+    ending) into row `rowIndex` of `matrix` and return the time in the line.
+    Tokens are split and trimmed the same way as tokenize() does, but are
+    parsed in place.                                                          */
+    double readRow(const char* begin, const char* end,
+                   const CharSet& delims, const CharSet& compDelims,
+                   SimTK::Matrix_<T>& matrix, int rowIndex,
+                   const std::string& fileName, size_t line_num) const;
+
+    /** Read an element of type T from the character range [begin, end).
+    Returns false if the number of components is not right for T.            */
+    static bool readElem(const char* begin, const char* end,
+                         const CharSet& compDelims, T& elem);
+
+    /** Following overloads give the number of components of an element and
+    create an element from its components.                                   */
+    static int numComponents_impl(double) { return 1; }
+    static int numComponents_impl(SimTK::UnitVec3) { return 3; }
+    static int numComponents_impl(SimTK::Quaternion) { return 4; }
+    static int numComponents_impl(SimTK::SpatialVec) { return 6; }
+    template<int M>
+    static int numComponents_impl(SimTK::Vec<M>) { return M; }
+    static inline void assignElem_impl(const double* comps, double& elem);
+    static inline void assignElem_impl(const double* comps,
+                                       SimTK::UnitVec3& elem);
+    static inline void assignElem_impl(const double* comps,
+                                       SimTK::Quaternion& elem);
+    static inline void assignElem_impl(const double* comps,
+                                       SimTK::SpatialVec& elem);
+    template<int M>
+    static inline void assignElem_impl(const double* comps,
+                                       SimTK::Vec<M>& elem);
+
+    /** Following overloads implement appendElem().                           */
+    inline void appendElem_impl(std::string& buffer,
+                                const double& elem,
+                                const unsigned& prec) const;
+    inline void appendElem_impl(std::string& buffer,
+                                const SimTK::SpatialVec& elem,
+                                const unsigned& prec) const;
     template<int M>
-    inline void writeElem_impl(std::ostream& stream,
-                               const SimTK::Vec<M>& elem,
-                               const unsigned& prec) const;
+    inline void appendElem_impl(std::string& buffer,
+                                const SimTK::Vec<M>& elem,
+                                const unsigned& prec) const;
       
     /** Trim string -- remove specified leading and trailing characters from 
     string. Trims out whitespace by default.                                  */
@@ -305,35 +360,60 @@ DelimFileAdapter<T>::clone() const {
 }
 
 template<typename T>
-typename DelimFileAdapter<T>::OutputTables
-DelimFileAdapter<T>::extendRead(const std::string& fileName) const {
-    OPENSIM_THROW_IF(fileName.empty(),
-                     EmptyFileName);
+class DelimFileAdapter<T>::DelimChunkSource :
+        public FileAdapter::ChunkSource {
+public:
+    DelimChunkSource(const DelimFileAdapter& adapter,
+                     const std::string& fileName);
 
-    std::ifstream in_stream{fileName};
-    OPENSIM_THROW_IF(!in_stream.good(),
-                     FileDoesNotExist,
-                     fileName);
-    
-    OPENSIM_THROW_IF(in_stream.peek() == std::ifstream::traits_type::eof(),
+    const AbstractDataTable& getHeader() const override { return _header; }
+
+    bool readChunk(AbstractDataTable& chunk, size_t maxRows) override;
+
+private:
+    /** Get the range of the next line (without the line ending). Returns
+    false at the end of the file.                                             */
+    bool nextLineRange(const char*& lineBegin, const char*& lineEnd);
+
+    // Copy of the adapter, which may not outlive the source.
+    const DelimFileAdapter  _adapter;
+    const std::string       _fileName;
+    // The whole file is scanned in place.
+    const MappedFile        _file;
+    const char*             _pos;
+    const char* const       _end;
+    size_t                  _lineNum{};
+    const CharSet           _delims;
+    const CharSet           _compDelims;
+    TimeSeriesTable_<T>     _header;
+    bool                    _finished{false};
+};
+
+template<typename T>
+DelimFileAdapter<T>::DelimChunkSource::DelimChunkSource(
+        const DelimFileAdapter& adapter, const std::string& fileName) :
+    _adapter(adapter),
+    _fileName(fileName),
+    _file(fileName),
+    _pos(_file.begin()),
+    _end(_file.end()),
+    _delims(makeCharSet(adapter._delimitersRead)),
+    _compDelims(makeCharSet(adapter._compDelimRead)) {
+    OPENSIM_THROW_IF(_file.size() == 0,
                      FileIsEmpty,
                      fileName);
 
-    size_t line_num{};
     // All the lines until "endheader" is header.
     std::regex endheader{R"([ \t]*)" + _endHeaderString + R"([ \t]*)"};
     std::regex keyvalue{R"((.*)=(.*))"};
     std::string header{};
     std::string line{};
     ValueArrayDictionary keyValuePairs;
-    while(std::getline(in_stream, line)) {
-        ++line_num;
-
-        // We might be parsing a file with CRLF (\r\n) line endings on a
-        // platform that uses only LF (\n) line endings, in which case the \r
-        // is part of `line` and we must remove it manually.
-        if (!line.empty() && line.back() == '\r') 
-            line.pop_back();
+    const char* lineBegin{};
+    const char* lineEnd{};
+    while(nextLineRange(lineBegin, lineEnd)) {
+        ++_lineNum;
+        line.assign(lineBegin, lineEnd);
 
         if(std::regex_match(line, endheader))
             break;
@@ -373,19 +453,16 @@ DelimFileAdapter<T>::extendRead(const std::string& fileName) const {
     }
     keyValuePairs.setValueForKey("header", header);
 
-    // Callable to get the next line in form of vector of tokens.
-    auto nextLine = [&] {
-        return getNextLine(in_stream, _delimitersRead);
-    };
-
     // Read the line containing column labels and fill up the column labels
     // container.
     std::vector<std::string> column_labels{};
-    while (column_labels.size() == 0) { // keep going down rows to find labels
-        column_labels = nextLine();
+    // keep going down rows to find labels
+    while (column_labels.size() == 0 && nextLineRange(lineBegin, lineEnd)) {
+        column_labels = tokenize(std::string{lineBegin, lineEnd},
+                                 adapter._delimitersRead);
         // for labels we never expect empty elements, so remove them
         IO::eraseEmptyElements(column_labels);
-        ++line_num;
+        ++_lineNum;
     }
 
     OPENSIM_THROW_IF(column_labels.size() == 0, Exception,
@@ -400,60 +477,103 @@ DelimFileAdapter<T>::extendRead(const std::string& fileName) const {
                      column_labels[0]);
     column_labels.erase(column_labels.begin());
 
-    // Read the rows one at a time and fill up the time column container and
-    // the data container. Start with a reasonable initial capacity for
-    // tradeoff between a small file and larger files. 100 worked well for
-    // a 50 MB file with ~80000 lines.
-    std::vector<double> timeVec;
-    int initCapacity = 100;
-    int ncol = static_cast<int>(column_labels.size());
-    timeVec.reserve(initCapacity);
-    SimTK::Matrix_<T> matrix(initCapacity, ncol);
-    
-    // Initialize current row and capacity
-    int curCapacity = initCapacity;
-    int curRow = 0;
-
-    // Start looping through each line
-    auto row = nextLine();
-    while (!row.empty()) {
-        ++line_num;
-        
-        // Double capacity if we reach the end of the containers.
-        // This is necessary until Simbody issue #401 is addressed.
-        if (curRow+1 > curCapacity) {
-            curCapacity *= 2;
-            timeVec.reserve(curCapacity);
-            matrix.resizeKeep(curCapacity, ncol);
-        }
-
-        // Time is column 0.
-        timeVec.push_back(std::stod(row.front()));
-        row.erase(row.begin());
+    const int ncol = static_cast<int>(column_labels.size());
+    _header = TimeSeriesTable_<T>{std::vector<double>{},
+                                  SimTK::Matrix_<T>(0, ncol),
+                                  column_labels};
+    _header.updTableMetaData() = keyValuePairs;
+}
 
-        auto row_vector = readElems(row);
+template<typename T>
+bool
+DelimFileAdapter<T>::DelimChunkSource::nextLineRange(const char*& lineBegin,
+                                                     const char*& lineEnd) {
+    if(_pos == _end)
+        return false;
+    lineBegin = _pos;
+    auto eol = static_cast<const char*>(std::memchr(_pos, '\n',
+                                                    _end - _pos));
+    lineEnd = eol ? eol : _end;
+    _pos = eol ? eol + 1 : _end;
+    // We might be parsing a file with CRLF (\r\n) line endings, in which
+    // case the \r must be removed.
+    if(lineEnd != lineBegin && *(lineEnd - 1) == '\r')
+        --lineEnd;
+    return true;
+}
 
-        OPENSIM_THROW_IF(row_vector.size() != column_labels.size(),
-            RowLengthMismatch,
-            fileName,
-            line_num,
-            column_labels.size(),
-            static_cast<size_t>(row_vector.size()));
-        
-        matrix.updRow(curRow) = std::move(row_vector);
+template<typename T>
+bool
+DelimFileAdapter<T>::DelimChunkSource::readChunk(AbstractDataTable& chunk,
+                                                 size_t maxRows) {
+    auto table = dynamic_cast<TimeSeriesTable_<T>*>(&chunk);
+    OPENSIM_THROW_IF(table == nullptr,
+                     IncorrectTableType,
+                     "File '" + _fileName + "' holds a table of " +
+                     dataTypeName() + ".");
+    *table = _header;
+    if(_finished)
+        return false;
+
+    // Each line holds at most one row, so the time column and the data
+    // container can be sized once from the number of lines in the chunk.
+    int maxRowsInChunk = 0;
+    for(const char* scan = _pos;
+        scan != _end && static_cast<size_t>(maxRowsInChunk) < maxRows;
+        ++maxRowsInChunk) {
+        auto eol = static_cast<const char*>(std::memchr(scan, '\n',
+                                                        _end - scan));
+        scan = eol ? eol + 1 : _end;
+    }
+    std::vector<double> timeVec;
+    const int ncol = static_cast<int>(_header.getNumColumns());
+    timeVec.reserve(maxRowsInChunk);
+    SimTK::Matrix_<T> matrix(maxRowsInChunk, ncol);
 
-        row = nextLine();
+    // Read the rows one at a time until the end of the chunk, the end of the
+    // file or an empty line.
+    int curRow = 0;
+    const char* lineBegin{};
+    const char* lineEnd{};
+    while(curRow < maxRowsInChunk) {
+        if(!nextLineRange(lineBegin, lineEnd) || lineBegin == lineEnd) {
+            _finished = true;
+            break;
+        }
+        ++_lineNum;
+        timeVec.push_back(_adapter.readRow(lineBegin, lineEnd,
+                                           _delims, _compDelims,
+                                           matrix, curRow,
+                                           _fileName, _lineNum));
         ++curRow;
     }
+    if(_pos == _end)
+        _finished = true;
+    if(curRow == 0)
+        return false;
+
+    // Resize the matrix down to the correct number of rows (only needed if
+    // the data ended before the end of the chunk).
+    if(curRow != maxRowsInChunk)
+        matrix.resizeKeep(curRow, ncol);
+
+    // Create the table and update other metadata from the header.
+    *table = TimeSeriesTable_<T>{timeVec, matrix,
+                                 _header.getColumnLabels()};
+    table->updTableMetaData() = _header.getTableMetaData();
+    return true;
+}
 
-    // Resize the matrix down to the correct number of rows.
-    // This is necessary until Simbody issue #401 is addressed.
-    matrix.resizeKeep(curRow, ncol);
+template<typename T>
+typename DelimFileAdapter<T>::OutputTables
+DelimFileAdapter<T>::extendRead(const std::string& fileName) const {
+    OPENSIM_THROW_IF(fileName.empty(),
+                     EmptyFileName);
 
-    // Create the table and update other metadata from above
-    auto table = 
-        std::make_shared<TimeSeriesTable_<T>>(timeVec, matrix, column_labels);
-    table->updTableMetaData() = keyValuePairs;
+    // The rows are read as a single chunk.
+    DelimChunkSource source{*this, fileName};
+    auto table = std::make_shared<TimeSeriesTable_<T>>();
+    source.readChunk(*table, std::numeric_limits<size_t>::max());
 
     OutputTables output_tables{};
     output_tables.emplace(tableString(), table);
@@ -461,6 +581,16 @@ DelimFileAdapter<T>::extendRead(const std::string& fileName) const {
     return output_tables;
 }
 
+template<typename T>
+std::unique_ptr<FileAdapter::ChunkSource>
+DelimFileAdapter<T>::extendOpenChunkSource(const std::string& fileName) const {
+    OPENSIM_THROW_IF(fileName.empty(),
+                     EmptyFileName);
+
+    return std::unique_ptr<FileAdapter::ChunkSource>{
+            new DelimChunkSource{*this, fileName}};
+}
+
 template<typename T>
 SimTK::RowVector_<T>
 DelimFileAdapter<T>::readElems(const std::vector<std::string>& tokens) const {
@@ -557,6 +687,168 @@ DelimFileAdapter<T>::readElems_impl(const std::vector<std::string>& tokens,
     return elems;
 }
   
+template<typename T>
+typename DelimFileAdapter<T>::CharSet
+DelimFileAdapter<T>::makeCharSet(const std::string& chars) {
+    CharSet set{};
+    for(const char ch : chars)
+        set[static_cast<unsigned char>(ch)] = true;
+    return set;
+}
+
+template<typename T>
+double
+DelimFileAdapter<T>::readRow(const char* begin, const char* end,
+                             const CharSet& delims, const CharSet& compDelims,
+                             SimTK::Matrix_<T>& matrix, int rowIndex,
+                             const std::string& fileName,
+                             size_t line_num) const {
+    const int ncol = matrix.ncol();
+    double time{};
+    T elem{};
+    // Number of elements read so far; the first token is the time.
+    int numElems = -1;
+    const char* tokenBegin = begin;
+    while(true) {
+        const char* tokenEnd = tokenBegin;
+        while(tokenEnd != end && !delims[static_cast<unsigned char>(*tokenEnd)])
+            ++tokenEnd;
+        const char* next = tokenEnd;
+
+        // Trim whitespace, as IO::TrimWhitespace() does.
+        while(tokenBegin != tokenEnd && isWhitespace(*tokenBegin))
+            ++tokenBegin;
+        while(tokenEnd != tokenBegin &&
+              isWhitespace(*(tokenEnd - 1)))
+            --tokenEnd;
+
+        if(numElems < 0) {
+            time = parseDouble(tokenBegin, tokenEnd);
+        } else {
+            if(!readElem(tokenBegin, tokenEnd, compDelims, elem))
+                break;
+            if(numElems < ncol)
+                matrix(rowIndex, numElems) = elem;
+        }
+        ++numElems;
+
+        // Like tokenize(), ignore an empty token after the last delimiter.
+        if(next == end || next + 1 == end) {
+            OPENSIM_THROW_IF(numElems != ncol,
+                             RowLengthMismatch,
+                             fileName,
+                             line_num,
+                             static_cast<size_t>(ncol),
+                             static_cast<size_t>(numElems));
+            return time;
+        }
+        tokenBegin = next + 1;
+    }
+
+    // An element had the wrong number of components. Read the line with
+    // tokenize() and readElems() to report the error.
+    auto row = tokenize(std::string{begin, end}, _delimitersRead);
+    time = std::stod(row.front());
+    row.erase(row.begin());
+
+    auto row_vector = readElems(row);
+
+    OPENSIM_THROW_IF(row_vector.size() != ncol,
+                     RowLengthMismatch,
+                     fileName,
+                     line_num,
+                     static_cast<size_t>(ncol),
+                     static_cast<size_t>(row_vector.size()));
+
+    matrix.updRow(rowIndex) = std::move(row_vector);
+    return time;
+}
+
+template<typename T>
+bool
+DelimFileAdapter<T>::readElem(const char* begin, const char* end,
+                              const CharSet& compDelims, T& elem) {
+    const int numComps = numComponents_impl(T{});
+    // Every supported element is made of doubles only, so its size gives
+    // the most components it can have.
+    static_assert(sizeof(T) % sizeof(double) == 0,
+                  "Elements must consist of doubles.");
+    constexpr int maxComps = static_cast<int>(sizeof(T) / sizeof(double));
+    assert(numComps <= maxComps);
+    // Split into components the same way tokenize() does, and only parse
+    // them once their number is known to be right.
+    const char* compBegins[maxComps];
+    const char* compEnds[maxComps];
+    int numFound = 0;
+    const char* compBegin = begin;
+    while(compBegin != end) {
+        const char* compEnd = compBegin;
+        while(compEnd != end &&
+              !compDelims[static_cast<unsigned char>(*compEnd)])
+            ++compEnd;
+        if(numFound == numComps)
+            return false;
+        compBegins[numFound] = compBegin;
+        compEnds[numFound] = compEnd;
+        ++numFound;
+        if(compEnd == end)
+            break;
+        compBegin = compEnd + 1;
+    }
+    if(numFound != numComps)
+        return false;
+
+    double comps[maxComps];
+    for(int i = 0; i < numComps; ++i) {
+        const char* b = compBegins[i];
+        const char* e = compEnds[i];
+        while(b != e && isWhitespace(*b))
+            ++b;
+        while(e != b && isWhitespace(*(e - 1)))
+            --e;
+        comps[i] = parseDouble(b, e);
+    }
+    assignElem_impl(comps, elem);
+    return true;
+}
+
+template<typename T>
+void
+DelimFileAdapter<T>::assignElem_impl(const double* comps, double& elem) {
+    elem = comps[0];
+}
+
+template<typename T>
+void
+DelimFileAdapter<T>::assignElem_impl(const double* comps,
+                                     SimTK::UnitVec3& elem) {
+    elem = SimTK::UnitVec3{comps[0], comps[1], comps[2]};
+}
+
+template<typename T>
+void
+DelimFileAdapter<T>::assignElem_impl(const double* comps,
+                                     SimTK::Quaternion& elem) {
+    elem = SimTK::Quaternion{comps[0], comps[1], comps[2], comps[3]};
+}
+
+template<typename T>
+void
+DelimFileAdapter<T>::assignElem_impl(const double* comps,
+                                     SimTK::SpatialVec& elem) {
+    elem = SimTK::SpatialVec{{comps[0], comps[1], comps[2]},
+                             {comps[3], comps[4], comps[5]}};
+}
+
+template<typename T>
+template<int M>
+void
+DelimFileAdapter<T>::assignElem_impl(const double* comps,
+                                     SimTK::Vec<M>& elem) {
+    for(int j = 0; j < M; ++j)
+        elem[j] = comps[j];
+}
+
 template<typename T>
 void
 DelimFileAdapter<T>::extendWrite(const InputTables& absTables, 
@@ -614,59 +906,62 @@ DelimFileAdapter<T>::extendWrite(const InputTables& absTables,
                       template getValue<std::string>();
     out_stream << "\n";
 
-    // Data rows.
-    for(unsigned row = 0; row < table->getNumRows(); ++row) {
-        constexpr auto prec = std::numeric_limits<double>::digits10 + 1;
-        out_stream << std::setprecision(prec)
-                   << table->getIndependentColumn()[row];
-        const auto& row_r = table->getRowAtIndex(row);
-        for(unsigned col = 0; col < table->getNumColumns(); ++col) {
-            const auto& elt = row_r[col];
-            out_stream << _delimiterWrite;
-            writeElem(out_stream, elt, prec);
-        }
-        out_stream << "\n";
-    }
+    // Data rows, formatted on several threads.
+    constexpr auto prec = std::numeric_limits<double>::digits10 + 1;
+    const auto& times = table->getIndependentColumn();
+    const auto matrix = table->getMatrix();
+    const int ncol = matrix.ncol();
+    TextRowWriter::write(out_stream, table->getNumRows(),
+            [&](size_t row, std::string& buffer) {
+                TextRowWriter::appendDouble(buffer, times[row], prec);
+                for(int col = 0; col < ncol; ++col) {
+                    buffer += _delimiterWrite;
+                    appendElem(buffer, matrix(int(row), col), prec);
+                }
+                buffer += '\n';
+            });
 }
 
 template<typename T>
 void
-DelimFileAdapter<T>::writeElem(std::ostream& stream,
-                               const T& elem,
-                               const unsigned& prec) const {
-    writeElem_impl(stream, elem, prec);
+DelimFileAdapter<T>::appendElem(std::string& buffer,
+                                const T& elem,
+                                const unsigned& prec) const {
+    appendElem_impl(buffer, elem, prec);
 }
 
 template<typename T>
 void
-DelimFileAdapter<T>::writeElem_impl(std::ostream& stream,
-                                    const double& elem,
-                                    const unsigned& prec) const {
-    stream << std::setprecision(prec) << elem;
+DelimFileAdapter<T>::appendElem_impl(std::string& buffer,
+                                     const double& elem,
+                                     const unsigned& prec) const {
+    TextRowWriter::appendDouble(buffer, elem, int(prec));
 }
 
 template<typename T>
 void
-DelimFileAdapter<T>::writeElem_impl(std::ostream& stream,
-                                    const SimTK::SpatialVec& elem,
-                                    const unsigned& prec) const {
-    stream                    << std::setprecision(prec) << elem[0][0]
-           << _compDelimWrite << std::setprecision(prec) << elem[0][1]
-           << _compDelimWrite << std::setprecision(prec) << elem[0][2]
-           << _compDelimWrite << std::setprecision(prec) << elem[1][0]
-           << _compDelimWrite << std::setprecision(prec) << elem[1][1]
-           << _compDelimWrite << std::setprecision(prec) << elem[1][2];
+DelimFileAdapter<T>::appendElem_impl(std::string& buffer,
+                                     const SimTK::SpatialVec& elem,
+                                     const unsigned& prec) const {
+    for(int i = 0; i < 2; ++i)
+        for(int j = 0; j < 3; ++j) {
+            if(i > 0 || j > 0)
+                buffer += _compDelimWrite;
+            TextRowWriter::appendDouble(buffer, elem[i][j], int(prec));
+        }
 }
 
 template<typename T>
 template<int M>
 void
-DelimFileAdapter<T>::writeElem_impl(std::ostream& stream,
-                                    const SimTK::Vec<M>& elem,
-                                    const unsigned& prec) const {
-    stream << std::setprecision(prec) << elem[0];
-    for(auto i = 1u; i < M; ++i)
-        stream << _compDelimWrite << std::setprecision(prec) << elem[i];
+DelimFileAdapter<T>::appendElem_impl(std::string& buffer,
+                                     const SimTK::Vec<M>& elem,
+                                     const unsigned& prec) const {
+    TextRowWriter::appendDouble(buffer, elem[0], int(prec));
+    for(auto i = 1u; i < M; ++i) {
+        buffer += _compDelimWrite;
+        TextRowWriter::appendDouble(buffer, elem[i], int(prec));
+    }
 }
 
 } // namespace OpenSim
@@ -1,6 +1,24 @@
 #include "FileAdapter.h"
 #include <OpenSim/Common/IO.h>
 
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#ifdef _WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
 namespace OpenSim {
 
 std::shared_ptr<DataAdapter>
@@ -34,6 +52,23 @@ FileAdapter::writeFile(const InputTables& tables,
     fileAdapter.extendWrite(tables, fileName);
 }
 
+std::unique_ptr<FileAdapter::ChunkSource>
+FileAdapter::openChunkSource(const std::string& fileName) {
+    auto extension = findExtension(fileName);
+    std::shared_ptr<DataAdapter> dataAdapter{};
+    if(extension == "sto")
+        dataAdapter = createSTOFileAdapterForReading(fileName);
+    else 
+        dataAdapter = createAdapter(extension);
+    auto& fileAdapter = static_cast<FileAdapter&>(*dataAdapter);
+    return fileAdapter.extendOpenChunkSource(fileName);
+}
+
+std::unique_ptr<FileAdapter::ChunkSource>
+FileAdapter::extendOpenChunkSource(const std::string&) const {
+    return nullptr;
+}
+
 std::string 
 FileAdapter::findExtension(const std::string& filename) {
     std::size_t found = filename.find_last_of('.');
@@ -75,6 +110,80 @@ FileAdapter::tokenize(const std::string& str,
     return tokens;
 }
 
+namespace {
+    // Powers of ten that are exactly representable as doubles.
+    const double exactPowersOfTen[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+    // Parse [+-]digits[.digits][(e|E)[+-]digits] when its value is m*10^e
+    // with m <= 2^53 and |e| <= 22. Both m and 10^e are then exact doubles,
+    // so one multiplication or division gives the correctly rounded result
+    // (Clinger's fast path). Returns false for any other input.
+    bool parseDecimalFast(const char* p, const char* end, double& value) {
+        bool negative = false;
+        if(p != end && (*p == '-' || *p == '+')) {
+            negative = *p == '-';
+            ++p;
+        }
+        std::uint64_t mantissa = 0;
+        int numDigits = 0;
+        int exponent = 0;
+        bool hasDigits = false;
+        for(; p != end && *p >= '0' && *p <= '9'; ++p) {
+            hasDigits = true;
+            if(mantissa == 0 && *p == '0') continue;
+            if(++numDigits > 19) return false;
+            mantissa = 10 * mantissa + (*p - '0');
+        }
+        if(p != end && *p == '.') {
+            for(++p; p != end && *p >= '0' && *p <= '9'; ++p) {
+                hasDigits = true;
+                --exponent;
+                if(mantissa == 0 && *p == '0') continue;
+                if(++numDigits > 19) return false;
+                mantissa = 10 * mantissa + (*p - '0');
+            }
+        }
+        if(!hasDigits) return false;
+        if(p != end && (*p == 'e' || *p == 'E')) {
+            ++p;
+            bool negativeExponent = false;
+            if(p != end && (*p == '-' || *p == '+')) {
+                negativeExponent = *p == '-';
+                ++p;
+            }
+            if(p == end || *p < '0' || *p > '9') return false;
+            int exp = 0;
+            for(; p != end && *p >= '0' && *p <= '9'; ++p)
+                if(exp < 10000) exp = 10 * exp + (*p - '0');
+            exponent += negativeExponent ? -exp : exp;
+        }
+        if(p != end) return false;
+
+        double result = static_cast<double>(mantissa);
+        if(mantissa != 0) {
+            if(mantissa > (std::uint64_t{1} << 53) ||
+                    exponent < -22 || exponent > 22)
+                return false;
+            if(exponent < 0)
+                result /= exactPowersOfTen[-exponent];
+            else
+                result *= exactPowersOfTen[exponent];
+        }
+        value = negative ? -result : result;
+        return true;
+    }
+} // anonymous namespace
+
+double
+FileAdapter::parseDouble(const char* begin, const char* end) {
+    double value{};
+    if(parseDecimalFast(begin, end, value))
+        return value;
+    return std::stod(std::string{begin, end});
+}
+
 std::vector<std::string>
 FileAdapter::getNextLine(std::istream& stream,
                          const std::string& delims) {
@@ -91,4 +200,68 @@ FileAdapter::getNextLine(std::istream& stream,
     return {};
 }
 
+MappedFile::MappedFile(const std::string& fileName) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ,
+                              FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                              FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    OPENSIM_THROW_IF(file == INVALID_HANDLE_VALUE,
+                     FileDoesNotExist,
+                     fileName);
+    LARGE_INTEGER fileSize{};
+    if(GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+        HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY,
+                                            0, 0, NULL);
+        if(mapping != NULL) {
+            _mapping = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping);
+            if(_mapping != nullptr)
+                _size = static_cast<size_t>(fileSize.QuadPart);
+        }
+    }
+    CloseHandle(file);
+#else
+    int file = open(fileName.c_str(), O_RDONLY);
+    OPENSIM_THROW_IF(file < 0,
+                     FileDoesNotExist,
+                     fileName);
+    struct stat fileStat;
+    if(fstat(file, &fileStat) == 0 && fileStat.st_size > 0) {
+        void* mapping = mmap(nullptr, static_cast<size_t>(fileStat.st_size),
+                             PROT_READ, MAP_PRIVATE, file, 0);
+        if(mapping != MAP_FAILED) {
+            _mapping = mapping;
+            _size = static_cast<size_t>(fileStat.st_size);
+            madvise(_mapping, _size, MADV_SEQUENTIAL);
+        }
+    }
+    close(file);
+#endif
+
+    if(_mapping != nullptr) {
+        _begin = static_cast<const char*>(_mapping);
+        return;
+    }
+
+    // The file could not be mapped (e.g., it is empty or is not a regular
+    // file), so read it instead.
+    std::ifstream stream{fileName, std::ios::binary};
+    OPENSIM_THROW_IF(!stream.good(),
+                     FileDoesNotExist,
+                     fileName);
+    _buffer.assign(std::istreambuf_iterator<char>{stream},
+                   std::istreambuf_iterator<char>{});
+    _begin = _buffer.data();
+    _size = _buffer.size();
+}
+
+MappedFile::~MappedFile() {
+    if(_mapping == nullptr) return;
+#ifdef _WIN32
+    UnmapViewOfFile(_mapping);
+#else
+    munmap(_mapping, _size);
+#endif
+}
+
 } // namespace OpenSim
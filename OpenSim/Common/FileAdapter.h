@@ -197,6 +197,32 @@ public:
     static void writeFile(const InputTables& tables, 
                           const std::string& fileName);
 
+#ifndef SWIG
+    /** Source of the rows of the table in a file, which reads a block of rows
+    at a time instead of the whole file at once. Use TableReader_ rather than
+    this class directly.                                                      */
+    class ChunkSource {
+    public:
+        virtual ~ChunkSource() = default;
+
+        /** Get a table of the type of the table in the file, with its column
+        labels and metadata but no rows.                                      */
+        virtual const AbstractDataTable& getHeader() const = 0;
+
+        /** Replace `chunk`, which must have the type of getHeader(), with a
+        table of the next rows in the file (at most maxRows rows), which has
+        the column labels and metadata of getHeader(). Returns false, leaving
+        `chunk` without rows, if all the rows have been read.                 */
+        virtual bool readChunk(AbstractDataTable& chunk, size_t maxRows) = 0;
+    };
+
+    /** Open a file to read its rows a block at a time, with the adapter for
+    its extension. Returns null if the adapter can only read whole files, in
+    which case readFile() has to be used.                                     */
+    static std::unique_ptr<ChunkSource>
+    openChunkSource(const std::string& fileName);
+#endif
+
     /** Find the extension from a filename.                                   */
     static
     std::string findExtension(const std::string& filename);
@@ -212,8 +238,52 @@ public:
     specifies that either a space or a tab can act as the delimiter.          */
     static std::vector<std::string> tokenize(const std::string& str, 
                                       const std::string& delims);
+
+#ifndef SWIG
+    /** Parse the number in the character range [begin, end), which should
+    not have leading or trailing whitespace. The result is the same as that of
+    std::stod() on the same characters (which is used for anything other than
+    plain decimal numbers), but common numbers are parsed in place without
+    allocating and independently of the locale.                              */
+    static double parseDouble(const char* begin, const char* end);
+#endif
+
+protected:
+#ifndef SWIG
+    /** Implements openChunkSource() for the files of this adapter. The
+    default implementation returns null.                                      */
+    virtual std::unique_ptr<ChunkSource>
+    extendOpenChunkSource(const std::string& fileName) const;
+#endif
 };
 
+#ifndef SWIG
+/** Read-only view of the entire contents of a file. The file is mapped into
+memory where the platform supports it, and is read into a buffer otherwise, so
+that adapters can scan large files in place instead of copying them line by
+line.                                                                         */
+class OSIMCOMMON_API MappedFile {
+public:
+    /** Open and map the file with the given name. Throws FileDoesNotExist if
+    the file cannot be opened.                                                */
+    explicit MappedFile(const std::string& fileName);
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile();
+
+    const char* begin() const { return _begin; }
+    const char* end() const { return _begin + _size; }
+    size_t size() const { return _size; }
+
+private:
+    const char* _begin{};
+    size_t _size{};
+    /** Start of the mapping; null if the file was read into _buffer.        */
+    void* _mapping{};
+    std::vector<char> _buffer;
+};
+#endif
+
 } // OpenSim namespace
 
 #endif // OPENSIM_FILE_ADAPTER_H_
@@ -154,3 +154,34 @@ evaluate(Array<double> &rValues,int aDerivOrder,double aX) const
         }
     }
 }
+
+//_____________________________________________________________________________
+/**
+ * Evaluate a function and its derivatives at many values of x.
+ *
+ * @param aIndex Index of the function to evaluate.
+ * @param aMaxDerivOrder Highest order of the derivatives to evaluate.
+ * @param aX Values of the x independent variable.
+ * @param rValues Matrix with one row per value of x, and the value of the
+ * function followed by its derivatives in the columns.
+ */
+void FunctionSet::
+evaluate(int aIndex, int aMaxDerivOrder, const SimTK::Array_<double>& aX,
+         SimTK::Matrix& rValues) const
+{
+    const Function& func = get(aIndex);
+    const int nx = (int)aX.size();
+    rValues.resize(nx, aMaxDerivOrder + 1);
+
+    std::vector<std::vector<int>> derivComponents(aMaxDerivOrder + 1);
+    for(int d=1; d<=aMaxDerivOrder; d++)
+        derivComponents[d].assign(d, 0);
+
+    SimTK::Vector arg(1);
+    for(int i=0; i<nx; i++) {
+        arg[0] = aX[i];
+        rValues(i, 0) = func.calcValue(arg);
+        for(int d=1; d<=aMaxDerivOrder; d++)
+            rValues(i, d) = func.calcDerivative(derivComponents[d], arg);
+    }
+}
@@ -75,6 +75,16 @@ public:
     virtual void
         evaluate(Array<double> &rValues,int aDerivOrder,
         double aX=0.0) const;
+#ifndef SWIG
+    /** Evaluate the function at aIndex and its derivatives up to order
+    aMaxDerivOrder at each of the values in aX. This avoids the allocations
+    that calling evaluate() for each value and order would make. Row i of
+    rValues receives the value of the function (column 0) and of its
+    derivatives (columns 1 through aMaxDerivOrder) at aX[i]. */
+    void evaluate(int aIndex, int aMaxDerivOrder,
+                  const SimTK::Array_<double>& aX,
+                  SimTK::Matrix& rValues) const;
+#endif
 
 //=============================================================================
 };  // END class FunctionSet
@@ -25,6 +25,7 @@
 // INCLUDE
 #include <OpenSim/Common/Component.h>
 #include <OpenSim/Common/TimeSeriesTable.h>
+#include <OpenSim/Common/TableStreamWriter.h>
 
 namespace OpenSim {
 
@@ -202,6 +203,31 @@ public:
         }
     }
 
+    /** Stream the reported rows to the binary (.bsto) file `fileName`, which
+    is written by a background thread (see TableStreamWriter_). The table
+    returned by getTable() then keeps only the most recent rows, at least
+    `numRowsToKeep` of them, so that the memory used by long simulations is
+    bounded. Call closeStream() to write the remaining rows and close the
+    file. The rows in the file must have increasing times, so close the
+    stream before calling clearTable() and reporting earlier times again. */
+    void streamToFile(const std::string& fileName, int numRowsToKeep = 1000) {
+        closeStream();
+        _streamFileName = fileName;
+        _numRowsToKeep = std::max(numRowsToKeep, 1);
+    }
+
+    /** Write the remaining rows to the file set with streamToFile(), close
+    the file and stop streaming. This has no effect if the rows are not
+    streamed to a file.                                                    */
+    void closeStream() {
+        _streamFileName.clear();
+        if (_streamWriter) {
+            std::unique_ptr<TableStreamWriter_<ValueT>> writer{
+                    _streamWriter.release()};
+            writer->close();
+        }
+    }
+
 protected:
     void implementReport(const SimTK::State& state) const override {
         const auto& input = this->template getInput<InputT>("inputs");
@@ -214,8 +240,7 @@ protected:
               result[idx] = value;
         }
         try {
-            const_cast<Self*>(this)->_outputTable.appendRow(state.getTime(),
-                                                            result);
+            appendToTable(state.getTime(), result);
         } catch(const InvalidTimestamp& exception) {
             OPENSIM_THROW(Exception,
                           "Attempting to update reporter with rows having "
@@ -246,11 +271,57 @@ protected:
     }
 
 private:
+    // Append a row to the table and, if streaming, to the file.
+    void appendToTable(double time,
+                       const SimTK::RowVector_<ValueT>& row) const {
+        Self* self = const_cast<Self*>(this);
+        self->_outputTable.appendRow(time, row);
+        if (_streamFileName.empty()) return;
+
+        if (!_streamWriter) {
+            // The writer takes the number of columns from the header, so the
+            // header has an (empty) column for each label.
+            std::vector<std::string> labels;
+            if (_outputTable.hasColumnLabels())
+                labels = _outputTable.getColumnLabels();
+            const TimeSeriesTable_<ValueT> header{std::vector<double>{},
+                    SimTK::Matrix_<ValueT>(0, int(labels.size())), labels};
+            self->_streamWriter.reset(
+                    new TableStreamWriter_<ValueT>(_streamFileName, header));
+        }
+        _streamWriter->appendRow(time, row);
+
+        // Drop the oldest rows in batches, so that the cost per report stays
+        // constant.
+        const size_t numRows = _outputTable.getNumRows();
+        const size_t numRowsToKeep = size_t(_numRowsToKeep);
+        if (numRows > 2 * numRowsToKeep) {
+            const auto& times = _outputTable.getIndependentColumn();
+            const size_t start = numRows - numRowsToKeep;
+            std::vector<std::string> labels;
+            if (_outputTable.hasColumnLabels())
+                labels = _outputTable.getColumnLabels();
+            const SimTK::Matrix_<ValueT> values =
+                    _outputTable.getMatrix().block(int(start), 0,
+                            int(numRowsToKeep), int(labels.size()));
+            self->_outputTable = TimeSeriesTable_<ValueT>{
+                    std::vector<double>(times.begin() + start, times.end()),
+                    values, labels};
+        }
+    }
 
     // Hold the output values in a table with values as columns and time rows
     // We write to this table in const methods, but only because we ensure
     // those const methods are never called with trial integrator states.
     TimeSeriesTable_<ValueT> _outputTable;
+
+    // File to which the rows are streamed (empty if they are not), and the
+    // number of recent rows kept in _outputTable while streaming. A copy of
+    // the reporter does not stream to the same file.
+    SimTK::ResetOnCopy<std::string> _streamFileName;
+    int _numRowsToKeep = 1000;
+    SimTK::ResetOnCopy<std::unique_ptr<TableStreamWriter_<ValueT>>>
+            _streamWriter;
 };
 
 /** A reporter that simply prints quantities to the console
@@ -353,8 +424,7 @@ inline void TableReporter_<SimTK::Vector, SimTK::Real>::
         const_cast<Self*>(this)->_outputTable.setColumnLabels(labels);
     }
 
-    const_cast<Self*>(this)->_outputTable.appendRow(state.getTime(), 
-                                                    (~result).getAsRowVector());
+    appendToTable(state.getTime(), (~result).getAsRowVector());
 }
 
 /** @name Commonly used concrete TableReporters */
@@ -25,6 +25,7 @@
 //=============================================================================
 #include "SmoothSegmentedFunction.h"
 #include <fstream>
+#include <vector>
 #include "simmath/internal/SplineFitter.h"
 
 //=============================================================================
@@ -95,7 +96,8 @@ SmoothSegmentedFunction::
           double x0, double x1, double y0, double y1,double dydx0, double dydx1,
           bool computeIntegral, bool intx0x1, const std::string& name):
 _x0(x0),_x1(x1),_y0(y0),_y1(y1),_dydx0(dydx0),_dydx1(dydx1),
-     _computeIntegral(computeIntegral),_intx0x1(intx0x1),_name(name)
+     _computeIntegral(computeIntegral),_intx0x1(intx0x1),_name(name),
+     _lookupTableTolerance(0)
 {
     
 
@@ -166,7 +168,8 @@ _x0(x0),_x1(x1),_y0(y0),_y1(y1),_dydx0(dydx0),_dydx1(dydx1),
  SmoothSegmentedFunction::SmoothSegmentedFunction():
  _x0(SimTK::NaN),_x1(SimTK::NaN),_y0(SimTK::NaN)
      ,_y1(SimTK::NaN),_dydx0(SimTK::NaN),_dydx1(SimTK::NaN),
-     _computeIntegral(false),_intx0x1(false),_name("NOT_YET_SET")
+     _computeIntegral(false),_intx0x1(false),_name("NOT_YET_SET"),
+     _lookupTableTolerance(0)
  {
         _arraySplineUX.resize(0);        
         _mXVec.resize(0);
@@ -202,6 +205,8 @@ double SmoothSegmentedFunction::calcValue(double x) const
     double yVal = 0;
     if(x >= _x0 && x <= _x1 )
     {
+        if(_lookupTableTolerance > 0)
+            return calcLookupTableDerivative(x, 0);
         int idx  = SegmentedQuinticBezierToolkit::calcIndex(x,_mXVec);
         double u = SegmentedQuinticBezierToolkit::
                  calcU(x,_mXVec[idx], _arraySplineUX[idx], UTOL,MAXITER);
@@ -270,6 +275,8 @@ double SmoothSegmentedFunction::calcDerivative(double x, int order) const
                 yVal = calcValue(x);
     }else{
             if(x >= _x0 && x <= _x1){        
+                if(_lookupTableTolerance > 0 && order <= 2)
+                    return calcLookupTableDerivative(x, order);
                 int idx  = SegmentedQuinticBezierToolkit::calcIndex(x,_mXVec);
                 double u = SegmentedQuinticBezierToolkit::
                                 calcU(x,_mXVec[idx], _arraySplineUX[idx], 
@@ -431,6 +438,219 @@ SimTK::Vec2 SmoothSegmentedFunction::getCurveDomain() const
     return xrange;
 }
 
+SimTK::Vec3 SmoothSegmentedFunction::
+    calcSectionDerivatives(int s, double x) const
+{
+    double u = SegmentedQuinticBezierToolkit::
+                    calcU(x,_mXVec[s], _arraySplineUX[s], UTOL,MAXITER);
+    SimTK::Vec3 y;
+    y(0) = SegmentedQuinticBezierToolkit::
+                    calcQuinticBezierCurveVal(u,_mYVec[s]);
+    for(int order=1; order <= 2; order++){
+        y(order) = SegmentedQuinticBezierToolkit::
+                    calcQuinticBezierCurveDerivDYDX(u, _mXVec[s], _mYVec[s],
+                                                    order);
+    }
+    return y;
+}
+
+/*
+ Each interval [xi, xi+h] of a section is a quintic Hermite polynomial in 
+ t = (x-xi)/h that matches y, dy/dx and d2y/dx2 at both ends. The error is
+ checked at t = 1/4, 1/2 and 3/4 of every interval; the number of intervals
+ of a section is doubled until the errors are below the tolerance.
+*/
+void SmoothSegmentedFunction::setLookupTableTolerance(double tolerance)
+{
+    SimTK_ERRCHK2_ALWAYS(tolerance >= 0,
+        "SmoothSegmentedFunction::setLookupTableTolerance",
+        "%s: tolerance must be 0 or positive, but %f was entered",
+        _name.c_str(), tolerance);
+
+    const int minIntervals = 8;
+    const int maxIntervals = 4096;
+
+    _lookupTableTolerance = 0;
+    _tableX.clear();
+    _tableInvH.clear();
+    _tableFirstInterval.clear();
+    _tableCoefficients.clear();
+    if(tolerance == 0 || _numBezierSections < 1)
+        return;
+
+    //The allowed error of each derivative, scaled by its largest magnitude
+    SimTK::Vec3 maxErr(1.0);
+    for(int s=0; s < _numBezierSections; s++){
+        double xs = _mXVec[s](0);
+        double xe = _mXVec[s](5);
+        for(int i=0; i < NUM_SAMPLE_PTS; i++){
+            double x = xs + (xe-xs)*i/(NUM_SAMPLE_PTS-1.0);
+            SimTK::Vec3 y = calcSectionDerivatives(s, x);
+            for(int order=0; order <= 2; order++)
+                maxErr(order) = max(maxErr(order), abs(y(order)));
+        }
+    }
+    maxErr *= tolerance;
+
+    for(int s=0; s < _numBezierSections; s++){
+        double xs = _mXVec[s](0);
+        double xe = _mXVec[s](5);
+        SimTK::Array_<SimTK::Vec6> coefficients;
+        bool converged = false;
+        int n = minIntervals;
+        for(; n <= maxIntervals && !converged; n *= 2){
+            double h = (xe-xs)/n;
+            coefficients.resize(n);
+            SimTK::Vec3 y0 = calcSectionDerivatives(s, xs);
+            converged = true;
+            for(int i=0; i < n; i++){
+                double xi = xs + h*i;
+                SimTK::Vec3 y1 = calcSectionDerivatives(s,
+                                        i == n-1 ? xe : xi + h);
+                double p0 = y0(0), m0 = h*y0(1), c0 = h*h*y0(2);
+                double p1 = y1(0), m1 = h*y1(1), c1 = h*h*y1(2);
+                SimTK::Vec6& a = coefficients[i];
+                a(0) = p0;
+                a(1) = m0;
+                a(2) = 0.5*c0;
+                a(3) = -10*p0 - 6*m0 - 1.5*c0 + 0.5*c1 - 4*m1 + 10*p1;
+                a(4) =  15*p0 + 8*m0 + 1.5*c0 -     c1 + 7*m1 - 15*p1;
+                a(5) =  -6*p0 - 3*m0 - 0.5*c0 + 0.5*c1 - 3*m1 +  6*p1;
+
+                for(int k=1; k <= 3 && converged && h > 0; k++){
+                    double t = 0.25*k;
+                    SimTK::Vec3 y = calcSectionDerivatives(s, xi + h*t);
+                    double p   = ((((a(5)*t + a(4))*t + a(3))*t + a(2))*t
+                                  + a(1))*t + a(0);
+                    double dp  = (((5*a(5)*t + 4*a(4))*t + 3*a(3))*t
+                                  + 2*a(2))*t + a(1);
+                    double ddp = ((20*a(5)*t + 12*a(4))*t + 6*a(3))*t
+                                  + 2*a(2);
+                    converged = abs(p - y(0)) <= maxErr(0)
+                             && abs(dp/h - y(1)) <= maxErr(1)
+                             && abs(ddp/(h*h) - y(2)) <= maxErr(2);
+                }
+                if(!converged)
+                    break;
+                y0 = y1;
+            }
+        }
+
+        SimTK_ERRCHK3_ALWAYS(converged,
+            "SmoothSegmentedFunction::setLookupTableTolerance",
+            "%s: a tolerance of %g could not be reached with %i intervals "
+            "per Bezier section", _name.c_str(), tolerance, maxIntervals);
+
+        n = (int)coefficients.size();
+        _tableX.push_back(xs);
+        _tableInvH.push_back(xe > xs ? n/(xe-xs) : 0);
+        _tableFirstInterval.push_back((int)_tableCoefficients.size());
+        for(int i=0; i < n; i++)
+            _tableCoefficients.push_back(coefficients[i]);
+    }
+    _tableX.push_back(_mXVec[_numBezierSections-1](5));
+    _tableFirstInterval.push_back((int)_tableCoefficients.size());
+    _lookupTableTolerance = tolerance;
+}
+
+double SmoothSegmentedFunction::getLookupTableTolerance() const
+{
+    return _lookupTableTolerance;
+}
+
+int SmoothSegmentedFunction::getLookupTableSize() const
+{
+    return (int)_tableCoefficients.size();
+}
+
+const SimTK::Vec6& SmoothSegmentedFunction::
+    findLookupTableInterval(double x, double& t, double& invH) const
+{
+    int s = 0;
+    while(s < _numBezierSections-1 && x >= _tableX[s+1])
+        s++;
+
+    invH = _tableInvH[s];
+    t = (x - _tableX[s])*invH;
+    int n = _tableFirstInterval[s+1] - _tableFirstInterval[s];
+    int i = min(max((int)t, 0), n-1);
+    t -= i;
+    return _tableCoefficients[_tableFirstInterval[s] + i];
+}
+
+double SmoothSegmentedFunction::
+    calcLookupTableDerivative(double x, int order) const
+{
+    double t, invH;
+    const SimTK::Vec6& a = findLookupTableInterval(x, t, invH);
+    switch(order){
+        case 0:
+            return ((((a(5)*t + a(4))*t + a(3))*t + a(2))*t + a(1))*t + a(0);
+        case 1:
+            return ((((5*a(5)*t + 4*a(4))*t + 3*a(3))*t + 2*a(2))*t + a(1))
+                   *invH;
+        default:
+            return (((20*a(5)*t + 12*a(4))*t + 6*a(3))*t + 2*a(2))
+                   *invH*invH;
+    }
+}
+
+template <typename CurveAt>
+void SmoothSegmentedFunction::calcDerivativesOfCurves(const CurveAt& curveAt,
+        const SimTK::Vector& x, int order, SimTK::Vector& result)
+{
+    const int n = x.size();
+    result.resize(n);
+
+    //Each point is evaluated as soon as its lookup table interval is found,
+    //so no work memory is needed. Points that are not evaluated from a
+    //lookup table are evaluated by calcDerivative().
+    for(int i=0; i < n; i++){
+        const SmoothSegmentedFunction& curve = curveAt(i);
+        const double xi = x[i];
+        if(!(curve._lookupTableTolerance > 0 && order <= 2
+             && xi >= curve._x0 && xi <= curve._x1)){
+            result[i] = curve.calcDerivative(xi, order);
+            continue;
+        }
+        double ti, invH;
+        const SimTK::Vec6& a = curve.findLookupTableInterval(xi, ti, invH);
+        if(order == 0){
+            result[i] =
+                ((((a(5)*ti + a(4))*ti + a(3))*ti + a(2))*ti + a(1))*ti + a(0);
+        }else if(order == 1){
+            result[i] =
+                ((((5*a(5)*ti + 4*a(4))*ti + 3*a(3))*ti + 2*a(2))*ti + a(1))
+                *invH;
+        }else{
+            result[i] = (((20*a(5)*ti + 12*a(4))*ti + 6*a(3))*ti + 2*a(2))
+                        *(invH*invH);
+        }
+    }
+}
+
+void SmoothSegmentedFunction::calcDerivatives(const SimTK::Vector& x,
+        int order, SimTK::Vector& result) const
+{
+    calcDerivativesOfCurves(
+        [this](int) -> const SmoothSegmentedFunction& { return *this; },
+        x, order, result);
+}
+
+void SmoothSegmentedFunction::calcDerivatives(
+        const SimTK::Array_<const SmoothSegmentedFunction*>& curves,
+        const SimTK::Vector& x, int order, SimTK::Vector& result)
+{
+    SimTK_ERRCHK2_ALWAYS((int)curves.size() == x.size(),
+        "SmoothSegmentedFunction::calcDerivatives",
+        "%i curves were given for %i points", (int)curves.size(), x.size());
+
+    calcDerivativesOfCurves(
+        [&curves](int i) -> const SmoothSegmentedFunction& {
+            return *curves[i]; },
+        x, order, result);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Utility functions
 ///////////////////////////////////////////////////////////////////////////////
@@ -197,6 +197,76 @@ namespace OpenSim {
                   derivative) linear extrapolation*/
        SimTK::Vec2 getCurveDomain() const;
 
+       /**Evaluate the curve and its first and second derivatives from a 
+       precomputed table instead of from the Bezier curves, which avoids 
+       finding the Bezier section and solving for u by Newton's method at 
+       every evaluation.
+
+       Within each Bezier section the table is a piecewise quintic Hermite 
+       interpolant of the curve on equally spaced points: it matches the 
+       value and first two derivatives of the curve at the points, so the 
+       interpolated curve is continuous to the second derivative, and its 
+       derivatives are the analytic derivatives of the interpolant. The 
+       number of points is doubled until the error of the value, the first 
+       derivative and the second derivative, checked at 3 points inside every 
+       interval, is below
+
+       \verbatim
+            tolerance * max(1, max |d^ny/dx^n|),  n = 0, 1, 2
+       \endverbatim
+
+       where the maximum is taken over the curve domain. Outside the curve 
+       domain, and for derivatives of order 3 or more, the curve is evaluated
+       as before.
+
+       @param tolerance The error bound of the table, or 0 to evaluate the
+                        Bezier curves directly (the default).
+       @throws SimTK::Exception
+        -If tolerance is negative
+        -If tolerance cannot be met with 4096 intervals per Bezier section
+
+       <B>Computational Costs</B>
+       \verbatim
+            x in curve domain  : ~25 flops
+       \endverbatim
+       */
+       void setLookupTableTolerance(double tolerance);
+
+       /**@return The error bound of the lookup table, or 0 if the curve is 
+       evaluated without a table. See setLookupTableTolerance().*/
+       double getLookupTableTolerance() const;
+
+       /**@return The number of quintic Hermite intervals in the lookup table,
+       or 0 if the curve is evaluated without a table.*/
+       int getLookupTableSize() const;
+
+       /**Evaluates the derivative of the given order (0 for the value) at 
+       each element of x; this gives the same results as calling 
+       calcDerivative(x[i], order) for each element. The points are 
+       evaluated one at a time in a single loop; a point in the domain of a 
+       lookup table (see setLookupTableTolerance()) is evaluated from its 
+       interval's polynomial as soon as the interval is found, and any other
+       point with calcDerivative(). Calling this method saves the per-call 
+       overhead of calcDerivative(), not the evaluations themselves.
+
+       @param x      The domain points of interest
+       @param order  The order of the derivative (0 to 6; orders above 2 are 
+                     not evaluated from the lookup table)
+       @param result The derivatives, resized to the size of x
+       */
+       void calcDerivatives(const SimTK::Vector& x, int order,
+                            SimTK::Vector& result) const;
+
+       /**Like calcDerivatives(x, order, result), but evaluates curves[i] at 
+       x[i], so that the same curve of many muscles (each with its own 
+       parameters) can be evaluated in one call.
+       @throws SimTK::Exception
+        -If curves and x do not have the same size
+       */
+       static void calcDerivatives(
+                    const SimTK::Array_<const SmoothSegmentedFunction*>& curves,
+                    const SimTK::Vector& x, int order, SimTK::Vector& result);
+
        /**This function will generate a csv file (of 'name_curveName.csv', where 
        name is the one used in the constructor) of the muscle curve, and 
        'curveName' corresponds to the function that was called from
@@ -344,6 +414,20 @@ namespace OpenSim {
         bool _intx0x1;
         /**The name of the function**/
         std::string _name;
+
+        /**The error bound of the lookup table, or 0 if there is no table*/
+        double _lookupTableTolerance;
+        /**The x value at the start of each Bezier section, followed by the
+        x value at the end of the last section*/
+        SimTK::Array_<double> _tableX;
+        /**1/h for the intervals of each Bezier section*/
+        SimTK::Array_<double> _tableInvH;
+        /**The index of the first interval of each Bezier section in 
+        _tableCoefficients, followed by the total number of intervals*/
+        SimTK::Array_<int> _tableFirstInterval;
+        /**Coefficients, in ascending powers of t = (x-xi)/h, of the quintic 
+        polynomial of each interval*/
+        SimTK::Array_<SimTK::Vec6> _tableCoefficients;
             
         /**No human should be constructing a SmoothSegmentedFunction, so the
         constructor is made private so that mere mortals cannot look at it. 
@@ -429,6 +513,26 @@ namespace OpenSim {
             SimTK::Array_<std::string>& colnames,
             const std::string& path, const std::string& filename) const;
 
+        /**Evaluates the value, first and second derivative of Bezier section
+        s at x, which must be in the domain of the section.*/
+        SimTK::Vec3 calcSectionDerivatives(int s, double x) const;
+
+        /**Evaluates the derivative of the given order (0, 1 or 2) of the 
+        lookup table at x, which must be in the curve domain.*/
+        double calcLookupTableDerivative(double x, int order) const;
+
+        /**Finds the interval of the lookup table that contains x, which must
+        be in the curve domain. Returns the coefficients of the interval and 
+        sets t to the position of x in the interval and invH to 1/h.*/
+        const SimTK::Vec6& findLookupTableInterval(double x, double& t,
+                                                   double& invH) const;
+
+        /**Implements the calcDerivatives() methods; curveAt(i) returns the 
+        curve to evaluate at x[i].*/
+        template <typename CurveAt>
+        static void calcDerivativesOfCurves(const CurveAt& curveAt,
+                    const SimTK::Vector& x, int order, SimTK::Vector& result);
+
        /**
        Refer to the documentation for calcValue(double x) 
        because this function is identical in function to 
@@ -27,7 +27,9 @@
 
 
 // INCLUDES
+#include <algorithm>
 #include <iostream>
+#include <limits>
 #include "IO.h"
 #include "Signal.h"
 #include "Storage.h"
@@ -37,6 +39,8 @@
 #include "GCVSpline.h"
 #include "StateVector.h"
 #include "STOFileAdapter.h"
+#include "BinaryFileAdapter.h"
+#include "TextRowWriter.h"
 #include "TimeSeriesTable.h"
 
 using namespace OpenSim;
@@ -133,8 +137,6 @@ const int Storage::LatestVersion = 1;
 //_____________________________________________________________________________
 /**
  * Destructor.
- *
- * The stored StateVectors are deleted during destruction.
  */
 Storage::~Storage()
 {
@@ -148,15 +150,14 @@ Storage::~Storage()
  * Default constructor.
  */
 Storage::Storage(int aCapacity,const string &aName) :
-    StorageInterface(aName),
-    _storage(StateVector())
+    StorageInterface(aName)
 {
     // SET NULL STATES
     setNull();
 
     // CAPACITY
-    _storage.ensureCapacity(aCapacity);
-    _storage.setCapacityIncrement(-1);
+    reserveRows(aCapacity);
+    _capacityIncrement = -1;
 
     _fileVersion = Storage::LatestVersion;
     // SET THE STATES
@@ -168,8 +169,7 @@ Storage::Storage(int aCapacity,const string &aName) :
  *
  */
 Storage::Storage(const string &fileName, bool readHeadersOnly) :
-    StorageInterface(fileName),
-    _storage(StateVector())
+    StorageInterface(fileName)
 {
     // SET NULL STATES
     setNull();
@@ -210,7 +210,15 @@ Storage::Storage(const string &fileName, bool readHeadersOnly) :
                     << "Only the first table '" << tables.begin()->first << "' will "
                     << "be loaded as Storage." << endl;
             }
-            convertTableToStorage(tables.begin()->second.get(), *this);
+            const AbstractDataTable* table = tables.begin()->second.get();
+            convertTableToStorage(table, *this);
+            if (table->hasTableMetaDataKey("inDegrees")) {
+                try {
+                    setInDegrees(SimTK::String::toLower(
+                        table->getTableMetaData<std::string>("inDegrees"))
+                            == "yes");
+                } catch (const InvalidTemplateArgument&) {}
+            }
             return;
         }
         catch (const std::exception& x) {
@@ -255,8 +263,8 @@ Storage::Storage(const string &fileName, bool readHeadersOnly) :
             << _columnLabels.getSize() << " were found" << std::endl;
     }
     // CAPACITY
-    _storage.ensureCapacity(nr);
-    _storage.setCapacityIncrement(-1);
+    reserveRows(nr);
+    _capacityIncrement = -1;
 
     // There are situations where we don't want to read the whole file in advance just header
     if (readHeadersOnly) return;
@@ -307,15 +315,14 @@ Storage::Storage(const string &fileName, bool readHeadersOnly) :
  * Copy constructor.
  */
 Storage::Storage(const Storage &aStorage,bool aCopyData) :
-    StorageInterface(aStorage),
-    _storage(StateVector())
+    StorageInterface(aStorage)
 {
     // NULL THE DATA
     setNull();
 
     // CAPACITY
-    _storage.ensureCapacity(aStorage._storage.getCapacity());
-    _storage.setCapacityIncrement(aStorage._storage.getCapacityIncrement());
+    _capacityIncrement = aStorage._capacityIncrement;
+    if(!aCopyData) reserveRows(aStorage._rowCapacity);
 
     // SET STATES
     setName(aStorage.getName());
@@ -341,15 +348,14 @@ Storage::Storage(const Storage &aStorage,bool aCopyData) :
 Storage::
 Storage(const Storage &aStorage,int aStateIndex,int aN,
              const char *aDelimiter) :
-     StorageInterface(aStorage),
-    _storage(StateVector())
+     StorageInterface(aStorage)
 {
     // NULL THE DATA
     setNull();
 
     // CAPACITY
-    _storage.ensureCapacity(aStorage._storage.getCapacity());
-    _storage.setCapacityIncrement(aStorage._storage.getCapacityIncrement());
+    reserveRows(aStorage.getSize());
+    _capacityIncrement = aStorage._capacityIncrement;
 
     // SET STATES
     setName(aStorage.getName());
@@ -365,7 +371,7 @@ Storage(const Storage &aStorage,int aStateIndex,int aN,
     // SET THE DATA
     int i,n;
     double time,*data = new double[aN];
-    for(i=0;i<aStorage._storage.getSize();i++) {
+    for(i=0;i<aStorage.getSize();i++) {
         aStorage.getTime(i,time);
         n = aStorage.getData(i,aStateIndex,aN,data);
         append(time,n,data);
@@ -415,6 +421,9 @@ setNull()
     _lastI = 0;
     _fp = 0;
     _inDegrees = false;
+    _rowCapacity = 0;
+    _numColumns = 0;
+    _capacityIncrement = -1;
 }
 //_____________________________________________________________________________
 /**
@@ -424,8 +433,7 @@ setNull()
  * other members of aStorage such as the name and the description.  To get
  * a complete copy, the copy constructor should be used.
  *
- * If this instance does not have enough capacity to hold the states
- * of the specified storage (aStorage), the capacity is increased.
+ * The capacity of this instance is set to that of aStorage.
  */
 void Storage::
 copyData(const Storage &aStorage)
@@ -433,15 +441,161 @@ copyData(const Storage &aStorage)
     _units = aStorage._units;
     setInDegrees(aStorage.isInDegrees());
 
-    // ENSURE CAPACITY
-    _storage.ensureCapacity(aStorage._storage.getCapacity());
-
     // COPY
-    //rdPtrArray::reset();
-    _storage.setSize(0);
-    for(int i=0;i<aStorage._storage.getSize();i++) {
-        _storage.append(aStorage._storage[i]);
+    _times = aStorage._times;
+    _rowSizes = aStorage._rowSizes;
+    _data = aStorage._data;
+    _rowCapacity = aStorage._rowCapacity;
+    _numColumns = aStorage._numColumns;
+    _capacityIncrement = aStorage._capacityIncrement;
+}
+//_____________________________________________________________________________
+/**
+ * Make room for at least aNumRows rows in every column.  Existing rows are
+ * moved to their new locations.
+ */
+void Storage::
+reserveRows(int aNumRows)
+{
+    if(aNumRows<=_rowCapacity) return;
+
+    std::vector<double> data((size_t)_numColumns*aNumRows,0.0);
+    const int size = getSize();
+    for(int j=0;j<_numColumns;j++) {
+        const double *column = getColumn(j);
+        std::copy(column,column+size,data.begin()+(size_t)j*aNumRows);
+    }
+    _data.swap(data);
+    _rowCapacity = aNumRows;
+    _times.reserve(aNumRows);
+    _rowSizes.reserve(aNumRows);
+}
+//_____________________________________________________________________________
+/**
+ * Make sure there are at least aNumColumns columns.  New columns are filled
+ * with zeros.
+ */
+void Storage::
+ensureNumColumns(int aNumColumns)
+{
+    if(aNumColumns<=_numColumns) return;
+    _data.resize((size_t)aNumColumns*_rowCapacity,0.0);
+    _numColumns = aNumColumns;
+}
+//_____________________________________________________________________________
+/**
+ * Overwrite the row at aTimeIndex with time aT and the aN states in aY.
+ * Entries past the end of the new row are zeroed.
+ */
+void Storage::
+setRow(int aTimeIndex,double aT,int aN,const double *aY)
+{
+    if(aN<0) aN = 0;
+    ensureNumColumns(aN);
+    _times[aTimeIndex] = aT;
+    _rowSizes[aTimeIndex] = aN;
+    double *y = _data.data() + aTimeIndex;
+    for(int j=0;j<aN;j++) y[(size_t)j*_rowCapacity] = aY[j];
+    for(int j=aN;j<_numColumns;j++) y[(size_t)j*_rowCapacity] = 0.0;
+}
+//_____________________________________________________________________________
+/**
+ * Replace the row at aTimeIndex with the time and states of aRow.
+ *
+ * @throws Exception if aTimeIndex is out of bounds.
+ */
+void Storage::
+setRow(int aTimeIndex,const StateVector &aRow)
+{
+    if((aTimeIndex<0)||(aTimeIndex>=getSize())) {
+        throw(Exception("Storage.setRow: index out of bounds."));
+    }
+    setRow(aTimeIndex,aRow.getTime(),aRow.getSize(),aRow.getData().get());
+}
+//_____________________________________________________________________________
+/**
+ * Append a row, growing the columns according to the capacity increment.
+ * If aCheckForDuplicateTime is true and aT equals the time of the last row,
+ * the last row is overwritten instead.
+ *
+ * @return Size of the storage after appending.
+ */
+int Storage::
+appendRow(double aT,int aN,const double *aY,bool aCheckForDuplicateTime)
+{
+    int size = getSize();
+    if(aCheckForDuplicateTime && size>0 && _times[size-1]==aT) {
+        setRow(size-1,aT,aN,aY);
+        return(size);
+    }
+
+    if(size>=_rowCapacity) {
+        int newCapacity;
+        if(_capacityIncrement==0) {
+            cout << "Storage.appendRow: WARNING- capacity is set not to "
+                 << "increase (i.e., increment=0)." << endl;
+            return(size);
+        } else if(_capacityIncrement<0) {
+            newCapacity = 2*std::max(_rowCapacity,1);
+        } else {
+            newCapacity = _rowCapacity + _capacityIncrement;
+        }
+        reserveRows(newCapacity);
     }
+
+    _times.push_back(aT);
+    _rowSizes.push_back(0);
+    setRow(size,aT,aN,aY);
+    return(size+1);
+}
+//_____________________________________________________________________________
+/**
+ * Copy the row at aTimeIndex into rVec.
+ */
+void Storage::
+copyRow(int aTimeIndex,StateVector &rVec) const
+{
+    const int n = _rowSizes[aTimeIndex];
+    Array<double> &data = rVec.getData();
+    data.setSize(n);
+    const double *y = _data.data() + aTimeIndex;
+    for(int j=0;j<n;j++) data[j] = y[(size_t)j*_rowCapacity];
+    rVec.setTime(_times[aTimeIndex]);
+}
+//_____________________________________________________________________________
+/**
+ * Print the row at aTimeIndex in the same format as StateVector::print().
+ *
+ * @return Number of characters written, or a negative value on error.
+ */
+int Storage::
+printRow(FILE *rFP,int aTimeIndex) const
+{
+    if(rFP==NULL) return(-1);
+
+    // TIME
+    char format[IO_STRLEN];
+    sprintf(format,"%s",IO::GetDoubleOutputFormat());
+    int n=0,nTotal=0;
+    n = fprintf(rFP,format,_times[aTimeIndex]);
+    if(n<0) return(n);
+    nTotal += n;
+
+    // STATES
+    sprintf(format,"\t%s",IO::GetDoubleOutputFormat());
+    const int ns = _rowSizes[aTimeIndex];
+    for(int j=0;j<ns;j++) {
+        n = fprintf(rFP,format,getValue(aTimeIndex,j));
+        if(n<0) return(n);
+        nTotal += n;
+    }
+
+    // CARRIAGE RETURN
+    n = fprintf(rFP,"\n");
+    if(n<0) return(n);
+    nTotal += n;
+
+    return(nTotal);
 }
 
 
@@ -703,7 +857,7 @@ getStepInterval() const
 void Storage::
 setCapacityIncrement(int aIncrement)
 {
-    _storage.setCapacityIncrement(aIncrement);
+    _capacityIncrement = aIncrement;
 }
 //_____________________________________________________________________________
 /**
@@ -715,7 +869,7 @@ setCapacityIncrement(int aIncrement)
 int Storage::
 getCapacityIncrement() const
 {
-    return(_storage.getCapacityIncrement());
+    return(_capacityIncrement);
 }
 
 //-----------------------------------------------------------------------------
@@ -732,17 +886,8 @@ getCapacityIncrement() const
 int Storage::
 getSmallestNumberOfStates() const
 {
-    int n,nmin=0;
-    for(int i=0;i<_storage.getSize();i++) {
-        n = _storage[i].getSize();
-        if(i==0) {
-            nmin = n;
-        } else if(n<nmin) {
-            nmin = n;
-        }
-    }
-
-    return(nmin);
+    if(_rowSizes.empty()) return(0);
+    return(*std::min_element(_rowSizes.begin(),_rowSizes.end()));
 }
 //_____________________________________________________________________________
 /**
@@ -753,27 +898,58 @@ getSmallestNumberOfStates() const
 StateVector* Storage::
 getLastStateVector() const
 {
-    StateVector *vec = NULL;
-    try {
-        vec = &_storage.updLast();
-    } catch(const Exception&) {
-        //x.print(cout);
-    }
-    return(vec);
+    return(getStateVector(getSize()-1));
 }
 //_____________________________________________________________________________
 /**
  * Get the StateVector at a specified time index.
  *
+ * The row is copied into a StateVector owned by this Storage, which is
+ * reused by the next call to getStateVector() or getLastStateVector().
+ * Changes made to it are not stored; use setRow() for that.
+ *
  * @param aTimeIndex Time index at which to get the state vector:
- * 0 <= aTimeIndex < _storage.getSize().
+ * 0 <= aTimeIndex < getSize().
  * @return Statevector. If no valid statevector exists at aTimeIndex, NULL
  * is returned.
  */
 StateVector* Storage::
 getStateVector(int aTimeIndex) const
 {
-    return(&_storage.updElt(aTimeIndex));
+    if((aTimeIndex<0)||(aTimeIndex>=getSize())) return(NULL);
+    copyRow(aTimeIndex,_rowCache);
+    return(&_rowCache);
+}
+//_____________________________________________________________________________
+/**
+ * Get a copy of the last states stored.
+ *
+ * @return Statevector.
+ * @throws Exception if no state vector is stored.
+ */
+StateVector Storage::
+getLastRow() const
+{
+    return(getRow(getSize()-1));
+}
+//_____________________________________________________________________________
+/**
+ * Get a copy of the StateVector at a specified time index.
+ *
+ * @param aTimeIndex Time index at which to get the state vector:
+ * 0 <= aTimeIndex < getSize().
+ * @return Statevector.
+ * @throws Exception if aTimeIndex is out of bounds.
+ */
+StateVector Storage::
+getRow(int aTimeIndex) const
+{
+    if((aTimeIndex<0)||(aTimeIndex>=getSize())) {
+        throw(Exception("Storage.getRow: index out of bounds."));
+    }
+    StateVector vec;
+    copyRow(aTimeIndex,vec);
+    return(vec);
 }
 
 //-----------------------------------------------------------------------------
@@ -789,10 +965,10 @@ getStateVector(int aTimeIndex) const
 double Storage::
 getFirstTime() const
 {
-    if(_storage.getSize()<=0) {
+    if(_times.empty()) {
         return(SimTK::NaN);
     }
-    return(_storage[0].getTime());
+    return(_times.front());
 }
 //_____________________________________________________________________________
 /**
@@ -804,10 +980,10 @@ getFirstTime() const
 double Storage::
 getLastTime() const
 {
-    if(_storage.getSize()<=0) {
+    if(_times.empty()) {
         return(SimTK::NaN);
     }
-    return(_storage.getLast().getTime());
+    return(_times.back());
 }
 //_____________________________________________________________________________
 /**
@@ -818,14 +994,12 @@ getLastTime() const
 double Storage::
 getMinTimeStep() const
 {
-    double *time=NULL;
-    int n = getTimeColumn(time);
+    const int n = getSize();
     double dtmin =  SimTK::Infinity;
     for(int i=1; i<n; i++) {
-        double dt = time[i] - time[i-1];
+        double dt = _times[i] - _times[i-1];
         if(dt<dtmin) dtmin = dt;
     }
-    delete[] time;
     return dtmin;
 }
 //_____________________________________________________________________________
@@ -845,16 +1019,13 @@ bool Storage::
 getTime(int aTimeIndex,double &rTime,int aStateIndex) const
 {
     if(aTimeIndex<0) return false;
-    if(aTimeIndex>_storage.getSize()) return false;
-
-    // GET STATEVECTOR
-    StateVector &vec = _storage[aTimeIndex];
+    if(aTimeIndex>=getSize()) return false;
 
     // CHECK FOR VALID STATE
-    if(aStateIndex >= vec.getSize()) return false;
+    if(aStateIndex >= _rowSizes[aTimeIndex]) return false;
 
     // ASSIGN TIME
-    rTime = vec.getTime();
+    rTime = _times[aTimeIndex];
     return true;
 }
 //_____________________________________________________________________________
@@ -863,33 +1034,30 @@ getTime(int aTimeIndex,double &rTime,int aStateIndex) const
  *
  * @param rTime Array where times are set.  If rTime is sent in as NULL,
  * memory is allocated.  If rTime is setn in as non-NULL, it is assumed that
- * enough memory has been allocated at rTime to hold _storage.getSize() doubles.
+ * enough memory has been allocated at rTime to hold getSize() doubles.
  * @param aStateIndex Index of the state for which to get the times.
  * By default, aStateIndex has a value of -1, which means disregard whether
  * or not there is a valid state- just get the times.  If aStateIndex is
  * non-negative, the time is set only if there is a valid state at aStateIndex.
- * @return Number of times set.  This can be less than _storage.getSize() if
+ * @return Number of times set.  This can be less than getSize() if
  * a state does not exist for all or a subset of the stored statevectors.
  */
 int Storage::
 getTimeColumn(double *&rTimes,int aStateIndex) const
 {
-    if(_storage.getSize()<=0) return(0);
+    const int size = getSize();
+    if(size<=0) return(0);
 
     // ALLOCATE MEMORY
     if(rTimes==NULL) {
-        rTimes = new double[_storage.getSize()];
+        rTimes = new double[size];
     }
 
-    // LOOP THROUGH STATEVECTORS
+    // ROWS THAT HAVE THE STATE
     int i,nTimes;
-    StateVector *vec;
-    for(i=nTimes=0;i<_storage.getSize();i++) {
-        vec = getStateVector(i);
-        if(vec==NULL) continue;
-        if(aStateIndex >= vec->getSize()) continue;
-        rTimes[nTimes] = vec->getTime();
-        nTimes++;
+    for(i=nTimes=0;i<size;i++) {
+        if(aStateIndex >= _rowSizes[i]) continue;
+        rTimes[nTimes++] = _times[i];
     }
 
     return(nTimes);
@@ -897,20 +1065,11 @@ getTimeColumn(double *&rTimes,int aStateIndex) const
 int Storage::
 getTimeColumn(Array<double> &rTimes,int aStateIndex) const
 {
-    if(_storage.getSize()<=0) return(0);
-
-    rTimes.setSize(_storage.getSize());
-
-    // LOOP THROUGH STATEVECTORS
-    int i,nTimes;
-    for(i=nTimes=0;i<_storage.getSize();i++) {
-        StateVector *vec = getStateVector(i);
-        if(vec==NULL) continue;
-        if(aStateIndex >= vec->getSize()) continue;
-        rTimes[nTimes] = vec->getTime();
-        nTimes++;
-    }
+    if(getSize()<=0) return(0);
 
+    rTimes.setSize(getSize());
+    double *times = rTimes.get();
+    int nTimes = getTimeColumn(times,aStateIndex);
     rTimes.setSize(nTimes);
 
     return(nTimes);
@@ -922,16 +1081,13 @@ getTimeColumn(Array<double> &rTimes,int aStateIndex) const
 void Storage::
 getTimeColumnWithStartTime(Array<double>& rTimes,double aStartTime) const
 {
-    if(_storage.getSize()<=0) return;
+    if(getSize()<=0) return;
 
     int startIndex = findIndex(aStartTime);
 
-    double *timesVec=0;
-    int size = getTimeColumn(timesVec);
-
+    const int size = getSize();
     for(int i=startIndex; i<size; i++)
-        rTimes.append(timesVec[i]);
-    delete[] timesVec;
+        rTimes.append(_times[i]);
 }
 //-----------------------------------------------------------------------------
 // DATA
@@ -941,7 +1097,7 @@ getTimeColumnWithStartTime(Array<double>& rTimes,double aStartTime) const
  * Get a data value of a specified state at a specified time index.
  *
  * @param aTimeIndex Index that identifies the time (row) at which to get the
- * data value:  0 <= aTimeIndex < _storage.getSize().
+ * data value:  0 <= aTimeIndex < getSize().
  * @param aStateIndex Index of the state (column) for which to get the value.
  * @param rValue Value of the state.
  * @return 1 on success, 0 on failure.
@@ -950,12 +1106,13 @@ int Storage::
 getData(int aTimeIndex,int aStateIndex,double &rValue) const
 {
     if(aTimeIndex<0) return(0);
-    if(aTimeIndex>=_storage.getSize()) return(0);
+    if(aTimeIndex>=getSize()) return(0);
+    if(aStateIndex<0) return(0);
+    if(aStateIndex>=_rowSizes[aTimeIndex]) return(0);
 
     // ASSIGNMENT
-    StateVector *vec = getStateVector(aTimeIndex);
-    if(vec==NULL) return(0);
-    return( vec->getDataValue(aStateIndex,rValue) );
+    rValue = getValue(aTimeIndex,aStateIndex);
+    return(1);
 }
 //_____________________________________________________________________________
 /**
@@ -967,15 +1124,11 @@ getData(int aTimeIndex,int aStateIndex,int aN,double **rData) const
     if(aN<=0) return(0);
     if(aStateIndex<0) return(0);
     if(aTimeIndex<0) return(0);
-    if(aTimeIndex>=_storage.getSize()) return(0);
-
-    // GET STATEVECTOR
-    StateVector *vec = getStateVector(aTimeIndex);
-    if(vec==NULL) return(0);
-    if(vec->getSize()<=0) return(0);
+    if(aTimeIndex>=getSize()) return(0);
 
     // NUMBER OF STATES TO GET
-    int size = vec->getSize();
+    int size = _rowSizes[aTimeIndex];
+    if(size<=0) return(0);
     if(aStateIndex>=size) return(0);
     int n = aStateIndex + aN;
     if(n>size) n = size;
@@ -986,9 +1139,8 @@ getData(int aTimeIndex,int aStateIndex,int aN,double **rData) const
 
     // ASSIGN DATA
     int i,j;
-    Array<double> &data = vec->getData();
     double *pData = *rData;
-    for(i=0,j=aStateIndex;j<n;i++,j++) pData[i] = data[j];
+    for(i=0,j=aStateIndex;j<n;i++,j++) pData[i] = getValue(aTimeIndex,j);
 
     return(N);
 }
@@ -999,7 +1151,7 @@ getData(int aTimeIndex,int aStateIndex,int aN,double **rData) const
  * from adjacent columns in the storage object.
  *
  * @param aTimeIndex Index that identifies the time (row) at which to get the
- * data value:  0 <= aTimeIndex < _storage.getSize().
+ * data value:  0 <= aTimeIndex < getSize().
  * @param aStateIndex Index of the state (column) at which to start getting
  * the data.
  * @param aN Number of states (columns) to get.
@@ -1077,12 +1229,15 @@ getData(int aTimeIndex,int aN,Array<double> &rData) const
 int Storage::
 getData(int aTimeIndex,int aN,SimTK::Vector& v) const
 {
-    Array<double> rData;
-    rData.setSize(aN);
-    int r = getData(aTimeIndex,0,aN,&rData[0]);
-    for (int i=0; i<aN; ++i)
-        v[i] = rData[i];
-    return r;
+    int r = 0;
+    if((aTimeIndex>=0)&&(aTimeIndex<getSize())) {
+        r = std::min(_rowSizes[aTimeIndex],aN);
+        for (int i=0; i<r; ++i)
+            v[i] = getValue(aTimeIndex,i);
+    }
+    for (int i=std::max(r,0); i<aN; ++i)
+        v[i] = 0.0;
+    return std::max(r,0);
 }
 //_____________________________________________________________________________
 /**
@@ -1101,31 +1256,16 @@ getDataAtTime(double aT,int aN,double **rData) const
 {
 
     // FIND THE CORRECT INTERVAL FOR aT
-    int i = findIndex(_lastI,aT);
-    if((i<0)||(_storage.getSize()<=0)) {
+    int i1,i2;
+    double pct;
+    if(!findInterval(aT,i1,i2,pct)) {
         *rData = NULL;
         return(0);
     }
 
-    // CHECK FOR i AT END POINTS
-    int i1=i,i2=i+1;
-
-    if(i2==_storage.getSize()) {
-        i1--;  if(i1<0) i1=0;
-        i2--;  if(i2<0) i2=0;
-    }
-
-    // STATES AT FIRST INDEX
-    int n1 = getStateVector(i1)->getSize();
-    double t1 = getStateVector(i1)->getTime();
-    Array<double> &y1 = getStateVector(i1)->getData();
-
-    // STATES AT NEXT INDEX
-    int n2 = getStateVector(i2)->getSize();
-    double t2 = getStateVector(i2)->getTime();
-    Array<double> &y2 = getStateVector(i2)->getData();
-
     // GET THE SMALLEST N TO PREVENT MEMORY OVER-RUNS
+    int n1 = _rowSizes[i1];
+    int n2 = _rowSizes[i2];
     int ns = (n1<n2) ? n1 : n2;
 
     // ALLOCATE MEMORY?
@@ -1138,21 +1278,12 @@ getDataAtTime(double aT,int aN,double **rData) const
     }
 
     // ASSIGN VALUES
-    double pct;
-    double num = aT-t1;
-    double den = t2-t1;
-    if(den<SimTK::Eps) {
-        pct = 0.0;
+    if(pct==0.0) {
+        for(int i=0;i<ns;i++) y[i] = getValue(i1,i);
     } else {
-        pct = num/den;
-    }
-
-
-    for(i=0;i<ns;i++) {
-        if(pct==0.0) {
-            y[i] = y1[i];
-        } else {
-            y[i] = y1[i] + pct*(y2[i]-y1[i]);
+        for(int i=0;i<ns;i++) {
+            const double *column = getColumn(i);
+            y[i] = column[i1] + pct*(column[i2]-column[i1]);
         }
     }
 
@@ -1184,15 +1315,34 @@ getDataAtTime(double aT,int aN,Array<double> &rData) const
     double *data=&rData[0];
     return getDataAtTime(aT,aN,&data);
 }
+//_____________________________________________________________________________
+/**
+ * Get the first aN states at a specified time, interpolating directly into
+ * the provided vector (no memory is allocated).
+ *
+ * @param aT Time at which to get the states.
+ * @param aN Number of states to get.
+ * @param v Vector whose first aN elements are set. Elements for which the
+ * storage has no data are set to zero.
+ * @return Number of states that were set from the storage.
+ */
 int Storage::
 getDataAtTime(double aT,int aN,SimTK::Vector& v) const
 {
-    Array<double> rData;
-    rData.setSize(aN);
-    int r = getDataAtTime(aT,aN,rData);
-    for (int i=0; i<aN; ++i)
-        v[i] = rData[i];
-    return r;
+    int i1,i2;
+    double pct;
+    int ns = 0;
+    if(findInterval(aT,i1,i2,pct)) {
+        ns = std::min(std::min(_rowSizes[i1],_rowSizes[i2]),aN);
+        for(int i=0;i<ns;i++) {
+            const double *column = getColumn(i);
+            v[i] = (pct==0.0) ? column[i1] :
+                    column[i1] + pct*(column[i2]-column[i1]);
+        }
+    }
+    for(int i=std::max(ns,0);i<aN;i++) v[i] = 0.0;
+    ns = std::max(ns,0);
+    return ns;
 }
 //_____________________________________________________________________________
 /**
@@ -1211,7 +1361,7 @@ getDataAtTime(double aT,int aN,SimTK::Vector& v) const
 int Storage::
 getDataColumn(int aStateIndex,double *&rData) const
 {
-    int n = _storage.getSize();
+    int n = getSize();
     if(n<=0) return(0);
 
     // ALLOCATION
@@ -1220,11 +1370,15 @@ getDataColumn(int aStateIndex,double *&rData) const
     }
 
     // ASSIGNMENT
+    if((aStateIndex<0)||(aStateIndex>=_numColumns)) return(0);
+    const double *column = getColumn(aStateIndex);
+    if(aStateIndex<getSmallestNumberOfStates()) {
+        std::copy(column,column+n,rData);
+        return(n);
+    }
     int i,nData;
     for(i=nData=0;i<n;i++) {
-        StateVector *vec = getStateVector(i);
-        if(vec==NULL) continue;
-        if(vec->getDataValue(aStateIndex,rData[nData])) nData++;
+        if(aStateIndex<_rowSizes[i]) rData[nData++] = column[i];
     }
 
     return(nData);
@@ -1232,19 +1386,12 @@ getDataColumn(int aStateIndex,double *&rData) const
 int Storage::
 getDataColumn(int aStateIndex,Array<double> &rData) const
 {
-    int n = _storage.getSize();
+    int n = getSize();
     if(n<=0) return(0);
 
     rData.setSize(n);
-
-    // ASSIGNMENT
-    int i,nData;
-    for(i=nData=0;i<n;i++) {
-        StateVector *vec = getStateVector(i);
-        if(vec==NULL) continue;
-        if(vec->getDataValue(aStateIndex,rData[nData])) nData++;
-    }
-
+    double *data = rData.get();
+    int nData = getDataColumn(aStateIndex,data);
     rData.setSize(nData);
 
     return(nData);
@@ -1257,13 +1404,13 @@ getDataColumn(int aStateIndex,Array<double> &rData) const
 void Storage::
 getDataColumn(const std::string& columnName, Array<double>& rData, double aStartTime)
 {
-    if(_storage.getSize()<=0) return;
+    if(getSize()<=0) return;
 
     int startIndex = findIndex(aStartTime);
     int colIndex = getStateIndex(columnName);
     double *dataVec=0;
     getDataColumn(colIndex, dataVec);
-    for(int i=startIndex; i<_storage.getSize(); i++)
+    for(int i=startIndex; i<getSize(); i++)
         rData.append(dataVec[i]);
     delete[] dataVec;
 }
@@ -1282,24 +1429,28 @@ getDataColumn(const std::string& columnName, Array<double>& rData, double aStart
 void Storage::
 setDataColumn(int aStateIndex,const Array<double> &aData)
 {
-    int n = _storage.getSize();
+    int n = getSize();
     if(n!=aData.getSize()) {
         cout<<"Storage.setDataColumn: ERR- sizes don't match." << endl;
         return;
     }
 
     // ASSIGNMENT
+    if((aStateIndex<0)||(aStateIndex>=_numColumns)) return;
+    double *column = updColumn(aStateIndex);
+    if(aStateIndex<getSmallestNumberOfStates()) {
+        std::copy(aData.get(),aData.get()+n,column);
+        return;
+    }
     for(int i=0;i<n;i++) {
-        StateVector *vec = getStateVector(i);
-        if(vec==NULL) continue;
-        vec->setDataValue(aStateIndex,aData[i]);
+        if(aStateIndex<_rowSizes[i]) column[i] = aData[i];
     }
 }
 /**
  * set values in the column specified by columnName to newValue
  */
 void Storage::setDataColumnToFixedValue(const std::string& columnName, double newValue) {
-    int n = _storage.getSize();
+    int n = getSize();
     int aStateIndex = getStateIndex(columnName);
     if(aStateIndex==-1) {
         cout<<"Storage.setDataColumnToFixedValue: ERR- column not found." << endl;
@@ -1307,10 +1458,10 @@ void Storage::setDataColumnToFixedValue(const std::string& columnName, double ne
     }
 
     // ASSIGNMENT
+    if((aStateIndex<0)||(aStateIndex>=_numColumns)) return;
+    double *column = updColumn(aStateIndex);
     for(int i=0;i<n;i++) {
-        StateVector *vec = getStateVector(i);
-        if(vec==NULL) continue;
-        vec->setDataValue(aStateIndex,newValue);
+        if(aStateIndex<_rowSizes[i]) column[i] = newValue;
     }
 
 }
@@ -1356,7 +1507,7 @@ void Storage::getDataForIdentifier(const std::string& identifier, Array<Array<do
     }
     /* a row of "data" can be shorter than number of columns if time is the first column, since 
        that is not considered a state by storage. Need to fix this! -aseth */
-    int nd = getLastStateVector()->getSize();
+    int nd = _rowSizes.empty() ? 0 : _rowSizes.back();
     int off = _columnLabels.getSize()-nd;
 
 
@@ -1386,24 +1537,45 @@ Storage::getColumnIndicesForIdentifier(const std::string& identifier) const
 TimeSeriesTable Storage::exportToTable() const {
     TimeSeriesTable table{};
 
+    const int nr = getSize();
+    const int nc = _columnLabels.getSize() - 1;
+    const bool copyColumns = nr > 0 && nc > 0 &&
+            getSmallestNumberOfStates() == nc &&
+            *std::max_element(_rowSizes.begin(), _rowSizes.end()) == nc;
+    if(copyColumns) {
+        // All rows are full, so the columns can be copied as blocks (the
+        // columns of a SimTK::Matrix are contiguous as well).
+        SimTK::Matrix matrix(nr, nc);
+        for(int j = 0; j < nc; ++j) {
+            std::copy(getColumn(j), getColumn(j) + nr, &matrix(0, j));
+        }
+        table = TimeSeriesTable(_times, matrix,
+                std::vector<std::string>(_columnLabels.get() + 1,
+                        _columnLabels.get() + _columnLabels.getSize()));
+    }
+
     table.addTableMetaData("header", getName());
     table.addTableMetaData("inDegrees", std::string{_inDegrees ? "yes" : "no"});
-    table.addTableMetaData("nRows", std::to_string(_storage.getSize()));
+    table.addTableMetaData("nRows", std::to_string(nr));
     table.addTableMetaData("nColumns", std::to_string(_columnLabels.getSize()));
     if(!getDescription().empty())
         table.addTableMetaData("description", getDescription());
 
+    if(copyColumns) return table;
+
     // Exclude the first column label. It is 'time'. Time is a separate column
     // in TimeSeriesTable and column label is optional.
     table.setColumnLabels(_columnLabels.get() + 1, 
                           _columnLabels.get() + _columnLabels.getSize());
+    table.reserveRows(nr);
 
-    for(int i = 0; i < _storage.getSize(); ++i) {
-        const auto& row = getStateVector(i)->getData();
-        const auto time = getStateVector(i)->getTime();
+    std::vector<double> row;
+    for(int i = 0; i < nr; ++i) {
+        row.resize(_rowSizes[i]);
+        for(int j = 0; j < _rowSizes[i]; ++j) row[j] = getValue(i, j);
         // Exclude the first column. It is 'time'. Time is a separate column in
         // TimeSeriesTable.
-        table.appendRow(time, row.get(), row.get() + row.getSize());
+        table.appendRow(_times[i], row.begin(), row.end());
     }
 
     return table;
@@ -1430,11 +1602,12 @@ TimeSeriesTable Storage::exportToTable() const {
 int Storage::
 reset(int aIndex)
 {
-    if(aIndex>=_storage.getSize()) return(_storage.getSize());
+    if(aIndex>=getSize()) return(getSize());
     if(aIndex<0) aIndex = 0;
-    _storage.setSize(aIndex);
+    _times.resize(aIndex);
+    _rowSizes.resize(aIndex);
 
-    return(_storage.getSize());
+    return(getSize());
 }
 //_____________________________________________________________________________
 /**
@@ -1466,18 +1639,24 @@ crop(const double newStartTime, const double newFinalTime)
 {
     int startindex = findIndex(newStartTime); 
     int finalindex = findIndex(newFinalTime); 
-    // Since underlying Array is packed we'll just move what we need up then 
-    // delete remaining rows in reverse order.
+    // Move the rows we keep to the top of each column, then drop the rest.
     int numRowsToKeep=finalindex-startindex+1;
     if (numRowsToKeep <=0){
         cout<<"Storage.crop: WARNING: No rows will be left." << endl;
         numRowsToKeep=0;
     }
-    if (startindex!=0){
-        for(int i=0; i<finalindex-startindex+1; i++)
-            _storage[i]=_storage[startindex+i];
+    if (startindex>0 && numRowsToKeep>0){
+        const int end = startindex+numRowsToKeep;
+        std::copy(_times.begin()+startindex,_times.begin()+end,_times.begin());
+        std::copy(_rowSizes.begin()+startindex,_rowSizes.begin()+end,
+                _rowSizes.begin());
+        for(int j=0;j<_numColumns;j++) {
+            double *column = updColumn(j);
+            std::copy(column+startindex,column+end,column);
+        }
     }
-    _storage.setSize(numRowsToKeep);
+    _times.resize(numRowsToKeep);
+    _rowSizes.resize(numRowsToKeep);
 }
 
 //=============================================================================
@@ -1493,17 +1672,15 @@ crop(const double newStartTime, const double newFinalTime)
 int Storage::
 append(const StateVector &aStateVector,bool aCheckForDuplicateTime)
 {
-    // TODO: use some tolerance when checking for duplicate time?
-    if(aCheckForDuplicateTime && _storage.getSize() && _storage.getLast().getTime()==aStateVector.getTime())
-        _storage.updLast() = aStateVector;
-    else
-        _storage.append(aStateVector);
+    const Array<double> &data = aStateVector.getData();
+    appendRow(aStateVector.getTime(),data.getSize(),data.get(),
+            aCheckForDuplicateTime);
 
     if (_fp!=0){
         aStateVector.print(_fp);
         fflush(_fp);
     }
-    return(_storage.getSize());
+    return(getSize());
 }
 //_____________________________________________________________________________
 /**
@@ -1518,9 +1695,11 @@ append(const StateVector &aStateVector,bool aCheckForDuplicateTime)
 int Storage::
 append(const Array<StateVector> &aStorage)
 {
-    for(int i=0; i<aStorage.getSize(); i++)
-        _storage.append(aStorage[i]);
-    return(_storage.getSize());
+    for(int i=0; i<aStorage.getSize(); i++) {
+        const Array<double> &data = aStorage[i].getData();
+        appendRow(aStorage[i].getTime(),data.getSize(),data.get(),false);
+    }
+    return(getSize());
 }
 //_____________________________________________________________________________
 /**
@@ -1534,20 +1713,17 @@ append(const Array<StateVector> &aStorage)
 int Storage::
 append(double aT,int aN,const double *aY,bool aCheckForDuplicateTime)
 {
-    if(aY==NULL) return(_storage.getSize());
-    if(aN<0) return(_storage.getSize());
+    if(aY==NULL) return(getSize());
+    if(aN<0) return(getSize());
 
     // APPEND
-    StateVector vec(aT, SimTK::Vector_<double>(aN, aY));
-    append(vec,aCheckForDuplicateTime);
-    // TODO: use some tolerance when checking for duplicate time?
-    /*
-    if(aCheckForDuplicateTime && _storage.getSize() && _storage.getLast().getTime()==vec.getTime())
-        _storage.getLast() = vec;
-    else
-        _storage.append(vec);
-    */
-    return(_storage.getSize());
+    appendRow(aT,aN,aY,aCheckForDuplicateTime);
+
+    if (_fp!=0){
+        printRow(_fp,getSize()-1);
+        fflush(_fp);
+    }
+    return(getSize());
 }
 //_____________________________________________________________________________
 /**
@@ -1593,18 +1769,82 @@ append(double aT,const Array<double>& aY,bool aCheckForDuplicateTime)
 int Storage::
 store(int aStep,double aT,int aN,const double *aY)
 {
-    if(_stepInterval==0) return(_storage.getSize());
+    if(_stepInterval==0) return(getSize());
     if((aStep%_stepInterval) == 0) {
         append(aT,aN,aY);
     }
 
-    return(_storage.getSize());
+    return(getSize());
 }
 
 
 //=============================================================================
 // OPERATIONS
 //=============================================================================
+//_____________________________________________________________________________
+/**
+ * Replace each value y of a column by op(y). Only rows that have a state at aStateIndex are changed. Columns below
+ * aNumFullColumns are known to be full, so they are updated without testing
+ * the size of each row.
+ */
+template <typename Op>
+void Storage::
+transformColumn(int aStateIndex,int aNumFullColumns,Op op)
+{
+    double *column = updColumn(aStateIndex);
+    const int size = getSize();
+    if(aStateIndex<aNumFullColumns) {
+        for(int i=0;i<size;i++) column[i] = op(column[i]);
+    } else {
+        for(int i=0;i<size;i++) {
+            if(aStateIndex<_rowSizes[i]) column[i] = op(column[i]);
+        }
+    }
+}
+//_____________________________________________________________________________
+/**
+ * Replace each value y of this storage by op(y,x), where x is the value of
+ * the same state in aStorage, linearly interpolated at the time of the row.
+ *
+ * As when the rows are combined one at a time with the values returned by
+ * getDataAtTime(), the number of states combined in a row is limited by
+ * the number of states available in aStorage at that row and at all of the
+ * preceding rows.
+ */
+template <typename Op>
+void Storage::
+combineWithStorage(const Storage &aStorage,Op op)
+{
+    const int size = getSize();
+    if(size<=0 || aStorage.getSize()<=0) return;
+
+    // INTERPOLATION INTERVALS IN aStorage
+    std::vector<int> i1(size),i2(size),count(size);
+    std::vector<double> pct(size);
+    int N = std::numeric_limits<int>::max();
+    int nFull = N;
+    for(int i=0;i<size;i++) {
+        aStorage.findInterval(_times[i],i1[i],i2[i],pct[i]);
+        N = std::min(N,std::min(aStorage._rowSizes[i1[i]],
+                aStorage._rowSizes[i2[i]]));
+        count[i] = std::min(_rowSizes[i],N);
+        nFull = std::min(nFull,count[i]);
+    }
+
+    // COMBINE BY COLUMN
+    const int nc = *std::max_element(count.begin(),count.end());
+    for(int j=0;j<nc;j++) {
+        const double *x = aStorage.getColumn(j);
+        double *column = updColumn(j);
+        for(int i=0;i<size;i++) {
+            if(j>=nFull && j>=count[i]) continue;
+            const double xi = (pct[i]==0.0) ? x[i1[i]] :
+                    x[i1[i]] + pct[i]*(x[i2[i]]-x[i1[i]]);
+            column[i] = op(column[i],xi);
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------
 // TIME
 //-----------------------------------------------------------------------------
@@ -1617,9 +1857,7 @@ store(int aStep,double aT,int aN,const double *aY)
 void Storage::
 shiftTime(double aValue)
 {
-    for(int i=0;i<_storage.getSize();i++) {
-        _storage[i].shiftTime(aValue);
-    }
+    for(double &t : _times) t += aValue;
 }
 //_____________________________________________________________________________
 /**
@@ -1630,9 +1868,7 @@ shiftTime(double aValue)
 void Storage::
 scaleTime(double aValue)
 {
-    for(int i=0;i<_storage.getSize();i++) {
-        _storage[i].scaleTime(aValue);
-    }
+    for(double &t : _times) t *= aValue;
 }
 
 //-----------------------------------------------------------------------------
@@ -1648,8 +1884,9 @@ scaleTime(double aValue)
 void Storage::
 add(double aValue)
 {
-    for(int i=0;i<_storage.getSize();i++) {
-        _storage[i].add(aValue);
+    const int nFull = getSmallestNumberOfStates();
+    for(int j=0;j<_numColumns;j++) {
+        transformColumn(j,nFull,[=](double y) { return y+aValue; });
     }
 }
 //_____________________________________________________________________________
@@ -1663,9 +1900,10 @@ add(double aValue)
 void Storage::
 add(int aN, double aValue)
 {
-    for(int i=0;i<_storage.getSize();i++) {
-        _storage[i].add(aN,aValue);
-    }
+    if(aValue==0) return;
+    const int nFull = getSmallestNumberOfStates();
+    if((aN<0)||(aN>=_numColumns)) return;
+    transformColumn(aN,nFull,[=](double y) { return y+aValue; });
 }
 //_____________________________________________________________________________
 /**
@@ -1677,8 +1915,11 @@ add(int aN, double aValue)
  * @see StateVector::add(int,double[])
  */
 void Storage::add(const SimTK::Vector_<double>& values) {
-    for(int i = 0; i < _storage.getSize(); ++i) {
-        _storage[i].add(values);
+    const int nFull = getSmallestNumberOfStates();
+    const int n = std::min(values.size(),_numColumns);
+    for(int j=0;j<n;j++) {
+        const double value = values[j];
+        transformColumn(j,nFull,[=](double y) { return y+value; });
     }
 }
 //_____________________________________________________________________________
@@ -1691,9 +1932,9 @@ void Storage::add(const SimTK::Vector_<double>& values) {
 void Storage::
 add(StateVector *aStateVector)
 {
-    for(int i=0;i<_storage.getSize();i++) {
-        _storage[i].add(aStateVector);
-    }
+    if(aStateVector==NULL) return;
+    const Array<double> &data = aStateVector->getData();
+    add(SimTK::Vector_<double>(data.getSize(),data.get()));
 }
 //_____________________________________________________________________________
 /**
@@ -1709,27 +1950,7 @@ void Storage::
 add(Storage *aStorage)
 {
     if(aStorage==NULL) return;
-
-    int n,N=0,nN;
-    double t,*Y=NULL;
-    for(int i=0;i<_storage.getSize();i++) {
-
-        // GET INFO ON THIS STORAGE INSTANCE
-        n = getStateVector(i)->getSize();
-        t = getStateVector(i)->getTime();
-
-        // GET DATA FROM ARGUMENT
-        N = aStorage->getDataAtTime(t,N,&Y);
-
-        // SET SIZE TO SMALLER
-        nN = (n<N) ? n : N;
-
-        // ADD
-        _storage[i].add(SimTK::Vector_<double>(nN, Y));
-    }
-
-    // CLEANUP
-    if(Y!=NULL) delete[] Y;
+    combineWithStorage(*aStorage,[](double y,double x) { return y+x; });
 }
 
 //-----------------------------------------------------------------------------
@@ -1745,8 +1966,9 @@ add(Storage *aStorage)
 void Storage::
 subtract(double aValue)
 {
-    for(int i=0;i<_storage.getSize();i++) {
-        _storage[i].subtract(aValue);
+    const int nFull = getSmallestNumberOfStates();
+    for(int j=0;j<_numColumns;j++) {
+        transformColumn(j,nFull,[=](double y) { return y-aValue; });
     }
 }
 //_____________________________________________________________________________
@@ -1759,8 +1981,11 @@ subtract(double aValue)
  * @see StateVector::subtract(int,double[])
  */
 void Storage::subtract(const SimTK::Vector_<double>& values) {
-    for(int i = 0; i < _storage.getSize(); ++i) {
-        _storage[i].subtract(values);
+    const int nFull = getSmallestNumberOfStates();
+    const int n = std::min(values.size(),_numColumns);
+    for(int j=0;j<n;j++) {
+        const double value = values[j];
+        transformColumn(j,nFull,[=](double y) { return y-value; });
     }
 }
 //_____________________________________________________________________________
@@ -1773,9 +1998,9 @@ void Storage::subtract(const SimTK::Vector_<double>& values) {
 void Storage::
 subtract(StateVector *aStateVector)
 {
-    for(int i=0;i<_storage.getSize();i++) {
-        _storage[i].subtract(aStateVector);
-    }
+    if(aStateVector==NULL) return;
+    const Array<double> &data = aStateVector->getData();
+    subtract(SimTK::Vector_<double>(data.getSize(),data.get()));
 }
 //_____________________________________________________________________________
 /**
@@ -1791,27 +2016,7 @@ void Storage::
 subtract(Storage *aStorage)
 {
     if(aStorage==NULL) return;
-
-    int n,N=0,nN;
-    double t,*Y=NULL;
-    for(int i=0;i<_storage.getSize();i++) {
-
-        // GET INFO ON THIS STORAGE INSTANCE
-        n = getStateVector(i)->getSize();
-        t = getStateVector(i)->getTime();
-
-        // GET DATA FROM ARGUMENT
-        N = aStorage->getDataAtTime(t,N,&Y);
-
-        // SET SIZE TO SMALLER
-        nN = (n<N) ? n : N;
-
-        // SUBTRACT
-        _storage[i].subtract(SimTK::Vector_<double>(nN, Y));
-    }
-
-    // CLEANUP
-    if(Y!=NULL) delete[] Y;
+    combineWithStorage(*aStorage,[](double y,double x) { return y-x; });
 }
 
 //-----------------------------------------------------------------------------
@@ -1827,8 +2032,9 @@ subtract(Storage *aStorage)
 void Storage::
 multiply(double aValue)
 {
-    for(int i=0;i<_storage.getSize();i++) {
-        _storage[i].multiply(aValue);
+    const int nFull = getSmallestNumberOfStates();
+    for(int j=0;j<_numColumns;j++) {
+        transformColumn(j,nFull,[=](double y) { return y*aValue; });
     }
 }
 //_____________________________________________________________________________
@@ -1841,8 +2047,11 @@ multiply(double aValue)
  * @see StateVector::multiply(int,double[])
  */
 void Storage::multiply(const SimTK::Vector_<double>& values) {
-    for(int i = 0; i < _storage.getSize(); ++i) {
-        _storage[i].multiply(values);
+    const int nFull = getSmallestNumberOfStates();
+    const int n = std::min(values.size(),_numColumns);
+    for(int j=0;j<n;j++) {
+        const double value = values[j];
+        transformColumn(j,nFull,[=](double y) { return y*value; });
     }
 }
 
@@ -1856,9 +2065,9 @@ void Storage::multiply(const SimTK::Vector_<double>& values) {
 void Storage::
 multiply(StateVector *aStateVector)
 {
-    for(int i=0;i<_storage.getSize();i++) {
-        _storage[i].multiply(aStateVector);
-    }
+    if(aStateVector==NULL) return;
+    const Array<double> &data = aStateVector->getData();
+    multiply(SimTK::Vector_<double>(data.getSize(),data.get()));
 }
 //_____________________________________________________________________________
 /**
@@ -1874,27 +2083,7 @@ void Storage::
 multiply(Storage *aStorage)
 {
     if(aStorage==NULL) return;
-
-    int n,N=0,nN;
-    double t,*Y=NULL;
-    for(int i=0;i<_storage.getSize();i++) {
-
-        // GET INFO ON THIS STORAGE INSTANCE
-        n = getStateVector(i)->getSize();
-        t = getStateVector(i)->getTime();
-
-        // GET DATA FROM ARGUMENT
-        N = aStorage->getDataAtTime(t,N,&Y);
-
-        // SET SIZE TO SMALLER
-        nN = (n<N) ? n : N;
-
-        // MULTIPLY
-        _storage[i].multiply(SimTK::Vector_<double>(nN, Y));
-    }
-
-    // CLEANUP
-    if(Y!=NULL) delete[] Y;
+    combineWithStorage(*aStorage,[](double y,double x) { return y*x; });
 }
 //_____________________________________________________________________________
 /**
@@ -1906,12 +2095,9 @@ multiply(Storage *aStorage)
 void Storage::
 multiplyColumn(int aIndex, double aValue)
 {
-    double newValue;
-    for(int i=0;i<_storage.getSize();i++) {
-        _storage[i].getDataValue(aIndex, newValue);
-        newValue *= aValue;
-        _storage[i].setDataValue(aIndex, newValue);
-    }
+    const int nFull = getSmallestNumberOfStates();
+    if((aIndex<0)||(aIndex>=_numColumns)) return;
+    transformColumn(aIndex,nFull,[=](double y) { return y*aValue; });
 }
 
 //-----------------------------------------------------------------------------
@@ -1926,21 +2112,31 @@ multiplyColumn(int aIndex, double aValue)
 void Storage::
 divide(double aValue)
 {
-    for(int i=0;i<_storage.getSize();i++) {
-        _storage[i].divide(aValue);
+    if(aValue==0.0) {
+        cout << "Storage.divide: ERROR- divide by zero" << endl;
+        return;
+    }
+    const int nFull = getSmallestNumberOfStates();
+    for(int j=0;j<_numColumns;j++) {
+        transformColumn(j,nFull,[=](double y) { return y/aValue; });
     }
 }
 //_____________________________________________________________________________
 /**
  * Divide all state vectors in this storage instance by an array.
  *
- * Only the first aN states of each state vector are altered.
+ * Only the first aN states of each state vector are altered. States
+ * divided by zero are set to NaN.
  *
  * @param values Array of values the states are to be divided by.
  */
 void Storage::divide(const SimTK::Vector_<double>& values) {
-    for(int i = 0; i < _storage.getSize(); ++i) {
-        _storage[i].divide(values);
+    const int nFull = getSmallestNumberOfStates();
+    const int n = std::min(values.size(),_numColumns);
+    for(int j=0;j<n;j++) {
+        const double value = values[j];
+        transformColumn(j,nFull,[=](double y) {
+            return (value==0.0) ? SimTK::NaN : y/value; });
     }
 }
 //_____________________________________________________________________________
@@ -1952,9 +2148,9 @@ void Storage::divide(const SimTK::Vector_<double>& values) {
 void Storage::
 divide(StateVector *aStateVector)
 {
-    for(int i=0;i<_storage.getSize();i++) {
-        _storage[i].divide(aStateVector);
-    }
+    if(aStateVector==NULL) return;
+    const Array<double> &data = aStateVector->getData();
+    divide(SimTK::Vector_<double>(data.getSize(),data.get()));
 }
 //_____________________________________________________________________________
 /**
@@ -1970,28 +2166,8 @@ void Storage::
 divide(Storage *aStorage)
 {
     if(aStorage==NULL) return;
-
-    int i;
-    int n,N=0,nN;
-    double t,*Y=NULL;
-    for(i=0;i<_storage.getSize();i++) {
-
-        // GET INFO ON THIS STORAGE INSTANCE
-        n = getStateVector(i)->getSize();
-        t = getStateVector(i)->getTime();
-
-        // GET DATA FROM ARGUMENT
-        N = aStorage->getDataAtTime(t,N,&Y);
-
-        // SET SIZE TO SMALLER
-        nN = (n<N) ? n : N;
-
-        // DIVIDE
-        _storage[i].divide(SimTK::Vector_<double>(nN, Y));
-    }
-
-    // CLEANUP
-    if(Y!=NULL) delete[] Y;
+    combineWithStorage(*aStorage,[](double y,double x) {
+        return (x==0.0) ? SimTK::NaN : y/x; });
 }
 
 //=============================================================================
@@ -2071,7 +2247,7 @@ int Storage::
 integrate(int aI1,int aI2,int aN,double *rArea,Storage *rStorage) const
 {
     // CHECK THAT THERE ARE STATES STORED
-    if(_storage.getSize()<=0) {
+    if(getSize()<=0) {
         cout << "Storage.integrate: ERROR- no stored states." << endl;
         return(0);
     }
@@ -2092,11 +2268,10 @@ integrate(int aI1,int aI2,int aN,double *rArea,Storage *rStorage) const
 
     // SET THE INDICES
     if(aI1<0) aI1 = 0;
-    if(aI2<0) aI2 = _storage.getSize()-1;
+    if(aI2<0) aI2 = getSize()-1;
 
     // WORKING MEMORY
     double ti,tf;
-    double *yi=NULL,*yf=NULL;
 
     bool functionAllocatedArea = false;
     if(!rArea) {
@@ -2109,28 +2284,36 @@ integrate(int aI1,int aI2,int aN,double *rArea,Storage *rStorage) const
 
     // RECORD FIRST STATE
     if(rStorage) {
-        ti = getStateVector(aI1)->getTime();
+        ti = _times[aI1];
         rStorage->append(ti,n,rArea);
     }
 
     // INTEGRATE
-    for(int I=aI1;I<aI2;I++) {
+    if(rStorage==NULL) {
+        // Only the total is needed, so integrate one column at a time.
+        for(int i=0;i<n;i++) {
+            const double *y = getColumn(i);
+            double area = 0.0;
+            for(int I=aI1;I<aI2;I++) {
+                area += 0.5*(y[I+1]+y[I])*(_times[I+1]-_times[I]);
+            }
+            rArea[i] += area;
+        }
+    } else {
+        for(int I=aI1;I<aI2;I++) {
 
-        // INITIAL
-        ti = getStateVector(I)->getTime();
-        yi = getStateVector(I)->getData().get();
+            // INITIAL AND FINAL
+            ti = _times[I];
+            tf = _times[I+1];
 
-        // FINAL
-        tf = getStateVector(I+1)->getTime();
-        yf = getStateVector(I+1)->getData().get();
+            // AREA
+            for(int i=0;i<n;i++) {
+                rArea[i] += 0.5*(getValue(I+1,i)+getValue(I,i))*(tf-ti);
+            }
 
-        // AREA
-        for(int i=0;i<n;i++) {
-            rArea[i] += 0.5*(yf[i]+yi[i])*(tf-ti);
+            // APPEND
+            rStorage->append(tf,n,rArea);
         }
-
-        // APPEND
-        if(rStorage) rStorage->append(tf,n,rArea);
     }
 
     // CLEANUP
@@ -2146,7 +2329,7 @@ int Storage::
 integrate(double aTI,double aTF,int aN,double *rArea,Storage *rStorage) const
 {
     // CHECK THAT THERE ARE STATES STORED
-    if(_storage.getSize()<=0) {
+    if(getSize()<=0) {
         cout << "Storage.integrate: ERROR- no stored states." << endl;
         return(0);
     }
@@ -2211,35 +2394,30 @@ integrate(double aTI,double aTF,int aN,double *rArea,Storage *rStorage) const
 
     // SPANS MULTIPLE INTERVALS
     } else {
-        double *yi=NULL,*yf=NULL;
 
         // FIRST SLICE
         getDataAtTime(aTI,n,&yI);
-        tf = getStateVector(II)->getTime();
-        yf = getStateVector(II)->getData().get();
+        tf = _times[II];
         for(int i=0;i<n;i++) {
-            rArea[i] += 0.5*(yf[i]+yI[i])*(tf-aTI);
+            rArea[i] += 0.5*(getValue(II,i)+yI[i])*(tf-aTI);
         }
         if(rStorage) rStorage->append(tf,n,rArea);
 
         // INTERVALS
         for(int I=II;I<FF;I++) {
-            ti = getStateVector(I)->getTime();
-            yi = getStateVector(I)->getData().get();
-            tf = getStateVector(I+1)->getTime();
-            yf = getStateVector(I+1)->getData().get();
+            ti = _times[I];
+            tf = _times[I+1];
             for(int i=0;i<n;i++) {
-                rArea[i] += 0.5*(yf[i]+yi[i])*(tf-ti);
+                rArea[i] += 0.5*(getValue(I+1,i)+getValue(I,i))*(tf-ti);
             }
             if(rStorage) rStorage->append(tf,n,rArea);
         }
 
         // LAST SLICE
-        ti = getStateVector(FF)->getTime();
-        yi = getStateVector(FF)->getData().get();
+        ti = _times[FF];
         getDataAtTime(aTF,n,&yF);
         for(int i=0;i<n;i++) {
-            rArea[i] += 0.5*(yF[i]+yi[i])*(aTF-ti);
+            rArea[i] += 0.5*(yF[i]+getValue(FF,i))*(aTF-ti);
         }
         if(rStorage) rStorage->append(aTF,n,rArea);
     }
@@ -2267,7 +2445,7 @@ computeArea(int aN,double *aArea) const
     // CHECK FOR VALID OUTPUT ARRAYS
     if(aN<=0) return(0);
     else if(aArea==NULL) return(0);
-    else return integrate(0,_storage.getSize()-1,aN,aArea,NULL);
+    else return integrate(0,getSize()-1,aN,aArea,NULL);
 }
 //_____________________________________________________________________________
 /**
@@ -2378,27 +2556,24 @@ pad(int aPadSize)
     Signal::Pad(aPadSize,paddedTime);
     int newSize = paddedTime.getSize();
 
-    // PAD EACH COLUMN
+    // PAD EACH COLUMN INTO A NEW BLOCK
     int nc = getSmallestNumberOfStates();
+    std::vector<double> data((size_t)newSize*nc);
     Array<double> paddedSignal(0.0,size);
-    StateVector *vecs = new StateVector[newSize];
-    for(int j=0;j<newSize;j++) {
-        vecs[j].getData().setSize(nc);
-        vecs[j].setTime(paddedTime[j]);
-    }
     for(int i=0;i<nc;i++) {
-        getDataColumn(i,paddedSignal);
+        paddedSignal.setSize(size);
+        std::copy(getColumn(i),getColumn(i)+size,paddedSignal.get());
         Signal::Pad(aPadSize,paddedSignal);
-        for(int j=0;j<newSize;j++)
-            vecs[j].setDataValue(i,paddedSignal[j]);
+        std::copy(paddedSignal.get(),paddedSignal.get()+newSize,
+                data.begin()+(size_t)i*newSize);
     }
 
-    // APPEND THE STATEVECTORS
-    _storage.setSize(0);
-    for(int i=0;i<newSize;i++) _storage.append(vecs[i]);
-
-    // CLEANUP
-    delete[] vecs;
+    // REPLACE THE DATA
+    _data.swap(data);
+    _rowCapacity = newSize;
+    _numColumns = nc;
+    _times.assign(paddedTime.get(),paddedTime.get()+newSize);
+    _rowSizes.assign(newSize,nc);
 }
 
 void Storage::
@@ -2406,7 +2581,7 @@ smoothSpline(int aOrder,double aCutoffFrequency)
 {
     int size = getSize();
     double dtmin = getMinTimeStep();
-    double avgDt = (_storage[size-1].getTime() - _storage[0].getTime()) / (size-1);
+    double avgDt = (getLastTime() - getFirstTime()) / (size-1);
 
     if(dtmin<SimTK::Eps) {
         cout<<"Storage.SmoothSpline: storage cannot be resampled."<<endl;
@@ -2446,7 +2621,7 @@ lowpassIIR(double aCutoffFrequency)
 {
     int size = getSize();
     double dtmin = getMinTimeStep();
-    double avgDt = (_storage[size-1].getTime() - _storage[0].getTime()) / (size-1);
+    double avgDt = (getLastTime() - getFirstTime()) / (size-1);
 
     if(dtmin<SimTK::Eps) {
         cout<<"Storage.lowpassIIR: storage cannot be resampled."<<endl;
@@ -2483,7 +2658,7 @@ lowpassFIR(int aOrder,double aCutoffFrequency)
 {
     int size = getSize();
     double dtmin = getMinTimeStep();
-    double avgDt = (_storage[size-1].getTime() - _storage[0].getTime()) / (size-1);
+    double avgDt = (getLastTime() - getFirstTime()) / (size-1);
 
     if (dtmin<SimTK::Eps) {
         cout<<"Storage.lowpassFIR: storage cannot be resampled."<<endl;
@@ -2537,16 +2712,24 @@ lowpassFIR(int aOrder,double aCutoffFrequency)
 int Storage::
 findIndex(int aI,double aT) const
 {
+
     // MAKE SURE aI IS VALID
-    if(_storage.getSize()<=0) return(-1);
-    if((aI>=_storage.getSize())||(aI<0)) aI=0;
-    if(getStateVector(aI)->getTime()>aT) aI=0;
+    const int size = getSize();
+    if(size<=0) return(-1);
+    if((aI>=size)||(aI<0)) aI=0;
 
     // SEARCH
-    //cout << "Storage.findIndex: starting at " << aI << endl;
+    // Successive queries usually fall in the same or the next interval, so
+    // check those before searching the rest of the storage.
     int i;
-    for(i=aI;i<_storage.getSize();i++) {
-        if(aT<getStateVector(i)->getTime()) break;
+    if(aT<_times[aI]) {
+        i = findUpperBound(0,aI,aT);
+    } else if(aI+1==size || aT<_times[aI+1]) {
+        i = aI+1;
+    } else if(aI+2==size || aT<_times[aI+2]) {
+        i = aI+2;
+    } else {
+        i = findUpperBound(aI+3,size,aT);
     }
     _lastI = i-1;
     if(_lastI<0) _lastI=0;
@@ -2567,16 +2750,63 @@ findIndex(int aI,double aT) const
 int Storage::
 findIndex(double aT) const
 {
-    if(_storage.getSize()<=0) return(-1);
-    int i;
-    for(i=0;i<_storage.getSize();i++) {
-        if(aT<getStateVector(i)->getTime()) break;
-    }
+    if(getSize()<=0) return(-1);
+    int i = findUpperBound(0,getSize(),aT);
     _lastI = i-1;
     if(_lastI<0) _lastI=0;
     return(_lastI);
 }
 //_____________________________________________________________________________
+/**
+ * Binary search for the first storage element in [aLo, aHi) whose time is
+ * greater than aT. The times of the stored states are assumed to be
+ * nondecreasing.
+ *
+ * @return Index of the first element occurring after aT, or aHi if there is
+ * no such element.
+ */
+int Storage::
+findUpperBound(int aLo,int aHi,double aT) const
+{
+    while(aLo<aHi) {
+        int mid = aLo + (aHi-aLo)/2;
+        if(aT<_times[mid]) aHi = mid;
+        else aLo = mid+1;
+    }
+    return(aLo);
+}
+//_____________________________________________________________________________
+/**
+ * Find the pair of stored states to interpolate between to get the states
+ * at time aT, starting the search at the last index that was found.
+ *
+ * @param aT Time.
+ * @param rI1 Index of the state at or before aT.
+ * @param rI2 Index of the state after aT (equal to rI1 if there is only one
+ * stored state).
+ * @param rPct Fraction of the interval [time(rI1), time(rI2)] at aT.
+ * @return False if there are no stored states.
+ */
+bool Storage::
+findInterval(double aT,int &rI1,int &rI2,double &rPct) const
+{
+    const int size = getSize();
+    int i = findIndex(_lastI,aT);
+    if((i<0)||(size<=0)) return(false);
+
+    // CHECK FOR i AT END POINTS
+    rI1 = i;  rI2 = i+1;
+    if(rI2==size) {
+        rI1--;  if(rI1<0) rI1=0;
+        rI2--;  if(rI2<0) rI2=0;
+    }
+
+    double t1 = _times[rI1];
+    double den = _times[rI2]-t1;
+    rPct = (den<SimTK::Eps) ? 0.0 : (aT-t1)/den;
+    return(true);
+}
+//_____________________________________________________________________________
 /** 
  * Find the range of frames that is between start time and end time
  * (inclusive). Return the indices of the bounding frames.
@@ -2599,7 +2829,7 @@ void Storage::findFrameRange(double aStartTime, double aEndTime, int& oStartFram
 double Storage::
 resample(double aDT, int aDegree)
 {
-    int numDataRows = _storage.getSize();
+    int numDataRows = getSize();
 
     if(numDataRows<=1) return aDT;
 
@@ -2615,7 +2845,10 @@ resample(double aDT, int aDegree)
 
     Array<std::string> saveLabels = getColumnLabels();
     // Free up memory used by Storage
-    _storage.setSize(0);
+    reset(0);
+    std::vector<double>().swap(_data);
+    _rowCapacity = 0;
+    _numColumns = 0;
     // For every column, collect data and fit spline to originalTimes, dataColumn.
     Storage *newStorage = splineSet->constructStorage(0,aDT);
     newStorage->setInDegrees(isInDegrees());
@@ -2635,7 +2868,7 @@ resample(double aDT, int aDegree)
 double Storage::
 resampleLinear(double aDT)
 {
-    int numDataRows = _storage.getSize();
+    int numDataRows = getSize();
 
     if(numDataRows<=1) return aDT;
 
@@ -2682,31 +2915,71 @@ resampleLinear(double aDT)
  */
 void Storage::interpolateAt(const Array<double> &targetTimes)
 {
+    const int size = getSize();
+    if(size<=0) return;
+
+    // COLLECT THE TIMES THAT DO NOT ALREADY HAVE A ROW
+    std::vector<double> newTimes;
     for(int i=0; i<targetTimes.getSize();i++){
         double t = targetTimes[i];
         // get index for t
         int tIndex = findIndex(t);
         // If within small number from t then pass
-        double actualTime=0.0;
-        if (tIndex < getSize()-1){
-            getTime(tIndex+1, actualTime);
-            if (fabs(actualTime - t)<1e-6) 
-                    continue;
-        }
+        if (tIndex < size-1 && fabs(_times[tIndex+1] - t)<1e-6)
+            continue;
         // or could be the following one too
-        getTime(tIndex, actualTime);
-        if (fabs(actualTime - t)<1e-6) 
-                continue;
-        // create a StateVector and add it
-        double *y=NULL;
-        int ny=0;
-        StateVector vec;
-        // INTERPOLATE THE STATES
-        ny = getDataAtTime(t,ny,&y);
-        vec.setStates(t, SimTK::Vector_<double>(ny, y));
-
-        _storage.insert(tIndex+1, vec);
+        if (fabs(_times[tIndex] - t)<1e-6)
+            continue;
+        newTimes.push_back(t);
+    }
+    if(newTimes.empty()) return;
+    std::sort(newTimes.begin(),newTimes.end());
+
+    // MERGE THE NEW ROWS WITH THE EXISTING ONES
+    // Each row of the result is interpolated between rows i1 and i2 of this
+    // storage; existing rows are simply rows with i1==i2 and pct==0.
+    std::vector<double> times;
+    std::vector<int> rowSizes, i1s, i2s;
+    std::vector<double> pcts;
+    times.reserve(size+newTimes.size());
+    int r = 0;
+    for(size_t k=0; k<=newTimes.size(); k++) {
+        const double t = k<newTimes.size() ? newTimes[k] :
+                std::numeric_limits<double>::infinity();
+        for(; r<size && _times[r]<t; r++) {
+            times.push_back(_times[r]);
+            rowSizes.push_back(_rowSizes[r]);
+            i1s.push_back(r); i2s.push_back(r); pcts.push_back(0.0);
+        }
+        if(k==newTimes.size()) break;
+        // Skip duplicates among the requested times.
+        if(!times.empty() && fabs(times.back() - t)<1e-6) continue;
+        int i1,i2;
+        double pct;
+        findInterval(t,i1,i2,pct);
+        times.push_back(t);
+        rowSizes.push_back(std::min(_rowSizes[i1],_rowSizes[i2]));
+        i1s.push_back(i1); i2s.push_back(i2); pcts.push_back(pct);
+    }
+
+    const int newSize = (int)times.size();
+    std::vector<double> data((size_t)newSize*_numColumns,0.0);
+    for(int j=0; j<_numColumns; j++) {
+        const double *column = getColumn(j);
+        double *newColumn = &data[(size_t)j*newSize];
+        for(int k=0; k<newSize; k++) {
+            if(j>=rowSizes[k]) continue;
+            const double y1 = column[i1s[k]];
+            newColumn[k] = pcts[k]==0.0 ? y1 :
+                    y1 + pcts[k]*(column[i2s[k]]-y1);
+        }
     }
+
+    _data.swap(data);
+    _times.swap(times);
+    _rowSizes.swap(rowSizes);
+    _rowCapacity = newSize;
+    _lastI = 0;
 }
 //=============================================================================
 // IO
@@ -2747,17 +3020,38 @@ setOutputFileName(const std::string& aFileName)
  * @param aMode Writing mode: "w" means write and "a" means append.  The 
  * default is "w".
  * @param aComment string to be written to the file header (preceded by # per SIMM)
+ * @param aNumThreads Number of threads that format the rows (see
+ * TextRowWriter). A value of 0 or less uses one thread per processor.
  * @return true on success
  */
 bool Storage::
-print(const string &aFileName,const string &aMode, const string& aComment) const
+print(const string &aFileName,const string &aMode, const string& aComment,
+      int aNumThreads) const
 {
+    // BINARY FILES
+    const size_t dot = aFileName.find_last_of('.');
+    if(dot!=string::npos && SimTK::String::toLower(
+            aFileName.substr(dot+1))==BinaryFileAdapter::extension()) {
+        try {
+            const TimeSeriesTable table = exportToTable();
+            if(aMode=="a" && ifstream(aFileName).good())
+                BinaryFileAdapter::append(table, aFileName);
+            else
+                BinaryFileAdapter::write(table, aFileName);
+        } catch(const std::exception& x) {
+            cout << "Storage.print(const string&,const string&): failed to"
+                 << " write file " << aFileName << endl << x.what() << endl;
+            return(false);
+        }
+        return(getSize()!=0);
+    }
+
     // OPEN THE FILE
     FILE *fp = IO::OpenFile(aFileName,aMode);
     if(fp==NULL) return(false);
 
     // WRITE THE HEADER
-    int n=0,nTotal=0;
+    int n=0;
     n = writeHeader(fp);
     if(n<0) {
         cout << "Storage.print(const string&,const string&): failed to" << endl
@@ -2791,23 +3085,51 @@ print(const string &aFileName,const string &aMode, const string& aComment) const
         return(false);
     }
 
-//printf("Storage.cpp:print storage=%x  n=%d ",&_storage, _storage.getSize());
-//std::cout << aFileName << endl;
-
     // VECTORS
-    for(int i=0;i<_storage.getSize();i++) {
-        n = getStateVector(i)->print(fp);
-        if(n<0) {
-            cout << "Storage.print(const string&,const string&): error printing to " << aFileName;
-            return(false);
-        }
-        nTotal += n;        
+    // Rows are formatted as by printRow(), on several threads.
+    const string format = IO::GetDoubleOutputFormat();
+    const bool written = TextRowWriter::write(fp, getSize(),
+        [&](size_t aRow, string& rBuffer) {
+            const int i = (int)aRow;
+            TextRowWriter::appendDouble(rBuffer, format.c_str(), _times[i]);
+            const int ns = _rowSizes[i];
+            for(int j=0;j<ns;j++) {
+                rBuffer += '\t';
+                TextRowWriter::appendDouble(rBuffer, format.c_str(),
+                                            getValue(i,j));
+            }
+            rBuffer += '\n';
+        },
+        aNumThreads);
+    if(!written) {
+        cout << "Storage.print(const string&,const string&): error printing to " << aFileName;
+        fclose(fp);
+        return(false);
     }
 
     // CLOSE
     fclose(fp);
 
-    return(nTotal!=0);
+    return(getSize()!=0);
+}
+//_____________________________________________________________________________
+/**
+ * Print the contents of this storage instance to a file on a background
+ * thread, so that the caller can keep computing while the file is written.
+ * A copy of this storage is printed, so this storage may be changed or
+ * destroyed while the file is written.
+ *
+ * @return Future holding the result of print().
+ */
+std::future<bool> Storage::
+printAsync(const string &aFileName,const string &aMode, const string& aComment) const
+{
+    auto copy = std::make_shared<Storage>(*this);
+    // Not copied by the copy constructor.
+    copy->_writeSIMMHeader = _writeSIMMHeader;
+    return std::async(std::launch::async, [=] {
+        return copy->print(aFileName, aMode, aComment);
+    });
 }
 //_____________________________________________________________________________
 /**
@@ -2820,11 +3142,15 @@ print(const string &aFileName,const string &aMode, const string& aComment) const
  *
  * The argument aDT specifies the time spacing.
  *
+ * The argument aNumThreads is the number of threads that format the rows
+ * (see TextRowWriter). A value of 0 or less uses one thread per processor.
+ *
  * The total number of characters written is returned.  If an error occurred,
  * a negative number is returned.
  */
 int Storage::
-print(const string &aFileName,double aDT,const string &aMode) const
+print(const string &aFileName,double aDT,const string &aMode,
+      int aNumThreads) const
 {
     // CHECK FOR VALID DT
     if(aDT<=0) return(0);
@@ -2876,41 +3202,72 @@ print(const string &aFileName,double aDT,const string &aMode) const
         return(n);
     }
 
-    // LOOP THROUGH THE DATA
-    int i,ny=0;
-    double t,*y=NULL;
-    StateVector vec;
-    for(t=ti,i=0;i<nr;i++,t=ti+aDT*(double)i) {
-
-        // INTERPOLATE THE STATES
-        ny = getDataAtTime(t,ny,&y);
-        vec.setStates(t, SimTK::Vector_<double>(ny, y));
-
-        // PRINT
-        n = vec.print(fp);
-        if(n<0) {
-            cout << "Storage.print(const string&,const string&): error printing to " << aFileName;
-            return(n);
+    // FIND THE INTERVALS OF THE ROWS
+    // findInterval() is not thread safe, so the intervals are found first.
+    // As in getDataAtTime(), a row has no more states than the one before it
+    // (until a time outside the storage is reached).
+    struct Sample { int i1, i2, ns; double pct; };
+    std::vector<Sample> samples(nr>0 ? nr : 0);
+    int ny=0;
+    bool hasPrevious=false;
+    for(int i=0;i<nr;i++) {
+        Sample& sample = samples[i];
+        if(!findInterval(ti+aDT*(double)i,sample.i1,sample.i2,sample.pct)) {
+            sample.ns = ny = 0;
+            hasPrevious = false;
+            continue;
         }
-        nTotal += n;        
+        int ns = std::min(_rowSizes[sample.i1],_rowSizes[sample.i2]);
+        if(hasPrevious && ny<ns) ns = ny;
+        sample.ns = ny = ns;
+        hasPrevious = true;
+    }
+
+    // INTERPOLATE AND PRINT THE ROWS
+    // Rows are formatted as by StateVector::print(), on several threads.
+    const string format = IO::GetDoubleOutputFormat();
+    const bool written = TextRowWriter::write(samples.size(),
+        [&](size_t aRow, string& rBuffer) {
+            const Sample& sample = samples[aRow];
+            TextRowWriter::appendDouble(rBuffer, format.c_str(),
+                                        ti+aDT*(double)aRow);
+            for(int j=0;j<sample.ns;j++) {
+                const double *column = getColumn(j);
+                const double value = (sample.pct==0.0) ? column[sample.i1] :
+                    column[sample.i1] +
+                    sample.pct*(column[sample.i2]-column[sample.i1]);
+                rBuffer += '\t';
+                TextRowWriter::appendDouble(rBuffer, format.c_str(), value);
+            }
+            rBuffer += '\n';
+        },
+        [&](const char *aData, size_t aSize) {
+            nTotal += (int)aSize;
+            return fwrite(aData,1,aSize,fp)==aSize;
+        },
+        aNumThreads);
+    if(!written) {
+        cout << "Storage.print(const string&,const string&): error printing to " << aFileName;
+        fclose(fp);
+        return(-1);
     }
 
     // CLEANUP
     fclose(fp);
-    if(y!=NULL) { delete[] y;  y=NULL; }
 
     return(nTotal);
 }
 
 void Storage::
 printResult(const Storage *aStorage,const std::string &aName,
-                const std::string &aDir,double aDT,const std::string &aExtension)
+                const std::string &aDir,double aDT,const std::string &aExtension,
+                int aNumThreads)
 {
     if(!aStorage) return;
     std::string path = (aDir=="") ? "." : aDir;
     std::string name = (aName.rfind(aExtension)==string::npos)? (path + "/" + aName + aExtension) :  (path + "/" + aName);
-    if(aDT<=0.0) aStorage->print(name);
-    else aStorage->print(name,aDT);
+    if(aDT<=0.0) aStorage->print(name,"w","",aNumThreads);
+    else aStorage->print(name,aDT,"w",aNumThreads);
 }
 
 //_____________________________________________________________________________
@@ -2925,7 +3282,7 @@ writeHeader(FILE *rFP,double aDT) const
     // COMPUTE ATTRIBUTES
     int nr,nc;
     if(aDT<=0) {
-        nr = _storage.getSize();
+        nr = getSize();
     } else {
         double ti = getFirstTime();
         double tf = getLastTime();
@@ -2970,7 +3327,7 @@ writeSIMMHeader(FILE *rFP,double aDT, const char *aComment) const
     // ROWS
     int nRows;
     if(aDT<=0) {
-        nRows = _storage.getSize();
+        nRows = getSize();
     } else {
         nRows = IO::ComputeNumberOfSteps(getFirstTime(),getLastTime(),aDT);
     }
@@ -3058,23 +3415,27 @@ void Storage::addToRdStorage(Storage& rStorage, double aStartTime, double aEndTi
         rStorage.getTime(i, stateTime);
         for (j = 0; j < getSize(); j++) {
             /* Assume that the first column is 'time'. */
-            time = getStateVector(j)->getTime();
+            time = _times[j];
             // The following tolerance is a hack. Previously, it used 0.0001
             // which caused values to be duplicated in cases where time
             // steps were within the tolerance. This method should only be
             // used to concatenate data columns from the same simulation
             // or analysis results.
             if (EQUAL_WITHIN_TOLERANCE(time, stateTime, SimTK::SignificantReal)) {
-                Array<double>& states = rStorage.getStateVector(i)->getData();
+                StateVector row = rStorage.getRow(i);
+                Array<double>& states = row.getData();
                 // Start at 1 to avoid duplicate time column
                 for (int k = 1; k < numColumns; k++)
                 {
                     if (_columnLabels[k] != "Unassigned")
                     {
-                        states.append(getStateVector(j)->getData().get(k-1));
+                        if (k-1 >= _rowSizes[j])
+                            throw(Exception("Array index out of bounds."));
+                        states.append(getValue(j,k-1));
                         addedData = true;
                     }
                 }
+                rStorage.setRow(i, row);
                 break;
             }
         }
@@ -3243,13 +3604,10 @@ bool Storage::parseHeaders(std::ifstream& aStream, int& rNumRows, int& rNumColum
 void Storage::
 exchangeTimeColumnWith(int aColumnIndex)
 {
-    StateVector* vec;
-    for(int i=0; i< _storage.getSize(); i++){
-        vec = getStateVector(i);
-        double swap = vec->getData().get(aColumnIndex);
-        double time=vec->getTime();
-        vec->setDataValue(aColumnIndex, time);
-        vec->setTime(swap);
+    double *column = (aColumnIndex<_numColumns) ? updColumn(aColumnIndex) : NULL;
+    for(int i=0; i<getSize(); i++){
+        if(aColumnIndex>=_rowSizes[i]) continue;
+        std::swap(_times[i],column[i]);
     }
     // Now column labels
     string swap = _columnLabels.get(0);
@@ -3283,15 +3641,16 @@ void Storage::postProcessSIMMMotion()
                 string rangeValue = iter->second;
                 double start, end;
                 sscanf(rangeValue.c_str(), "%lf %lf", &start, &end);
-                if (_storage.getSize()<2){  // Something wrong throw exception unless start==end
+                if (getSize()<2){  // Something wrong throw exception unless start==end
                     if (start !=end){
                         stringstream errorMessage;
                         errorMessage << "Error: Motion file has inconsistent headers";
                         throw (Exception(errorMessage.str()));
                     }
-                    else if (_storage.getSize()==1){
+                    else if (getSize()==1){
                         // Prepend a Time column
-                        StateVector vec = _storage.get(0);
+                        StateVector vec;
+                        copyRow(0,vec);
                         vec.getData().append(0.0);
                         _columnLabels.append("time");
                         exchangeTimeColumnWith(_columnLabels.findIndex("time"));
@@ -3300,11 +3659,13 @@ void Storage::postProcessSIMMMotion()
                         throw (Exception("File has no data"));
                 }
                 else {  // time  column from range, size
-                    double timeStep = (end - start)/(_storage.getSize()-1);
+                    double timeStep = (end - start)/(getSize()-1);
                     _columnLabels.append("time");
-                    for(int i=0; i<_storage.getSize(); i++){
-                        Array<double>& data=_storage.updElt(i).getData();
-                        data.append(i*timeStep);
+                    for(int i=0; i<getSize(); i++){
+                        const int n = _rowSizes[i];
+                        ensureNumColumns(n+1);
+                        updColumn(n)[i] = i*timeStep;
+                        _rowSizes[i] = n+1;
                     }
                     int timeColumnIndex=_columnLabels.findIndex("time");
                     exchangeTimeColumnWith(timeColumnIndex-1);
@@ -32,6 +32,11 @@
 #include "StorageInterface.h"
 #include "TimeSeriesTable.h"
 
+#include <future>
+#include <map>
+#include <memory>
+#include <vector>
+
 const int Storage_DEFAULT_CAPACITY = 256;
 //=============================================================================
 //=============================================================================
@@ -58,6 +63,13 @@ typedef std::map<std::string, std::string, std::less<std::string> > MapKeysToVal
  * TimeIndex, and a particular state (or column) is indexed by the
  * StateIndex.
  *
+ * The data are stored by column: the times are held in one contiguous
+ * vector and the states in a single column-major block that grows by
+ * doubling (see setCapacityIncrement()), so that extracting, interpolating,
+ * and operating on columns does not touch a separately allocated block per
+ * row. Rows are handed out as StateVectors built from the columns on
+ * demand (see getStateVector() and getRow()); use setRow() to change a row.
+ *
  * @version 1.0
  * @author Frank C. Anderson
  */
@@ -76,8 +88,23 @@ public:
 protected:
     static std::string simmReservedKeys[];
 
-    /** Array of StateVectors. */
-    Array<StateVector> _storage;
+    /** Times of the stored statevectors (rows). */
+    std::vector<double> _times;
+    /** Number of states in each row. Rows need not have the same number of
+    states. */
+    std::vector<int> _rowSizes;
+    /** States in column-major order: state j of row i is at
+    _data[j*_rowCapacity + i]. Entries past the end of a row are zero. */
+    std::vector<double> _data;
+    /** Number of rows for which the columns of _data have room. */
+    int _rowCapacity;
+    /** Number of columns in _data (the size of the largest row). */
+    int _numColumns;
+    /** Increment by which the row capacity grows (see
+    Array::setCapacityIncrement()). */
+    int _capacityIncrement;
+    /** Row most recently requested with getStateVector(). */
+    mutable StateVector _rowCache;
     /** Token used to mark the end of the description in a file. */
     std::string _headerToken;
     /** Column labels. */
@@ -165,11 +192,27 @@ public:
     // GET AND SET
     //--------------------------------------------------------------------------
     // SIZE
-    int getSize() const override { return(_storage.getSize()); }
+    int getSize() const override { return((int)_times.size()); }
     // STATEVECTOR
     int getSmallestNumberOfStates() const;
+    /** Get the row at aTimeIndex, or NULL if there is no such row. The row
+    is copied into a StateVector owned by this Storage, which is overwritten
+    by the next call to getStateVector() or getLastStateVector(); changes
+    made to it do not affect this Storage (use setRow()). For bulk access,
+    prefer getValue(), getDataColumn(), and getTimeColumn(), which do not
+    copy rows. */
     StateVector* getStateVector(int aTimeIndex) const override;
+    /** Get the last row, or NULL if this Storage is empty. See
+    getStateVector(). */
     StateVector* getLastStateVector() const override;
+    /** Get a copy of the row at aTimeIndex. Throws if aTimeIndex is out of
+    bounds. */
+    StateVector getRow(int aTimeIndex) const;
+    /** Get a copy of the last row. Throws if this Storage is empty. */
+    StateVector getLastRow() const;
+    /** Replace the time and states of the row at aTimeIndex with those of
+    aRow. Throws if aTimeIndex is out of bounds. */
+    void setRow(int aTimeIndex,const StateVector &aRow);
     // TIME
     double getFirstTime() const override;
     double getLastTime() const override;
@@ -257,7 +300,7 @@ public:
     //--------------------------------------------------------------------------
     int reset(int aIndex=0);
     int reset(double aTime);
-    void purge() { _storage.setSize(0); };  // Similar to reset but doesn't try to keep history
+    void purge() { reset(0); };  // Similar to reset but doesn't try to keep history
     void crop(const double newStartTime, const double newFinalTime);
     //--------------------------------------------------------------------------
     // STORAGE
@@ -360,12 +403,18 @@ public:
     //--------------------------------------------------------------------------
     // IO
     //--------------------------------------------------------------------------
-    bool print(const std::string &aFileName,const std::string &aMode="w", const std::string& aComment="") const;
-    int print(const std::string &aFileName,double aDT,const std::string &aMode="w") const;
+    bool print(const std::string &aFileName,const std::string &aMode="w", const std::string& aComment="",
+               int aNumThreads=0) const;
+    int print(const std::string &aFileName,double aDT,const std::string &aMode="w",
+              int aNumThreads=0) const;
+#ifndef SWIG
+    std::future<bool> printAsync(const std::string &aFileName,const std::string &aMode="w", const std::string& aComment="") const;
+#endif
     void setOutputFileName(const std::string& aFileName) override ;
     // convenience function for Analyses and DerivCallbacks
     static void printResult(const Storage *aStorage,const std::string &aName,
-        const std::string &aDir,double aDT,const std::string &aExtension);
+        const std::string &aDir,double aDT,const std::string &aExtension,
+        int aNumThreads=0);
     void interpolateAt(const Array<double> &targetTimes);
 private:
     int writeHeader(FILE *rFP,double aDT=-1) const;
@@ -374,6 +423,25 @@ private:
     int writeColumnLabels(FILE *rFP) const;
     int integrate(double aTI,double aTF,int aN,double *rArea,Storage *rStorage) const;
     int integrate(int aI1,int aI2,int aN,double *rArea,Storage *rStorage) const;
+    int findUpperBound(int aLo,int aHi,double aT) const;
+    bool findInterval(double aT,int &rI1,int &rI2,double &rPct) const;
+    // COLUMNAR DATA
+    const double* getColumn(int aStateIndex) const
+    {   return(_data.data() + (size_t)aStateIndex*_rowCapacity); }
+    double* updColumn(int aStateIndex)
+    {   return(_data.data() + (size_t)aStateIndex*_rowCapacity); }
+    double getValue(int aTimeIndex,int aStateIndex) const
+    {   return(_data[(size_t)aStateIndex*_rowCapacity + aTimeIndex]); }
+    void reserveRows(int aNumRows);
+    void ensureNumColumns(int aNumColumns);
+    void setRow(int aTimeIndex,double aT,int aN,const double *aY);
+    int appendRow(double aT,int aN,const double *aY,bool aCheckForDuplicateTime);
+    void copyRow(int aTimeIndex,StateVector &rVec) const;
+    int printRow(FILE *rFP,int aTimeIndex) const;
+    template <typename Op>
+    void transformColumn(int aStateIndex,int aNumFullColumns,Op op);
+    template <typename Op>
+    void combineWithStorage(const Storage &aStorage,Op op);
 
 //=============================================================================
 };  // END of class Storage
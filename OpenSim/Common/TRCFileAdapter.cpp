@@ -1,7 +1,11 @@
 #include "TRCFileAdapter.h"
 #include <OpenSim/Common/IO.h>
+#include <OpenSim/Common/TextRowWriter.h>
+#include <algorithm>
+#include <cstring>
+#include <exception>
 #include <fstream>
-#include <iomanip>
+#include <thread>
 
 namespace OpenSim {
 
@@ -22,6 +26,108 @@ const std::vector<std::string> TRCFileAdapter::_metadataKeys{"DataRate",
         "CameraRate", "NumFrames", "NumMarkers", "Units", "OrigDataRate", 
         "OrigDataStartFrame", "OrigNumFrames"};
 
+namespace {
+    // Find the end of the line that starts at `begin`, excluding the '\n'.
+    const char* findLineEnd(const char* begin, const char* end) {
+        if(begin == end)
+            return end;
+        auto lineEnd = static_cast<const char*>(
+                std::memchr(begin, '\n', static_cast<size_t>(end - begin)));
+        return lineEnd != nullptr ? lineEnd : end;
+    }
+
+    // Same delimiters as _delimitersRead.
+    bool isDelimiter(char ch) {
+        return ch == '\t' || ch == '\r';
+    }
+
+    // Whitespace trimmed from tokens (see IO::TrimWhitespace()).
+    bool isWhitespace(char ch) {
+        return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n';
+    }
+
+    // Smallest number of rows worth decoding on a thread of its own.
+    const int minRowsPerThread{1024};
+
+    // Character range [begin, end) of a line or a token in the file.
+    struct LineRange {
+        const char* begin;
+        const char* end;
+    };
+
+    LineRange trim(const char* begin, const char* end) {
+        while(begin != end && isWhitespace(*begin))
+            ++begin;
+        while(end != begin && isWhitespace(*(end - 1)))
+            --end;
+        return {begin, end};
+    }
+
+    // True if the line is empty or its first token is blank; such lines are
+    // skipped between the header and the data.
+    bool isBlankRow(const char* begin, const char* end) {
+        const char* tokenEnd = begin;
+        while(tokenEnd != end && !isDelimiter(*tokenEnd))
+            ++tokenEnd;
+        const LineRange token = trim(begin, tokenEnd);
+        return token.begin == token.end;
+    }
+
+    // Split the line into tokens the same way FileAdapter::tokenize() does,
+    // decode the markers into row `rowIndex` of `matrix` and return the time.
+    // `tokens` is scratch space, reused from row to row.
+    double decodeRow(const LineRange& line,
+                     SimTK::Matrix_<SimTK::Vec3>& matrix,
+                     int rowIndex,
+                     std::vector<LineRange>& tokens,
+                     const std::string& fileName,
+                     size_t line_num) {
+        tokens.clear();
+        const char* tokenBegin = line.begin;
+        while(true) {
+            const char* tokenEnd = tokenBegin;
+            while(tokenEnd != line.end && !isDelimiter(*tokenEnd))
+                ++tokenEnd;
+            // Like tokenize(), ignore an empty token after the last
+            // delimiter.
+            if(tokenBegin == line.end)
+                break;
+            tokens.push_back(trim(tokenBegin, tokenEnd));
+            if(tokenEnd == line.end)
+                break;
+            tokenBegin = tokenEnd + 1;
+        }
+
+        const int numMarkers = matrix.ncol();
+        const size_t expected = 3 * static_cast<size_t>(numMarkers) + 2;
+        OPENSIM_THROW_IF(tokens.size() != expected,
+                         RowLengthMismatch,
+                         fileName,
+                         line_num,
+                         expected,
+                         tokens.size());
+
+        // Columns 2 till the end are data.
+        for(int m = 0; m < numMarkers; ++m) {
+            const LineRange* comps = &tokens[3 * m + 2];
+            SimTK::Vec3& marker = matrix.updElt(rowIndex, m);
+            //only if each component is specified read process as a Vec3
+            if(comps[0].begin != comps[0].end &&
+                    comps[1].begin != comps[1].end &&
+                    comps[2].begin != comps[2].end)
+                marker = SimTK::Vec3{
+                    FileAdapter::parseDouble(comps[0].begin, comps[0].end),
+                    FileAdapter::parseDouble(comps[1].begin, comps[1].end),
+                    FileAdapter::parseDouble(comps[2].begin, comps[2].end)};
+            else
+                marker = SimTK::Vec3(SimTK::NaN);
+        }
+
+        // Column 1 is time.
+        return FileAdapter::parseDouble(tokens[1].begin, tokens[1].end);
+    }
+}
+
 TRCFileAdapter* 
 TRCFileAdapter::clone() const {
     return new TRCFileAdapter{*this};
@@ -47,21 +153,44 @@ TRCFileAdapter::extendRead(const std::string& fileName) const {
     OPENSIM_THROW_IF(fileName.empty(),
                      EmptyFileName);
 
-    std::ifstream in_stream{fileName};
-    OPENSIM_THROW_IF(!in_stream.good(),
-                     FileDoesNotExist,
-                     fileName);
-
-    auto table = std::make_shared<TimeSeriesTableVec3>();
+    // The file is scanned in place; rows are decoded directly from it.
+    const MappedFile file{fileName};
+    const char* pos = file.begin();
+    const char* const fileEnd = file.end();
+
+    // Callable to get the range of the next line, without its line ending.
+    // Returns false at the end of the file.
+    auto nextLineRange = [&](const char*& begin, const char*& end) {
+        if(pos == fileEnd)
+            return false;
+        begin = pos;
+        end = findLineEnd(pos, fileEnd);
+        pos = end == fileEnd ? end : end + 1;
+        // Get rid of the extra \r if parsing a file with CRLF line endings.
+        if(end != begin && *(end - 1) == '\r')
+            --end;
+        return true;
+    };
 
     // Callable to get the next line in form of vector of tokens.
     auto nextLine = [&] {
-        return getNextLine(in_stream, _delimitersRead);
+        const char* begin{};
+        const char* end{};
+        if(!nextLineRange(begin, end))
+            return std::vector<std::string>{};
+        return tokenize(std::string{begin, end}, _delimitersRead);
     };
 
+    auto table = std::make_shared<TimeSeriesTableVec3>();
+
     // First line of the stream is considered the header.
     std::string header{};
-    std::getline(in_stream, header);
+    {
+        const char* begin{};
+        const char* end{};
+        if(nextLineRange(begin, end))
+            header.assign(begin, end);
+    }
     auto header_tokens = tokenize(header, _headerDelimiters);
     OPENSIM_THROW_IF(header_tokens.empty(),
                      FileIsEmpty,
@@ -164,57 +293,59 @@ TRCFileAdapter::extendRead(const std::string& fileName) const {
         }
     }
 
-    // Read the rows one at a time and fill up the time column container and
-    // the data container.
+    // Find the rows, skipping blank lines between header and data. An empty
+    // line during data parsing denotes end of data.
     std::size_t line_num{_dataStartsAtLine};
-    std::vector<std::string> row = nextLine();
-    // skip immediate blank lines between header and data.
-    while(row.empty() || row.at(0).empty()) {
-        row = nextLine();
+    std::vector<LineRange> rows{};
+    const char* begin{};
+    const char* end{};
+    bool hasLine = nextLineRange(begin, end);
+    while(hasLine && isBlankRow(begin, end)) {
+        hasLine = nextLineRange(begin, end);
         ++line_num;
     }
-    
-    const size_t expected{ column_labels.size() * 3 + 2 };
-
-    // An empty line during data parsing denotes end of data
-    while(!row.empty()) {
-        OPENSIM_THROW_IF(row.size() != expected,
-                         RowLengthMismatch,
-                         fileName,
-                         line_num,
-                         expected,
-                         row.size());
-
-        // Columns 2 till the end are data.
-        TimeSeriesTableVec3::RowVector 
-            row_vector{static_cast<int>(num_markers_expected), 
-                       SimTK::Vec3(SimTK::NaN)};
-        int ind{0};
-        for (std::size_t c = 2; c < column_labels.size() * 3 + 2; c += 3) {
-            //only if each component is specified read process as a Vec3
-            if ( !(row.at(c).empty() || row.at(c + 1).empty() 
-                                     || row.at(c + 2).empty()) ) {
-                row_vector[ind] = SimTK::Vec3{ std::stod(row.at(c)),
-                                               std::stod(row.at(c + 1)),
-                                               std::stod(row.at(c + 2)) };
-            } // otherwise the value will remain NaN (default)
-            ++ind;
-        }
-
-        // Column 1 is time.
-        table->appendRow(std::stod(row.at(1)), std::move(row_vector));
-
-        row = nextLine();
-        ++line_num;
+    while(hasLine && begin != end) {
+        rows.push_back({begin, end});
+        hasLine = nextLineRange(begin, end);
     }
 
-    // Set the column labels of the table.
-    ValueArray<std::string> value_array{};
-    for(const auto& cl : column_labels)
-        value_array.upd().push_back(SimTK::Value<std::string>{cl});
-    TimeSeriesTableVec3::DependentsMetaData dep_metadata{};
-    dep_metadata.setValueArrayForKey("labels", value_array);
-    table->setDependentsMetaData(dep_metadata);
+    // Decode contiguous blocks of rows on separate threads, directly into
+    // the time column and the matrix of the table.
+    const int numRows = static_cast<int>(rows.size());
+    const int numMarkers = static_cast<int>(num_markers_expected);
+    std::vector<double> times(numRows);
+    SimTK::Matrix_<SimTK::Vec3> matrix(numRows, numMarkers);
+    int numThreads = static_cast<int>(std::thread::hardware_concurrency());
+    numThreads = std::max(1, std::min(numThreads,
+                                      numRows / minRowsPerThread));
+    std::vector<std::exception_ptr> errors(numThreads);
+    auto decodeBlock = [&](int t) {
+        try {
+            std::vector<LineRange> tokens{};
+            for(int i = numRows * t / numThreads;
+                    i < numRows * (t + 1) / numThreads; ++i)
+                times[i] = decodeRow(rows[i], matrix, i, tokens, fileName,
+                                     line_num + i);
+        } catch(...) {
+            errors[t] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> threads{};
+    for(int t = 1; t < numThreads; ++t)
+        threads.emplace_back(decodeBlock, t);
+    decodeBlock(0);
+    for(auto& thread : threads)
+        thread.join();
+    // Report the error in the first bad row.
+    for(const auto& error : errors)
+        if(error)
+            std::rethrow_exception(error);
+
+    // Validate the times and set the column labels of the table.
+    auto metadata = table->getTableMetaData();
+    table = std::make_shared<TimeSeriesTableVec3>(times, matrix,
+                                                  column_labels);
+    table->updTableMetaData() = metadata;
 
     OutputTables output_tables{};
     output_tables.emplace(_markers, table);
@@ -347,22 +478,26 @@ TRCFileAdapter::extendWrite(const InputTables& absTables,
     // Empty line.
     out_stream << "\n";
 
-    // Data rows.
-    for(unsigned row = 0; row < table->getNumRows(); ++row) {
-        constexpr auto prec = std::numeric_limits<double>::digits10 + 1;
-        out_stream << row + 1                           << _delimiterWrite
-                   << std::setprecision(prec) 
-                   << table->getIndependentColumn()[row] << _delimiterWrite;
-        const auto& row_r = table->getRowAtIndex(row);
-        for(unsigned col = 0; col < table->getNumColumns(); ++col) {
-            const auto& elt = row_r[col];
-            out_stream << std::setprecision(prec) 
-                       << elt[0] << _delimiterWrite
-                       << elt[1] << _delimiterWrite
-                       << elt[2] << _delimiterWrite;
-        }
-        out_stream << "\n";
-    }
+    // Data rows, formatted on several threads.
+    constexpr auto prec = std::numeric_limits<double>::digits10 + 1;
+    const auto& times = table->getIndependentColumn();
+    const auto matrix = table->getMatrix();
+    const int ncol = matrix.ncol();
+    TextRowWriter::write(out_stream, table->getNumRows(),
+            [&](size_t row, std::string& buffer) {
+                buffer += std::to_string(row + 1);
+                buffer += _delimiterWrite;
+                TextRowWriter::appendDouble(buffer, times[row], prec);
+                buffer += _delimiterWrite;
+                for(int col = 0; col < ncol; ++col) {
+                    const auto& elt = matrix(int(row), col);
+                    for(int i = 0; i < 3; ++i) {
+                        TextRowWriter::appendDouble(buffer, elt[i], prec);
+                        buffer += _delimiterWrite;
+                    }
+                }
+                buffer += '\n';
+            });
 }
 
 }
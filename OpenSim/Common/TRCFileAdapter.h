@@ -134,7 +134,11 @@ public:
 /** TRCFileAdapter is a FileAdapter that reads and writes TRC files. It accepts
 (when writing) and returns (when reading) a specific type of DataTable referred 
 to as Table in this class. Be sure to expect/provide that table when working
-with this adapter.                                                            */
+with this adapter.
+
+When reading, the file is scanned in place and the rows of large files are
+decoded on several threads, so reading scales with the number of
+processors.                                                                   */
 class OSIMCOMMON_API TRCFileAdapter : public FileAdapter {
 public:
     TRCFileAdapter()                                 = default;
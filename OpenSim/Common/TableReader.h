@@ -0,0 +1,159 @@
+#ifndef OPENSIM_TABLE_READER_H_
+#define OPENSIM_TABLE_READER_H_
+/* -------------------------------------------------------------------------- *
+ *                          OpenSim:  TableReader.h                           *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2019 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "FileAdapter.h"
+#include "TimeSeriesTable.h"
+
+#include <algorithm>
+#include <memory>
+
+namespace OpenSim {
+
+/** TableReader_ reads the rows of a time series from a file in chunks of at
+most getChunkSize() rows, so that the rows can be processed before the whole
+file has been read, and a file need not fit in memory. The column labels and
+metadata of the table are available from getHeader() as soon as the reader is
+created.
+
+STO, MOT, CSV and binary (".bsto") files are read a chunk at a time. Files of
+other types (TRC, C3D) are read whole when the reader is created, and then
+handed out in chunks like the others.
+
+@code
+TableReader_<SimTK::Vec3> reader{"markers.sto", 1000};
+TimeSeriesTable_<SimTK::Vec3> chunk{};
+while(reader.readChunk(chunk))
+    process(chunk);
+@endcode
+
+@tparam ETY Type of the elements of the table in the file.                   */
+template<typename ETY = SimTK::Real>
+class TableReader_ {
+public:
+    /** Open the file `fileName`, which must hold one table or a table named
+    `tableName`.
+    \throws IncorrectTableType If the table in the file is not a
+                               TimeSeriesTable_ of ETY.
+    \throws InvalidArgument If the file holds several tables and there is no
+                            table named `tableName`.                          */
+    TableReader_(const std::string& fileName,
+                 size_t chunkSize = 4096,
+                 const std::string& tableName = "") :
+        _fileName{fileName},
+        _chunkSize{std::max(chunkSize, size_t{1})} {
+        _source = FileAdapter::openChunkSource(fileName);
+        if(_source) {
+            auto header =
+                dynamic_cast<const TimeSeriesTable_<ETY>*>(
+                        &_source->getHeader());
+            OPENSIM_THROW_IF(header == nullptr,
+                             IncorrectTableType,
+                             "File '" + fileName + "' does not contain a "
+                             "table of the requested type.");
+            _header = *header;
+        } else {
+            _table.reset(new TimeSeriesTable_<ETY>{fileName, tableName});
+            _header = TimeSeriesTable_<ETY>{std::vector<double>{},
+                    SimTK::Matrix_<ETY>(0, int(_table->getNumColumns())),
+                    _table->getColumnLabels()};
+            _header.updTableMetaData() = _table->getTableMetaData();
+        }
+    }
+
+    TableReader_(const TableReader_&)            = delete;
+    TableReader_& operator=(const TableReader_&) = delete;
+
+    /** Get a table with the column labels and metadata of the table in the
+    file, and no rows.                                                       */
+    const TimeSeriesTable_<ETY>& getHeader() const { return _header; }
+
+    /** Replace `chunk` with a table of the next rows in the file (at most
+    getChunkSize() rows), with the column labels and metadata of getHeader().
+    Returns false, leaving `chunk` without rows, if all the rows have been
+    read.
+    \throws TimestampLessThanEqualToPrevious If the times in the file do not
+                                             increase.                       */
+    bool readChunk(TimeSeriesTable_<ETY>& chunk) {
+        bool hasRows{};
+        if(_source) {
+            hasRows = _source->readChunk(chunk, _chunkSize);
+        } else {
+            chunk = _header;
+            const size_t numRows =
+                std::min(_chunkSize, _table->getNumRows() - _numRowsRead);
+            hasRows = numRows > 0;
+            if(hasRows) {
+                const auto& times = _table->getIndependentColumn();
+                chunk.appendRows(
+                        std::vector<double>(times.begin() + _numRowsRead,
+                                times.begin() + _numRowsRead + numRows),
+                        _table->getMatrix().block(int(_numRowsRead), 0,
+                                int(numRows),
+                                int(_table->getNumColumns())));
+            }
+        }
+        if(!hasRows)
+            return false;
+
+        const double firstTime = chunk.getIndependentColumn().front();
+        OPENSIM_THROW_IF(_numRowsRead > 0 && firstTime <= _lastTime,
+                         TimestampLessThanEqualToPrevious,
+                         _numRowsRead, firstTime, _lastTime);
+        _numRowsRead += chunk.getNumRows();
+        _lastTime = chunk.getIndependentColumn().back();
+        return true;
+    }
+
+    /** Read all the rows that have not been read yet into one table.        */
+    TimeSeriesTable_<ETY> readRemainingRows() {
+        TimeSeriesTable_<ETY> table{_header};
+        TimeSeriesTable_<ETY> chunk{};
+        while(readChunk(chunk))
+            table.appendRows(chunk.getIndependentColumn(), chunk.getMatrix());
+        return table;
+    }
+
+    const std::string& getFileName() const { return _fileName; }
+    size_t getChunkSize() const { return _chunkSize; }
+    /** Get the number of rows read so far.                                  */
+    size_t getNumRowsRead() const { return _numRowsRead; }
+
+private:
+    std::string                                 _fileName;
+    size_t                                      _chunkSize;
+    TimeSeriesTable_<ETY>                       _header;
+    size_t                                      _numRowsRead{};
+    double                                      _lastTime{};
+    // Source of the rows, if the file can be read a chunk at a time.
+    std::unique_ptr<FileAdapter::ChunkSource>   _source;
+    // Otherwise, the whole table in the file.
+    std::unique_ptr<TimeSeriesTable_<ETY>>      _table;
+};
+
+/** See TableReader_ for details on the interface.                           */
+typedef TableReader_<SimTK::Real> TableReader;
+
+} // namespace OpenSim
+
+#endif // OPENSIM_TABLE_READER_H_
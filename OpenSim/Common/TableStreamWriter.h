@@ -0,0 +1,321 @@
+#ifndef OPENSIM_TABLE_STREAM_WRITER_H_
+#define OPENSIM_TABLE_STREAM_WRITER_H_
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  TableStreamWriter.h                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2019 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "BinaryFileAdapter.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+namespace OpenSim {
+
+/** TableStreamWriter_ writes the rows of a time series to a binary file
+(see BinaryFileAdapter) while they are being produced, so that the rows do
+not have to be kept in memory until the end of a simulation.
+
+Rows are collected in chunks of getChunkSize() rows. Full chunks are handed to
+a background thread that writes them to the file, through a queue that holds
+at most getMaxQueuedChunks() chunks: if the file cannot be written as fast as
+rows are appended, appendRow() waits for the queue to make room, so memory
+use stays bounded. An exception thrown while writing is rethrown by the next
+call to appendRow(), flush() or close().
+
+A row with the same time as the previous row replaces the previous row, as in
+Storage::append(). If the previous row has already been written, the new row
+is ignored instead; this happens when a simulation is continued from the
+state at which it stopped.
+
+@code
+TimeSeriesTable header{};
+header.setColumnLabels({"a", "b"});
+TableStreamWriter writer{"results.bsto", header};
+for(int i = 0; i < 100000; ++i)
+    writer.appendRow(0.001 * i, SimTK::RowVector(2, double(i)));
+writer.close();
+TimeSeriesTable table{"results.bsto"};
+@endcode
+
+@tparam ETY Type of the elements of the rows. BinaryFileAdapter supports
+            double, SimTK::Vec3, SimTK::Quaternion and SimTK::SpatialVec.   */
+template<typename ETY = SimTK::Real>
+class TableStreamWriter_ {
+public:
+    /** Create (or overwrite) the file `fileName` and write the column labels
+    and string metadata of `table` to it, followed by the rows of `table`, if
+    any.
+    \throws IOError If the file cannot be opened.
+    \throws IncorrectTableType If BinaryFileAdapter does not support tables of
+                               ETY.                                           */
+    TableStreamWriter_(const std::string& fileName,
+                       const TimeSeriesTable_<ETY>& table,
+                       int chunkSize = 256,
+                       int maxQueuedChunks = 4) :
+        _fileName{fileName},
+        _chunkSize{std::max(chunkSize, 1)},
+        _maxQueuedChunks{std::max(maxQueuedChunks, 1)} {
+        if(table.getNumColumns() > 0)
+            _labels = table.getColumnLabels();
+
+        _stream.open(fileName, std::ios::binary | std::ios::trunc);
+        OPENSIM_THROW_IF(!_stream.good(),
+                         IOError,
+                         "Could not open file '" + fileName + "' for "
+                         "writing.");
+        BinaryFileAdapter::writeTableHeader(_stream, table);
+        BinaryFileAdapter::writeTableRows(_stream, table);
+        if(table.getNumRows() > 0) {
+            _lastWrittenTime = table.getIndependentColumn().back();
+            _hasWrittenRows = true;
+        }
+        startChunk();
+
+        _thread = std::thread{&TableStreamWriter_::writeChunks, this};
+    }
+
+    TableStreamWriter_(const TableStreamWriter_&)            = delete;
+    TableStreamWriter_& operator=(const TableStreamWriter_&) = delete;
+
+    /** Calls close(). An exception thrown while closing is reported on the
+    console, since it cannot be thrown from the destructor.                  */
+    ~TableStreamWriter_() {
+        try {
+            close();
+        } catch(const std::exception& x) {
+            std::cout << "TableStreamWriter: failed to write file '"
+                      << _fileName << "'.\n" << x.what() << std::endl;
+        }
+    }
+
+    /** Append a row. The times of the rows must increase; see the class
+    description for rows with the same time.
+    \throws IncorrectNumColumns If the row does not have one element per
+                                column.
+    \throws InvalidTimestamp If `time` precedes the time of the previous
+                             row.                                            */
+    void appendRow(double time, const SimTK::RowVectorBase<ETY>& row) {
+        rethrowError();
+        OPENSIM_THROW_IF(_closed,
+                         Exception,
+                         "File '" + _fileName + "' is already closed.");
+        OPENSIM_THROW_IF(row.size() != _pendingValues.ncol(),
+                         IncorrectNumColumns,
+                         static_cast<size_t>(_pendingValues.ncol()),
+                         static_cast<size_t>(row.size()));
+
+        if(!_pendingTimes.empty() && time == _pendingTimes.back()) {
+            _pendingValues.updRow(int(_pendingTimes.size()) - 1) = row;
+            return;
+        }
+        const bool hasPrevious = !_pendingTimes.empty() || _hasWrittenRows;
+        const double previousTime = _pendingTimes.empty() ?
+                                    _lastWrittenTime : _pendingTimes.back();
+        if(hasPrevious && time == previousTime)
+            return;
+        OPENSIM_THROW_IF(hasPrevious && time < previousTime,
+                         InvalidTimestamp,
+                         "Time " + std::to_string(time) + " precedes the "
+                         "time of the previous row (" +
+                         std::to_string(previousTime) + ").");
+
+        // The last row is held back until the next row arrives, so that it
+        // can still be replaced by a row with the same time.
+        if(_pendingTimes.size() == static_cast<size_t>(_chunkSize))
+            pushChunk();
+        _pendingValues.updRow(int(_pendingTimes.size())) = row;
+        _pendingTimes.push_back(time);
+    }
+
+    /** Write all the rows appended so far to the file, and wait until they
+    are written.                                                             */
+    void flush() {
+        rethrowError();
+        if(_closed)
+            return;
+        if(!_pendingTimes.empty())
+            pushChunk();
+        std::unique_lock<std::mutex> lock{_mutex};
+        _changed.wait(lock, [&] {
+                return (_queue.empty() && !_writing) || _error; });
+        if(!_error) {
+            _stream.flush();
+            if(!_stream.good())
+                _error = std::make_exception_ptr(
+                        IOError{__FILE__, __LINE__, __func__,
+                                "Failed to write file '" + _fileName + "'."});
+        }
+        lock.unlock();
+        rethrowError();
+    }
+
+    /** Write the remaining rows, stop the background thread and close the
+    file. No rows can be appended afterwards. Calling close() again has no
+    effect.                                                                  */
+    void close() {
+        if(_closed)
+            return;
+        try {
+            flush();
+        } catch(...) {
+            stopThread();
+            throw;
+        }
+        stopThread();
+        _stream.close();
+        OPENSIM_THROW_IF(_stream.fail(),
+                         IOError,
+                         "Failed to write file '" + _fileName + "'.");
+    }
+
+    const std::string& getFileName() const { return _fileName; }
+    int getChunkSize() const { return _chunkSize; }
+    int getMaxQueuedChunks() const { return _maxQueuedChunks; }
+
+private:
+    struct Chunk {
+        std::vector<double> times;
+        SimTK::Matrix_<ETY> values;
+    };
+
+    void startChunk() {
+        _pendingTimes.clear();
+        _pendingTimes.reserve(_chunkSize);
+        _pendingValues.resize(_chunkSize, int(_labels.size()));
+    }
+
+    // Hand the pending rows to the background thread, waiting for room in
+    // the queue.
+    void pushChunk() {
+        Chunk chunk{};
+        chunk.times.swap(_pendingTimes);
+        chunk.values = std::move(_pendingValues);
+        {
+            std::unique_lock<std::mutex> lock{_mutex};
+            _changed.wait(lock, [&] {
+                    return _queue.size() <
+                           static_cast<size_t>(_maxQueuedChunks) || _error; });
+            if(!_error) {
+                _lastWrittenTime = chunk.times.back();
+                _hasWrittenRows = true;
+                _queue.push_back(std::move(chunk));
+            }
+        }
+        _changed.notify_all();
+        startChunk();
+        rethrowError();
+    }
+
+    // Body of the background thread.
+    void writeChunks() {
+        std::unique_lock<std::mutex> lock{_mutex};
+        while(true) {
+            _changed.wait(lock, [&] { return !_queue.empty() || _stopping; });
+            if(_queue.empty())
+                return;
+            Chunk chunk = std::move(_queue.front());
+            _queue.pop_front();
+            _writing = true;
+            lock.unlock();
+            _changed.notify_all();
+
+            std::exception_ptr error{};
+            try {
+                const int numRows = int(chunk.times.size());
+                chunk.values.resizeKeep(numRows, chunk.values.ncol());
+                const TimeSeriesTable_<ETY> table{chunk.times, chunk.values,
+                                                  _labels};
+                BinaryFileAdapter::writeTableRows(_stream, table);
+                OPENSIM_THROW_IF(!_stream.good(),
+                                 IOError,
+                                 "Failed to write file '" + _fileName +
+                                 "'.");
+            } catch(...) {
+                error = std::current_exception();
+            }
+
+            lock.lock();
+            _writing = false;
+            if(error) {
+                _error = error;
+                _queue.clear();
+            }
+            _changed.notify_all();
+        }
+    }
+
+    void stopThread() {
+        {
+            std::lock_guard<std::mutex> lock{_mutex};
+            _stopping = true;
+        }
+        _changed.notify_all();
+        if(_thread.joinable())
+            _thread.join();
+        _closed = true;
+    }
+
+    void rethrowError() {
+        std::exception_ptr error{};
+        {
+            std::lock_guard<std::mutex> lock{_mutex};
+            error = _error;
+        }
+        if(error)
+            std::rethrow_exception(error);
+    }
+
+    std::string              _fileName;
+    std::vector<std::string> _labels;
+    int                      _chunkSize;
+    int                      _maxQueuedChunks;
+    std::ofstream            _stream;
+
+    // Rows that have not been handed to the background thread yet. Only
+    // used by the thread that appends rows.
+    std::vector<double>      _pendingTimes;
+    SimTK::Matrix_<ETY>      _pendingValues;
+    double                   _lastWrittenTime{};
+    bool                     _hasWrittenRows{false};
+    bool                     _closed{false};
+
+    // Shared with the background thread; guarded by _mutex.
+    std::mutex               _mutex;
+    std::condition_variable  _changed;
+    std::deque<Chunk>        _queue;
+    bool                     _writing{false};
+    bool                     _stopping{false};
+    std::exception_ptr       _error{};
+    std::thread              _thread;
+};
+
+/** See TableStreamWriter_ for details on the interface.                     */
+typedef TableStreamWriter_<SimTK::Real> TableStreamWriter;
+
+} // namespace OpenSim
+
+#endif // OPENSIM_TABLE_STREAM_WRITER_H_
@@ -0,0 +1,316 @@
+/* -------------------------------------------------------------------------- *
+ *                    OpenSim:  testBinaryFileAdapter.cpp                     *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2019 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "OpenSim/Common/Adapters.h"
+#include "OpenSim/Common/Storage.h"
+#include "OpenSim/Common/TableReader.h"
+#include "OpenSim/Common/TableStreamWriter.h"
+
+#include <fstream>
+#include <type_traits>
+
+using namespace OpenSim;
+
+// Values that do not survive a round trip through text, so that the tests
+// check that the binary files keep full precision.
+template<typename T>
+T makeElement(int row, int col);
+
+template<>
+double makeElement<double>(int row, int col) {
+    return 1.0 / (3 + row) + SimTK::Pi * col;
+}
+
+template<>
+SimTK::Vec3 makeElement<SimTK::Vec3>(int row, int col) {
+    return {makeElement<double>(row, col),
+            -makeElement<double>(row, col + 1),
+            1e-300 * makeElement<double>(row, col + 2)};
+}
+
+template<>
+SimTK::Quaternion makeElement<SimTK::Quaternion>(int row, int col) {
+    return SimTK::Quaternion{SimTK::Rotation{makeElement<double>(row, col),
+                                             SimTK::UnitVec3{1, 2, 3}}};
+}
+
+template<>
+SimTK::SpatialVec makeElement<SimTK::SpatialVec>(int row, int col) {
+    return {makeElement<SimTK::Vec3>(row, col),
+            makeElement<SimTK::Vec3>(col, row)};
+}
+
+template<typename T>
+TimeSeriesTable_<T> makeTable(int numRows, int numColumns,
+                              double startTime = 0) {
+    std::vector<double> times{};
+    SimTK::Matrix_<T> matrix(numRows, numColumns);
+    for(int row = 0; row < numRows; ++row) {
+        times.push_back(startTime + 0.01 * row);
+        for(int col = 0; col < numColumns; ++col)
+            matrix(row, col) = makeElement<T>(row, col);
+    }
+    std::vector<std::string> labels{};
+    for(int col = 0; col < numColumns; ++col)
+        labels.push_back("column" + std::to_string(col));
+
+    TimeSeriesTable_<T> table{times, matrix, labels};
+    table.addTableMetaData("inDegrees", std::string{"no"});
+    table.addTableMetaData("nRows", numRows);
+    return table;
+}
+
+template<typename T>
+void compareTables(const TimeSeriesTable_<T>& expected,
+                   const TimeSeriesTable_<T>& actual) {
+    SimTK_TEST(actual.getNumRows() == expected.getNumRows());
+    SimTK_TEST(actual.getNumColumns() == expected.getNumColumns());
+    SimTK_TEST(actual.getIndependentColumn() ==
+               expected.getIndependentColumn());
+    if(expected.getNumColumns() > 0)
+        SimTK_TEST(actual.getColumnLabels() == expected.getColumnLabels());
+    for(size_t row = 0; row < expected.getNumRows(); ++row)
+        for(size_t col = 0; col < expected.getNumColumns(); ++col)
+            SimTK_TEST(actual.getMatrix()(int(row), int(col)) ==
+                       expected.getMatrix()(int(row), int(col)));
+}
+
+template<typename T>
+void testRoundTrip() {
+    const std::string fileName{"testBinaryFileAdapter_roundTrip.bsto"};
+    const auto table = makeTable<T>(25, 4);
+    BinaryFileAdapter::write(table, fileName);
+
+    const auto read = BinaryFileAdapter::readFile<T>(fileName);
+    compareTables(table, read);
+    // Only the metadata that are strings are written.
+    SimTK_TEST(read.template getTableMetaData<std::string>("inDegrees") ==
+               "no");
+    SimTK_TEST(!read.hasTableMetaDataKey("nRows"));
+
+    // The file holds a table of T, not of another type.
+    if(!std::is_same<T, double>::value)
+        SimTK_TEST_MUST_THROW_EXC(
+                BinaryFileAdapter::readFile<double>(fileName),
+                IncorrectTableType);
+
+    // An empty table.
+    const auto empty = makeTable<T>(0, 0);
+    BinaryFileAdapter::write(empty, fileName);
+    compareTables(empty, BinaryFileAdapter::readFile<T>(fileName));
+}
+
+// Exposes extendWrite(), which uses the chunk size of the adapter.
+class ChunkedFileAdapter : public BinaryFileAdapter {
+public:
+    using BinaryFileAdapter::extendWrite;
+};
+
+void testChunks() {
+    const std::string fileName{"testBinaryFileAdapter_chunks.bsto"};
+    const auto table = makeTable<double>(103, 7);
+    for(int chunkSize : {1, 10, 103, 1000, 0}) {
+        ChunkedFileAdapter adapter{};
+        adapter.setChunkSize(chunkSize);
+        DataAdapter::InputTables tables{};
+        tables.emplace(BinaryFileAdapter::tableString(), &table);
+        adapter.extendWrite(tables, fileName);
+        compareTables(table, BinaryFileAdapter::readFile<double>(fileName));
+    }
+}
+
+void testAppend() {
+    const std::string fileName{"testBinaryFileAdapter_append.bsto"};
+    const auto first = makeTable<SimTK::Vec3>(10, 3, 0);
+    const auto second = makeTable<SimTK::Vec3>(5, 3, 1);
+    BinaryFileAdapter::write(first, fileName);
+    BinaryFileAdapter::append(second, fileName);
+
+    auto expected = first;
+    for(size_t row = 0; row < second.getNumRows(); ++row)
+        expected.appendRow(second.getIndependentColumn()[row],
+                           second.getRowAtIndex(row));
+    compareTables(expected,
+                  BinaryFileAdapter::readFile<SimTK::Vec3>(fileName));
+
+    // The rows must follow the rows in the file.
+    SimTK_TEST_MUST_THROW_EXC(BinaryFileAdapter::append(first, fileName),
+                              InvalidArgument);
+    // The table must have the same type and columns.
+    SimTK_TEST_MUST_THROW_EXC(
+            BinaryFileAdapter::append(makeTable<double>(5, 3, 2), fileName),
+            IncorrectTableType);
+    SimTK_TEST_MUST_THROW_EXC(
+            BinaryFileAdapter::append(makeTable<SimTK::Vec3>(5, 2, 2),
+                                      fileName),
+            IncorrectTableType);
+}
+
+void testCorruptFiles() {
+    const std::string fileName{"testBinaryFileAdapter_corrupt.bsto"};
+    {
+        std::ofstream stream{fileName};
+        stream << "time\tcolumn0\n0\t1\n";
+    }
+    SimTK_TEST_MUST_THROW_EXC(BinaryFileAdapter::readFile<double>(fileName),
+                              BinaryFileCorrupt);
+
+    // Cut a valid file short.
+    BinaryFileAdapter::write(makeTable<double>(10, 2), fileName);
+    std::string contents{};
+    {
+        std::ifstream stream{fileName, std::ios::binary};
+        contents.assign(std::istreambuf_iterator<char>{stream},
+                        std::istreambuf_iterator<char>{});
+    }
+    {
+        std::ofstream stream{fileName, std::ios::binary};
+        stream.write(contents.data(), contents.size() - 4);
+    }
+    SimTK_TEST_MUST_THROW_EXC(BinaryFileAdapter::readFile<double>(fileName),
+                              BinaryFileCorrupt);
+}
+
+void testFileAdapterAndStorage() {
+    const std::string fileName{"testBinaryFileAdapter_storage.bsto"};
+    const auto table = makeTable<double>(20, 3);
+
+    // The adapter is registered for the extension.
+    DataAdapter::InputTables tables{};
+    tables.emplace("table", &table);
+    FileAdapter::writeFile(tables, fileName);
+    auto read = FileAdapter::readFile(fileName).at("table");
+    compareTables(table, dynamic_cast<TimeSeriesTable&>(*read));
+    compareTables(table, TimeSeriesTable{fileName});
+
+    Storage storage{fileName};
+    SimTK_TEST(storage.getSize() == 20);
+    SimTK_TEST(storage.getColumnLabels().getSize() == 4);
+    SimTK_TEST(!storage.isInDegrees());
+
+    storage.setInDegrees(true);
+    const std::string copyName{"testBinaryFileAdapter_storageCopy.bsto"};
+    SimTK_TEST(storage.print(copyName));
+    Storage copy{copyName};
+    SimTK_TEST(copy.isInDegrees());
+    compareTables(table, copy.exportToTable());
+
+    // Storage appends rows to binary files in mode "a".
+    Storage more{};
+    more.setColumnLabels(storage.getColumnLabels());
+    more.append(1.0, SimTK::Vector(3, 2.0));
+    SimTK_TEST(more.print(copyName, "a"));
+    SimTK_TEST(Storage{copyName}.getSize() == 21);
+}
+
+void testTableStreamWriter() {
+    const std::string fileName{"testBinaryFileAdapter_stream.bsto"};
+    const auto table = makeTable<SimTK::Vec3>(1000, 3);
+    const auto header = makeTable<SimTK::Vec3>(0, 3);
+    const auto& other = table.getRowAtIndex(999);
+    {
+        TableStreamWriter_<SimTK::Vec3> writer{fileName, header, 64, 2};
+        const auto& times = table.getIndependentColumn();
+        for(size_t row = 0; row < table.getNumRows(); ++row) {
+            // A row with the same time replaces the previous row.
+            writer.appendRow(times[row], other);
+            writer.appendRow(times[row], table.getRowAtIndex(row));
+            if(row == 500) {
+                writer.flush();
+                compareTables(makeTable<SimTK::Vec3>(501, 3),
+                        BinaryFileAdapter::readFile<SimTK::Vec3>(fileName));
+                // The row was written, so a row with the same time is
+                // ignored.
+                writer.appendRow(times[row], other);
+            }
+        }
+        SimTK_TEST_MUST_THROW_EXC(writer.appendRow(0, table.getRowAtIndex(0)),
+                                  InvalidTimestamp);
+        SimTK_TEST_MUST_THROW_EXC(
+                writer.appendRow(100, SimTK::RowVector_<SimTK::Vec3>(2)),
+                IncorrectNumColumns);
+        writer.close();
+        SimTK_TEST_MUST_THROW(writer.appendRow(100, table.getRowAtIndex(0)));
+    }
+    const auto read = BinaryFileAdapter::readFile<SimTK::Vec3>(fileName);
+    compareTables(table, read);
+    SimTK_TEST(read.getTableMetaData<std::string>("inDegrees") == "no");
+}
+
+template<typename T>
+void testTableReader(const std::string& fileName,
+                     const TimeSeriesTable_<T>& expected) {
+    for(size_t chunkSize : {1, 7, 1000}) {
+        TableReader_<T> reader{fileName, chunkSize};
+        SimTK_TEST(reader.getHeader().getNumRows() == 0);
+        SimTK_TEST(reader.getHeader().getColumnLabels() ==
+                   expected.getColumnLabels());
+        SimTK_TEST(reader.getHeader().template
+                   getTableMetaData<std::string>("inDegrees") == "no");
+
+        auto table = reader.getHeader();
+        TimeSeriesTable_<T> chunk{};
+        while(reader.readChunk(chunk)) {
+            SimTK_TEST(chunk.getNumRows() > 0);
+            SimTK_TEST(chunk.getNumRows() <= chunkSize);
+            SimTK_TEST(chunk.getColumnLabels() == expected.getColumnLabels());
+            table.appendRows(chunk.getIndependentColumn(), chunk.getMatrix());
+        }
+        SimTK_TEST(chunk.getNumRows() == 0);
+        SimTK_TEST(reader.getNumRowsRead() == expected.getNumRows());
+        compareTables(expected, table);
+    }
+
+    // Rows that were not read yet.
+    TableReader_<T> reader{fileName, 10};
+    TimeSeriesTable_<T> chunk{};
+    SimTK_TEST(reader.readChunk(chunk));
+    const auto rest = reader.readRemainingRows();
+    SimTK_TEST(rest.getNumRows() == expected.getNumRows() - 10);
+    SimTK_TEST(rest.getIndependentColumn().front() ==
+               expected.getIndependentColumn()[10]);
+}
+
+void testTableReader() {
+    const std::string binaryName{"testBinaryFileAdapter_reader.bsto"};
+    const auto table = makeTable<SimTK::Vec3>(103, 3);
+    BinaryFileAdapter::write(table, binaryName);
+    testTableReader(binaryName, table);
+    SimTK_TEST_MUST_THROW_EXC(TableReader{binaryName}, IncorrectTableType);
+}
+
+int main() {
+    SimTK_START_TEST("testBinaryFileAdapter");
+        SimTK_SUBTEST(testRoundTrip<double>);
+        SimTK_SUBTEST(testRoundTrip<SimTK::Vec3>);
+        SimTK_SUBTEST(testRoundTrip<SimTK::Quaternion>);
+        SimTK_SUBTEST(testRoundTrip<SimTK::SpatialVec>);
+        SimTK_SUBTEST(testChunks);
+        SimTK_SUBTEST(testAppend);
+        SimTK_SUBTEST(testCorruptFiles);
+        SimTK_SUBTEST(testFileAdapterAndStorage);
+        SimTK_SUBTEST(testTableStreamWriter);
+        SimTK_SUBTEST(testTableReader);
+    SimTK_END_TEST();
+
+    return 0;
+}
@@ -31,6 +31,9 @@
 #include <simbody/internal/MobilizedBody_Pin.h>
 #include <simbody/internal/MobilizedBody_Ground.h>
 
+#include <atomic>
+#include <thread>
+
 using namespace OpenSim;
 using namespace std;
 using namespace SimTK;
@@ -56,6 +59,32 @@ private:
     }
 }; //end class Sub
 
+// A component with a discrete variable and a cache variable.
+class DiscreteAndCache : public Component {
+    OpenSim_DECLARE_CONCRETE_OBJECT(DiscreteAndCache, Component);
+private:
+    void extendAddToSystem(MultibodySystem &system) const override {
+        Super::extendAddToSystem(system);
+        addDiscreteVariable("discrete", Stage::Dynamics);
+        addCacheVariable("cache", Vec3(0), Stage::Velocity);
+    }
+}; //end class DiscreteAndCache
+
+// A component that counts how often its output is computed.
+class CountingOutput : public Component {
+    OpenSim_DECLARE_CONCRETE_OBJECT(CountingOutput, Component);
+public:
+    OpenSim_DECLARE_OUTPUT(timeSquared, double, getTimeSquared,
+            SimTK::Stage::Time);
+    double getTimeSquared(const SimTK::State& s) const {
+        ++numEvaluations;
+        return s.getTime() * s.getTime();
+    }
+    mutable std::atomic<int> numEvaluations{0};
+    CountingOutput() = default;
+    CountingOutput(const CountingOutput& other) : Component(other) {}
+}; //end class CountingOutput
+
 class TheWorld : public Component {
     OpenSim_DECLARE_CONCRETE_OBJECT(TheWorld, Component);
 public:
@@ -1238,6 +1267,184 @@ void testGetStateVariableValue() {
             OpenSim::Exception);
 }
 
+void testVariableHandles() {
+
+    TheWorld top;
+    top.setName("top");
+    Sub* a = new Sub();
+    a->setName("a");
+    Sub* b = new Sub();
+    b->setName("b");
+    DiscreteAndCache* c = new DiscreteAndCache();
+    c->setName("c");
+
+    top.add(a);
+    top.add(c);
+    a->addComponent(b);
+
+    // Handles cannot be obtained before the System exists.
+    SimTK_TEST_MUST_THROW_EXC(a->getStateVariableHandle("subState"),
+            ComponentHasNoSystem);
+
+    MultibodySystem system;
+    top.buildUpSystem(system);
+    State s = system.realizeTopology();
+
+    // State variables, through a path and locally.
+    StateVariableHandle bState = top.getStateVariableHandle("a/b/subState");
+    StateVariableHandle aState = a->getStateVariableHandle("subState");
+    SimTK_TEST(bState.isValid() && aState.isValid());
+    SimTK_TEST(bState.getName() == "subState");
+    bState.setValue(s, 30);
+    aState.setValue(s, 20);
+    SimTK_TEST(b->getStateVariableValue(s, "subState") == 30);
+    SimTK_TEST(top.getStateVariableValue(s, "a/subState") == 20);
+    b->setStateVariableValue(s, "subState", 31);
+    SimTK_TEST(bState.getValue(s) == 31);
+
+    SimTK_TEST_MUST_THROW_EXC(top.getStateVariableHandle("typo/b/subState"),
+            OpenSim::Exception);
+    SimTK_TEST_MUST_THROW_EXC(a->getStateVariableHandle("typo"),
+            OpenSim::Exception);
+
+    // Discrete variable.
+    DiscreteVariableHandle discrete = c->getDiscreteVariableHandle("discrete");
+    discrete.setValue(s, 2.5);
+    SimTK_TEST(c->getDiscreteVariableValue(s, "discrete") == 2.5);
+    c->setDiscreteVariableValue(s, "discrete", 3.5);
+    SimTK_TEST(discrete.getValue(s) == 3.5);
+    SimTK_TEST_MUST_THROW_EXC(c->getDiscreteVariableHandle("typo"),
+            OpenSim::Exception);
+
+    system.realize(s, Stage::Velocity);
+
+    // The outputs for state variables use the resolved state variables.
+    SimTK_TEST(a->getOutputValue<double>(s, "subState") == 20);
+    SimTK_TEST(b->getOutputValue<double>(s, "subState") == 31);
+
+    // Cache variable.
+    CacheVariableHandle<Vec3> cache = c->getCacheVariableHandle<Vec3>("cache");
+    cache.setValue(s, Vec3(1, 2, 3));
+    SimTK_TEST(cache.isValueValid(s));
+    SimTK_TEST(c->isCacheVariableValid(s, "cache"));
+    SimTK_TEST(c->getCacheVariableValue<Vec3>(s, "cache") == Vec3(1, 2, 3));
+    cache.updValue(s)[0] = 4;
+    SimTK_TEST(cache.getValue(s) == Vec3(4, 2, 3));
+    cache.markValueInvalid(s);
+    SimTK_TEST(!c->isCacheVariableValid(s, "cache"));
+    cache.markValueValid(s);
+    SimTK_TEST(c->isCacheVariableValid(s, "cache"));
+    SimTK_TEST_MUST_THROW_EXC(c->getCacheVariableHandle<double>("cache"),
+            OpenSim::Exception);
+    SimTK_TEST_MUST_THROW_EXC(c->getCacheVariableHandle<Vec3>("typo"),
+            OpenSim::Exception);
+
+    // Unbound handles.
+    StateVariableHandle unbound;
+    SimTK_TEST(!unbound.isValid());
+    SimTK_TEST_MUST_THROW_EXC(unbound.getValue(s), OpenSim::Exception);
+
+    // Handles become invalid once the variables are deallocated.
+    top.finalizeFromProperties();
+    SimTK_TEST(!bState.isValid());
+    SimTK_TEST(!discrete.isValid());
+    SimTK_TEST(!cache.isValid());
+    SimTK_TEST_MUST_THROW_EXC(bState.getValue(s), OpenSim::Exception);
+
+    // Handles do not access their Component to check validity, so they can
+    // outlive it.
+    StateVariableHandle orphan;
+    DiscreteVariableHandle orphanDiscrete;
+    {
+        MultibodySystem otherSystem;
+        TheWorld other;
+        Sub* d = new Sub();
+        d->setName("d");
+        DiscreteAndCache* e = new DiscreteAndCache();
+        e->setName("e");
+        other.add(d);
+        other.add(e);
+        other.buildUpSystem(otherSystem);
+        otherSystem.realizeTopology();
+        orphan = other.getStateVariableHandle("d/subState");
+        orphanDiscrete = e->getDiscreteVariableHandle("discrete");
+        SimTK_TEST(orphan.isValid() && orphanDiscrete.isValid());
+    }
+    SimTK_TEST(!orphan.isValid());
+    SimTK_TEST(!orphanDiscrete.isValid());
+    SimTK_TEST_MUST_THROW_EXC(orphan.getValue(s), OpenSim::Exception);
+}
+
+void testOutputValueReuse() {
+    TheWorld top;
+    top.setName("top");
+    CountingOutput* c = new CountingOutput();
+    c->setName("c");
+    top.add(c);
+
+    MultibodySystem system;
+    top.buildUpSystem(system);
+    State s = system.realizeTopology();
+    s.setTime(2.0);
+
+    // Below Acceleration, the value is computed every time.
+    system.realize(s, Stage::Velocity);
+    SimTK_TEST(c->getOutputValue<double>(s, "timeSquared") == 4);
+    SimTK_TEST(c->getOutputValue<double>(s, "timeSquared") == 4);
+    SimTK_TEST(c->numEvaluations == 2);
+
+    // At Acceleration, the value is computed once.
+    system.realize(s, Stage::Acceleration);
+    SimTK_TEST(c->getOutputValue<double>(s, "timeSquared") == 4);
+    SimTK_TEST(c->getOutputValue<double>(s, "timeSquared") == 4);
+    SimTK_TEST(c->numEvaluations == 3);
+
+    // Also through the channel (e.g., as used by reporters).
+    const auto& channel = Output<double>::downcast(
+            c->getOutput("timeSquared")).getChannel("timeSquared");
+    SimTK_TEST(dynamic_cast<const Output<double>::Channel&>(channel)
+            .getValue(s) == 4);
+    SimTK_TEST(c->numEvaluations == 3);
+
+    // Changing the State invalidates the value.
+    s.setTime(3.0);
+    system.realize(s, Stage::Acceleration);
+    SimTK_TEST(c->getOutputValue<double>(s, "timeSquared") == 9);
+    SimTK_TEST(c->getOutputValue<double>(s, "timeSquared") == 9);
+    SimTK_TEST(c->numEvaluations == 4);
+
+    // Each State holds its own value; copies do not inherit it.
+    State s2 = s;
+    s2.setTime(1.0);
+    system.realize(s2, Stage::Acceleration);
+    SimTK_TEST(c->getOutputValue<double>(s2, "timeSquared") == 1);
+    SimTK_TEST(c->getOutputValue<double>(s, "timeSquared") == 9);
+    SimTK_TEST(c->numEvaluations == 5);
+
+    // Threads evaluating the output with their own States do not interfere.
+    const int numThreads = 4;
+    std::vector<int> numErrors(numThreads, 0);
+    std::vector<std::thread> threads;
+    for (int ithread = 0; ithread < numThreads; ++ithread) {
+        threads.emplace_back([&, ithread]() {
+            State sThread = s;
+            for (int i = 0; i < 100; ++i) {
+                const double time = ithread + 0.01 * i;
+                sThread.setTime(time);
+                system.realize(sThread, Stage::Time);
+                if (c->getOutputValue<double>(sThread, "timeSquared") !=
+                        time * time) {
+                    ++numErrors[ithread];
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    for (int ithread = 0; ithread < numThreads; ++ithread) {
+        SimTK_TEST(numErrors[ithread] == 0);
+    }
+}
+
 void testInputOutputConnections()
 {
     {
@@ -2276,6 +2483,8 @@ int main() {
         SimTK_SUBTEST(testFindComponent);
         SimTK_SUBTEST(testTraversePathToComponent);
         SimTK_SUBTEST(testGetStateVariableValue);
+        SimTK_SUBTEST(testVariableHandles);
+        SimTK_SUBTEST(testOutputValueReuse);
         SimTK_SUBTEST(testInputOutputConnections);
         SimTK_SUBTEST(testInputConnecteePaths);
         SimTK_SUBTEST(testExceptionsForConnecteeTypeMismatch);
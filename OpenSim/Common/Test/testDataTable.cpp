@@ -797,6 +797,97 @@ int main() {
 
         std::cout << "\tRemoving rows took:" << dTr << "ms" << std::endl;
     }
+    {
+        std::cout << "Test column and row lookup after changes to the table."
+                  << std::endl;
+        std::vector<double> times{0, 0.1, 0.25, 0.3, 0.7};
+        SimTK::Matrix data{5, 3};
+        for(int r = 0; r < data.nrow(); ++r)
+            for(int c = 0; c < data.ncol(); ++c)
+                data(r, c) = 10 * r + c;
+        TimeSeriesTable table{times, data, {"a", "b", "c"}};
+
+        ASSERT(table.getColumnIndex("c") == 2);
+        table.setColumnLabel(2, "d");
+        ASSERT(!table.hasColumn("c"));
+        ASSERT(table.getColumnIndex("d") == 2);
+        SimTK_TEST_MUST_THROW_EXC(table.getColumnIndex("c"),
+                                  OpenSim::KeyNotFound);
+        table.removeColumn("a");
+        ASSERT(table.getColumnIndex("b") == 0);
+        ASSERT(table.getColumnIndex("d") == 1);
+        SimTK_TEST_MUST_THROW_EXC(table.removeColumn("a"),
+                                  OpenSim::KeyNotFound);
+        table.appendColumn("e", std::vector<double>(5, 1.0));
+        ASSERT(table.getColumnIndex("e") == 2);
+
+        // Copies have their own index.
+        TimeSeriesTable copy{table};
+        copy.setColumnLabels({"x", "y", "z"});
+        ASSERT(copy.getColumnIndex("z") == 2);
+        ASSERT(table.getColumnIndex("e") == 2);
+        ASSERT(!copy.hasColumn("e"));
+
+        for(size_t r = 0; r < times.size(); ++r)
+            ASSERT(table.getRow(times[r])[0] == 10 * r + 1);
+        SimTK_TEST_MUST_THROW_EXC(table.getRow(0.2), OpenSim::KeyNotFound);
+        SimTK_TEST_MUST_THROW_EXC(table.getRow(1.0), OpenSim::KeyNotFound);
+        table.removeRow(0.25);
+        ASSERT(table.getRow(0.3)[0] == 31);
+        table.updRow(0.7)[0] = -1;
+        ASSERT(table.getRowAtIndex(3)[0] == -1);
+        SimTK_TEST_MUST_THROW_EXC(table.updRow(0.25), OpenSim::KeyNotFound);
+    }
+    {
+        std::cout << "Test appending rows to a table with room for rows."
+                  << std::endl;
+        TimeSeriesTable table{};
+        table.setColumnLabels({"a", "b"});
+        table.reserveRows(100);
+        ASSERT(table.getRowCapacity() >= 100);
+        for(int r = 0; r < 10; ++r)
+            table.appendRow(0.1 * r, SimTK::RowVector(2, double(r)));
+        ASSERT(table.getNumRows() == 10);
+        ASSERT(table.getMatrix().nrow() == 10);
+        ASSERT(table.getDependentColumn("b").size() == 10);
+        ASSERT(table.getDependentColumnAtIndex(1)[9] == 9);
+
+        SimTK::Matrix more{5, 2};
+        std::vector<double> moreTimes{};
+        for(int r = 0; r < 5; ++r) {
+            moreTimes.push_back(1 + 0.1 * r);
+            more.updRow(r) = 10 + r;
+        }
+        table.appendRows(moreTimes, more);
+        ASSERT(table.getNumRows() == 15);
+        ASSERT(table.getRowAtIndex(14)[0] == 14);
+        ASSERT(table.getMatrix().nrow() == 15);
+
+        // Rows are only appended if all of them are valid.
+        SimTK_TEST_MUST_THROW_EXC(table.appendRows(moreTimes, more),
+                                  OpenSim::TimestampLessThanEqualToPrevious);
+        ASSERT(table.getNumRows() == 15);
+        SimTK_TEST_MUST_THROW_EXC(
+                table.appendRows({2, 2.1}, SimTK::Matrix{2, 3, 0.0}),
+                OpenSim::IncorrectNumColumns);
+        ASSERT(table.getNumRows() == 15);
+
+        table.removeRowAtIndex(0);
+        table.appendRow(2, SimTK::RowVector(2, 20.0));
+        ASSERT(table.getNumRows() == 15);
+        ASSERT(table.getRowAtIndex(0)[0] == 1);
+        ASSERT(table.getRow(2)[1] == 20);
+        table.updMatrix() += 1;
+        ASSERT(table.getRow(2)[1] == 21);
+
+        // Appending a column drops the room for rows.
+        table.appendColumn("c", std::vector<double>(15, 3.0));
+        ASSERT(table.getRowCapacity() == 15);
+        ASSERT(table.getDependentColumn("c").size() == 15);
+        table.appendRow(3, SimTK::RowVector(3, 30.0));
+        ASSERT(table.getNumRows() == 16);
+        ASSERT(table.getRowCapacity() >= 16);
+    }
 
     return 0;
 }
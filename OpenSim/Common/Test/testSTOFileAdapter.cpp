@@ -21,10 +21,15 @@
  * -------------------------------------------------------------------------- */
 
 #include "OpenSim/Common/Adapters.h"
+#include "OpenSim/Common/TableReader.h"
 
 #include <unordered_set>
 #include <fstream>
 #include <cstdio>
+#include <cmath>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
 
 std::string getNextToken(std::istream& stream, 
                          const std::string& delims) {
@@ -228,6 +233,155 @@ void testReadingWriting() {
     }
 }
 
+void testReadingNumbers() {
+    using namespace OpenSim;
+
+    // Numbers in various notations must be read exactly as std::stod() reads
+    // them, regardless of which path of the parser they take.
+    const std::vector<std::string> numbers{"0", "-0", "+1.5", ".5", "5.",
+        "1e5", "1E-5", "0.000123", "0.30000000000000004",
+        "9.0071992547409934", "123456789012345678901234567890",
+        "-2.5e+300", "nan", "NaN", "-inf", "0x1p3",
+        "3.14159265358979323846264338327950288"};
+    const std::string fileName{"testSTOFileAdapter_numbers.sto"};
+    {
+        std::ofstream file{fileName, std::ios::binary};
+        file << "header\r\nversion=1\r\nendheader\r\n";
+        file << "time\tc0\tc1\r\n";
+        for(size_t i = 0; i < numbers.size(); ++i)
+            // Trailing delimiters and whitespace around tokens are ignored.
+            file << i << "\t " << numbers[i] << "\t"
+                 << numbers[numbers.size() - 1 - i] << " \t\r\n";
+    }
+    const auto table = STOFileAdapter::readFile(fileName);
+    SimTK_TEST(table.getNumRows() == numbers.size());
+    SimTK_TEST(table.getNumColumns() == 2);
+    for(size_t i = 0; i < numbers.size(); ++i) {
+        const auto& row = table.getRowAtIndex(i);
+        const double expected[2] = {std::stod(numbers[i]),
+                std::stod(numbers[numbers.size() - 1 - i])};
+        SimTK_TEST(table.getIndependentColumn()[i] == i);
+        for(int j = 0; j < 2; ++j) {
+            SimTK_TEST((row[j] == expected[j] &&
+                        std::signbit(row[j]) == std::signbit(expected[j])) ||
+                       (std::isnan(row[j]) && std::isnan(expected[j])));
+        }
+    }
+
+    // Rows with the wrong number of elements or components are errors.
+    {
+        std::ofstream file{fileName};
+        file << "endheader\ntime\tc0\tc1\n0\t1\t2\n1\t1\n";
+    }
+    SimTK_TEST_MUST_THROW_EXC(STOFileAdapter::readFile(fileName),
+                              RowLengthMismatch);
+    {
+        std::ofstream file{fileName};
+        file << "DataType=Vec3\nendheader\ntime\tc0\n0\t1,2,3\n1\t1,2\n";
+    }
+    SimTK_TEST_MUST_THROW_EXC(STOFileAdapter_<SimTK::Vec3>::readFile(fileName),
+                              IncorrectNumTokens);
+    std::remove(fileName.c_str());
+}
+
+void testWritingNumbers() {
+    using namespace OpenSim;
+
+    // The rows are formatted on several threads, and must be written exactly
+    // as a stream formats them.
+    const int numRows = 5000;
+    std::vector<double> times{};
+    SimTK::Matrix_<SimTK::Vec3> matrix(numRows, 2);
+    for(int i = 0; i < numRows; ++i) {
+        times.push_back(0.001 * i);
+        matrix(i, 0) = SimTK::Vec3{std::sin(i) * std::pow(10.0, i % 40 - 20),
+                                   -1.0 / (i + 1), 1e300 * i};
+        matrix(i, 1) = SimTK::Vec3{i % 11 == 0 ? SimTK::NaN : 1.5 * i,
+                                   SimTK::Infinity, -0.0};
+    }
+    const TimeSeriesTable_<SimTK::Vec3> table{times, matrix, {"a", "b"}};
+    const std::string fileName{"testSTOFileAdapter_writing.sto"};
+    STOFileAdapter_<SimTK::Vec3>::write(table, fileName);
+
+    std::ostringstream expected{};
+    constexpr auto prec = std::numeric_limits<double>::digits10 + 1;
+    expected << std::setprecision(prec);
+    for(int i = 0; i < numRows; ++i) {
+        expected << times[i];
+        for(int j = 0; j < 2; ++j)
+            expected << "\t" << matrix(i, j)[0] << "," << matrix(i, j)[1]
+                     << "," << matrix(i, j)[2];
+        expected << "\n";
+    }
+
+    std::ifstream file{fileName};
+    const std::string contents{std::istreambuf_iterator<char>{file},
+                               std::istreambuf_iterator<char>{}};
+    const std::string labels{"time\ta\tb\n"};
+    const auto dataBegin = contents.find(labels);
+    SimTK_TEST(dataBegin != std::string::npos);
+    SimTK_TEST(contents.substr(dataBegin + labels.size()) == expected.str());
+    file.close();
+    std::remove(fileName.c_str());
+}
+
+void testTableReader() {
+    using namespace OpenSim;
+
+    const std::string fileName{"testSTOFileAdapter_reader.sto"};
+    {
+        TimeSeriesTable table{};
+        table.setColumnLabels({"c0", "c1", "c2", "c3"});
+        for(int i = 0; i < 103; ++i)
+            table.appendRow(0.01 * i, {1.0 / (3 + i), -0.5 * i, 1e-10 * i,
+                                       SimTK::Pi * i});
+        table.addTableMetaData("inDegrees", std::string{"no"});
+        STOFileAdapter::write(table, fileName);
+    }
+    // Text files lose precision, so the chunks are compared with the table
+    // read whole.
+    const TimeSeriesTable expected{fileName};
+
+    for(size_t chunkSize : {1, 7, 1000}) {
+        TableReader reader{fileName, chunkSize};
+        SimTK_TEST(reader.getHeader().getNumRows() == 0);
+        SimTK_TEST(reader.getHeader().getColumnLabels() ==
+                   expected.getColumnLabels());
+        SimTK_TEST(reader.getHeader().getTableMetaData<std::string>(
+                           "inDegrees") == "no");
+
+        auto table = reader.getHeader();
+        TimeSeriesTable chunk{};
+        while(reader.readChunk(chunk)) {
+            SimTK_TEST(chunk.getNumRows() > 0);
+            SimTK_TEST(chunk.getNumRows() <= chunkSize);
+            SimTK_TEST(chunk.getColumnLabels() == expected.getColumnLabels());
+            table.appendRows(chunk.getIndependentColumn(), chunk.getMatrix());
+        }
+        SimTK_TEST(chunk.getNumRows() == 0);
+        SimTK_TEST(reader.getNumRowsRead() == expected.getNumRows());
+        SimTK_TEST(table.getIndependentColumn() ==
+                   expected.getIndependentColumn());
+        for(int row = 0; row < int(expected.getNumRows()); ++row)
+            for(int col = 0; col < int(expected.getNumColumns()); ++col)
+                SimTK_TEST(table.getMatrix()(row, col) ==
+                           expected.getMatrix()(row, col));
+    }
+
+    // Rows that were not read yet.
+    TableReader reader{fileName, 10};
+    TimeSeriesTable chunk{};
+    SimTK_TEST(reader.readChunk(chunk));
+    const auto rest = reader.readRemainingRows();
+    SimTK_TEST(rest.getNumRows() == expected.getNumRows() - 10);
+    SimTK_TEST(rest.getIndependentColumn().front() ==
+               expected.getIndependentColumn()[10]);
+
+    SimTK_TEST_MUST_THROW_EXC(TableReader_<SimTK::Vec3>{fileName},
+                              IncorrectTableType);
+    std::remove(fileName.c_str());
+}
+
 int main() {
     using namespace OpenSim;
 
@@ -335,6 +489,17 @@ int main() {
     SimTK_TEST(outputTables["table"]->getNumRows() == 2);
     SimTK_TEST(outputTables["table"]->getNumColumns() == 2);
 
+    std::cout << "Testing reading numbers in different notations."
+              << std::endl;
+    testReadingNumbers();
+
+    std::cout << "Testing writing numbers." << std::endl;
+    testWritingNumbers();
+
+    std::cout << "Testing reading a file in chunks with TableReader."
+              << std::endl;
+    testTableReader();
+
     std::cout << "\nAll tests passed!" << std::endl;
 
     return 0;
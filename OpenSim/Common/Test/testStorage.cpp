@@ -21,7 +21,10 @@
  * -------------------------------------------------------------------------- */
 
 #include <fstream>
+#include <future>
+#include <iterator>
 #include <OpenSim/Common/Storage.h>
+#include <OpenSim/Common/IO.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 #include <OpenSim/Common/STOFileAdapter.h>
 
@@ -170,6 +173,258 @@ void testStorageGetStateIndexBackwardsCompatibility() {
     // TODO: Put XML document version in Storage header.
 }
 
+void testStorageTimeLookup() {
+    // Nondecreasing times, including repeated times.
+    const int nRows = 200;
+    const int nCols = 3;
+    Storage sto(nRows);
+    double t = 0;
+    for (int i = 0; i < nRows; ++i) {
+        if (i % 17 != 5) t += 0.01 * (1 + i % 3);
+        double row[nCols] = { t, 2 * t, -t };
+        sto.append(t, nCols, row);
+    }
+    SimTK_TEST(sto.getSize() == nRows);
+
+    // Index of the last element whose time is not greater than aT (or 0).
+    auto linearFindIndex = [&](double aT) {
+        int i = 0;
+        while (i < nRows && !(aT < sto.getStateVector(i)->getTime())) ++i;
+        return std::max(i - 1, 0);
+    };
+
+    std::vector<double> queries{ -1.0, 0.0, 1e6 };
+    for (int i = 0; i < nRows; ++i) {
+        const double ti = sto.getStateVector(i)->getTime();
+        queries.push_back(ti);
+        queries.push_back(ti + 0.003);
+    }
+    // Also query out of order so the cached index is a poor starting point.
+    std::vector<double> shuffled(queries.rbegin(), queries.rend());
+    for (int i = 0; i < (int)queries.size(); i += 7) {
+        std::swap(shuffled[i], shuffled[(i * 31) % queries.size()]);
+    }
+    queries.insert(queries.end(), shuffled.begin(), shuffled.end());
+
+    int hint = 0;
+    for (double q : queries) {
+        const int expected = linearFindIndex(q);
+        SimTK_TEST(sto.findIndex(q) == expected);
+        SimTK_TEST(sto.findIndex(hint, q) == expected);
+        SimTK_TEST(sto.findIndex(nRows + 3, q) == expected);
+        hint = (hint * 13 + 7) % nRows;
+    }
+
+    // Interpolated values are the same for each getDataAtTime() overload.
+    double tFirst, tLast;
+    sto.getTime(0, tFirst);
+    sto.getTime(nRows - 1, tLast);
+    for (double q = tFirst; q < tLast; q += 0.0037) {
+        Array<double> arr(0.0, nCols);
+        SimTK_TEST(sto.getDataAtTime(q, nCols, arr) == nCols);
+        SimTK_TEST_EQ(arr[1], 2 * arr[0]);
+        SimTK_TEST_EQ(arr[2], -arr[0]);
+        if (q >= sto.getStateVector(1)->getTime()) {
+            SimTK_TEST_EQ(arr[0], q);
+        }
+
+        double* ptr = new double[nCols];
+        SimTK_TEST(sto.getDataAtTime(q, nCols, ptr) == nCols);
+        for (int j = 0; j < nCols; ++j) SimTK_TEST_EQ(ptr[j], arr[j]);
+        delete[] ptr;
+
+        // Elements beyond the stored columns are zeroed.
+        SimTK::Vector v(nCols + 2, SimTK::NaN);
+        SimTK_TEST(sto.getDataAtTime(q, nCols + 2, v) == nCols);
+        for (int j = 0; j < nCols; ++j) SimTK_TEST_EQ(v[j], arr[j]);
+        SimTK_TEST(v[nCols] == 0 && v[nCols + 1] == 0);
+    }
+}
+
+void testStorageColumnar() {
+    // Grow in small increments, with rows of different lengths.
+    Storage sto(2);
+    sto.setCapacityIncrement(3);
+    const int nRows = 20;
+    for (int i = 0; i < nRows; ++i) {
+        double row[3] = { 1.0 * i, 10.0 * i, 100.0 * i };
+        sto.append(0.1 * i, i == 7 ? 2 : 3, row);
+    }
+    SimTK_TEST(sto.getSize() == nRows);
+    SimTK_TEST(sto.getSmallestNumberOfStates() == 2);
+    SimTK_TEST(sto.getStateVector(7)->getSize() == 2);
+    SimTK_TEST(sto.getStateVector(8)->getSize() == 3);
+    double value;
+    sto.getData(12, 2, value);
+    SimTK_TEST_EQ(value, 1200.0);
+
+    // Appending at the last time overwrites the last row.
+    double last[3] = { -1, -2, -3 };
+    sto.append(0.1 * (nRows - 1), 3, last);
+    SimTK_TEST(sto.getSize() == nRows);
+    sto.getData(nRows - 1, 0, value);
+    SimTK_TEST_EQ(value, -1.0);
+
+    // getStateVector() builds the row in a StateVector owned by the Storage,
+    // which the next call reuses.
+    StateVector* cachedRow = sto.getStateVector(8);
+    SimTK_TEST(sto.getStateVector(7) == cachedRow);
+    SimTK_TEST(cachedRow->getSize() == 2);
+    SimTK_TEST(sto.getLastStateVector() == cachedRow);
+    SimTK_TEST_EQ(cachedRow->getTime(), sto.getLastTime());
+    SimTK_TEST(sto.getStateVector(nRows) == NULL);
+    SimTK_TEST(sto.getStateVector(-1) == NULL);
+    SimTK_TEST(Storage().getLastStateVector() == NULL);
+    SimTK_TEST_MUSTTHROW(Storage().getLastRow());
+
+    // getRow() returns a copy; edits are stored with setRow().
+    StateVector row7 = sto.getRow(7);
+    row7.getData().append(700.0);
+    SimTK_TEST(sto.getSmallestNumberOfStates() == 2);
+    sto.setRow(7, row7);
+    SimTK_TEST(sto.getSmallestNumberOfStates() == 3);
+    StateVector row3 = sto.getRow(3);
+    row3.setTime(0.31);
+    double t;
+    sto.getTime(3, t);
+    SimTK_TEST_EQ(t, 0.3);
+    sto.setRow(3, row3);
+    sto.getTime(3, t);
+    SimTK_TEST_EQ(t, 0.31);
+    row3.setTime(0.3);
+    sto.setRow(3, row3);
+    SimTK_TEST_MUSTTHROW(sto.setRow(nRows, row3));
+
+    Array<double> column;
+    SimTK_TEST(sto.getDataColumn(2, column) == nRows);
+    SimTK_TEST_EQ(column[7], 700.0);
+    SimTK_TEST_EQ(column[5], 500.0);
+
+    // Operations with another storage interpolate it at our times.
+    Storage other(sto);
+    other.multiply(2.0);
+    other.subtract(&sto);
+    for (int i = 0; i < nRows; ++i) {
+        Array<double> a(0.0, 3), b(0.0, 3);
+        sto.getData(i, 3, a);
+        other.getData(i, 3, b);
+        for (int j = 0; j < 3; ++j) SimTK_TEST_EQ(a[j], b[j]);
+    }
+
+    // Exported tables and printed files have the same data.
+    Array<std::string> labels;
+    labels.append("time");
+    labels.append("a");
+    labels.append("b");
+    labels.append("c");
+    sto.setColumnLabels(labels);
+    const TimeSeriesTable table = sto.exportToTable();
+    SimTK_TEST((int)table.getNumRows() == nRows);
+    SimTK_TEST_EQ(table.getMatrix()(11, 1), 110.0);
+    sto.print("testStorageColumnar.sto");
+    Storage reloaded("testStorageColumnar.sto");
+    SimTK_TEST(reloaded.getSize() == nRows);
+    reloaded.getData(11, 1, value);
+    SimTK_TEST_EQ(value, 110.0);
+
+    // Interpolated rows are inserted in time order.
+    Array<double> targetTimes;
+    targetTimes.append(0.25);
+    targetTimes.append(0.05);
+    targetTimes.append(0.3);
+    sto.interpolateAt(targetTimes);
+    SimTK_TEST(sto.getSize() == nRows + 2);
+    sto.getTime(1, t);
+    SimTK_TEST_EQ(t, 0.05);
+    sto.getData(1, 1, value);
+    SimTK_TEST_EQ(value, 5.0);
+    sto.getTime(4, t);
+    SimTK_TEST_EQ(t, 0.25);
+
+    sto.crop(0.25, 0.5);
+    SimTK_TEST(sto.getSize() == 4);
+    sto.getData(0, 0, value);
+    SimTK_TEST_EQ(value, 2.5);
+}
+
+void testStoragePrint() {
+    // Enough rows to be formatted on several threads.
+    Storage sto;
+    Array<std::string> labels;
+    labels.append("time");
+    labels.append("a");
+    labels.append("b");
+    sto.setColumnLabels(labels);
+    const int nRows = 5000;
+    for (int i = 0; i < nRows; ++i) {
+        double row[2] = { std::sin(i), 1e6 * i };
+        // Rows of different lengths.
+        sto.append(0.01 * i, i == 100 ? 1 : 2, row);
+    }
+    sto.print("testStoragePrint.sto");
+    std::future<bool> printed = sto.printAsync("testStoragePrintAsync.sto");
+    // The storage may be changed while the file is written.
+    double last[2] = { 1, 2 };
+    sto.append(100.0, 2, last);
+    SimTK_TEST(printed.get());
+
+    auto readFile = [](const std::string& fileName) {
+        std::ifstream file(fileName);
+        return std::string(std::istreambuf_iterator<char>(file),
+                           std::istreambuf_iterator<char>());
+    };
+    const std::string contents = readFile("testStoragePrint.sto");
+    SimTK_TEST(readFile("testStoragePrintAsync.sto") == contents);
+
+    // The rows are written exactly as printRow() (fprintf()) writes them.
+    std::string expected;
+    char text[256];
+    const std::string format = IO::GetDoubleOutputFormat();
+    for (int i = 0; i < nRows; ++i) {
+        double t, value;
+        sto.getTime(i, t);
+        snprintf(text, sizeof(text), format.c_str(), t);
+        expected += text;
+        for (int j = 0; j < (i == 100 ? 1 : 2); ++j) {
+            sto.getData(i, j, value);
+            snprintf(text, sizeof(text), ("\t" + format).c_str(), value);
+            expected += text;
+        }
+        expected += "\n";
+    }
+    SimTK_TEST(contents.size() >= expected.size());
+    SimTK_TEST(contents.compare(contents.size() - expected.size(),
+                                expected.size(), expected) == 0);
+
+    // Printing at uniform times gives the rows that StateVector::print()
+    // gives for the interpolated states, with one or several threads.
+    const double dt = 0.0037;
+    SimTK_TEST(sto.print("testStoragePrintDT.sto", dt) > 0);
+    SimTK_TEST(sto.print("testStoragePrintDT1.sto", dt, "w", 1) > 0);
+    const std::string resampled = readFile("testStoragePrintDT.sto");
+    SimTK_TEST(readFile("testStoragePrintDT1.sto") == resampled);
+    {
+        FILE* fp = fopen("testStoragePrintDTRows.sto", "w");
+        double ti = sto.getFirstTime();
+        int nr = IO::ComputeNumberOfSteps(ti, sto.getLastTime(), dt);
+        int ny = 0;
+        double* y = NULL;
+        StateVector vec;
+        for (int i = 0; i < nr; ++i) {
+            const double t = ti + dt*(double)i;
+            ny = sto.getDataAtTime(t, ny, &y);
+            vec.setStates(t, SimTK::Vector_<double>(ny, y));
+            vec.print(fp);
+        }
+        delete[] y;
+        fclose(fp);
+    }
+    const std::string rows = readFile("testStoragePrintDTRows.sto");
+    SimTK_TEST(resampled.size() >= rows.size());
+    SimTK_TEST(resampled.compare(resampled.size() - rows.size(),
+                                 rows.size(), rows) == 0);
+}
+
 int main() {
     SimTK_START_TEST("testStorage");
 
@@ -194,6 +449,12 @@ int main() {
         SimTK_SUBTEST(testStorageLegacy);
 
         SimTK_SUBTEST(testStorageGetStateIndexBackwardsCompatibility);
+
+        SimTK_SUBTEST(testStorageTimeLookup);
+
+        SimTK_SUBTEST(testStorageColumnar);
+
+        SimTK_SUBTEST(testStoragePrint);
     SimTK_END_TEST();
 }
 
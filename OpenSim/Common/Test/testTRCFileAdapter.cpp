@@ -23,8 +23,10 @@
 #include "OpenSim/Common/Adapters.h"
 #include <OpenSim/Common/IO.h>
 
+#include <cmath>
 #include <fstream>
 #include <cstdio>
+#include <iterator>
 
 void testFailed(const std::string& filename,
                 const std::string& origtoken,
@@ -120,6 +122,79 @@ void compareFiles(const std::string& filenameA,
     } // end while
 }
 
+// A file with enough rows to be decoded on several threads must read the
+// same as the table it was written from.
+void testLargeFile() {
+    using namespace OpenSim;
+
+    const std::string filename{"testtrcfileadapter_large.trc"};
+    const int numRows = 10000;
+    const int numMarkers = 5;
+    std::vector<double> times{};
+    SimTK::Matrix_<SimTK::Vec3> matrix(numRows, numMarkers);
+    for(int row = 0; row < numRows; ++row) {
+        times.push_back(0.01 * row);
+        for(int col = 0; col < numMarkers; ++col)
+            matrix(row, col) = (row + col) % 7 == 0 ?
+                    SimTK::Vec3(SimTK::NaN) :
+                    SimTK::Vec3{0.5 * row, -1e-5 * col, 1e5 * (row + col)};
+    }
+    TimeSeriesTableVec3 table{times, matrix,
+                              {"m0", "m1", "m2", "m3", "m4"}};
+    table.updTableMetaData().setValueForKey("DataRate", std::string{"100"});
+    table.updTableMetaData().setValueForKey("Units", std::string{"mm"});
+    TRCFileAdapter::write(table, filename);
+
+    const auto read = TRCFileAdapter::readFile(filename);
+    OPENSIM_THROW_IF(read.getNumRows() != numRows ||
+                     read.getNumColumns() != numMarkers ||
+                     read.getColumnLabels() != table.getColumnLabels(),
+                     Exception, "Table read from large file does not match.");
+    for(int row = 0; row < numRows; ++row) {
+        OPENSIM_THROW_IF(std::abs(read.getIndependentColumn()[row] -
+                                  times[row]) > 1e-12,
+                         Exception, "Time does not match.");
+        for(int col = 0; col < numMarkers; ++col) {
+            const auto& expected = matrix(row, col);
+            const auto& actual = read.getMatrix()(row, col);
+            for(int i = 0; i < 3; ++i)
+                OPENSIM_THROW_IF(std::isnan(expected[i]) ?
+                                 !std::isnan(actual[i]) :
+                                 std::abs(actual[i] - expected[i]) >
+                                 1e-12 * (1 + std::abs(expected[i])),
+                                 Exception, "Marker does not match.");
+        }
+    }
+
+    // A short row far into the file is reported.
+    std::string contents{};
+    {
+        std::ifstream stream{filename};
+        contents.assign(std::istreambuf_iterator<char>{stream},
+                        std::istreambuf_iterator<char>{});
+    }
+    const auto pos = contents.find("\n8000\t");
+    OPENSIM_THROW_IF(pos == std::string::npos,
+                     Exception, "Row 8000 not found.");
+    // Keep only the frame number.
+    const auto dataBegin = contents.find('\t', pos + 1) + 1;
+    const auto dataEnd = contents.find('\n', pos + 1);
+    contents.erase(dataBegin, dataEnd - dataBegin);
+    {
+        std::ofstream stream{filename};
+        stream << contents;
+    }
+    bool threw = false;
+    try {
+        TRCFileAdapter::readFile(filename);
+    } catch(RowLengthMismatch&) {
+        threw = true;
+    }
+    OPENSIM_THROW_IF(!threw, Exception, "Short row was not reported.");
+
+    std::remove(filename.c_str());
+}
+
 int main() {
     using namespace OpenSim;
 
@@ -187,6 +262,16 @@ int main() {
         }
     }
 
+    std::cout << "Testing TRCFileAdapter::read() of a large file"
+              << std::endl;
+    try {
+        testLargeFile();
+    }
+    catch (std::exception& ex) {
+        std::cout << "Failed because: '" << ex.what() << "'." << std::endl;
+        failed = true;
+    }
+
     if (failed)
         return 1;
 
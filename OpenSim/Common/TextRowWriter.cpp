@@ -0,0 +1,220 @@
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  TextRowWriter.cpp                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2019 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "TextRowWriter.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdarg>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace OpenSim {
+
+const size_t TextRowWriter::RowsPerBlock{1024};
+
+namespace {
+    // Size of the buffer at which rows formatted on one thread are written.
+    const size_t bufferSize{1 << 20};
+
+    // Append the text of the printf format `format` to `buffer`.
+    void appendFormatted(std::string& buffer, const char* format, ...) {
+        char text[64];
+        va_list args;
+        va_start(args, format);
+        va_list argsCopy;
+        va_copy(argsCopy, args);
+        const int size = std::vsnprintf(text, sizeof(text), format, args);
+        va_end(args);
+        if(size < 0) {
+            va_end(argsCopy);
+            return;
+        }
+        if(static_cast<size_t>(size) < sizeof(text)) {
+            buffer.append(text, static_cast<size_t>(size));
+        } else {
+            // Long values (e.g., large numbers in fixed notation).
+            const size_t begin = buffer.size();
+            buffer.resize(begin + size + 1);
+            std::vsnprintf(&buffer[begin], size + 1, format, argsCopy);
+            buffer.resize(begin + size);
+        }
+        va_end(argsCopy);
+    }
+}
+
+bool
+TextRowWriter::write(size_t numRows,
+                     const FormatRow& formatRow,
+                     const WriteText& writeText,
+                     int numThreads) {
+    const size_t numBlocks = (numRows + RowsPerBlock - 1) / RowsPerBlock;
+    if(numThreads <= 0)
+        numThreads = static_cast<int>(std::thread::hardware_concurrency());
+    numThreads = static_cast<int>(std::min<size_t>(
+                                  std::max(numThreads, 1), numBlocks));
+
+    // Few rows: format and write them on this thread.
+    if(numThreads <= 1) {
+        std::string buffer{};
+        for(size_t row = 0; row < numRows; ++row) {
+            formatRow(row, buffer);
+            if(buffer.size() >= bufferSize) {
+                if(!writeText(buffer.data(), buffer.size()))
+                    return false;
+                buffer.clear();
+            }
+        }
+        return buffer.empty() || writeText(buffer.data(), buffer.size());
+    }
+
+    // The threads take the blocks in order and format them into a window of
+    // buffers, while this thread writes the buffers in order. A thread does
+    // not start a block until its buffer in the window has been written, so
+    // memory use is bounded.
+    const size_t window = 2 * static_cast<size_t>(numThreads);
+    std::vector<std::string> buffers(window);
+    std::vector<bool> ready(window, false);
+    size_t nextBlock = 0;
+    size_t nextToWrite = 0;
+    bool stopping = false;
+    std::exception_ptr error{};
+    std::mutex mutex;
+    std::condition_variable changed;
+
+    auto formatBlocks = [&] {
+        std::string buffer{};
+        std::unique_lock<std::mutex> lock{mutex};
+        while(true) {
+            changed.wait(lock, [&] {
+                    return stopping || nextBlock == numBlocks ||
+                           nextBlock < nextToWrite + window; });
+            if(stopping || nextBlock == numBlocks)
+                return;
+            const size_t block = nextBlock++;
+            lock.unlock();
+
+            std::exception_ptr blockError{};
+            buffer.clear();
+            try {
+                const size_t end = std::min(numRows,
+                                            (block + 1) * RowsPerBlock);
+                for(size_t row = block * RowsPerBlock; row < end; ++row)
+                    formatRow(row, buffer);
+            } catch(...) {
+                blockError = std::current_exception();
+            }
+
+            lock.lock();
+            if(blockError) {
+                if(!error)
+                    error = blockError;
+                stopping = true;
+            } else {
+                buffers[block % window].swap(buffer);
+                ready[block % window] = true;
+            }
+            changed.notify_all();
+        }
+    };
+
+    std::vector<std::thread> threads{};
+    for(int t = 0; t < numThreads; ++t)
+        threads.emplace_back(formatBlocks);
+
+    bool written = true;
+    std::string buffer{};
+    for(size_t block = 0; block < numBlocks; ++block) {
+        {
+            std::unique_lock<std::mutex> lock{mutex};
+            changed.wait(lock, [&] {
+                    return ready[block % window] || stopping; });
+            if(!ready[block % window])
+                break;
+            buffer.clear();
+            buffer.swap(buffers[block % window]);
+            ready[block % window] = false;
+            nextToWrite = block + 1;
+        }
+        changed.notify_all();
+        if(!writeText(buffer.data(), buffer.size())) {
+            written = false;
+            break;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        stopping = true;
+    }
+    changed.notify_all();
+    for(auto& thread : threads)
+        thread.join();
+    if(error)
+        std::rethrow_exception(error);
+    return written;
+}
+
+bool
+TextRowWriter::write(std::ostream& stream,
+                     size_t numRows,
+                     const FormatRow& formatRow,
+                     int numThreads) {
+    return write(numRows, formatRow,
+                 [&](const char* data, size_t size) {
+                     stream.write(data, static_cast<std::streamsize>(size));
+                     return stream.good();
+                 },
+                 numThreads);
+}
+
+bool
+TextRowWriter::write(FILE* file,
+                     size_t numRows,
+                     const FormatRow& formatRow,
+                     int numThreads) {
+    return write(numRows, formatRow,
+                 [&](const char* data, size_t size) {
+                     return std::fwrite(data, 1, size, file) == size;
+                 },
+                 numThreads);
+}
+
+void
+TextRowWriter::appendDouble(std::string& buffer,
+                            const char* format,
+                            double value) {
+    appendFormatted(buffer, format, value);
+}
+
+void
+TextRowWriter::appendDouble(std::string& buffer,
+                            double value,
+                            int precision) {
+    // std::ostream formats doubles with "%.*g" (without the fixed or
+    // scientific flags).
+    appendFormatted(buffer, "%.*g", precision, value);
+}
+
+} // namespace OpenSim
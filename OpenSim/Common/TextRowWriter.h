@@ -0,0 +1,100 @@
+#ifndef OPENSIM_TEXT_ROW_WRITER_H_
+#define OPENSIM_TEXT_ROW_WRITER_H_
+/* -------------------------------------------------------------------------- *
+ *                         OpenSim:  TextRowWriter.h                          *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2019 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimCommonDLL.h"
+
+#include <cstdio>
+#include <functional>
+#include <ostream>
+#include <string>
+
+namespace OpenSim {
+
+/** TextRowWriter writes the rows of a table as text. Blocks of rows are
+formatted into large buffers on several threads, and the buffers are written
+in row order, so the output is the same as if the rows were formatted one
+after another. Storage and the adapters for text files (STO, MOT, CSV, TRC)
+use it to write their rows.
+
+@code
+std::vector<double> values = ...;
+std::ofstream stream{"values.txt"};
+TextRowWriter::write(stream, values.size(),
+        [&](size_t row, std::string& buffer) {
+            TextRowWriter::appendDouble(buffer, values[row], 17);
+            buffer += '\n';
+        });
+@endcode                                                                      */
+class OSIMCOMMON_API TextRowWriter {
+public:
+    /** Appends the text of row `row`, including its line ending, to
+    `buffer`. It is called on several threads at once (for different rows),
+    so it must only read the data it formats.                                */
+    typedef std::function<void(size_t row, std::string& buffer)> FormatRow;
+    /** Writes `size` characters of formatted rows. Returns false if the
+    characters could not be written.                                         */
+    typedef std::function<bool(const char* data, size_t size)> WriteText;
+
+    /** Format rows 0 to `numRows` - 1 with `formatRow` and pass the text to
+    `writeText`, in row order. Returns false, after stopping the threads, if
+    `writeText` fails. An exception thrown by `formatRow` is rethrown.
+    @param numThreads Number of threads that format rows. A value of 0 or
+                      less uses one thread per processor. Fewer threads are
+                      used when there are few rows.                          */
+    static bool write(size_t numRows,
+                      const FormatRow& formatRow,
+                      const WriteText& writeText,
+                      int numThreads = 0);
+
+    /** Write the rows to `stream`. Returns false if writing fails.          */
+    static bool write(std::ostream& stream,
+                      size_t numRows,
+                      const FormatRow& formatRow,
+                      int numThreads = 0);
+
+    /** Write the rows to `file`. Returns false if writing fails.            */
+    static bool write(FILE* file,
+                      size_t numRows,
+                      const FormatRow& formatRow,
+                      int numThreads = 0);
+
+    /** Append `value` formatted with the printf format `format` (e.g., the
+    format of IO::GetDoubleOutputFormat()), which takes one double.          */
+    static void appendDouble(std::string& buffer,
+                             const char* format,
+                             double value);
+
+    /** Append `value` formatted as a std::ostream with precision
+    `precision` (and default flags) formats it.                              */
+    static void appendDouble(std::string& buffer,
+                             double value,
+                             int precision);
+
+    /** Number of rows that are formatted together into one buffer.         */
+    static const size_t RowsPerBlock;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_TEXT_ROW_WRITER_H_
@@ -425,6 +425,21 @@ protected:
                              DT::_indData[rowIndex + 1]);
         }
     }
+
+    /** Find the row with the given time by binary search, since the time
+    column is strictly increasing.                                            */
+    size_t findRowIndex(const double& time) const override {
+        using DT = DataTable_<double, ETY>;
+
+        const auto& timeCol = DT::_indData;
+        auto iter = std::lower_bound(timeCol.cbegin(), timeCol.cend(), time);
+        if(iter != timeCol.cend() && *iter == time)
+            return std::distance(timeCol.cbegin(), iter);
+
+        // Times assigned through DataTable_ are not checked to be increasing,
+        // so make sure the time is really missing.
+        return DT::findRowIndex(time);
+    }
 }; // TimeSeriesTable_
 
 /** See TimeSeriesTable_ for details on the interface.                        */
@@ -25,11 +25,30 @@
 #include "Model/Model.h"
 #include <OpenSim/Common/FunctionSet.h>
 
+#include <exception>
+#include <memory>
+#include <thread>
+
 using namespace std;
 using namespace SimTK;
 
 namespace OpenSim {
 
+namespace {
+    // The residual mobility forces of the state s of the model, whose speeds
+    // have accelerations udot.
+    void calcResidualForces(const Model& model, const SimTK::State& s,
+            const Vector& udot, Vector& residualMobilityForces)
+    {
+        const MultibodySystem& system = model.getMultibodySystem();
+        system.realize(s, SimTK::Stage::Dynamics);
+        system.getMatterSubsystem().calcResidualForceIgnoringConstraints(s,
+            system.getMobilityForces(s, Stage::Dynamics),
+            system.getRigidBodyForces(s, Stage::Dynamics),
+            udot, residualMobilityForces);
+    }
+}
+
 //______________________________________________________________________________
 /**
  * An implementation of the InverseDynamicsSolver 
@@ -141,4 +160,94 @@ void InverseDynamicsSolver::solve(SimTK::State &s, const FunctionSet &Qs, const
     }
 }
 
+/** Same as above, but solving the frames on several threads */
+void InverseDynamicsSolver::solve(const SimTK::State &s, const FunctionSet &Qs,
+    const Array_<double> &times, Matrix &genForceTrajectory, int numThreads,
+    const FrameFunction &frameFunction)
+{
+    const Model& model = getModel();
+    int nq = model.getNumCoordinates();
+    int nt = times.size();
+
+    if(Qs.getSize() != nq){
+        throw Exception("InverseDynamicsSolver::solve invalid number of q functions.");
+    }
+
+    if( nq != model.getNumSpeeds()){
+        throw Exception("InverseDynamicsSolver::solve using FunctionSet, nq != nu not supported.");
+    }
+
+    genForceTrajectory.resize(nt, nq);
+    if(nt == 0) return;
+
+    // Evaluate the coordinates, speeds and accelerations of all frames, one
+    // function at a time.
+    Matrix q(nt, nq), u(nt, nq), udot(nt, nq);
+    Matrix values;
+    for(int j=0; j<nq; j++){
+        Qs.evaluate(j, 2, times, values);
+        q(j) = values(0);
+        u(j) = values(1);
+        udot(j) = values(2);
+    }
+
+    if(numThreads <= 0) numThreads = (int)std::thread::hardware_concurrency();
+    numThreads = std::max(1, std::min(numThreads, nt));
+
+    // Building a model is not guaranteed to be thread safe, so the copies
+    // of the model for the other threads are built here, one at a time.
+    std::vector<std::unique_ptr<Model>> models;
+    for(int t=1; t<numThreads; t++){
+        models.emplace_back(model.clone());
+        models.back()->initSystem();
+    }
+
+    std::vector<std::exception_ptr> errors(numThreads);
+    auto solveFrames = [&](int t) {
+        try {
+            const Model& threadModel = (t == 0) ? model : *models[t-1];
+            SimTK::State threadState = s;
+            if(t > 0){
+                threadState = threadModel.getWorkingState();
+                threadState.updY() = s.getY();
+                const ForceSet& forces = model.getForceSet();
+                const ForceSet& threadForces = threadModel.getForceSet();
+                for(int k=0; k<forces.getSize(); k++)
+                    threadForces[k].setAppliesForce(threadState,
+                                                    forces[k].appliesForce(s));
+            }
+
+            Vector frameUdot(nq), residualMobilityForces;
+            const int begin = nt*t/numThreads;
+            const int end = nt*(t+1)/numThreads;
+            for(int i=begin; i<end; i++){
+                threadState.updTime() = times[i];
+                threadState.updQ() = ~q[i];
+                threadState.updU() = ~u[i];
+                frameUdot = ~udot[i];
+                calcResidualForces(threadModel, threadState, frameUdot,
+                                   residualMobilityForces);
+                genForceTrajectory[i] = ~residualMobilityForces;
+                if(frameFunction)
+                    frameFunction(threadModel, threadState, i,
+                                  residualMobilityForces);
+                if(numThreads == 1)
+                    const_cast<AnalysisSet&>(model.getAnalysisSet())
+                        .step(threadState, i);
+            }
+        } catch(...) {
+            errors[t] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for(int t=1; t<numThreads; t++) threads.emplace_back(solveFrames, t);
+    solveFrames(0);
+    for(auto& thread : threads) thread.join();
+
+    for(const auto& error : errors){
+        if(error) std::rethrow_exception(error);
+    }
+}
+
 } // end of namespace OpenSim
\ No newline at end of file
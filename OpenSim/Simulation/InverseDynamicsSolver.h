@@ -26,6 +26,8 @@
 #include "Solver.h"
 #include "SimTKcommon/internal/State.h"
 
+#include <functional>
+
 namespace OpenSim {
 
 class FunctionSet;
@@ -98,6 +100,30 @@ public:
     virtual void solve(SimTK::State& s, const FunctionSet& Qs, 
                  const SimTK::Array_<double>&  times,
                  SimTK::Array_<SimTK::Vector>& genForceTrajectory);
+
+    /** A function called by the trajectory solve below for each frame, with
+        the model that solved the frame, the state of the frame (realized to
+        Dynamics), the index of the frame and its generalized forces. */
+    typedef std::function<void(const Model& model, const SimTK::State& s,
+                               int frame, const SimTK::Vector& genForces)>
+        FrameFunction;
+
+    /** Same as above, but the frames are divided among numThreads threads
+        (0 or less uses one thread per processor). The coordinate functions
+        are first evaluated at all the times in the calling thread. The
+        calling thread then solves the first chunk of frames with the model
+        and a copy of s; every other thread solves its chunk with its own
+        copy of the model, taking its state variables and enabled forces from
+        s. Row i of genForceTrajectory receives the generalized forces at
+        times[i]. If a single thread is used, the model's analyses are
+        stepped at each frame as in the solve above; otherwise they are not.
+        frameFunction, if given, is called for each frame from the thread
+        that solved it, and may only write to memory that is specific to the
+        frame. */
+    void solve(const SimTK::State& s, const FunctionSet& Qs,
+               const SimTK::Array_<double>& times,
+               SimTK::Matrix& genForceTrajectory, int numThreads,
+               const FrameFunction& frameFunction = FrameFunction());
 #endif
 //=============================================================================
 };  // END of class InverseDynamicsSolver
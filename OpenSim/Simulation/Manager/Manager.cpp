@@ -24,6 +24,7 @@
 /* Note: This code was originally developed by Realistic Dynamics Inc. 
  * Author: Frank C. Anderson 
  */
+#include <algorithm>
 #include <cstdio>
 #include "Manager.h"
 #include <OpenSim/Simulation/Model/Model.h>
@@ -97,6 +98,9 @@ setNull()
     _dt = 1.0e-4;
     _performAnalyses=true;
     _writeToStorage=true;
+    _numStatesToKeep = 1000;
+    _numStatesDiscarded = 0;
+    _numControlsToKeep = 1000;
     _tArray.setSize(0);
     _dtArray.setSize(0);
 }
@@ -629,6 +633,33 @@ TimeSeriesTable Manager::getStatesTable() const {
     return getStateStorage().exportToTable();
 }
 
+void Manager::
+setStatesFileForStreaming(const std::string& fileName, int numStatesToKeep)
+{
+    OPENSIM_THROW_IF(_statesWriter != nullptr, Exception,
+        "Manager::setStatesFileForStreaming(): "
+        "Cannot change the file after states have been streamed to it.");
+    _statesFileName = fileName;
+    _numStatesToKeep = std::max(numStatesToKeep, 1);
+}
+
+void Manager::
+setControlsFileForStreaming(const std::string& fileName,
+                            int numControlsToKeep)
+{
+    OPENSIM_THROW_IF(_controlsWriter != nullptr, Exception,
+        "Manager::setControlsFileForStreaming(): "
+        "Cannot change the file after controls have been streamed to it.");
+    _controlsFileName = fileName;
+    _numControlsToKeep = std::max(numControlsToKeep, 1);
+}
+
+void Manager::flushStatesFile()
+{
+    if (_statesWriter) _statesWriter->flush();
+    if (_controlsWriter) _controlsWriter->flush();
+}
+
 //_____________________________________________________________________________
 /**
  * Get whether there is a storage buffer for the integration states.
@@ -709,6 +740,7 @@ const SimTK::State& Manager::integrate(double finalTime)
 
     if (time >= stepToTime) {
         // No integration can be performed.
+        flushStatesFile();
         return getState();
     }
 
@@ -740,6 +772,7 @@ const SimTK::State& Manager::integrate(double finalTime)
             cout << "Integration failed due to the following reason: "
                 << _integ->getTerminationReasonString(_integ->getTerminationReason())
                 << endl;
+            flushStatesFile();
             return getState();
         }
 
@@ -752,6 +785,7 @@ const SimTK::State& Manager::integrate(double finalTime)
     clearHalt();
 
     record(_integ->getState(), -1);
+    flushStatesFile();
 
     return getState();
 }
@@ -799,6 +833,44 @@ void Manager::initializeStorageAndAnalyses(const SimTK::State& s)
 
     record(s, 0);
 }
+
+namespace {
+    // The header of a file to which rows of `numColumns` values from
+    // `store` are streamed. The labels of `store` are used if there is one
+    // for each column (besides time); otherwise the columns are numbered.
+    TimeSeriesTable createStreamHeader(const Storage& store, int numColumns)
+    {
+        const Array<string>& storeLabels = store.getColumnLabels();
+        std::vector<std::string> labels;
+        if (storeLabels.getSize() == numColumns + 1) {
+            labels.assign(storeLabels.get() + 1,
+                          storeLabels.get() + storeLabels.getSize());
+        } else {
+            for (int i = 0; i < numColumns; ++i)
+                labels.push_back(store.getName() + "_" + std::to_string(i));
+        }
+        TimeSeriesTable header(std::vector<double>(),
+                               SimTK::Matrix(0, numColumns), labels);
+        header.addTableMetaData("header", store.getName());
+        header.addTableMetaData("inDegrees", std::string{"no"});
+        return header;
+    }
+
+    // Drop the oldest rows of a Storage whose rows are streamed to a file,
+    // keeping at least numRowsToKeep of them, and return the number of rows
+    // dropped. Rows are dropped in batches, so that the cost per step stays
+    // constant.
+    int discardOldestRows(Storage& store, int numRowsToKeep)
+    {
+        const int size = store.getSize();
+        if (size <= 2 * numRowsToKeep) return 0;
+        double startTime;
+        store.getTime(size - numRowsToKeep, startTime);
+        store.crop(startTime, store.getLastTime());
+        return size - store.getSize();
+    }
+}
+
 //_____________________________________________________________________________
 /**
 * set and initialize a SimTK::TimeStepper
@@ -840,10 +912,41 @@ void Manager::record(const SimTK::State& s, const int& step)
         SimTK::Vector stateValues = _model->getStateVariableValues(s);
         StateVector vec;
         vec.setStates(s.getTime(), stateValues);
-        getStateStorage().append(vec);
-        if (_model->isControlled())
+        Storage& stateStore = getStateStorage();
+        stateStore.append(vec);
+        if (!_statesFileName.empty()) {
+            if (!_statesWriter) {
+                _statesWriter.reset(new TableStreamWriter(_statesFileName,
+                        createStreamHeader(stateStore, stateValues.size())));
+            }
+            _statesWriter->appendRow(s.getTime(), ~stateValues);
+            _numStatesDiscarded +=
+                    discardOldestRows(stateStore, _numStatesToKeep);
+        }
+        if (_model->isControlled()) {
             _controllerSet->storeControls(s, 
-                (step < 0) ? getStateStorage().getSize() : step);
+                (step < 0) ? stateStore.getSize() + _numStatesDiscarded
+                           : step);
+            if (!_controlsFileName.empty()) {
+                Storage& controlStore = _controllerSet->updControlStorage();
+                // The controls are not stored at every step (see
+                // Storage::store()), nor if there are no actuators.
+                if (controlStore.getSize() > 0 &&
+                        controlStore.getLastTime() == s.getTime()) {
+                    const SimTK::Vector& controls = _model->getControls(s);
+                    if (!_controlsWriter) {
+                        // The labels name the actuators, which may have more
+                        // than one control each.
+                        _controlsWriter.reset(new TableStreamWriter(
+                                _controlsFileName,
+                                createStreamHeader(controlStore,
+                                                   controls.size())));
+                    }
+                    _controlsWriter->appendRow(s.getTime(), ~controls);
+                    discardOldestRows(controlStore, _numControlsToKeep);
+                }
+            }
+        }
     }
 }
 
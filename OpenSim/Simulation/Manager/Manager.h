@@ -31,6 +31,7 @@
 // INCLUDES
 #include <OpenSim/Common/Array.h>
 #include "OpenSim/Common/TimeSeriesTable.h"
+#include "OpenSim/Common/TableStreamWriter.h"
 #include <OpenSim/Simulation/osimSimulationDLL.h>
 #include <SimTKcommon/internal/ReferencePtr.h>
 
@@ -87,6 +88,22 @@ private:
     /** Storage for the states. */
     std::unique_ptr<Storage> _stateStore;
 
+    /** File to which the states are streamed (empty if they are not). */
+    std::string _statesFileName;
+    /** Number of recent states kept in the Storage while streaming. */
+    int _numStatesToKeep;
+    /** Number of states removed from the Storage while streaming. */
+    int _numStatesDiscarded;
+    /** Writes the states to _statesFileName in the background. */
+    std::unique_ptr<TableStreamWriter> _statesWriter;
+
+    /** File to which the controls are streamed (empty if they are not). */
+    std::string _controlsFileName;
+    /** Number of recent controls kept in the Storage while streaming. */
+    int _numControlsToKeep;
+    /** Writes the controls to _controlsFileName in the background. */
+    std::unique_ptr<TableStreamWriter> _controlsWriter;
+
     /** Flag for signaling a desired halt. */
     bool _halt;
 
@@ -163,6 +180,35 @@ public:
     void setWriteToStorage(bool writeToStorage)
     { _writeToStorage =  writeToStorage; }
 
+    /** Stream the recorded states to the binary (.bsto) file `fileName`
+    while integrating, instead of keeping all of them in memory. The rows are
+    written by a background thread (see TableStreamWriter), and the file
+    holds all the states recorded so far whenever integrate() returns. The
+    state Storage (getStateStorage()) then keeps only the most recent states,
+    at least `numStatesToKeep` of them, for analyses that need recent history;
+    this bounds the memory used by long simulations. The file can be read
+    with Storage or TimeSeriesTable. Call this before integrate(); it has no
+    effect if states are not written to storage (see setWriteToStorage()).
+    The controls of a controlled model are stored separately; use
+    setControlsFileForStreaming() to bound their memory as well. */
+    void setStatesFileForStreaming(const std::string& fileName,
+                                   int numStatesToKeep = 1000);
+    /** The file set with setStatesFileForStreaming(); empty if the states are
+    not streamed to a file. */
+    const std::string& getStatesFileForStreaming() const
+    {   return _statesFileName; }
+    /** Stream the controls of a controlled model to the binary (.bsto) file
+    `fileName` while integrating, as setStatesFileForStreaming() does for the
+    states. The control Storage of the model's ControllerSet (see
+    Model::printControlStorage()) then keeps only the most recent controls,
+    at least `numControlsToKeep` of them. */
+    void setControlsFileForStreaming(const std::string& fileName,
+                                     int numControlsToKeep = 1000);
+    /** The file set with setControlsFileForStreaming(); empty if the
+    controls are not streamed to a file. */
+    const std::string& getControlsFileForStreaming() const
+    {   return _controlsFileName; }
+
     /** @name Configure the Integrator
       * @note Call these functions before calling `Manager::initialize()`.
       * @{ */
@@ -341,6 +387,9 @@ public:
     /** Set the Storage object to be used for storing states. The Manager takes
     ownership of the passed-in Storage. */
     void setStateStorage(Storage& aStorage);
+    /** If the states are streamed to a file (see
+    setStatesFileForStreaming()), the Storage only holds the most recent
+    states. */
     Storage& getStateStorage() const;
     TimeSeriesTable getStatesTable() const;
 
@@ -363,6 +412,9 @@ private:
     // step = 0 is the beginning, step = -1 used to denote the end/final step
     void record(const SimTK::State& s, const int& step);
 
+    // Write the streamed states and controls to their files, if any.
+    void flushStatesFile();
+
 //=============================================================================
 };  // END of class Manager
 
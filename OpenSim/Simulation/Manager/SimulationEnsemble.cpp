@@ -0,0 +1,192 @@
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  SimulationEnsemble.cpp                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2019 Stanford University and the Authors                *
+ * Author(s): OpenSim Team                                                    *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "SimulationEnsemble.h"
+#include <OpenSim/Simulation/Model/Model.h>
+
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <thread>
+
+using namespace OpenSim;
+
+namespace {
+    // Building a model (clone() and initSystem()) touches the shared
+    // resources of the source model and is not guaranteed to be thread safe,
+    // so the workers build their models one at a time. Integration itself
+    // runs concurrently.
+    std::mutex modelConstructionMutex;
+
+    bool isFinite(const SimTK::Vector& y) {
+        for (int i = 0; i < y.size(); ++i) {
+            if (!SimTK::isFinite(y[i])) return false;
+        }
+        return true;
+    }
+
+    Model* buildModel(const Model& source,
+            const SimulationEnsemble::ModelOverride& modelOverride) {
+        std::lock_guard<std::mutex> lock(modelConstructionMutex);
+        std::unique_ptr<Model> model(source.clone());
+        if (modelOverride) modelOverride(*model);
+        model->initSystem();
+        return model.release();
+    }
+}
+
+SimulationEnsemble::SimulationEnsemble(const Model& model) : _model(&model)
+{
+    OPENSIM_THROW_IF(!model.hasSystem(), Exception,
+        "SimulationEnsemble: Model '" + model.getName() + "' does not have "
+        "a System. Call Model::initSystem() before creating the ensemble.");
+}
+
+int SimulationEnsemble::addRun(const SimTK::State& initialState)
+{
+    return addRun(initialState, ModelOverride(), StateOverride());
+}
+
+int SimulationEnsemble::addRun(const SimTK::State& initialState,
+        ModelOverride modelOverride, StateOverride stateOverride)
+{
+    Run run;
+    run.initialState = initialState;
+    run.modelOverride = std::move(modelOverride);
+    run.stateOverride = std::move(stateOverride);
+    _runs.push_back(std::move(run));
+    return getNumRuns() - 1;
+}
+
+std::vector<SimulationEnsemble::Result>
+SimulationEnsemble::integrate(double finalTime) const
+{
+    const int numRuns = getNumRuns();
+    std::vector<Result> results(numRuns);
+    if (numRuns == 0) return results;
+
+    int numThreads = _numThreads > 0 ? _numThreads :
+            (int)std::thread::hardware_concurrency();
+    numThreads = std::max(1, std::min(numThreads, numRuns));
+
+    // Runs are handed out one at a time so that long and short runs balance
+    // across the workers.
+    std::atomic<int> nextRun(0);
+    auto worker = [&]() {
+        // The worker's own copy of the model is only built once it is
+        // needed by a run without a model override.
+        std::unique_ptr<Model> workerModel;
+        int irun;
+        while ((irun = nextRun++) < numRuns) {
+            const Run& run = _runs[irun];
+            Result& result = results[irun];
+            try {
+                std::unique_ptr<Model> runModel;
+                Model* model = nullptr;
+                if (run.modelOverride) {
+                    runModel.reset(buildModel(*_model, run.modelOverride));
+                    model = runModel.get();
+                } else {
+                    if (!workerModel) {
+                        workerModel.reset(
+                                buildModel(*_model, ModelOverride()));
+                    }
+                    model = workerModel.get();
+                }
+                integrateRun(run, *model, finalTime, result);
+            } catch (const std::exception& e) {
+                result.success = false;
+                result.message = e.what();
+            } catch (...) {
+                result.success = false;
+                result.message = "Unknown exception.";
+            }
+        }
+    };
+
+    if (numThreads == 1) {
+        worker();
+    } else {
+        std::vector<std::thread> threads;
+        threads.reserve(numThreads);
+        for (int i = 0; i < numThreads; ++i) threads.emplace_back(worker);
+        for (auto& thread : threads) thread.join();
+    }
+
+    return results;
+}
+
+void SimulationEnsemble::integrateRun(const Run& run, Model& model,
+        double finalTime, Result& result) const
+{
+    SimTK::State state = model.getWorkingState();
+    const SimTK::State& initialState = run.initialState;
+    OPENSIM_THROW_IF(initialState.getNY() != state.getNY(), Exception,
+        "SimulationEnsemble: expected an initial state with " +
+        std::to_string(state.getNY()) + " continuous variables but got " +
+        std::to_string(initialState.getNY()) + ".");
+    state.setTime(initialState.getTime());
+    state.updY() = initialState.getY();
+    if (run.stateOverride) run.stateOverride(model, state);
+
+    Manager manager(model);
+    // Analyses belong to the original model and are not run by the workers.
+    manager.setPerformAnalyses(false);
+    manager.setIntegratorMethod(_integratorMethod);
+    if (_accuracy > 0) manager.setIntegratorAccuracy(_accuracy);
+    if (_maxStepSize > 0) manager.setIntegratorMaximumStepSize(_maxStepSize);
+    if (_fixedStepSize > 0 && finalTime > state.getTime()) {
+        const double duration = finalTime - state.getTime();
+        const int numSteps = std::max(1, (int)std::ceil(
+                duration / _fixedStepSize - SimTK::SignificantReal));
+        SimTK::Vector dt(numSteps, _fixedStepSize);
+        dt[numSteps - 1] = duration - (numSteps - 1) * _fixedStepSize;
+        manager.setUseSpecifiedDT(true);
+        manager.setDTArray(dt, state.getTime());
+    }
+    manager.initialize(state);
+    result.finalState = manager.integrate(finalTime);
+
+    const SimTK::Integrator& integ = manager.getIntegrator();
+    if (integ.isSimulationOver() &&
+            integ.getTerminationReason() !=
+                    SimTK::Integrator::ReachedFinalTime) {
+        result.success = false;
+        result.message = "Integration failed: " +
+            integ.getTerminationReasonString(integ.getTerminationReason());
+    } else if (!isFinite(result.finalState.getY())) {
+        result.success = false;
+        result.message = "Integration diverged: NaN state at time " +
+            std::to_string(result.finalState.getTime()) + ".";
+    } else {
+        result.success = true;
+    }
+
+    const Storage& statesStorage = manager.getStateStorage();
+    result.statesTable = statesStorage.exportToTable();
+    if (_recordTrajectory) {
+        result.statesTrajectory =
+                StatesTrajectory::createFromStatesStorage(model,
+                        statesStorage);
+    }
+}
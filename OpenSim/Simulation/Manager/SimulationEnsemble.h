@@ -0,0 +1,184 @@
+#ifndef OPENSIM_SIMULATION_ENSEMBLE_H_
+#define OPENSIM_SIMULATION_ENSEMBLE_H_
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  SimulationEnsemble.h                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2019 Stanford University and the Authors                *
+ * Author(s): OpenSim Team                                                    *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "Manager.h"
+#include <OpenSim/Simulation/StatesTrajectory.h>
+
+#include <functional>
+
+namespace OpenSim {
+
+class Model;
+
+//=============================================================================
+//=============================================================================
+/**
+ * Integrates many independent simulations of the same Model (an ensemble)
+ * across a pool of threads. This is intended for Monte Carlo and sensitivity
+ * studies in which each run differs only in its initial state, its property
+ * values (e.g., muscle parameters), or its controls.
+ *
+ * Each worker thread owns its own copy of the model (obtained with
+ * Model::clone()) and creates a new Manager, and hence a new integrator and
+ * TimeStepper, for each run it performs. The model passed to the constructor
+ * is never modified and is not used to integrate.
+ *
+ * A run is described by an initial SimTK::State of the original model and,
+ * optionally, a function that overrides model properties and/or a function
+ * that edits the worker's initial state. The continuous state variables
+ * (q, u, z) and time of the provided state are copied into the worker's
+ * state; discrete variables take their default values unless they are set
+ * by the state override.
+ *
+ * A run that throws an exception, or whose integrator stops before the final
+ * time or produces non-finite state values, is reported as failed in its
+ * Result; the remaining runs continue.
+ *
+ * @code
+ * Model model("arm26.osim");
+ * SimTK::State& s = model.initSystem();
+ * SimulationEnsemble ensemble(model);
+ * ensemble.setIntegratorAccuracy(1e-5);
+ * for (int i = 0; i < 100; ++i) {
+ *     SimTK::State s0 = s;
+ *     model.getCoordinateSet()[0].setValue(s0, 0.01 * i);
+ *     ensemble.addRun(s0);
+ * }
+ * const auto results = ensemble.integrate(1.0);
+ * for (const auto& result : results) {
+ *     if (!result.success) std::cout << result.message << std::endl;
+ * }
+ * @endcode
+ */
+class OSIMSIMULATION_API SimulationEnsemble {
+public:
+    /** Edits properties of a worker's copy of the model before the copy's
+     * system is built. The model passed in is private to a single run. */
+    typedef std::function<void(Model&)> ModelOverride;
+    /** Edits the initial state of a run, after the continuous state variables
+     * have been copied from the run's initial state. */
+    typedef std::function<void(const Model&, SimTK::State&)> StateOverride;
+
+    /** The outcome of a single run of the ensemble. */
+    struct Result {
+        /** True if the run reached the final time with finite states. */
+        bool success = false;
+        /** Reason for the failure of the run; empty if successful. */
+        std::string message;
+        /** The state at the end of the run (or where the run stopped). */
+        SimTK::State finalState;
+        /** The recorded states, with one row per integration step. */
+        TimeSeriesTable statesTable;
+        /** The recorded states as a StatesTrajectory. Only populated if
+         * setRecordStatesTrajectory(true) was called. The states are
+         * compatible with the model passed to the constructor. */
+        StatesTrajectory statesTrajectory;
+    };
+
+    /** The ensemble keeps a reference to `model`, which must outlive the
+     * ensemble. The model's system must already be initialized (i.e.,
+     * Model::initSystem() has been called). */
+    explicit SimulationEnsemble(const Model& model);
+
+    SimulationEnsemble(const SimulationEnsemble&) = delete;
+    SimulationEnsemble& operator=(const SimulationEnsemble&) = delete;
+
+    /** @name Configure the ensemble
+     * @{ */
+    /** The number of threads to use. If `numThreads` is less than 1 (the
+     * default), the number of hardware threads is used. No more threads than
+     * runs are ever created. */
+    void setNumThreads(int numThreads) { _numThreads = numThreads; }
+    int getNumThreads() const { return _numThreads; }
+
+    /** Integrator used for every run. See Manager::setIntegratorMethod(). */
+    void setIntegratorMethod(Manager::IntegratorMethod method)
+    {   _integratorMethod = method; }
+    /** Accuracy of the integrator for every run; ignored if not positive. */
+    void setIntegratorAccuracy(double accuracy) { _accuracy = accuracy; }
+    /** Maximum step size of the integrator; ignored if not positive. */
+    void setIntegratorMaximumStepSize(double hmax) { _maxStepSize = hmax; }
+    /** %Set the Manager to take fixed steps of size `dt` (i.e., states are
+     * recorded every `dt`). If `dt` is not positive (the default), states are
+     * recorded at every internal step of the integrator. */
+    void setFixedStepSize(double dt) { _fixedStepSize = dt; }
+
+    /** If true, each Result also contains a StatesTrajectory. This requires
+     * building a SimTK::State for every recorded step and is off by
+     * default. */
+    void setRecordStatesTrajectory(bool tf) { _recordTrajectory = tf; }
+    /** @} */
+
+    /** @name Define the runs
+     * @{ */
+    /** Add a run that starts from `initialState`, which must be a state of
+     * the model passed to the constructor. Returns the index of the run. */
+    int addRun(const SimTK::State& initialState);
+    /** Add a run whose model copy is edited by `modelOverride` (it may be
+     * empty) and whose initial state is edited by `stateOverride` (it may be
+     * empty). A run with a model override builds its own copy of the model,
+     * which is more expensive than using the worker's copy. Returns the
+     * index of the run. */
+    int addRun(const SimTK::State& initialState,
+            ModelOverride modelOverride,
+            StateOverride stateOverride = StateOverride());
+    int getNumRuns() const { return (int)_runs.size(); }
+    void clearRuns() { _runs.clear(); }
+    /** @} */
+
+    /** Integrate all runs to `finalTime` and return their results in the
+     * order in which the runs were added. Failures of individual runs are
+     * reported in their Result and do not cause this function to throw. */
+    std::vector<Result> integrate(double finalTime) const;
+
+private:
+    struct Run {
+        SimTK::State initialState;
+        ModelOverride modelOverride;
+        StateOverride stateOverride;
+    };
+
+    void integrateRun(const Run& run, Model& model, double finalTime,
+            Result& result) const;
+
+    SimTK::ReferencePtr<const Model> _model;
+    std::vector<Run> _runs;
+
+    int _numThreads = -1;
+    Manager::IntegratorMethod _integratorMethod =
+            Manager::IntegratorMethod::RungeKuttaMerson;
+    double _accuracy = -1;
+    double _maxStepSize = -1;
+    double _fixedStepSize = -1;
+    bool _recordTrajectory = false;
+
+//=============================================================================
+};  // END of class SimulationEnsemble
+
+} // namespace OpenSim
+//=============================================================================
+//=============================================================================
+
+#endif // OPENSIM_SIMULATION_ENSEMBLE_H_
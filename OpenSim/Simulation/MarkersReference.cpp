@@ -22,6 +22,7 @@
  * -------------------------------------------------------------------------- */
 
 #include "MarkersReference.h"
+#include <OpenSim/Common/TableReader.h>
 #include <SimTKcommon/internal/State.h>
 #include <cmath>
 
@@ -30,6 +31,30 @@ using namespace SimTK;
 
 namespace OpenSim {
 
+namespace {
+    // Read the markers in an STO file, which holds either Vec3 columns or x,
+    // y and z columns of doubles. A MarkersReference gives access to every
+    // frame, so the whole table is kept; the doubles are packed into Vec3s a
+    // chunk at a time only so that they are not also all in memory at once.
+    TimeSeriesTable_<SimTK::Vec3> readMarkersSTOFile(const string& fileName) {
+        try {
+            TableReader reader{fileName};
+            TimeSeriesTable chunk{};
+            if(!reader.readChunk(chunk))
+                return reader.getHeader().pack<SimTK::Vec3>();
+            TimeSeriesTable_<SimTK::Vec3> table = chunk.pack<SimTK::Vec3>();
+            while(reader.readChunk(chunk)) {
+                const auto packed = chunk.pack<SimTK::Vec3>();
+                table.appendRows(packed.getIndependentColumn(),
+                                 packed.getMatrix());
+            }
+            return table;
+        } catch(const IncorrectTableType&) {
+            return TableReader_<SimTK::Vec3>{fileName}.readRemainingRows();
+        }
+    }
+}
+
 MarkersReference::MarkersReference() :
     Reference_<SimTK::Vec3>() {
     constructProperties();
@@ -67,11 +92,7 @@ void MarkersReference::initializeFromMarkersFile(const std::string& markerFile,
     if(fileExt == "trc") {
         _markerTable = TimeSeriesTableVec3{markerFile};
     } else {
-        try {
-            _markerTable = (TimeSeriesTable{markerFile}).pack<SimTK::Vec3>();
-        } catch(const IncorrectTableType&) {
-            _markerTable = TimeSeriesTable_<SimTK::Vec3>{markerFile};
-        }
+        _markerTable = readMarkersSTOFile(markerFile);
     }
 
     upd_marker_file() = markerFile;
@@ -89,6 +89,14 @@ void ActivationFiberLengthMuscle::constructProperties()
     addStateVariable(STATE_FIBER_LENGTH_NAME);//, SimTK::Stage::Velocity);
  }
 
+void ActivationFiberLengthMuscle::extendRealizeTopology(SimTK::State& s) const
+{
+    Super::extendRealizeTopology(s);
+
+    _activationSV = getStateVariableHandle(STATE_ACTIVATION_NAME);
+    _fiberLengthSV = getStateVariableHandle(STATE_FIBER_LENGTH_NAME);
+}
+
  void ActivationFiberLengthMuscle::extendInitStateFromProperties( SimTK::State& s) const
 {
     Super::extendInitStateFromProperties(s);   // invoke superclass implementation
@@ -151,19 +159,19 @@ void ActivationFiberLengthMuscle::
 
 void ActivationFiberLengthMuscle::setActivation(SimTK::State& s, double activation) const
 {
-    setStateVariableValue(s, STATE_ACTIVATION_NAME, activation);
+    _activationSV.setValue(s, activation);
 }
 
 void ActivationFiberLengthMuscle::setFiberLength(SimTK::State& s, double fiberLength) const
 {
-    setStateVariableValue(s, STATE_FIBER_LENGTH_NAME, fiberLength);
+    _fiberLengthSV.setValue(s, fiberLength);
     // NOTE: This is a temporary measure since we were forced to allocate
     // fiber length as a Dynamics stage dependent state variable.
     // In order to force the recalculation of the length cache we have to 
     // invalidate the length info whenever fiber length is set.
-    markCacheVariableInvalid(s,"lengthInfo");
-    markCacheVariableInvalid(s,"velInfo");
-    markCacheVariableInvalid(s,"dynamicsInfo");
+    _lengthInfoCV.markValueInvalid(s);
+    _velInfoCV.markValueInvalid(s);
+    _dynamicsInfoCV.markValueInvalid(s);
 }
 
 double ActivationFiberLengthMuscle::getActivationRate(const SimTK::State& s) const
@@ -124,6 +124,7 @@ protected:
     /** Model Component Interface */
     void extendConnectToModel(Model& aModel) override;
     void extendAddToSystem(SimTK::MultibodySystem& system) const override;
+    void extendRealizeTopology(SimTK::State& s) const override;
     void extendInitStateFromProperties(SimTK::State& s) const override;
     void extendSetPropertiesFromState(const SimTK::State& state) override;
     void computeStateVariableDerivatives(const SimTK::State& s) const override;
@@ -131,6 +132,13 @@ protected:
     static const std::string STATE_ACTIVATION_NAME;
     static const std::string STATE_FIBER_LENGTH_NAME;   
 
+#ifndef SWIG
+    /** Handles to the activation and fiber length state variables, resolved
+        in extendRealizeTopology(). */
+    mutable SimTK::ResetOnCopy<StateVariableHandle> _activationSV;
+    mutable SimTK::ResetOnCopy<StateVariableHandle> _fiberLengthSV;
+#endif
+
 private:
     void constructProperties();
 
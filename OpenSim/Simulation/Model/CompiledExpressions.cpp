@@ -0,0 +1,255 @@
+/* -------------------------------------------------------------------------- *
+ *                    OpenSim:  CompiledExpressions.cpp                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2019 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "CompiledExpressions.h"
+#include <OpenSim/Common/Exception.h>
+#include <Lepton.h>
+#include <lepton/Exception.h>
+
+#include <algorithm>
+
+using namespace OpenSim;
+
+namespace {
+    int findVariable(const std::vector<std::string>& variables,
+            const std::string& name, const std::string& expression)
+    {
+        const auto it = std::find(variables.begin(), variables.end(), name);
+        if (it == variables.end()) {
+            std::string names;
+            for (const auto& variable : variables) {
+                names += (names.empty() ? "" : ", ") + variable;
+            }
+            OPENSIM_THROW(Exception, "Expression '" + expression + "' uses "
+                "unknown variable '" + name + "'. The variables are: " +
+                names + ".");
+        }
+        return (int)(it - variables.begin());
+    }
+}
+
+CompiledExpressions::CompiledExpressions() = default;
+
+CompiledExpressions::CompiledExpressions(
+        const std::vector<std::string>& expressions,
+        const std::vector<std::string>& variables) :
+    _expressions(expressions), _variables(variables)
+{
+    _parsed.resize(_expressions.size());
+    _jitExpressions.resize(_expressions.size());
+    _jitVariables.resize(_expressions.size());
+    for (int i = 0; i < getNumExpressions(); ++i) parse(i);
+    link();
+}
+
+CompiledExpressions::CompiledExpressions(const CompiledExpressions& other) :
+    CompiledExpressions()
+{
+    *this = other;
+}
+
+CompiledExpressions&
+CompiledExpressions::operator=(const CompiledExpressions& other)
+{
+    if (this != &other) {
+        _expressions = other._expressions;
+        _variables = other._variables;
+        _parsed.clear();
+        _parsed.resize(_expressions.size());
+        _jitExpressions.clear();
+        _jitExpressions.resize(_expressions.size());
+        _jitVariables.clear();
+        _jitVariables.resize(_expressions.size());
+#ifdef LEPTON_USE_JIT
+        // The machine code refers to memory owned by the compiled expression,
+        // so it is compiled again rather than copied.
+        for (int i = 0; i < getNumExpressions(); ++i) parse(i);
+#else
+        for (int i = 0; i < getNumExpressions(); ++i) {
+            _parsed[i].reset(new Lepton::ParsedExpression(*other._parsed[i]));
+        }
+#endif
+        link();
+    }
+    return *this;
+}
+
+CompiledExpressions::~CompiledExpressions() = default;
+
+void CompiledExpressions::setExpression(int index,
+        const std::string& expression)
+{
+    OPENSIM_THROW_IF(index < 0 || index >= getNumExpressions(),
+            IndexOutOfRange, (size_t)index, 0,
+            (size_t)getNumExpressions() - 1);
+    const std::string previous = _expressions[index];
+    _expressions[index] = expression;
+    try {
+        parse(index);
+    } catch (...) {
+        _expressions[index] = previous;
+        throw;
+    }
+    link();
+}
+
+void CompiledExpressions::parse(int index)
+{
+    const std::string& expression = _expressions[index];
+    std::unique_ptr<Lepton::ParsedExpression> parsed;
+    try {
+        parsed.reset(new Lepton::ParsedExpression(
+                Lepton::Parser::parse(expression).optimize()));
+    } catch (const Lepton::Exception& x) {
+        OPENSIM_THROW(Exception, "Could not parse expression '" +
+                expression + "': " + x.what());
+    }
+
+#ifdef LEPTON_USE_JIT
+    std::unique_ptr<Lepton::CompiledExpression> compiled(
+            new Lepton::CompiledExpression(
+                    parsed->createCompiledExpression()));
+    std::vector<std::pair<int, double*>> variables;
+    for (const auto& name : compiled->getVariables()) {
+        variables.emplace_back(findVariable(_variables, name, expression),
+                &compiled->getVariableReference(name));
+    }
+    _jitExpressions[index] = std::move(compiled);
+    _jitVariables[index] = std::move(variables);
+#else
+    // Check the variables now, so that an unknown variable leaves the
+    // program unchanged.
+    std::vector<const Lepton::ExpressionTreeNode*> nodes{
+            &parsed->getRootNode()};
+    while (!nodes.empty()) {
+        const Lepton::ExpressionTreeNode* node = nodes.back();
+        nodes.pop_back();
+        if (node->getOperation().getId() == Lepton::Operation::VARIABLE) {
+            findVariable(_variables, node->getOperation().getName(),
+                    expression);
+        }
+        for (const auto& child : node->getChildren()) nodes.push_back(&child);
+    }
+#endif
+    _parsed[index] = std::move(parsed);
+}
+
+void CompiledExpressions::link()
+{
+    _steps.clear();
+    _resultIndices.clear();
+    _workspaceSize = (int)_variables.size();
+    _maxNumArguments = 1;
+
+#ifndef LEPTON_USE_JIT
+    // Nodes are shared across all the expressions, so a subexpression that
+    // appears more than once is evaluated once.
+    std::vector<std::pair<const Lepton::ExpressionTreeNode*, int>> compiled;
+    for (int i = 0; i < getNumExpressions(); ++i) {
+        _resultIndices.push_back(compileNode(_parsed[i]->getRootNode(),
+                compiled, _expressions[i]));
+    }
+#endif
+}
+
+int CompiledExpressions::compileNode(const Lepton::ExpressionTreeNode& node,
+        std::vector<std::pair<const Lepton::ExpressionTreeNode*, int>>&
+                compiled,
+        const std::string& expression)
+{
+    for (const auto& entry : compiled) {
+        if (*entry.first == node) return entry.second;
+    }
+
+    std::vector<int> arguments;
+    for (const auto& child : node.getChildren()) {
+        arguments.push_back(compileNode(child, compiled, expression));
+    }
+
+    const Lepton::Operation& operation = node.getOperation();
+    int index;
+    if (operation.getId() == Lepton::Operation::VARIABLE) {
+        index = findVariable(_variables, operation.getName(), expression);
+    } else {
+        index = _workspaceSize++;
+
+        Step step;
+        step.operation.reset(operation.clone());
+        step.adjacentArguments = true;
+        for (size_t i = 1; i < arguments.size(); ++i) {
+            if (arguments[i] != arguments[i - 1] + 1) {
+                step.adjacentArguments = false;
+            }
+        }
+        step.arguments = std::move(arguments);
+        step.target = index;
+        _maxNumArguments = std::max(_maxNumArguments,
+                                    (int)step.arguments.size());
+        _steps.push_back(std::move(step));
+    }
+    compiled.emplace_back(&node, index);
+    return index;
+}
+
+void CompiledExpressions::evaluate(const double* variableValues,
+        double* results) const
+{
+#ifdef LEPTON_USE_JIT
+    std::lock_guard<std::mutex> lock(_jitMutex);
+    for (size_t i = 0; i < _jitExpressions.size(); ++i) {
+        for (const auto& variable : _jitVariables[i]) {
+            *variable.second = variableValues[variable.first];
+        }
+        results[i] = _jitExpressions[i]->evaluate();
+    }
+#else
+    // The memory is shared by all the programs evaluated on this thread and
+    // only grows, so it is allocated once per thread in practice.
+    thread_local std::vector<double> workspace;
+    thread_local std::vector<double> argumentValues;
+    if ((int)workspace.size() < _workspaceSize)
+        workspace.resize(_workspaceSize);
+    if ((int)argumentValues.size() < _maxNumArguments)
+        argumentValues.resize(_maxNumArguments);
+
+    std::copy(variableValues, variableValues + _variables.size(),
+            workspace.begin());
+    for (const Step& step : _steps) {
+        double* arguments;
+        if (step.arguments.empty()) {
+            arguments = argumentValues.data();
+        } else if (step.adjacentArguments) {
+            arguments = &workspace[step.arguments[0]];
+        } else {
+            for (size_t i = 0; i < step.arguments.size(); ++i) {
+                argumentValues[i] = workspace[step.arguments[i]];
+            }
+            arguments = argumentValues.data();
+        }
+        workspace[step.target] =
+                step.operation->evaluate(arguments, _noVariables);
+    }
+    for (size_t i = 0; i < _resultIndices.size(); ++i) {
+        results[i] = workspace[_resultIndices[i]];
+    }
+#endif
+}
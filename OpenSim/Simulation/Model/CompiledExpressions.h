@@ -0,0 +1,142 @@
+#ifndef OPENSIM_COMPILED_EXPRESSIONS_H_
+#define OPENSIM_COMPILED_EXPRESSIONS_H_
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  CompiledExpressions.h                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2019 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Simulation/osimSimulationDLL.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Lepton {
+class CompiledExpression;
+class ExpressionTreeNode;
+class Operation;
+class ParsedExpression;
+}
+
+namespace OpenSim {
+
+/**
+ * Evaluates one or more Lepton expressions of the same variables (e.g., the
+ * six expressions of an ExpressionBasedBushingForce) as a single compiled
+ * program. The variables are bound to fixed slots when the expressions are
+ * compiled, so evaluating the expressions does not look up variables by name
+ * or allocate memory, and a subexpression that appears in several
+ * expressions is evaluated only once.
+ *
+ * If OpenSim is built with OPENSIM_WITH_LEPTON_JIT, each expression is
+ * instead compiled to machine code by Lepton (without sharing
+ * subexpressions between expressions).
+ *
+ * evaluate() may be called from several threads at the same time. The
+ * interpreted program keeps its intermediate values in memory owned by the
+ * calling thread. Machine code compiled by Lepton keeps its variables in the
+ * object, so evaluations of the same object are serialized in that case.
+ */
+class OSIMSIMULATION_API CompiledExpressions {
+public:
+    CompiledExpressions();
+    /** Compile `expressions`, whose variables must be among `variables`.
+     * The values of the variables are passed to evaluate() in the order of
+     * `variables`.
+     * @throws Exception If an expression cannot be parsed or uses a variable
+     * that is not in `variables`. */
+    CompiledExpressions(const std::vector<std::string>& expressions,
+                        const std::vector<std::string>& variables);
+    CompiledExpressions(const CompiledExpressions& other);
+    CompiledExpressions& operator=(const CompiledExpressions& other);
+    ~CompiledExpressions();
+
+    int getNumExpressions() const { return (int)_expressions.size(); }
+    int getNumVariables() const { return (int)_variables.size(); }
+
+    /** Replace the expression with the given index (in the order passed to
+     * the constructor). Only the new expression is parsed.
+     * @throws Exception If the expression cannot be parsed or uses a variable
+     * that is not among the variables; the object is then unchanged. */
+    void setExpression(int index, const std::string& expression);
+
+    /** Evaluate all expressions. `variableValues` holds getNumVariables()
+     * values, and `results` receives getNumExpressions() values, in the order
+     * of the expressions. */
+    void evaluate(const double* variableValues, double* results) const;
+
+    /** Evaluate the only expression. */
+    double evaluate(const double* variableValues) const {
+        double result;
+        evaluate(variableValues, &result);
+        return result;
+    }
+
+private:
+    // One operation of the program.
+    struct Step {
+        std::unique_ptr<Lepton::Operation> operation;
+        // Indices of the arguments in the workspace.
+        std::vector<int> arguments;
+        // True if the arguments are adjacent in the workspace, in which case
+        // they are passed to the operation in place.
+        bool adjacentArguments;
+        int target;
+    };
+
+    // Parse expression `index`, check its variables and, with the JIT, compile
+    // it to machine code. The results are stored only if this succeeds.
+    void parse(int index);
+    // Build the interpreted program from the parsed expressions.
+    void link();
+    // Add the steps that evaluate `node` (unless an identical node was
+    // already compiled) and return the index of its value in the workspace.
+    int compileNode(const Lepton::ExpressionTreeNode& node,
+            std::vector<std::pair<const Lepton::ExpressionTreeNode*, int>>&
+                    compiled,
+            const std::string& expression);
+
+    std::vector<std::string> _expressions;
+    std::vector<std::string> _variables;
+
+    std::vector<std::unique_ptr<Lepton::ParsedExpression>> _parsed;
+
+    // Interpreted program. The workspace, which evaluate() allocates per
+    // thread, holds the values of the variables first and then the results
+    // of the steps.
+    std::vector<Step> _steps;
+    std::vector<int> _resultIndices;
+    int _workspaceSize = 0;
+    int _maxNumArguments = 1;
+    std::map<std::string, double> _noVariables;
+
+    // Expressions compiled to machine code, and the locations of their
+    // variables (paired with the indices of the variables).
+    std::vector<std::unique_ptr<Lepton::CompiledExpression>> _jitExpressions;
+    std::vector<std::vector<std::pair<int, double*>>> _jitVariables;
+    // Serializes evaluations of the machine code, which writes its variables.
+    mutable std::mutex _jitMutex;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_COMPILED_EXPRESSIONS_H_
@@ -58,6 +58,8 @@ public:
     void constructStorage();
     void storeControls( const SimTK::State& s, int step );
     void printControlStorage( const std::string& fileName) const;
+    /** The Storage to which storeControls() appends the controls. */
+    Storage& updControlStorage() { return *_controlStore; }
     TimeSeriesTable getControlTable() const;
     void setActuators(Set<Actuator>& actuators);
 
@@ -24,10 +24,11 @@
 //=============================================================================
 // INCLUDES
 //=============================================================================
-#include <Lepton.h>
-
 #include "ExpressionBasedBushingForce.h"
 
+#include <algorithm>
+#include <cctype>
+
 using namespace std;
 using namespace SimTK;
 using namespace OpenSim;
@@ -176,12 +177,7 @@ void ExpressionBasedBushingForce::constructProperties()
     constructProperty_Fx_expression( zero );
     constructProperty_Fy_expression( zero );
     constructProperty_Fz_expression( zero );
-    setMxExpression( "0.0" );
-    setMyExpression( "0.0" );
-    setMzExpression( "0.0" );
-    setFxExpression( "0.0" );
-    setFyExpression( "0.0" );
-    setFzExpression( "0.0" );
+    compileStiffnessExpressions();
     
     constructProperty_rotational_damping(Vec3(0));
     constructProperty_translational_damping(Vec3(0));
@@ -201,12 +197,12 @@ void ExpressionBasedBushingForce::extendFinalizeFromProperties()
     Super::extendFinalizeFromProperties(); // base class first
 
     // must initialize the 6 force functions using the user provided expressions
-    setMxExpression(get_Mx_expression());
-    setMyExpression(get_My_expression());
-    setMzExpression(get_Mz_expression());
-    setFxExpression(get_Fx_expression());
-    setFyExpression(get_Fy_expression());
-    setFzExpression(get_Fz_expression());
+    for (std::string* expression : {&upd_Mx_expression(), &upd_My_expression(),
+                                    &upd_Mz_expression(), &upd_Fx_expression(),
+                                    &upd_Fy_expression(), &upd_Fz_expression()})
+        expression->erase(remove_if(expression->begin(), expression->end(),
+                                    ::isspace), expression->end());
+    compileStiffnessExpressions();
 
     // fill damping matrix with damping from vector property
     for (int i = 0; i<3; i++) {
@@ -215,60 +211,71 @@ void ExpressionBasedBushingForce::extendFinalizeFromProperties()
     }
 }
 
-/** Set the expression for the Mx function and create it's lepton program */
+/** Set the expression for the Mx function and recompile it */
 void ExpressionBasedBushingForce::setMxExpression(std::string expression) 
 {
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
+    _stiffnessExpressions.setExpression(0, expression);
     set_Mx_expression(expression);
-    MxProg = Lepton::Parser::parse(expression).optimize().createProgram();
 }
 
-/** Set the expression for the My function and create it's lepton program */
+/** Set the expression for the My function and recompile it */
 void ExpressionBasedBushingForce::setMyExpression(std::string expression) 
 {
     
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
+    _stiffnessExpressions.setExpression(1, expression);
     set_My_expression(expression);
-    MyProg = Lepton::Parser::parse(expression).optimize().createProgram();
 }
 
-/** Set the expression for the Mz function and create it's lepton program */
+/** Set the expression for the Mz function and recompile it */
 void ExpressionBasedBushingForce::setMzExpression(std::string expression) 
 {
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
+    _stiffnessExpressions.setExpression(2, expression);
     set_Mz_expression(expression);
-    MzProg = Lepton::Parser::parse(expression).optimize().createProgram();
 }
 
-/** Set the expression for the Fx function and create it's lepton program */
+/** Set the expression for the Fx function and recompile it */
 void ExpressionBasedBushingForce::setFxExpression(std::string expression) 
 {
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
+    _stiffnessExpressions.setExpression(3, expression);
     set_Fx_expression(expression);
-    FxProg = Lepton::Parser::parse(expression).optimize().createProgram();
 }
 
-/** Set the expression for the Fy function and create it's lepton program */
+/** Set the expression for the Fy function and recompile it */
 void ExpressionBasedBushingForce::setFyExpression(std::string expression) 
 {
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
+    _stiffnessExpressions.setExpression(4, expression);
     set_Fy_expression(expression);
-    FyProg = Lepton::Parser::parse(expression).optimize().createProgram();
 }
 
-/** Set the expression for the Fz function and create it's lepton program */
+/** Set the expression for the Fz function and recompile it */
 void ExpressionBasedBushingForce::setFzExpression(std::string expression) 
 {
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
+    _stiffnessExpressions.setExpression(5, expression);
     set_Fz_expression(expression);
-    FzProg = Lepton::Parser::parse(expression).optimize().createProgram();
 }
+/* Compile the 6 expressions together, so that subexpressions they share are
+evaluated once. */
+void ExpressionBasedBushingForce::compileStiffnessExpressions()
+{
+    _stiffnessExpressions = CompiledExpressions(
+            {get_Mx_expression(), get_My_expression(), get_Mz_expression(),
+             get_Fx_expression(), get_Fy_expression(), get_Fz_expression()},
+            {"theta_x", "theta_y", "theta_z",
+             "delta_x", "delta_y", "delta_z"});
+}
+
 //=============================================================================
 // COMPUTATION
 //=============================================================================
@@ -282,21 +289,9 @@ SimTK::Vec6 ExpressionBasedBushingForce::
 
     Vec6 fk = Vec6(0.0);
 
-    std::map<std::string, double> deflectionVars;
-    deflectionVars["theta_x"] = dq[0];
-    deflectionVars["theta_y"] = dq[1];
-    deflectionVars["theta_z"] = dq[2];
-    deflectionVars["delta_x"] = dq[3];
-    deflectionVars["delta_y"] = dq[4];
-    deflectionVars["delta_z"] = dq[5];
-
-
-    fk[0] = MxProg.evaluate(deflectionVars);
-    fk[1] = MyProg.evaluate(deflectionVars);
-    fk[2] = MzProg.evaluate(deflectionVars);
-    fk[3] = FxProg.evaluate(deflectionVars);
-    fk[4] = FyProg.evaluate(deflectionVars);
-    fk[5] = FzProg.evaluate(deflectionVars);
+    // The variables are theta_x, theta_y, theta_z, delta_x, delta_y, delta_z,
+    // in the order of dq, and the results are Mx, My, Mz, Fx, Fy, Fz.
+    _stiffnessExpressions.evaluate(&dq[0], &fk[0]);
 
     return -fk;
 }
@@ -26,6 +26,7 @@
 
 // INCLUDE
 #include "Force.h"
+#include "CompiledExpressions.h"
 #include <OpenSim/Simulation/Model/TwoFrameLinker.h>
 
 namespace OpenSim {
@@ -272,8 +273,10 @@ private:
 
     SimTK::Mat66 _dampingMatrix{ 0.0 };
 
-    // parser programs for efficiently evaluating the expressions
-    Lepton::ExpressionProgram MxProg, MyProg, MzProg, FxProg, FyProg, FzProg;
+    void compileStiffnessExpressions();
+
+    // the 6 expressions (Mx, My, Mz, Fx, Fy, Fz) compiled together
+    CompiledExpressions _stiffnessExpressions;
 
 //==============================================================================
 };  // END of class ExpressionBasedBushingForce
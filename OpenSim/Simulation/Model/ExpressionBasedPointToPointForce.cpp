@@ -26,8 +26,9 @@
 //=============================================================================
 #include "ExpressionBasedPointToPointForce.h"
 #include <OpenSim/Simulation/Model/Model.h>
-#include <lepton/Parser.h>
-#include <lepton/ParsedExpression.h>
+
+#include <algorithm>
+#include <cctype>
 
 using namespace OpenSim;
 using namespace std;
@@ -137,7 +138,7 @@ void ExpressionBasedPointToPointForce::extendConnectToModel(Model& model)
             remove_if(expression.begin(), expression.end(), ::isspace), 
                       expression.end() );
     
-    _forceProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    _forceExpression = CompiledExpressions({expression}, {"d", "ddot"});
 }
 
 //=============================================================================
@@ -187,11 +188,9 @@ void ExpressionBasedPointToPointForce::computeForce(const SimTK::State& s,
     //speed along the line connecting the two bodies
     const double ddot = dot(vRel, r_G)/d;
 
-    std::map<std::string, double> forceVars;
-    forceVars["d"] = d;
-    forceVars["ddot"] = ddot;
+    const double forceVars[2] = {d, ddot};
 
-    double forceMag = _forceProg.evaluate(forceVars);
+    double forceMag = _forceExpression.evaluate(forceVars);
     setCacheVariableValue<double>(s, "force_magnitude", forceMag);
 
     const Vec3 f1_G = (forceMag/d) * r_G;
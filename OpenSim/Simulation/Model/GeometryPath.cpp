@@ -31,6 +31,8 @@
 #include <OpenSim/Simulation/Wrap/PathWrap.h>
 #include "Model.h"
 
+#include <chrono>
+
 //=============================================================================
 // STATICS
 //=============================================================================
@@ -104,6 +106,10 @@ void GeometryPath::extendConnectToModel(Model& aModel)
     Array<AbstractPathPoint *> pathPrototype;
     addCacheVariable<Array<AbstractPathPoint *> >
         ("current_path", pathPrototype, SimTK::Stage::Position);
+    // Scratch memory for wrapping the path. It is never marked valid; it only
+    // keeps its arrays from one path computation to the next.
+    addCacheVariable<WrapWorkspace>("wrap_workspace", WrapWorkspace(),
+                                    SimTK::Stage::Position);
 
     // We consider this cache entry valid any time after it has been created
     // and first marked valid, and we won't ever invalidate it.
@@ -835,7 +841,18 @@ void GeometryPath::computePath(const SimTK::State& s) const
   
     // Use the current path so far to check for intersection with wrap objects, 
     // which may add additional points to the path.
-    applyWrapObjects(s, currentPath);
+    if (!_counters) {
+        applyWrapObjects(s, currentPath);
+    } else {
+        ++_counters->numPathComputations;
+        if (get_PathWrapSet().getSize() > 0) {
+            const auto start = std::chrono::steady_clock::now();
+            applyWrapObjects(s, currentPath);
+            _counters->wrappingNanoseconds +=
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start).count();
+        }
+    }
     calcLengthAfterPathComputation(s, currentPath);
 
     markCacheVariableValid(s, "current_path");
@@ -871,11 +888,19 @@ applyWrapObjects(const SimTK::State& s, Array<AbstractPathPoint*>& path) const
     if (get_PathWrapSet().getSize() < 1)
         return;
 
-    WrapResult best_wrap;
-    Array<int> result, order;
+    // The wrap results are kept in the state's workspace, so that the arrays
+    // of wrap points keep their memory from one path computation to the next.
+    WrapWorkspace& workspace =
+        updCacheVariableValue<WrapWorkspace>(s, "wrap_workspace");
+    WrapResult& best_wrap = workspace.bestWrap;
+    WrapResult& wr = workspace.wrap;
+    Array<int>& result = workspace.result;
+    Array<int>& order = workspace.order;
+    std::vector<WrapWarmStart>& warmStarts = workspace.warmStarts;
 
     result.setSize(get_PathWrapSet().getSize());
     order.setSize(get_PathWrapSet().getSize());
+    warmStarts.resize(get_PathWrapSet().getSize());
 
     // Set the initial order to be the order they are listed in the path.
     for (int i = 0; i < get_PathWrapSet().getSize(); i++)
@@ -893,6 +918,7 @@ applyWrapObjects(const SimTK::State& s, Array<AbstractPathPoint*>& path) const
         {
             result[i] = 0;
             PathWrap& ws = get_PathWrapSet().get(order[i]);
+            WrapWarmStart& warmStart = warmStarts[order[i]];
             const WrapObject* wo = ws.getWrapObject();
             best_wrap.wrap_pts.setSize(0);
             double min_length_change = SimTK::Infinity;
@@ -975,12 +1001,27 @@ applyWrapObjects(const SimTK::State& s, Array<AbstractPathPoint*>& path) const
                         || (   path.get(pt1)->getWrapObject() 
                             != path.get(pt2)->getWrapObject()))
                     {
-                        WrapResult wr;
                         wr.startPoint = pt1;
                         wr.endPoint   = pt2;
+                        // Clear the values left by the previous segment,
+                        // and pass the solution of the last wrap over ws if
+                        // it wrapped this segment.
+                        wr.wrap_pts.setSize(0);
+                        wr.c1 = wr.sv = SimTK::Vec3(0);
+                        if (warmStart.startPoint == pt1 &&
+                            warmStart.endPoint == pt2) {
+                            wr.previous_r1 = warmStart.r1;
+                            wr.previous_r2 = warmStart.r2;
+                            wr.closest_u = warmStart.closest_u;
+                        } else {
+                            wr.previous_r1 = wr.previous_r2 =
+                                SimTK::Vec3(SimTK::NaN);
+                            wr.closest_u = SimTK::Vec2(SimTK::NaN);
+                        }
 
                         result[i] = wo->wrapPathSegment(s, *path.get(pt1), 
                                                         *path.get(pt2), ws, wr);
+                        if (_counters) ++_counters->numWrapCalculations;
                         if (result[i] == WrapObject::mandatoryWrap) {
                             // "mandatoryWrap" means the path actually 
                             // intersected the wrap object. In this case, you 
@@ -1026,12 +1067,21 @@ applyWrapObjects(const SimTK::State& s, Array<AbstractPathPoint*>& path) const
                 if (best_wrap.wrap_pts.getSize() == 0) {
                     ws.resetPreviousWrap();
                     ws.updWrapPoint2().getWrapPath().setSize(0);
+                    warmStart = WrapWarmStart();
                 } else {
+                    warmStart.startPoint = best_wrap.startPoint;
+                    warmStart.endPoint = best_wrap.endPoint;
+                    warmStart.r1 = best_wrap.r1;
+                    warmStart.r2 = best_wrap.r2;
+                    warmStart.closest_u = best_wrap.closest_u;
+
                     // If wrapping did occur, copy wrap info into the PathStruct.
                     ws.updWrapPoint1().getWrapPath().setSize(0);
 
                     Array<SimTK::Vec3>& wrapPath = ws.updWrapPoint2().getWrapPath();
-                    wrapPath = best_wrap.wrap_pts;
+                    wrapPath.setSize(best_wrap.wrap_pts.getSize());
+                    for (int j = 0; j < wrapPath.getSize(); j++)
+                        wrapPath[j] = best_wrap.wrap_pts[j];
 
                     // In OpenSim, all conversion to/from the wrap object's 
                     // reference frame will be performed inside 
@@ -1158,6 +1208,42 @@ computeMomentArm(const SimTK::State& s, const Coordinate& aCoord) const
     return _maSolver->solve(s, aCoord,  *this);
 }
 
+//_____________________________________________________________________________
+/*
+ * Computation counters.
+ */
+void GeometryPath::setComputationCountersEnabled(bool enabled)
+{
+    if (enabled)
+        _counters.reset(new ComputationCounters());
+    else
+        _counters.reset();
+}
+
+int GeometryPath::getNumPathComputations() const
+{
+    return _counters ? _counters->numPathComputations.load() : 0;
+}
+
+int GeometryPath::getNumWrapCalculations() const
+{
+    return _counters ? _counters->numWrapCalculations.load() : 0;
+}
+
+double GeometryPath::getWrappingTime() const
+{
+    return _counters ? 1e-9*_counters->wrappingNanoseconds.load() : 0;
+}
+
+void GeometryPath::resetComputationCounters()
+{
+    if (_counters) {
+        _counters->numPathComputations = 0;
+        _counters->numWrapCalculations = 0;
+        _counters->wrappingNanoseconds = 0;
+    }
+}
+
 //_____________________________________________________________________________
 // Override default implementation by object to intercept and fix the XML node
 // underneath the model to match current version.
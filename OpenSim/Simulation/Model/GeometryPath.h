@@ -29,8 +29,12 @@
 #include "OpenSim/Simulation/Model/ModelComponent.h"
 #include "PathPointSet.h"
 #include <OpenSim/Simulation/Wrap/PathWrapSet.h>
+#include <OpenSim/Simulation/Wrap/WrapResult.h>
 #include <OpenSim/Simulation/MomentArmSolver.h>
 
+#include <atomic>
+#include <vector>
+
 
 #ifdef SWIG
     #ifdef OSIMSIMULATION_API
@@ -44,7 +48,6 @@ namespace OpenSim {
 class Coordinate;
 class PointForceDirection;
 class ScaleSet;
-class WrapResult;
 class WrapObject;
 
 //=============================================================================
@@ -86,6 +89,45 @@ private:
     // but we cannot simply use a unique_ptr because we want the pointer to be
     // cleared on copy.
     SimTK::ResetOnCopy<std::unique_ptr<MomentArmSolver> > _maSolver;
+
+    // Solution of the last wrap over a PathWrap, from which the wrap objects
+    // start their searches when the same path segment is wrapped again.
+    struct WrapWarmStart {
+        int startPoint = -1;
+        int endPoint = -1;
+        SimTK::Vec3 r1{SimTK::NaN};
+        SimTK::Vec3 r2{SimTK::NaN};
+        SimTK::Vec2 closest_u{SimTK::NaN};
+    };
+
+    // Work space of applyWrapObjects(). It is kept in a cache variable, so
+    // that each state has its own, and the wrap results and their arrays of
+    // points are not allocated for every path computation. The warm starts
+    // (one per PathWrap) are also kept here rather than in the PathWraps,
+    // which are shared by all the states.
+    struct WrapWorkspace {
+        WrapResult bestWrap;
+        WrapResult wrap;
+        Array<int> result;
+        Array<int> order;
+        std::vector<WrapWarmStart> warmStarts;
+        friend std::ostream& operator<<(std::ostream& o,
+                                        const WrapWorkspace&) {
+            o << "GeometryPath::WrapWorkspace should not be serialized!"
+              << std::endl;
+            return o;
+        }
+    };
+
+    // Counters of the computations of this path, which exist only while they
+    // are enabled. They are atomic because the path may be computed with
+    // several states at once. Like _maSolver, they are cleared on copy.
+    struct ComputationCounters {
+        std::atomic<int> numPathComputations{0};
+        std::atomic<int> numWrapCalculations{0};
+        std::atomic<long long> wrappingNanoseconds{0};
+    };
+    SimTK::ResetOnCopy<std::unique_ptr<ComputationCounters> > _counters;
     
 //=============================================================================
 // METHODS
@@ -100,6 +142,7 @@ public:
     const PathPointSet& getPathPointSet() const { return get_PathPointSet(); }
     PathPointSet& updPathPointSet() { return upd_PathPointSet(); }
     const PathWrapSet& getWrapSet() const { return get_PathWrapSet(); }
+    PathWrapSet& updWrapSet() { return upd_PathWrapSet(); }
     void addPathWrap(WrapObject& aWrapObject);
 
     //--------------------------------------------------------------------------
@@ -181,6 +224,31 @@ public:
     //--------------------------------------------------------------------------
     virtual double computeMomentArm(const SimTK::State& s, const Coordinate& aCoord) const;
 
+    /** @name Computation counters
+    Optional counters of the computations of this path, with any state, since
+    the counters were enabled or reset. They help find the paths whose
+    wrapping dominates the cost of an analysis or simulation. The counters
+    are disabled by default and in copies of the path; while they are
+    disabled, the path is computed without counting and the getters return
+    zero. Do not enable or disable the counters while the path is being
+    computed on another thread. */
+    /// @{
+    /** Enable the counters, starting them from zero, or disable them. */
+    void setComputationCountersEnabled(bool enabled);
+    bool getComputationCountersEnabled() const { return bool(_counters); }
+    /** The number of times the points and length of the path were computed
+    (i.e., requested with a state in which they were not already cached). */
+    int getNumPathComputations() const;
+    /** The number of times a segment of the path was wrapped over a wrap
+    object (whether or not the segment touched the object). */
+    int getNumWrapCalculations() const;
+    /** The total time, in seconds, spent wrapping the path over its wrap
+    objects. */
+    double getWrappingTime() const;
+    /** Set the counters to zero, if they are enabled. */
+    void resetComputationCounters();
+    /// @}
+
     //--------------------------------------------------------------------------
     // SCALING
     //--------------------------------------------------------------------------
@@ -235,6 +235,18 @@ void Muscle::extendConnectToModel(Model& aModel)
        ("potentialEnergyInfo", MusclePotentialEnergyInfo(), SimTK::Stage::Velocity);
  }
 
+void Muscle::extendRealizeTopology(SimTK::State& state) const
+{
+    Super::extendRealizeTopology(state);
+
+    _lengthInfoCV = getCacheVariableHandle<MuscleLengthInfo>("lengthInfo");
+    _velInfoCV = getCacheVariableHandle<FiberVelocityInfo>("velInfo");
+    _dynamicsInfoCV =
+        getCacheVariableHandle<MuscleDynamicsInfo>("dynamicsInfo");
+    _potentialEnergyInfoCV = getCacheVariableHandle<MusclePotentialEnergyInfo>(
+            "potentialEnergyInfo");
+}
+
 void Muscle::extendSetPropertiesFromState(const SimTK::State& state)
 {
     Super::extendSetPropertiesFromState(state);
@@ -512,79 +524,79 @@ void Muscle::setExcitation(SimTK::State& s, double excitation) const
 /* Access to muscle calculation data structures */
 const Muscle::MuscleLengthInfo& Muscle::getMuscleLengthInfo(const SimTK::State& s) const
 {
-    if(!isCacheVariableValid(s,"lengthInfo")){
+    if(!_lengthInfoCV.isValueValid(s)){
         MuscleLengthInfo &umli = updMuscleLengthInfo(s);
         calcMuscleLengthInfo(s, umli);
-        markCacheVariableValid(s,"lengthInfo");
+        _lengthInfoCV.markValueValid(s);
         // don't bother fishing it out of the cache since 
         // we just calculated it and still have a handle on it
         return umli;
     }
-    return getCacheVariableValue<MuscleLengthInfo>(s, "lengthInfo");
+    return _lengthInfoCV.getValue(s);
 }
 
 Muscle::MuscleLengthInfo& Muscle::updMuscleLengthInfo(const SimTK::State& s) const
 {
-    return updCacheVariableValue<MuscleLengthInfo>(s, "lengthInfo");
+    return _lengthInfoCV.updValue(s);
 }
 
 const Muscle::FiberVelocityInfo& Muscle::
 getFiberVelocityInfo(const SimTK::State& s) const
 {
-    if(!isCacheVariableValid(s,"velInfo")){
+    if(!_velInfoCV.isValueValid(s)){
         FiberVelocityInfo& ufvi = updFiberVelocityInfo(s);
         calcFiberVelocityInfo(s, ufvi);
-        markCacheVariableValid(s,"velInfo");
+        _velInfoCV.markValueValid(s);
         // don't bother fishing it out of the cache since 
         // we just calculated it and still have a handle on it
         return ufvi;
     }
-    return getCacheVariableValue<FiberVelocityInfo>(s, "velInfo");
+    return _velInfoCV.getValue(s);
 }
 
 Muscle::FiberVelocityInfo& Muscle::
 updFiberVelocityInfo(const SimTK::State& s) const
 {
-    return updCacheVariableValue<FiberVelocityInfo>(s, "velInfo");
+    return _velInfoCV.updValue(s);
 }
 
 const Muscle::MuscleDynamicsInfo& Muscle::
 getMuscleDynamicsInfo(const SimTK::State& s) const
 {
-    if(!isCacheVariableValid(s,"dynamicsInfo")){
+    if(!_dynamicsInfoCV.isValueValid(s)){
         MuscleDynamicsInfo& umdi = updMuscleDynamicsInfo(s);
         calcMuscleDynamicsInfo(s, umdi);
-        markCacheVariableValid(s,"dynamicsInfo");
+        _dynamicsInfoCV.markValueValid(s);
         // don't bother fishing it out of the cache since 
         // we just calculated it and still have a handle on it
         return umdi;
     }
-    return getCacheVariableValue<MuscleDynamicsInfo>(s, "dynamicsInfo");
+    return _dynamicsInfoCV.getValue(s);
 }
 Muscle::MuscleDynamicsInfo& Muscle::
 updMuscleDynamicsInfo(const SimTK::State& s) const
 {
-    return updCacheVariableValue<MuscleDynamicsInfo>(s, "dynamicsInfo");
+    return _dynamicsInfoCV.updValue(s);
 }
 
 const Muscle::MusclePotentialEnergyInfo& Muscle::
 getMusclePotentialEnergyInfo(const SimTK::State& s) const
 {
-    if(!isCacheVariableValid(s,"potentialEnergyInfo")){
+    if(!_potentialEnergyInfoCV.isValueValid(s)){
         MusclePotentialEnergyInfo& umpei = updMusclePotentialEnergyInfo(s);
         calcMusclePotentialEnergyInfo(s, umpei);
-        markCacheVariableValid(s,"potentialEnergyInfo");
+        _potentialEnergyInfoCV.markValueValid(s);
         // don't bother fishing it out of the cache since 
         // we just calculated it and still have a handle on it
         return umpei;
     }
-    return getCacheVariableValue<MusclePotentialEnergyInfo>(s, "potentialEnergyInfo");
+    return _potentialEnergyInfoCV.getValue(s);
 }
 
 Muscle::MusclePotentialEnergyInfo& Muscle::
 updMusclePotentialEnergyInfo(const SimTK::State& s) const
 {
-    return updCacheVariableValue<MusclePotentialEnergyInfo>(s, "potentialEnergyInfo");
+    return _potentialEnergyInfoCV.updValue(s);
 }
 
 
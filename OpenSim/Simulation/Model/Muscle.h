@@ -439,6 +439,7 @@ protected:
     /** Model Component creation interface */
     void extendConnectToModel(Model& aModel) override;
     void extendAddToSystem(SimTK::MultibodySystem& system) const override;
+    void extendRealizeTopology(SimTK::State& state) const override;
     void extendSetPropertiesFromState(const SimTK::State &s) override;
     void extendInitStateFromProperties(SimTK::State& state) const override;
     
@@ -858,6 +859,20 @@ protected:
     };
 
 
+    /** Handles to the cache variables that hold the structs above, resolved
+        in extendRealizeTopology() so that the muscle calculations do not
+        look up the cache variables by name. */
+#ifndef SWIG
+    mutable SimTK::ResetOnCopy<CacheVariableHandle<MuscleLengthInfo>>
+        _lengthInfoCV;
+    mutable SimTK::ResetOnCopy<CacheVariableHandle<FiberVelocityInfo>>
+        _velInfoCV;
+    mutable SimTK::ResetOnCopy<CacheVariableHandle<MuscleDynamicsInfo>>
+        _dynamicsInfoCV;
+    mutable SimTK::ResetOnCopy<CacheVariableHandle<MusclePotentialEnergyInfo>>
+        _potentialEnergyInfoCV;
+#endif
+
     /** to support deprecated muscles */
     double _maxIsometricForce;
     double _optimalFiberLength;
@@ -24,6 +24,7 @@
 #include "MomentArmSolver.h"
 #include "Model/PointForceDirection.h"
 #include "Model/Model.h"
+#include "Model/GeometryPath.h"
 
 using namespace std;
 using namespace SimTK;
@@ -71,22 +72,8 @@ double MomentArmSolver::solve(const State &state, const Coordinate &aCoord,
     // set speeds to zero
     s_ma.updU() = 0;
 
-    // zero out all the forces
-    _bodyForces *= 0;
-    _generalizedForces = 0;
-
-    // apply a tension of unity to the bodies of the path
-    Vector pathDependentMobilityForces(s_ma.getNU(), 0.0);
-    path.addInEquivalentForces(s_ma, 1.0, _bodyForces, pathDependentMobilityForces);
-
-    //_bodyForces.dump("bodyForces from addInEquivalentForcesOnBodies");
-
-    // Convert body spatial forces F to equivalent mobility forces f based on 
-    // geometry (no dynamics required): f = ~J(q) * F.
-    getModel().getMultibodySystem().getMatterSubsystem()
-        .multiplyBySystemJacobianTranspose(s_ma, _bodyForces, _generalizedForces);
+    computeUnitTensionGeneralizedForces(s_ma, path);
 
-    _generalizedForces += pathDependentMobilityForces;
     // Moment-arm is the effective torque (since tension is 1) at the 
     // coordinate of interest taking into account the generalized forces also 
     // acting on other coordinates that are coupled via constraint.
@@ -132,6 +119,60 @@ double MomentArmSolver::solve(const State &state, const Coordinate &aCoord,
     return ~_coupling*_generalizedForces;
 }
 
+Matrix MomentArmSolver::solve(const State &state,
+        const std::vector<const Coordinate*> &coordinates,
+        const std::vector<const GeometryPath*> &paths) const
+{
+    const int nc = (int)coordinates.size();
+    const int np = (int)paths.size();
+
+    //Local modifiable copy of the state
+    State& s_ma = _stateCopy;
+    s_ma.updQ() = state.getQ();
+
+    // compute the coupling between coordinates due to constraints, once for
+    // each coordinate rather than once for every path as well
+    _couplingMatrix.resize(s_ma.getNU(), nc);
+    for (int j = 0; j < nc; ++j) {
+        _couplingMatrix(j) = computeCouplingVector(s_ma, *coordinates[j]);
+    }
+
+    // set speeds to zero
+    s_ma.updU() = 0;
+
+    Matrix momentArms(np, nc);
+    for (int i = 0; i < np; ++i) {
+        computeUnitTensionGeneralizedForces(s_ma, *paths[i]);
+        // Moment-arms are the effective torques (since tension is 1) at the
+        // coordinates of interest including coupling due to constraints.
+        momentArms[i] = ~(~_couplingMatrix*_generalizedForces);
+    }
+    return momentArms;
+}
+
+void MomentArmSolver::computeUnitTensionGeneralizedForces(
+        const SimTK::State &state, const GeometryPath &path) const
+{
+    // zero out all the forces
+    _bodyForces *= 0;
+    _generalizedForces = 0;
+
+    // apply a tension of unity to the bodies of the path
+    Vector pathDependentMobilityForces(state.getNU(), 0.0);
+    path.addInEquivalentForces(state, 1.0, _bodyForces,
+        pathDependentMobilityForces);
+
+    //_bodyForces.dump("bodyForces from addInEquivalentForcesOnBodies");
+
+    // Convert body spatial forces F to equivalent mobility forces f based on 
+    // geometry (no dynamics required): f = ~J(q) * F.
+    getModel().getMultibodySystem().getMatterSubsystem()
+        .multiplyBySystemJacobianTranspose(state, _bodyForces,
+            _generalizedForces);
+
+    _generalizedForces += pathDependentMobilityForces;
+}
+
 SimTK::Vector MomentArmSolver::computeCouplingVector(SimTK::State &state, 
         const Coordinate &coordinate) const
 {
@@ -83,6 +83,22 @@ public:
     double solve(const SimTK::State& state, const Coordinate &coordinate, 
         const Array<PointForceDirection *> &pfds) const;
 
+#ifndef SWIG
+    /** Solve for the effective moment-arms of many GeometryPaths about many
+        Coordinates at once. The coupling between coordinates due to
+        constraints is computed once per coordinate and the generalized forces
+        due to a unit tension are computed once per path, so this is much
+        cheaper than calling solve() for every (path, coordinate) pair.
+    @param  state               current state of the model
+    @param  coordinates         Coordinates about which we want the moment-arms
+    @param  paths               GeometryPaths for which to calculate moment-arms
+    @return ma                  paths x coordinates Matrix of moment-arms
+    */
+    SimTK::Matrix solve(const SimTK::State& state,
+        const std::vector<const Coordinate*>& coordinates,
+        const std::vector<const GeometryPath*>& paths) const;
+#endif
+
 private:
     // Internal state of the solver initialized as a copy of the default state
     mutable SimTK::State _stateCopy;
@@ -96,9 +112,17 @@ private:
     // Keep preallocated vector of the coupling constraint factors
     mutable SimTK::Vector _coupling;
 
+    // Keep preallocated matrix of the coupling factors (nu x ncoordinates)
+    mutable SimTK::Matrix _couplingMatrix;
+
     // compute vector of constraint coupling factors
     SimTK::Vector computeCouplingVector(SimTK::State &state, 
         const Coordinate &coordinate) const;
+
+    // compute the generalized forces due to a unit tension along the path
+    // in the (velocity-free) internal state
+    void computeUnitTensionGeneralizedForces(const SimTK::State &state,
+        const GeometryPath &path) const;
 //=============================================================================
 };  // END of class MomentArmSolver
 //=============================================================================
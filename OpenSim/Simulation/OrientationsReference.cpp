@@ -23,6 +23,7 @@
 
 #include "OrientationsReference.h"
 #include <OpenSim/Common/Units.h>
+#include <OpenSim/Common/TableReader.h>
 #include <OpenSim/Common/TRCFileAdapter.h>
 #include <SimTKcommon/internal/State.h>
 
@@ -61,26 +62,32 @@ void OrientationsReference::loadOrientationsEulerAnglesFile(
 {
     upd_orientation_file() = orientationFile;
 
-    auto xyzEulerData = TimeSeriesTable_<Vec3>(orientationFile);
+    // All of the rotations are kept, since the reference gives access to
+    // every frame; the angles are converted a chunk of rows at a time only so
+    // that they are not also all in memory along with the rotations.
+    TableReader_<Vec3> reader{orientationFile};
+    const auto& header = reader.getHeader();
 
-    _orientationData.updTableMetaData() = xyzEulerData.getTableMetaData();
-    _orientationData.setDependentsMetaData(xyzEulerData.getDependentsMetaData());
+    _orientationData.updTableMetaData() = header.getTableMetaData();
+    _orientationData.setDependentsMetaData(header.getDependentsMetaData());
 
-    const auto& times = xyzEulerData.getIndependentColumn();
-
-    size_t nt = xyzEulerData.getNumRows();
-    int nc = int(xyzEulerData.getNumColumns());
+    int nc = int(header.getNumColumns());
 
     RowVector_<Rotation> row(nc);
 
-    for (size_t i = 0; i < nt; ++i) {
-        const auto& xyzRow = xyzEulerData.getRowAtIndex(i);
-        for (int j = 0; j < nc; ++j) {
-            const Vec3& xyzO = xyzRow[j];
-            row[j] = Rotation(BodyOrSpaceType::BodyRotationSequence,
-                xyzO[0], XAxis, xyzO[1], YAxis, xyzO[2], ZAxis);
+    TimeSeriesTable_<Vec3> xyzEulerData{};
+    while (reader.readChunk(xyzEulerData)) {
+        const auto& times = xyzEulerData.getIndependentColumn();
+        size_t nt = xyzEulerData.getNumRows();
+        for (size_t i = 0; i < nt; ++i) {
+            const auto& xyzRow = xyzEulerData.getRowAtIndex(i);
+            for (int j = 0; j < nc; ++j) {
+                const Vec3& xyzO = xyzRow[j];
+                row[j] = Rotation(BodyOrSpaceType::BodyRotationSequence,
+                    xyzO[0], XAxis, xyzO[1], YAxis, xyzO[2], ZAxis);
+            }
+            _orientationData.appendRow(times[i], row);
         }
-        _orientationData.appendRow(times[i], row);
     }
 
     populateFromOrientationData();
@@ -137,7 +137,15 @@ TimeSeriesTable StatesTrajectory::exportToTable(const Model& model,
             createVector(model.getStateVariableNames()) :
             requestedStateVars;
     table.setColumnLabels(stateVars);
+    table.reserveRows(getSize());
     size_t numDepColumns = stateVars.size();
+
+    // Resolve the requested state variables once rather than for every row.
+    std::vector<StateVariableHandle> handles;
+    handles.reserve(requestedStateVars.size());
+    for (const auto& name : requestedStateVars) {
+        handles.push_back(model.getStateVariableHandle(name));
+    }
     
     // Fill up the table with the data.
     for (size_t itime = 0; itime < getSize(); ++itime) {
@@ -150,8 +158,7 @@ TimeSeriesTable StatesTrajectory::exportToTable(const Model& model,
             row = model.getStateVariableValues(state).transpose();
         } else {
             for (unsigned icol = 0; icol < numDepColumns; ++icol) {
-                row[static_cast<int>(icol)] = 
-                    model.getStateVariableValue(state, stateVars[icol]);
+                row[static_cast<int>(icol)] = handles[icol].getValue(state);
             }
         }
 
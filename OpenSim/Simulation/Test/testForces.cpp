@@ -33,6 +33,7 @@
 //      7. ExternalForce
 //      8. PathSpring
 //      9. ExpressionBasedPointToPointForce
+//     10. CompiledExpressions
 //      
 //     Add tests here as Forces are added to OpenSim
 //
@@ -43,6 +44,8 @@
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 #include "SimTKcommon/internal/Xml.h"
 
+#include <thread>
+
 using namespace OpenSim;
 using namespace std;
 
@@ -66,6 +69,7 @@ void testCoordinateLimitForce();
 void testCoordinateLimitForceRotational();
 void testExpressionBasedPointToPointForce();
 void testExpressionBasedCoordinateForce();
+void testCompiledExpressions();
 void testSerializeDeserialize();
 void testTranslationalDampingEffect(Model& osimModel, Coordinate& sliderCoord, double start_h, Component& componentWithDamping);
 
@@ -150,6 +154,12 @@ int main()
         failures.push_back("testExpressionBasedCoordinateForce");
     }
 
+    try { testCompiledExpressions(); }
+    catch (const std::exception& e){
+        cout << e.what() <<endl; 
+        failures.push_back("testCompiledExpressions");
+    }
+
     try { testSerializeDeserialize(); }
     catch (const std::exception& e){
         cout << e.what() <<endl; 
@@ -268,6 +278,80 @@ void testExpressionBasedCoordinateForce()
     osimModel.disownAllComponents();
 }
 
+void testCompiledExpressions()
+{
+    using SimTK::Pi;
+
+    // The expressions share the subexpression sin(x*y), the variable z is
+    // unused and y is used before x.
+    CompiledExpressions expressions(
+        {"sin(x*y)+2", "y^2-sin(x*y)/x", "step(x-1)*max(x,y)", "3.5"},
+        {"x", "y", "z"});
+    ASSERT(expressions.getNumExpressions() == 4);
+    ASSERT(expressions.getNumVariables() == 3);
+
+    for (double x : {-2.0, 0.5, 1.5, Pi}) {
+        for (double y : {-1.0, 0.0, 0.25, 4.0}) {
+            const double variables[3] = {x, y, 1e10};
+            double results[4];
+            expressions.evaluate(variables, results);
+            ASSERT_EQUAL(sin(x*y) + 2, results[0], 1e-15);
+            ASSERT_EQUAL(y*y - sin(x*y)/x, results[1], 1e-14);
+            ASSERT_EQUAL((x > 1 ? std::max(x, y) : 0.0), results[2], 1e-15);
+            ASSERT_EQUAL(3.5, results[3], 0.0);
+
+            // A copy has its own program.
+            CompiledExpressions copy(expressions);
+            ASSERT_EQUAL(sin(x*y) + 2, copy.evaluate(variables), 1e-15);
+            copy = CompiledExpressions({"x*x*x"}, {"x"});
+            ASSERT_EQUAL(x*x*x, copy.evaluate(variables), 1e-14);
+        }
+    }
+
+    // Unknown variables and invalid expressions are reported when compiling.
+    ASSERT_THROW(OpenSim::Exception,
+                 CompiledExpressions({"q+w"}, {"q", "qdot"}));
+    ASSERT_THROW(OpenSim::Exception,
+                 CompiledExpressions({"q+"}, {"q", "qdot"}));
+
+    // Replacing one expression keeps the others, and a replacement that
+    // cannot be compiled leaves the object unchanged.
+    {
+        const double variables[3] = {2.0, 3.0, 0.0};
+        double results[4];
+        expressions.setExpression(1, "x*y*z");
+        ASSERT_THROW(OpenSim::Exception, expressions.setExpression(3, "w"));
+        ASSERT_THROW(OpenSim::Exception, expressions.setExpression(4, "x"));
+        expressions.evaluate(variables, results);
+        ASSERT_EQUAL(sin(6.0) + 2, results[0], 1e-15);
+        ASSERT_EQUAL(0.0, results[1], 0.0);
+        ASSERT_EQUAL(3.0, results[2], 0.0);
+        ASSERT_EQUAL(3.5, results[3], 0.0);
+    }
+
+    // Several threads can evaluate the same object at the same time.
+    {
+        const int numThreads = 4;
+        std::vector<int> numErrors(numThreads, 0);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < numThreads; ++t) {
+            threads.emplace_back([&expressions, &numErrors, t]() {
+                for (int i = 0; i < 10000; ++i) {
+                    const double x = 0.5 + t + 1e-4*i;
+                    const double variables[3] = {x, 2.0, 3.0};
+                    double results[4];
+                    expressions.evaluate(variables, results);
+                    if (std::abs(results[0] - (sin(2*x) + 2)) > 1e-14 ||
+                            std::abs(results[1] - 6*x) > 1e-13)
+                        ++numErrors[t];
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        for (int t = 0; t < numThreads; ++t) ASSERT(numErrors[t] == 0);
+    }
+}
+
 void testExpressionBasedPointToPointForce()
 {
     using namespace SimTK;
@@ -37,13 +37,22 @@ Manager Tests:
 4. testConstructors: Ensure different constructors work as intended.
 5. testIntegratorInterface: Ensure setting integrator options works as intended.
 6. testExceptions: Test that misuse actually triggers exceptions.
+7. testSimulationEnsemble: Integrate an ensemble of falling balls in parallel
+   and compare with the analytical solution; a failing run must not affect
+   the other runs.
+8. testStreamingStates: Stream the states of a simulation to a file, across
+   several calls to integrate(), and compare with the states kept in memory.
+9. testStreamingControls: Stream the controls of a controlled model to a
+   file, and check that only the most recent controls are kept in memory.
 
 //=============================================================================*/
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/SimbodyEngine/PinJoint.h>
 #include <OpenSim/Simulation/SimbodyEngine/FreeJoint.h>
+#include <OpenSim/Simulation/SimbodyEngine/SliderJoint.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 #include <OpenSim/Simulation/Manager/Manager.h>
+#include <OpenSim/Simulation/Manager/SimulationEnsemble.h>
 #include <OpenSim/Common/LoadOpenSimLibrary.h>
 #include <OpenSim/Simulation/Control/PrescribedController.h>
 #include <OpenSim/Common/Constant.h>
@@ -56,6 +65,9 @@ void testExcitationUpdatesWithManager();
 void testConstructors();
 void testIntegratorInterface();
 void testExceptions();
+void testSimulationEnsemble();
+void testStreamingStates();
+void testStreamingControls();
 
 int main()
 {
@@ -97,6 +109,24 @@ int main()
         failures.push_back("testExceptions");
     }
 
+    try { testSimulationEnsemble(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testSimulationEnsemble");
+    }
+
+    try { testStreamingStates(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testStreamingStates");
+    }
+
+    try { testStreamingControls(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testStreamingControls");
+    }
+
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << endl;
         return 1;
@@ -478,3 +508,154 @@ void testExceptions()
     manager.setIntegratorAccuracy(1e-4);
     manager.setIntegratorMinimumStepSize(0.01);
 }
+
+void testSimulationEnsemble()
+{
+    cout << "Running testSimulationEnsemble" << endl;
+
+    using SimTK::Vec3;
+
+    Model model;
+    model.setName("ball");
+    auto ball = new Body("ball", 0.7, Vec3(0.1), SimTK::Inertia::sphere(0.5));
+    model.addBody(ball);
+    auto slider = new SliderJoint("slider", model.getGround(), Vec3(0),
+        Vec3(0, 0, SimTK::Pi/2), *ball, Vec3(0), Vec3(0, 0, SimTK::Pi/2));
+    model.addJoint(slider);
+    const double g = 9.81;
+    model.setGravity(Vec3(0, -g, 0));
+
+    SimTK::State& state = model.initSystem();
+    const Coordinate& height = slider->getCoordinate();
+
+    const int numRuns = 8;
+    const int failingRun = 5;
+    const double finalTime = 0.5;
+    SimulationEnsemble ensemble(model);
+    ensemble.setNumThreads(3);
+    ensemble.setIntegratorAccuracy(1e-8);
+    ensemble.setFixedStepSize(0.01);
+    for (int i = 0; i < numRuns; ++i) {
+        SimTK::State s0 = state;
+        height.setValue(s0, 0.1 * i);
+        if (i == failingRun) {
+            ensemble.addRun(s0, SimulationEnsemble::ModelOverride(),
+                [](const Model&, SimTK::State&) {
+                    OPENSIM_THROW(Exception, "Intentional failure.");
+                });
+        } else {
+            const int run = ensemble.addRun(s0);
+            SimTK_TEST(run == i);
+        }
+    }
+    SimTK_TEST(ensemble.getNumRuns() == numRuns);
+
+    const auto results = ensemble.integrate(finalTime);
+    SimTK_TEST((int)results.size() == numRuns);
+    for (int i = 0; i < numRuns; ++i) {
+        const auto& result = results[i];
+        if (i == failingRun) {
+            SimTK_TEST(!result.success);
+            SimTK_TEST(result.message.find("Intentional failure.") !=
+                    std::string::npos);
+            continue;
+        }
+        SimTK_TEST(result.success);
+        SimTK_TEST(result.message.empty());
+        SimTK_TEST_EQ(result.finalState.getTime(), finalTime);
+        const double expected = 0.1 * i - 0.5 * g * finalTime * finalTime;
+        SimTK_TEST_EQ_TOL(height.getValue(result.finalState), expected, 1e-6);
+        // Fixed steps of 0.01 s from 0 to 0.5 s.
+        SimTK_TEST(result.statesTable.getNumRows() == 51);
+        SimTK_TEST_EQ(result.statesTable.getIndependentColumn().back(),
+                finalTime);
+    }
+}
+
+void testStreamingStates()
+{
+    cout << "Running testStreamingStates" << endl;
+
+    using SimTK::Vec3;
+
+    Model model;
+    model.setName("ball");
+    auto ball = new Body("ball", 0.7, Vec3(0.1), SimTK::Inertia::sphere(0.5));
+    model.addBody(ball);
+    auto slider = new SliderJoint("slider", model.getGround(), Vec3(0),
+        Vec3(0, 0, SimTK::Pi/2), *ball, Vec3(0), Vec3(0, 0, SimTK::Pi/2));
+    model.addJoint(slider);
+    SimTK::State& state = model.initSystem();
+
+    // Integrate the same motion with and without streaming.
+    const std::string fileName = "testManager_streamingStates.bsto";
+    const int numStatesToKeep = 20;
+    Manager reference(model);
+    reference.setIntegratorAccuracy(1e-8);
+    reference.initialize(state);
+    Manager manager(model);
+    manager.setIntegratorAccuracy(1e-8);
+    manager.setStatesFileForStreaming(fileName, numStatesToKeep);
+    SimTK_TEST(manager.getStatesFileForStreaming() == fileName);
+    manager.initialize(state);
+    for (int i = 1; i <= 4; ++i) {
+        reference.integrate(0.5 * i);
+        manager.integrate(0.5 * i);
+        // The file holds all the states whenever integrate() returns.
+        const TimeSeriesTable streamed(fileName);
+        const TimeSeriesTable expected = reference.getStatesTable();
+        SimTK_TEST(streamed.getNumRows() == expected.getNumRows());
+        SimTK_TEST(streamed.getColumnLabels() == expected.getColumnLabels());
+        SimTK_TEST(streamed.getIndependentColumn() ==
+                expected.getIndependentColumn());
+        SimTK_TEST_EQ(streamed.getMatrix(), expected.getMatrix());
+    }
+    SimTK_TEST(reference.getStateStorage().getSize() > 2 * numStatesToKeep);
+
+    // Only the most recent states are kept in memory.
+    const Storage& kept = manager.getStateStorage();
+    SimTK_TEST(kept.getSize() >= numStatesToKeep);
+    SimTK_TEST(kept.getSize() <= 2 * numStatesToKeep);
+    SimTK_TEST_EQ(kept.getLastTime(), 2.0);
+
+    // The file can be read back as a Storage as well.
+    Storage fromFile(fileName);
+    SimTK_TEST(fromFile.getSize() == reference.getStateStorage().getSize());
+}
+
+void testStreamingControls()
+{
+    cout << "Running testStreamingControls" << endl;
+    LoadOpenSimLibrary("osimActuators");
+    Model arm("arm26.osim");
+
+    const Muscle& muscle = arm.getMuscles().get(0);
+    PrescribedController* controller = new PrescribedController();
+    controller->addActuator(muscle);
+    controller->prescribeControlForActuator(0, new Constant(0.3));
+    arm.addController(controller);
+    SimTK::State& state = arm.initSystem();
+
+    const std::string fileName = "testManager_streamingControls.bsto";
+    const int numControlsToKeep = 2;
+    Manager manager(arm);
+    manager.setControlsFileForStreaming(fileName, numControlsToKeep);
+    SimTK_TEST(manager.getControlsFileForStreaming() == fileName);
+    manager.initialize(state);
+    manager.integrate(0.1);
+
+    // The file holds all the controls.
+    const TimeSeriesTable streamed(fileName);
+    SimTK_TEST(streamed.getNumRows() > 2 * numControlsToKeep);
+    SimTK_TEST(streamed.getNumColumns() == (size_t)arm.getNumControls());
+    SimTK_TEST(streamed.getColumnLabels()[0] == muscle.getName());
+    SimTK_TEST_EQ(streamed.getIndependentColumn().back(), 0.1);
+    for (size_t i = 0; i < streamed.getNumRows(); ++i)
+        SimTK_TEST_EQ(streamed.getMatrix()(int(i), 0), 0.3);
+
+    // Only the most recent controls are kept in memory.
+    const TimeSeriesTable kept = arm.getControlsTable();
+    SimTK_TEST(kept.getNumRows() >= (size_t)numControlsToKeep);
+    SimTK_TEST(kept.getNumRows() <= 2 * (size_t)numControlsToKeep);
+    SimTK_TEST_EQ(kept.getIndependentColumn().back(), 0.1);
+}
@@ -56,6 +56,8 @@ void testMomentArmDefinitionForModel(const string &filename,
 
 void testMomentArmsAcrossCompoundJoint();
 
+void testMomentArmMatrixForModel(const string &filename);
+
 int main()
 {
     clock_t startTime = clock();
@@ -128,6 +130,12 @@ int main()
 
         testMomentArmDefinitionForModel("CoupledCoordinatesMPPsMomentArmTest.osim", "foot_angle", "vas_int_r", SimTK::Vec2(-2*SimTK::Pi/3, SimTK::Pi/18), -1.0, "Multiple moving path points: FAILED");
         cout << "Multiple moving path points coupled coordinates test: PASSED\n" << endl;
+
+        testMomentArmMatrixForModel("gait2354_simbody.osim");
+        cout << "Moment-arm matrix of gait2354: PASSED\n" << endl;
+
+        testMomentArmMatrixForModel("testMomentArmsConstraintB.osim");
+        cout << "Moment-arm matrix with coupled coordinates: PASSED\n" << endl;
     }
     catch (const Exception& e) {
         e.print(cerr);
@@ -166,6 +174,45 @@ void testMomentArmsAcrossCompoundJoint()
         0.0, "testMomentArmsAcrossCompoundJoint: FAILED");
 }
 
+// The moment-arm matrix (all muscles about all coordinates) must agree with
+// the moment-arms solved for one muscle and one coordinate at a time.
+void testMomentArmMatrixForModel(const string &filename)
+{
+    Model model(filename);
+    SimTK::State& s = model.initSystem();
+
+    std::vector<const Coordinate*> coordinates;
+    for (const auto& coord : model.getComponentList<Coordinate>())
+        coordinates.push_back(&coord);
+    std::vector<const GeometryPath*> paths;
+    for (const auto& muscle : model.getComponentList<Muscle>())
+        paths.push_back(&muscle.getGeometryPath());
+
+    MomentArmSolver maSolver(model);
+    // Evaluate at the default pose and at a pose with every coordinate
+    // displaced toward the middle of its range.
+    for (int pose = 0; pose < 2; ++pose) {
+        if (pose == 1) {
+            for (const auto* coord : coordinates) {
+                if (coord->getLocked(s)) continue;
+                coord->setValue(s, 0.5*(coord->getRangeMin() +
+                    coord->getRangeMax()), false);
+            }
+            model.assemble(s);
+        }
+        model.realizeVelocity(s);
+        SimTK::Matrix momentArms = maSolver.solve(s, coordinates, paths);
+        ASSERT(momentArms.nrow() == (int)paths.size());
+        ASSERT(momentArms.ncol() == (int)coordinates.size());
+        for (size_t i = 0; i < paths.size(); ++i) {
+            for (size_t j = 0; j < coordinates.size(); ++j) {
+                double ma = maSolver.solve(s, *coordinates[j], *paths[i]);
+                ASSERT_EQUAL(ma, momentArms(int(i), int(j)), 1e-10);
+            }
+        }
+    }
+}
+
 //==========================================================================================================
 // moment_arm = dl/dtheta, definition using inexact perturbation technique
 //==========================================================================================================
@@ -114,9 +114,61 @@ void testTableReporterLabels() {
     SimTK_TEST(headings[1] == "height");
 }
 
+void testTableReporterStreaming() {
+    Model model;
+    model.setName("world");
+
+    auto* ball = new OpenSim::Body("ball", 1., Vec3(0), Inertia(0));
+    model.addBody(ball);
+
+    auto* slider = new SliderJoint("slider", model.getGround(), Vec3(0),
+        Vec3(0,0,Pi/2.), *ball, Vec3(0), Vec3(0,0,Pi/2.));
+    model.addJoint(slider);
+
+    // One reporter streams its rows to a file, the other keeps all of them.
+    auto* streaming = new TableReporter();
+    streaming->setName("streaming");
+    streaming->set_report_time_interval(0.01);
+    streaming->addToReport(slider->getCoordinate().getOutput("value"));
+    streaming->addToReport(slider->getCoordinate().getOutput("speed"));
+    model.addComponent(streaming);
+    auto* reference = new TableReporter();
+    reference->setName("reference");
+    reference->set_report_time_interval(0.01);
+    reference->addToReport(slider->getCoordinate().getOutput("value"));
+    reference->addToReport(slider->getCoordinate().getOutput("speed"));
+    model.addComponent(reference);
+
+    const std::string fileName{"testReporters_streaming.bsto"};
+    const int numRowsToKeep = 10;
+    streaming->streamToFile(fileName, numRowsToKeep);
+
+    State& state = model.initSystem();
+    Manager manager(model);
+    state.setTime(0.0);
+    manager.initialize(state);
+    manager.integrate(1.0);
+    streaming->closeStream();
+
+    const auto& expected = reference->getTable();
+    SimTK_TEST(expected.getNumRows() == 101);
+    const TimeSeriesTable streamed(fileName);
+    SimTK_TEST(streamed.getColumnLabels() == expected.getColumnLabels());
+    SimTK_TEST(streamed.getIndependentColumn() ==
+               expected.getIndependentColumn());
+    SimTK_TEST_EQ(streamed.getMatrix(), expected.getMatrix());
+
+    // Only the most recent rows are kept in memory.
+    const auto& kept = streaming->getTable();
+    SimTK_TEST(kept.getNumRows() >= numRowsToKeep);
+    SimTK_TEST(kept.getNumRows() <= 2 * numRowsToKeep);
+    SimTK_TEST_EQ(kept.getIndependentColumn().back(), 1.0);
+}
+
 int main() {
     SimTK_START_TEST("testReporters");
         SimTK_SUBTEST(testConsoleReporterLabels);
         SimTK_SUBTEST(testTableReporterLabels);
+        SimTK_SUBTEST(testTableReporterStreaming);
     SimTK_END_TEST();
 };
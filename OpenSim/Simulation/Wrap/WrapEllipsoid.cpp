@@ -49,6 +49,16 @@ static const char* wrapTypeName = "ellipsoid";
 #define N_STEPS               16
 #define SV_BOUNDARY_BLEND     0.3
 
+// Whether the points r and c are on the same side of the line through p and
+// m, in the plane with normal vs.
+static bool areOnSameSide(const Vec3& r, const Vec3& c, const Vec3& p,
+                          const Vec3& m, const Vec3& vs)
+{
+    const Vec3 pm = m - p;
+    return SimTK::dot(vs, SimTK::cross(pm, r - p)) *
+           SimTK::dot(vs, SimTK::cross(pm, c - p)) > 0.0;
+}
+
 //=============================================================================
 // CONSTRUCTOR(S) AND DESTRUCTOR
 //=============================================================================
@@ -213,6 +223,14 @@ int WrapEllipsoid::wrapLine(const SimTK::State& s, SimTK::Vec3& aPoint1, SimTK::
     aFlag = true;
     aWrapResult.wrap_pts.setSize(0);
 
+    // If the path last wrapped the same segment over this object with this
+    // state, the GeometryPath passes the tangent points of that wrap, which
+    // are used below as starting guesses for the new tangent points. They
+    // are in the frame of the wrap object's body, so convert them back.
+    const bool hasPreviousTangentPoints =
+        aWrapResult.previous_r1.isFinite() &&
+        aWrapResult.previous_r2.isFinite();
+
     // This algorithm works best if the coordinates (aPoint1, aPoint2,
     // origin, _dimensions) are all somewhat close to 1.0. So use
     // the ellipsoid dimensions to calculate a multiplication factor that
@@ -484,16 +502,14 @@ int WrapEllipsoid::wrapLine(const SimTK::State& s, SimTK::Vec3& aPoint1, SimTK::
     // c1[] was still on the first side. The new way of initializing
     // r1 sets it to c1 so that it will stay on c1's side of the
     // ellipsoid.
-    {
-        bool use_c1_to_find_tangent_pts = true;
+    bool use_c1_to_find_tangent_pts = true;
 
-        if (aPathWrap.getMethod() == PathWrap::axial)
-            use_c1_to_find_tangent_pts = (bool) (t[bestMu] > 0.0 && t[bestMu] < 1.0);
+    if (aPathWrap.getMethod() == PathWrap::axial)
+        use_c1_to_find_tangent_pts = (bool) (t[bestMu] > 0.0 && t[bestMu] < 1.0);
 
-        if (use_c1_to_find_tangent_pts)
-            for (i = 0; i < 3; i++)
-                aWrapResult.r1[i] = aWrapResult.r2[i] = aWrapResult.c1[i];
-    }
+    if (use_c1_to_find_tangent_pts)
+        for (i = 0; i < 3; i++)
+            aWrapResult.r1[i] = aWrapResult.r2[i] = aWrapResult.c1[i];
 
     // if wrapping is constrained to one half of the ellipsoid,
     // check to see if we need to flip c1 to the active side of
@@ -538,9 +554,34 @@ int WrapEllipsoid::wrapLine(const SimTK::State& s, SimTK::Vec3& aPoint1, SimTK::
 
     vs4 = - Mtx::DotProduct(3, vs, aWrapResult.c1);
 
-    // find r1 & r2 by starting at c1 moving toward p1 & p2
-    calcTangentPoint(p1e, aWrapResult.r1, p1, m, a, vs, vs4);
-    calcTangentPoint(p2e, aWrapResult.r2, p2, m, a, vs, vs4);
+    // find r1 & r2 by starting at c1 moving toward p1 & p2. If the tangent
+    // points of the previous wrap are available, start from them instead,
+    // which takes fewer iterations; their results are kept only if both
+    // converged to tangent points on c1's side of the ellipsoid.
+    bool found_tangent_pts = false;
+
+    if (use_c1_to_find_tangent_pts && hasPreviousTangentPoints)
+    {
+        const SimTK::Transform& X_BW = getTransform();
+        SimTK::Vec3 r1 = X_BW.shiftBaseStationToFrame(aWrapResult.previous_r1) * aWrapResult.factor;
+        SimTK::Vec3 r2 = X_BW.shiftBaseStationToFrame(aWrapResult.previous_r2) * aWrapResult.factor;
+
+        if (calcTangentPoint(p1e, r1, p1, m, a, vs, vs4) &&
+            calcTangentPoint(p2e, r2, p2, m, a, vs, vs4) &&
+            areOnSameSide(r1, aWrapResult.c1, p1, m, vs) &&
+            areOnSameSide(r2, aWrapResult.c1, p2, m, vs))
+        {
+            aWrapResult.r1 = r1;
+            aWrapResult.r2 = r2;
+            found_tangent_pts = true;
+        }
+    }
+
+    if (!found_tangent_pts)
+    {
+        calcTangentPoint(p1e, aWrapResult.r1, p1, m, a, vs, vs4);
+        calcTangentPoint(p2e, aWrapResult.r2, p2, m, a, vs, vs4);
+    }
 
     // create a series of line segments connecting r1 & r2 along the
     // surface of the ellipsoid.
@@ -609,7 +650,8 @@ calc_wrap_path:
  * @param a Ellipsoid axis
  * @param vs Plane vector
  * @param vs4 Plane coefficient
- * @return '1' if the point was adjusted, '0' otherwise
+ * @return '1' if the adjusted point satisfies the constraints, '0' if the
+ * iterations stopped before it did
  */
 int WrapEllipsoid::calcTangentPoint(double p1e, SimTK::Vec3& r1, SimTK::Vec3& p1, SimTK::Vec3& m,
                                                 SimTK::Vec3& a, SimTK::Vec3& vs, double vs4) const
@@ -792,6 +834,9 @@ int WrapEllipsoid::calcTangentPoint(double p1e, SimTK::Vec3& r1, SimTK::Vec3& p1
             ssq = SQR(ee[0]) + SQR(ee[1]) + SQR(ee[2]) + SQR(ee[3]);
             ssqo = ssq;     
         }
+
+        if (ssq > ELLIPSOID_TINY)
+            return 0;
     }   
     return 1;
 
@@ -39,7 +39,10 @@ using namespace OpenSim;
 /**
  * Default constructor.
  */
-WrapResult::WrapResult()
+WrapResult::WrapResult() :
+    previous_r1(SimTK::NaN),
+    previous_r2(SimTK::NaN),
+    closest_u(SimTK::NaN)
 {
 }
 
@@ -59,7 +62,11 @@ WrapResult::~WrapResult()
  */
 void WrapResult::copyData(const WrapResult& aWrapResult)
 {
-    wrap_pts = aWrapResult.wrap_pts;
+    // Copy the points into the existing array, which is not reallocated
+    // unless it is too small.
+    wrap_pts.setSize(aWrapResult.wrap_pts.getSize());
+    for (int j = 0; j < wrap_pts.getSize(); j++)
+        wrap_pts[j] = aWrapResult.wrap_pts[j];
     wrap_path_length = aWrapResult.wrap_path_length;
 
     startPoint = aWrapResult.startPoint;
@@ -72,6 +79,9 @@ void WrapResult::copyData(const WrapResult& aWrapResult)
         c1[i] = aWrapResult.c1[i];
         sv[i] = aWrapResult.sv[i];
     }
+    previous_r1 = aWrapResult.previous_r1;
+    previous_r2 = aWrapResult.previous_r2;
+    closest_u = aWrapResult.closest_u;
 }
 
 //=============================================================================
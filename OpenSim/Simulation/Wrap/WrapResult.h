@@ -57,6 +57,10 @@ public:
     SimTK::Vec3 c1;              // intermediate point used by some wrap objects
     SimTK::Vec3 sv;              // intermediate point used by some wrap objects
     double factor;             // scale factor used to normalize parameters
+    SimTK::Vec3 previous_r1;     // tangent points of the previous wrap of the
+    SimTK::Vec3 previous_r2;     // same segment, used as starting guesses
+    SimTK::Vec2 closest_u;     // line parameters of the closest points to the
+                               // axis of a torus, used as starting guesses
 
 //=============================================================================
 // METHODS
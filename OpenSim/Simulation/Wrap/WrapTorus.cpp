@@ -44,6 +44,9 @@ using SimTK::Vec3;
 static const char* wrapTypeName = "torus";
 
 #define CYL_LENGTH 10000.0
+// Largest move, as a fraction of the segment length, of a closest point
+// search started from the previous solution.
+#define MAX_WARM_START_STEP 0.1
 
 //=============================================================================
 // CONSTRUCTOR(S) AND DESTRUCTOR
@@ -211,7 +214,10 @@ int WrapTorus::wrapLine(const SimTK::State& s, SimTK::Vec3& aPoint1, SimTK::Vec3
     //bool far_side_wrap = false;
     aFlag = true;
 
-    if (findClosestPoint(get_outer_radius(), &aPoint1[0], &aPoint2[0], &closestPt[0], &closestPt[1], &closestPt[2], _wrapSign, _wrapAxis) == 0)
+    // The search for the closest point starts from aWrapResult.closest_u,
+    // which the GeometryPath sets to the solution of the previous wrap of the
+    // same path segment with this state (NaN if there is none).
+    if (findClosestPoint(get_outer_radius(), &aPoint1[0], &aPoint2[0], &closestPt[0], &closestPt[1], &closestPt[2], _wrapSign, _wrapAxis, aWrapResult.closest_u) == 0)
         return noWrap;
 
     // Now put a cylinder at closestPt and call the cylinder wrap code.
@@ -266,11 +272,15 @@ int WrapTorus::wrapLine(const SimTK::State& s, SimTK::Vec3& aPoint1, SimTK::Vec3
  * @param zc The Z coordinate of the closest point
  * @param wrap_sign If wrap is constrained to a quadrant, the sign of the relevant axis
  * @param wrap_axis If wrap is constrained to a quadrant, the relevant axis
+ * @param u0 Distances along the line, from p1 and from p2, at which to start
+ * the two searches for the closest point (NaN to start at p1 and p2). On
+ * return, the distances found by the searches.
  * @return '1' if a closest point was found, '0' if there was an error while trying to constrain the wrap
  */
 int WrapTorus::findClosestPoint(double radius, double p1[], double p2[],
                                           double* xc, double* yc, double* zc,
-                                          int wrap_sign, int wrap_axis) const
+                                          int wrap_sign, int wrap_axis,
+                                          SimTK::Vec2& u0) const
 {
    int info;                  // output flag
    int num_func_calls;        // number of calls to func (nfev)
@@ -290,6 +300,34 @@ int WrapTorus::findClosestPoint(double radius, double p1[], double p2[],
    // Circle variables
    double u, mag, nx, ny, nz, x, y, z, a1[3], a2[3], distance1, distance2, betterPt = 0;
 
+   // Searches for the distance along the line from cb.p1 to cb.p2 of the
+   // point closest to the circle. If `start` is not NaN, the search starts
+   // there, and its result is accepted only if the search converged to a
+   // point on the segment that is not far from the start; otherwise, the
+   // search is repeated from cb.p1.
+   auto search = [&](double start) -> double {
+      const double length = sqrt(
+          (cb.p2[0]-cb.p1[0])*(cb.p2[0]-cb.p1[0]) +
+          (cb.p2[1]-cb.p1[1])*(cb.p2[1]-cb.p1[1]) +
+          (cb.p2[2]-cb.p1[2])*(cb.p2[2]-cb.p1[2]));
+      if (!SimTK::isNaN(start)) {
+         q[0] = start;
+         lmdif_C(calcCircleResids, numResid, numQs, q, resid,
+                 ftol, xtol, gtol, max_iter, epsfcn, diag, mode, step_factor,
+                 nprint, &info, &num_func_calls, fjac, ldfjac, ipvt, qtf,
+                 wa1, wa2, wa3, wa4, (void*)&cb);
+         if (info >= 1 && info <= 4 && q[0] >= 0.0 && q[0] <= length &&
+             fabs(q[0] - start) <= MAX_WARM_START_STEP * length)
+            return q[0];
+      }
+      q[0] = 0.0;
+      lmdif_C(calcCircleResids, numResid, numQs, q, resid,
+              ftol, xtol, gtol, max_iter, epsfcn, diag, mode, step_factor,
+              nprint, &info, &num_func_calls, fjac, ldfjac, ipvt, qtf,
+              wa1, wa2, wa3, wa4, (void*)&cb);
+      return q[0];
+   };
+
    cb.p1[0] = p1[0];
    cb.p1[1] = p1[1];
    cb.p1[2] = p1[2];
@@ -298,14 +336,7 @@ int WrapTorus::findClosestPoint(double radius, double p1[], double p2[],
    cb.p2[2] = p2[2];
    cb.r = radius;
 
-   q[0] = 0.0;
-
-   lmdif_C(calcCircleResids, numResid, numQs, q, resid,
-           ftol, xtol, gtol, max_iter, epsfcn, diag, mode, step_factor,
-           nprint, &info, &num_func_calls, fjac, ldfjac, ipvt, qtf,
-           wa1, wa2, wa3, wa4, (void*)&cb);
-
-   u = q[0];
+   u = u0[0] = search(u0[0]);
 
    mag = sqrt((p2[0]-p1[0])*(p2[0]-p1[0]) + (p2[1]-p1[1])*(p2[1]-p1[1]) + (p2[2]-p1[2])*(p2[2]-p1[2]));
 
@@ -333,14 +364,7 @@ int WrapTorus::findClosestPoint(double radius, double p1[], double p2[],
    cb.p2[2] = p1[2];
    cb.r = radius;
 
-   q[0] = 0.0;
-
-   lmdif_C(calcCircleResids, numResid, numQs, q, resid,
-           ftol, xtol, gtol, max_iter, epsfcn, diag, mode, step_factor,
-           nprint, &info, &num_func_calls, fjac, ldfjac, ipvt, qtf,
-           wa1, wa2, wa3, wa4, (void*)&cb);
-
-   u = q[0];
+   u = u0[1] = search(u0[1]);
 
    mag = sqrt((p2[0]-p1[0])*(p2[0]-p1[0]) + (p2[1]-p1[1])*(p2[1]-p1[1]) + (p2[2]-p1[2])*(p2[2]-p1[2]));
 
@@ -89,7 +89,7 @@ private:
 
     int findClosestPoint(double radius, double p1[], double p2[],
         double* xc, double* yc, double* zc,
-        int wrap_sign, int wrap_axis) const;
+        int wrap_sign, int wrap_axis, SimTK::Vec2& u0) const;
     static void calcCircleResids(int numResid, int numQs, double q[],
         double resid[], int *flag2, void *ptr);
 
@@ -71,6 +71,7 @@
 #include "Model/Ground.h"
 
 #include "Manager/Manager.h"
+#include "Manager/SimulationEnsemble.h"
 
 #include "Control/ControlSet.h"
 #include "Control/ControlSetController.h"
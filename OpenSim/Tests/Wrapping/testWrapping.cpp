@@ -47,6 +47,7 @@ public:
 };
 
 void testWrapCylinder();
+void testWrapWarmStart();
 void testWrapObjectUpdateFromXMLNode30515();
 void simulate(Model& osimModel, State& si, double initialTime, double finalTime);
 void simulateModelWithMusclesNoViz(const string &modelFile, double finalTime, double activation=0.5);
@@ -61,6 +62,7 @@ int main()
 
     try{
         testWrapCylinder();
+        testWrapWarmStart();
         // performance of multiple paths with wrapping in upper-extremity
         simulateModelWithMusclesNoViz("TestShoulderWrapping.osim", 0.1);}
     catch (const std::exception& e) {
@@ -402,6 +404,106 @@ void testWrapCylinder()
 
         ASSERT_EQUAL<double>(len1, len2, SimTK::Eps);
     }
+
+    // The paths count their computations once the counters are enabled, and
+    // the computations are only repeated when the state changes.
+    GeometryPath& path1 = spring1->updGeometryPath();
+    SimTK_TEST(!path1.getComputationCountersEnabled());
+    SimTK_TEST(path1.getNumPathComputations() == 0);
+    path1.setComputationCountersEnabled(true);
+    for (int i = 0; i < nsteps; ++i) {
+        coord.setValue(s, i*SimTK::Pi/(2*nsteps));
+        model.realizeVelocity(s);
+        spring1->getLength(s);
+    }
+    SimTK_TEST(path1.getNumPathComputations() >= nsteps);
+    SimTK_TEST(path1.getNumWrapCalculations() >= nsteps);
+    SimTK_TEST(path1.getWrappingTime() >= 0);
+    path1.resetComputationCounters();
+    SimTK_TEST(path1.getNumPathComputations() == 0);
+    SimTK_TEST(path1.getNumWrapCalculations() == 0);
+    coord.setValue(s, 0);
+    model.realizeVelocity(s);
+    spring1->getLength(s);
+    const int numPathComputations = path1.getNumPathComputations();
+    SimTK_TEST(numPathComputations >= 1);
+    spring1->getLength(s);
+    SimTK_TEST(path1.getNumPathComputations() == numPathComputations);
+    path1.setComputationCountersEnabled(false);
+    SimTK_TEST(path1.getNumPathComputations() == 0);
+}
+
+// Paths wrapped over an ellipsoid or a torus start their searches from the
+// previous wrap of the same segment. Check that they find the same path as
+// searches started from scratch.
+void testWrapWarmStart()
+{
+    for (const std::string wrapType : {"ellipsoid", "torus"}) {
+        Model model;
+        model.setName("testWrapWarmStart_" + wrapType);
+        auto& ground = model.updGround();
+
+        WrapObject* wrapObject;
+        Vec3 origin, insertion;
+        if (wrapType == "ellipsoid") {
+            auto ellipsoid = new WrapEllipsoid();
+            ellipsoid->set_dimensions(Vec3(0.05, 0.04, 0.03));
+            wrapObject = ellipsoid;
+            origin = Vec3(-0.1, 0, 0.005);
+            insertion = Vec3(0.1, 0, -0.02);
+        } else {
+            // The path passes through the hole of the torus.
+            auto torus = new WrapTorus();
+            torus->set_outer_radius(0.1);
+            torus->set_inner_radius(0.02);
+            wrapObject = torus;
+            origin = Vec3(0, 0, 0.1);
+            insertion = Vec3(0.15, 0, -0.1);
+        }
+        wrapObject->setName(wrapType);
+        ground.addWrapObject(wrapObject);
+
+        // The insertion slides along the x axis of ground.
+        auto body = new OpenSim::Body("body", 1, Vec3(0), Inertia(0.01));
+        model.addComponent(body);
+        auto joint = new SliderJoint("slider", ground, insertion, Vec3(0),
+                                     *body, Vec3(0), Vec3(0));
+        model.addComponent(joint);
+
+        PathSpring* spring = new PathSpring("spring", 1.0, 0.1, 0.01);
+        spring->updGeometryPath().
+            appendNewPathPoint("origin", ground, origin);
+        spring->updGeometryPath().
+            appendNewPathPoint("insert", *body, Vec3(0));
+        spring->updGeometryPath().addPathWrap(*wrapObject);
+        PathWrap& pathWrap = spring->updGeometryPath().updWrapSet()[0];
+        model.addComponent(spring);
+
+        SimTK::State& s = model.initSystem();
+        const Coordinate& coord = joint->getCoordinate();
+
+        int numWrapped = 0;
+        const int nsteps = 20;
+        for (int i = 0; i <= nsteps; ++i) {
+            const double q = 0.05*i/nsteps;
+            coord.setValue(s, q);
+            model.realizePosition(s);
+            const double warmLength = spring->getLength(s);
+            if (spring->getGeometryPath().getCurrentPath(s).getSize() > 2)
+                ++numWrapped;
+
+            // Forget the previous wrap and wrap the same path again.
+            SimTK::State coldState = s;
+            pathWrap.resetPreviousWrap();
+            coord.setValue(coldState, q);
+            model.realizePosition(coldState);
+            const double coldLength = spring->getLength(coldState);
+
+            ASSERT_EQUAL<double>(coldLength, warmLength, 1e-5);
+        }
+        // The path must have touched the wrap object.
+        SimTK_TEST(numWrapped > 0);
+    }
 }
 
 
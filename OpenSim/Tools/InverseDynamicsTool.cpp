@@ -60,7 +60,8 @@ InverseDynamicsTool::InverseDynamicsTool() : DynamicsTool(),
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
     _outputGenForceFileName(_outputGenForceFileNameProp.getValueStr()),
     _jointsForReportingBodyForces(_jointsForReportingBodyForcesProp.getValueStrArray()),
-    _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr())
+    _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr()),
+    _numThreads(_numThreadsProp.getValueInt())
 {
     setNull();
 }
@@ -79,7 +80,8 @@ InverseDynamicsTool::InverseDynamicsTool(const string &aFileName, bool aLoadMode
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
     _outputGenForceFileName(_outputGenForceFileNameProp.getValueStr()),
     _jointsForReportingBodyForces(_jointsForReportingBodyForcesProp.getValueStrArray()),
-    _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr())
+    _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr()),
+    _numThreads(_numThreadsProp.getValueInt())
 {
     setNull();
     updateFromXMLDocument();
@@ -101,7 +103,8 @@ InverseDynamicsTool::InverseDynamicsTool(const InverseDynamicsTool &aTool) :
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
     _outputGenForceFileName(_outputGenForceFileNameProp.getValueStr()),
     _jointsForReportingBodyForces(_jointsForReportingBodyForcesProp.getValueStrArray()),
-    _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr())
+    _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr()),
+    _numThreads(_numThreadsProp.getValueInt())
 {
     setNull();
     *this = aTool;
@@ -148,6 +151,13 @@ void InverseDynamicsTool::setupProperties()
     _outputBodyForcesAtJointsFileNameProp.setName("output_body_forces_file");
     _outputBodyForcesAtJointsFileNameProp.setValue("body_forces_at_joints.sto");
     _propertySet.append(&_outputBodyForcesAtJointsFileNameProp);
+
+    _numThreadsProp.setComment("Number of threads that solve the time frames. "
+        "A value of 0 or less uses one thread per processor. With more than one "
+        "thread, the analyses of the model are not run.");
+    _numThreadsProp.setName("num_threads");
+    _numThreadsProp.setValue(1);
+    _propertySet.append(&_numThreadsProp);
 }
 
 //_____________________________________________________________________________
@@ -179,6 +189,7 @@ operator=(const InverseDynamicsTool &aTool)
     _lowpassCutoffFrequency = aTool._lowpassCutoffFrequency;
     _outputGenForceFileName = aTool._outputGenForceFileName;
     _outputBodyForcesAtJointsFileName = aTool._outputBodyForcesAtJointsFileName;
+    _numThreads = aTool._numThreads;
     _coordinateValues = NULL;
 
     return(*this);
@@ -325,23 +336,52 @@ bool InverseDynamicsTool::run()
         
         Array_<double> times(nt, 0.0);
         for(int i=0; i<nt; i++){
-            times[i]=_coordinateValues->getStateVector(start_index+i)->getTime();
+            _coordinateValues->getTime(start_index+i, times[i]);
+        }
+
+        JointSet jointsForEquivalentBodyForces;
+        getJointsByName(*_model, _jointsForReportingBodyForces, jointsForEquivalentBodyForces);
+        int nj = jointsForEquivalentBodyForces.getSize();
+
+        // Joints are identified by index so that they can be found in the
+        // copies of the model used by other threads.
+        std::vector<int> jointIndices(nj);
+        for(int j=0; j<nj; ++j){
+            jointIndices[j] = _model->getJointSet().getIndex(
+                    jointsForEquivalentBodyForces[j].getName());
         }
 
         // Preallocate results
-        Array_<Vector> genForceTraj(nt, Vector(nq, 0.0));
+        Matrix genForceTraj(nt, nq, 0.0);
+        Matrix bodyForces(nt, 6*nj, 0.0);
+
+        // Equivalent body forces are computed for each frame as it is solved
+        InverseDynamicsSolver::FrameFunction calcBodyForces;
+        if(nj>0){
+            calcBodyForces = [&](const Model& model, const SimTK::State& state,
+                                 int frame, const Vector& genForces) {
+                for(int j=0; j<nj; ++j){
+                    const SpatialVec equivalentBodyForceAtJoint =
+                        model.getJointSet()[jointIndices[j]]
+                            .calcEquivalentSpatialForce(state, genForces);
+                    for(int k=0; k<3; ++k){
+                        // body force components
+                        bodyForces(frame, 6*j+k) = equivalentBodyForceAtJoint[1][k];
+                        // body torque components
+                        bodyForces(frame, 6*j+k+3) = equivalentBodyForceAtJoint[0][k];
+                    }
+                }
+            };
+        }
 
         // solve for the trajectory of generalized forces that correspond to the 
         // coordinate trajectories provided
-        ivdSolver.solve(s, *coordFunctions, times, genForceTraj);
+        ivdSolver.solve(s, *coordFunctions, times, genForceTraj, _numThreads,
+                        calcBodyForces);
         success = true;
 
         cout << "InverseDynamicsTool: " << nt << " time frames in " 
             << (double)(clock()-start)/CLOCKS_PER_SEC << "s\n" <<endl;
-    
-        JointSet jointsForEquivalentBodyForces;
-        getJointsByName(*_model, _jointsForReportingBodyForces, jointsForEquivalentBodyForces);
-        int nj = jointsForEquivalentBodyForces.getSize();
 
         // Generalized forces from ID Solver are in MultibodyTree order and not
         // necessarily in the order of the Coordinates in the Model.
@@ -366,40 +406,16 @@ bool InverseDynamicsTool::run()
 
         Storage genForceResults(nt);
         Storage bodyForcesResults(nt);
-        SpatialVec equivalentBodyForceAtJoint;
 
         for(int i=0; i<nt; i++){
             StateVector
-                genForceVec(times[i], genForceTraj[i]);
+                genForceVec(times[i], Vector(~genForceTraj[i]));
             genForceResults.append(genForceVec);
 
-            // if there are joints requested for equivalent body forces then calculate them
+            // if there are joints requested for equivalent body forces then report them
             if(nj>0){
-                Vector forces(6*nj, 0.0);
-                StateVector bodyForcesVec(times[i],
-                                          SimTK::Vector_<double>(6*nj,
-                                                                 &forces[0]));
-
-                s.updTime() = times[i];
-                Vector &q = s.updQ();
-                Vector &u = s.updU();
-
-                for(int j=0; j<nq; ++j){
-                    q[j] = coordFunctions->evaluate(j, 0, times[i]);
-                    u[j] = coordFunctions->evaluate(j, 1, times[i]);
-                }
-            
-                for(int j=0; j<nj; ++j){
-                    equivalentBodyForceAtJoint = jointsForEquivalentBodyForces[j].calcEquivalentSpatialForce(s, genForceTraj[i]);
-                    for(int k=0; k<3; ++k){
-                        // body force components
-                        bodyForcesVec.setDataValue(6*j+k, equivalentBodyForceAtJoint[1][k]); 
-                        // body torque components
-                        bodyForcesVec.setDataValue(6*j+k+3, equivalentBodyForceAtJoint[0][k]);
-                    }
-                }
+                StateVector bodyForcesVec(times[i], Vector(~bodyForces[i]));
                 bodyForcesResults.append(bodyForcesVec);
-
             }
         }
 
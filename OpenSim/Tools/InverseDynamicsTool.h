@@ -88,6 +88,11 @@ protected:
     PropertyStr _outputBodyForcesAtJointsFileNameProp;
     std::string &_outputBodyForcesAtJointsFileName;
 
+    /** Number of threads that solve the time frames (0 or less for one per
+        processor) */
+    PropertyInt _numThreadsProp;
+    int &_numThreads;
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -156,6 +161,12 @@ public:
     void setLowpassCutoffFrequency(double aFrequency) {
         _lowpassCutoffFrequency = aFrequency;
     }
+    /**
+     * get/set the number of threads that solve the time frames. With more
+     * than one thread, the model's analyses are not stepped.
+     */
+    int getNumThreads() const { return _numThreads; }
+    void setNumThreads(int aNumThreads) { _numThreads = aNumThreads; }
     //--------------------------------------------------------------------------
     // INTERFACE
     //--------------------------------------------------------------------------
@@ -40,6 +40,9 @@
 #include "IKCoordinateTask.h"
 #include "IKMarkerTask.h"
 
+#include <exception>
+#include <memory>
+#include <thread>
 
 using namespace OpenSim;
 using namespace std;
@@ -70,7 +73,8 @@ InverseKinematicsTool::InverseKinematicsTool() : Tool(),
     _timeRange(_timeRangeProp.getValueDblArray()),
     _reportErrors(_reportErrorsProp.getValueBool()),
     _outputMotionFileName(_outputMotionFileNameProp.getValueStr()),
-    _reportMarkerLocations(_reportMarkerLocationsProp.getValueBool())
+    _reportMarkerLocations(_reportMarkerLocationsProp.getValueBool()),
+    _numThreads(_numThreadsProp.getValueInt())
 {
     setNull();
 }
@@ -95,7 +99,8 @@ InverseKinematicsTool::InverseKinematicsTool(const string &aFileName, bool aLoad
     _timeRange(_timeRangeProp.getValueDblArray()),
     _reportErrors(_reportErrorsProp.getValueBool()),
     _outputMotionFileName(_outputMotionFileNameProp.getValueStr()),
-    _reportMarkerLocations(_reportMarkerLocationsProp.getValueBool())
+    _reportMarkerLocations(_reportMarkerLocationsProp.getValueBool()),
+    _numThreads(_numThreadsProp.getValueInt())
 {
     setNull();
     updateFromXMLDocument();
@@ -123,7 +128,8 @@ InverseKinematicsTool::InverseKinematicsTool(const InverseKinematicsTool &aTool)
     _timeRange(_timeRangeProp.getValueDblArray()),
     _reportErrors(_reportErrorsProp.getValueBool()),
     _outputMotionFileName(_outputMotionFileNameProp.getValueStr()),
-    _reportMarkerLocations(_reportMarkerLocationsProp.getValueBool())
+    _reportMarkerLocations(_reportMarkerLocationsProp.getValueBool()),
+    _numThreads(_numThreadsProp.getValueInt())
 {
     setNull();
     *this = aTool;
@@ -216,6 +222,16 @@ void InverseKinematicsTool::setupProperties()
     _reportMarkerLocationsProp.setName("report_marker_locations");
     _reportMarkerLocationsProp.setValue(false);
     _propertySet.append(&_reportMarkerLocationsProp);
+
+    _numThreadsProp.setComment(
+        "Number of threads used to solve the frames. The frames are divided "
+        "into contiguous chunks that are solved concurrently, each starting "
+        "from the solution of the frame before it. A value of 0 or less uses "
+        "one thread per processor. The default, 1, solves the frames in "
+        "sequence.");
+    _numThreadsProp.setName("num_threads");
+    _numThreadsProp.setValue(1);
+    _propertySet.append(&_numThreadsProp);
 }
 
 //_____________________________________________________________________________
@@ -252,6 +268,7 @@ operator=(const InverseKinematicsTool &aTool)
     _reportErrors = aTool._reportErrors;
     _outputMotionFileName = aTool._outputMotionFileName;
     _reportMarkerLocations = aTool._reportMarkerLocations;
+    _numThreads = aTool._numThreads;
 
     return(*this);
 }
@@ -264,6 +281,97 @@ operator=(const InverseKinematicsTool &aTool)
 //=============================================================================
 // RUN
 //=============================================================================
+namespace {
+    // Solves frames first_ix through final_ix of the marker data in
+    // numChunks contiguous chunks, concurrently, each with its own copy of
+    // the model, references and solver. Every chunk but the first is
+    // assembled at the frame before it, which is tracked but not recorded, so
+    // that the first frame of the chunk starts from a nearby pose as it would
+    // in sequence. Row k of q receives the coordinates of frame first_ix + k,
+    // and likewise the marker errors and locations, which are only computed
+    // if their matrices have columns.
+    void solveFramesInParallel(const Model& model,
+            const MarkersReference& markersReference,
+            const SimTK::Array_<CoordinateReference>& coordinateReferences,
+            double constraintWeight, double accuracy,
+            const std::vector<double>& times, int first_ix, int final_ix,
+            int numChunks, SimTK::Matrix& q,
+            SimTK::Matrix& squaredMarkerErrors,
+            SimTK::Matrix_<Vec3>& markerLocations)
+    {
+        struct Chunk {
+            std::unique_ptr<Model> model;
+            MarkersReference markersReference;
+            SimTK::Array_<CoordinateReference> coordinateReferences;
+            int begin;
+            int end;
+            std::exception_ptr error;
+        };
+
+        // Building a model is not guaranteed to be thread safe, so the copies
+        // are built here, one at a time.
+        const int numFrames = final_ix - first_ix + 1;
+        std::vector<std::unique_ptr<Chunk>> chunks;
+        for (int c = 0; c < numChunks; ++c) {
+            std::unique_ptr<Chunk> chunk(new Chunk());
+            chunk->model.reset(model.clone());
+            chunk->model->initSystem();
+            chunk->markersReference = markersReference;
+            chunk->coordinateReferences = coordinateReferences;
+            chunk->begin = first_ix + numFrames*c/numChunks;
+            chunk->end = first_ix + numFrames*(c + 1)/numChunks;
+            chunks.push_back(std::move(chunk));
+        }
+
+        auto solveChunk = [&](Chunk& chunk) {
+            try {
+                InverseKinematicsSolver ikSolver(*chunk.model,
+                    chunk.markersReference, chunk.coordinateReferences,
+                    constraintWeight);
+                ikSolver.setAccuracy(accuracy);
+                SimTK::State s = chunk.model->getWorkingState();
+                const int warmup_ix = std::max(chunk.begin - 1, first_ix);
+                s.updTime() = times[warmup_ix];
+                ikSolver.assemble(s);
+
+                const int nm = ikSolver.getNumMarkersInUse();
+                SimTK::Array_<double> errors(nm, 0.0);
+                SimTK::Array_<Vec3> locations(nm, Vec3(0));
+                for (int i = warmup_ix; i < chunk.end; ++i) {
+                    s.updTime() = times[i];
+                    ikSolver.track(s);
+                    if (i < chunk.begin) continue;
+
+                    const int k = i - first_ix;
+                    q[k] = ~s.getQ();
+                    if (squaredMarkerErrors.ncol() > 0) {
+                        ikSolver.computeCurrentSquaredMarkerErrors(errors);
+                        for (int j = 0; j < nm; ++j)
+                            squaredMarkerErrors(k, j) = errors[j];
+                    }
+                    if (markerLocations.ncol() > 0) {
+                        ikSolver.computeCurrentMarkerLocations(locations);
+                        for (int j = 0; j < nm; ++j)
+                            markerLocations(k, j) = locations[j];
+                    }
+                }
+            } catch (...) {
+                chunk.error = std::current_exception();
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(numChunks);
+        for (auto& chunk : chunks)
+            threads.emplace_back(solveChunk, std::ref(*chunk));
+        for (auto& thread : threads) thread.join();
+
+        for (const auto& chunk : chunks) {
+            if (chunk->error) std::rethrow_exception(chunk->error);
+        }
+    }
+}
+
 //_____________________________________________________________________________
 /**
  * Run the inverse kinematics tool.
@@ -360,9 +468,45 @@ bool InverseKinematicsTool::run()
 
         const clock_t start = clock();
 
+        // With more than one thread, all the frames are solved first, and the
+        // solutions are then reported in order below.
+        int numThreads = _numThreads > 0 ? _numThreads :
+            (int)std::thread::hardware_concurrency();
+        numThreads = std::max(1, std::min(numThreads, Nframes));
+        SimTK::Matrix solvedQ;
+        SimTK::Matrix solvedSquaredMarkerErrors;
+        SimTK::Matrix_<Vec3> solvedMarkerLocations;
+        if (numThreads > 1) {
+            cout << "Solving " << Nframes << " frames with " << numThreads
+                 << " threads." << endl;
+            solvedQ.resize(Nframes, s.getNQ());
+            solvedSquaredMarkerErrors.resize(Nframes, _reportErrors ? nm : 0);
+            solvedMarkerLocations.resize(Nframes,
+                                         _reportMarkerLocations ? nm : 0);
+            solveFramesInParallel(*_model, markersReference,
+                coordinateReferences, _constraintWeight, _accuracy, times,
+                start_ix, final_ix, numThreads, solvedQ,
+                solvedSquaredMarkerErrors, solvedMarkerLocations);
+        }
+
         for (int i = start_ix; i <= final_ix; ++i) {
             s.updTime() = times[i];
-            ikSolver.track(s);
+            if (numThreads > 1) {
+                const int k = i - start_ix;
+                s.updQ() = ~solvedQ[k];
+                _model->getMultibodySystem().realize(s, SimTK::Stage::Position);
+                for (int j = 0; j < solvedSquaredMarkerErrors.ncol(); ++j)
+                    squaredMarkerErrors[j] = solvedSquaredMarkerErrors(k, j);
+                for (int j = 0; j < solvedMarkerLocations.ncol(); ++j)
+                    markerLocations[j] = solvedMarkerLocations(k, j);
+            } else {
+                ikSolver.track(s);
+                if (_reportErrors)
+                    ikSolver.computeCurrentSquaredMarkerErrors(
+                        squaredMarkerErrors);
+                if (_reportMarkerLocations)
+                    ikSolver.computeCurrentMarkerLocations(markerLocations);
+            }
             
             if(_reportErrors){
                 Array<double> markerErrors(0.0, 3);
@@ -370,7 +514,6 @@ bool InverseKinematicsTool::run()
                 double maxSquaredMarkerError = 0.0;
                 int worst = -1;
 
-                ikSolver.computeCurrentSquaredMarkerErrors(squaredMarkerErrors);
                 for(int j=0; j<nm; ++j){
                     totalSquaredMarkerError += squaredMarkerErrors[j];
                     if(squaredMarkerErrors[j] > maxSquaredMarkerError){
@@ -393,7 +536,6 @@ bool InverseKinematicsTool::run()
             }
 
             if(_reportMarkerLocations){
-                ikSolver.computeCurrentMarkerLocations(markerLocations);
                 Array<double> locations(0.0, 3*nm);
                 for(int j=0; j<nm; ++j){
                     for(int k=0; k<3; ++k)
@@ -107,6 +107,10 @@ private:
     PropertyBool _reportMarkerLocationsProp;
     bool &_reportMarkerLocations;
 
+    // number of threads among which the frames are divided
+    PropertyInt _numThreadsProp;
+    int &_numThreads;
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -137,6 +141,13 @@ public:
 
     void setCoordinateFileName(const std::string& coordDataFileName) { _coordinateFileName=coordDataFileName;};
     const std::string& getCoordinateFileName() const { return  _coordinateFileName;};
+
+    /** Set the number of threads used to solve the frames. The frames are
+    divided into contiguous chunks, one per thread, each of which is solved
+    with its own copy of the model. A value of 0 or less uses one thread per
+    processor. The default, 1, solves the frames in sequence. */
+    void setNumThreads(int numThreads) { _numThreads = numThreads; };
+    int getNumThreads() const { return _numThreads; };
     
     //const OpenSim::Storage& getOutputStorage() const;
 private:
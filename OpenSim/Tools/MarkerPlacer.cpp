@@ -385,7 +385,9 @@ bool MarkerPlacer::processModel(Model* aModel,
     
     _outputStorage.reset(new Storage(statesReporter.updStatesStorage()));
     _outputStorage->setName("static pose");
-    _outputStorage->getStateVector(0)->setTime(s.getTime());
+    StateVector firstRow = _outputStorage->getRow(0);
+    firstRow.setTime(s.getTime());
+    _outputStorage->setRow(0, firstRow);
 
     if(_printResultFiles) {
         std::string savedCwd = IO::getCwd();
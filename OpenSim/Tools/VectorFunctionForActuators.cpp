@@ -99,6 +99,9 @@ setNull()
     _CMCActuatorSubsystem = NULL;
     _model             = NULL;
     _integrator        = NULL;
+    _controller        = NULL;
+    _actuators.clear();
+    _timeStepper.reset();
 }
 
 //_____________________________________________________________________________
@@ -243,6 +246,13 @@ getCMCActSubsys()
 /**
  * Evaluate the vector function.
  *
+ * The actuator states are integrated from the initial to the final time with
+ * the controls held by the CMC controller. If the model has no actuator
+ * states (e.g., only CoordinateActuators, or muscles that ignore both
+ * activation dynamics and tendon compliance), the actuator forces at the
+ * final time depend only on the controls and the kinematics, and are computed
+ * without integrating.
+ *
  * @param s SimTK::State.
  * @param aF Array of actuator force differences.
  */
@@ -252,30 +262,37 @@ evaluate( const SimTK::State& s, double *aX, double *rF)
     int i;
     int N = getNX();
 
-    CMC& controller=  dynamic_cast<CMC&>(_model->updControllerSet().get("CMC" ));
-    controller.updControlSet().setControlValues(_tf, aX);
+    if(_controller == NULL) {
+        _controller = &dynamic_cast<CMC&>(_model->updControllerSet().get("CMC" ));
+        const Set<const Actuator>& forceSet = _controller->getActuatorSet();
+        _actuators.resize(N);
+        for(i=0;i<N;i++) {
+            _actuators[i] = &dynamic_cast<const ScalarActuator&>(forceSet[i]);
+        }
+        _timeStepper.reset(new SimTK::TimeStepper(*_CMCActuatorSystem, *_integrator));
+    }
+    _controller->updControlSet().setControlValues(_tf, aX);
 
-    // create a Manager that will integrate just the actuator subsystem and use only the 
-    // CMC controller
+    // integrate just the actuator subsystem and use only the CMC controller
     SimTK::State& actSysState = _CMCActuatorSystem->updDefaultState();
     getCMCActSubsys()->updZ(actSysState) = _model->getMultibodySystem()
                                             .getDefaultSubsystem().getZ(s);
-    actSysState.setTime(_ti);
 
-    SimTK::TimeStepper ts(*_CMCActuatorSystem, *_integrator);
-    ts.initialize(actSysState);
-    ts.stepTo(_tf);
+    if(actSysState.getNZ() == 0) {
+        actSysState.setTime(_tf);
+        actSysState.invalidateAllCacheAtOrAbove(SimTK::Stage::Dynamics);
+        _CMCActuatorSystem->realize(actSysState, SimTK::Stage::Dynamics);
+    } else {
+        actSysState.setTime(_ti);
+        _timeStepper->initialize(actSysState);
+        _timeStepper->stepTo(_tf);
+    }
 
-    const Set<const Actuator>& forceSet = controller.getActuatorSet();
     // Vector function values
-    int j = 0;
+    const SimTK::State& completeState = getCMCActSubsys()->getCompleteState();
     for(i=0;i<N;i++) {
-        auto act = dynamic_cast<const ScalarActuator*>(&forceSet[i]);
-        rF[j] = act->getActuation(getCMCActSubsys()->getCompleteState()) - _f[j];
-        j++;
+        rF[i] = _actuators[i]->getActuation(completeState) - _f[i];
     }
-
-
 }
 //_____________________________________________________________________________
 /**
@@ -30,17 +30,23 @@
 #include <OpenSim/Common/Array.h>
 #include <OpenSim/Common/VectorFunctionUncoupledNxN.h>
 
+#include <memory>
+#include <vector>
+
 namespace SimTK {
 class Integrator;
 class System;
+class TimeStepper;
 }
 
 //=============================================================================
 //=============================================================================
 namespace OpenSim { 
 
+class CMC;
 class CMCActuatorSubsystem;
 class Model;
+class ScalarActuator;
 
 /**
  * An abstract class for representing a vector function.
@@ -79,6 +85,12 @@ protected:
     SimTK::Integrator* _integrator;
     /** Model */
     Model* _model;
+    /** CMC controller, its actuators (in the order of the controls) and the
+        time stepper of the actuator system. These are set up by the first
+        evaluation and reused by later ones. */
+    CMC* _controller;
+    std::vector<const ScalarActuator*> _actuators;
+    std::unique_ptr<SimTK::TimeStepper> _timeStepper;
 
 
 //=============================================================================